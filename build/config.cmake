@@ -9,6 +9,13 @@ ELSE()
     MESSAGE (FATAL_ERROR "Error: unsupported target")
 ENDIF()
 
+# 64-bit toolchains store object properties and array elements in 32-bit (ESCARGOT_USE_32BIT_IN_64BIT)
+# ESCARGOT_UNBOXED_DOUBLE keeps them in 64-bit EncodedValue so that storing a double never allocates a heap number
+IF (ESCARGOT_UNBOXED_DOUBLE)
+    LIST (REMOVE_ITEM ESCARGOT_CXXFLAGS_DEBUG -DESCARGOT_USE_32BIT_IN_64BIT)
+    LIST (REMOVE_ITEM ESCARGOT_CXXFLAGS_RELEASE -DESCARGOT_USE_32BIT_IN_64BIT)
+ENDIF()
+
 # CONFIGURE ESCARGOT VERSION
 FIND_PACKAGE(Git)
 IF (GIT_FOUND)
@@ -121,6 +128,10 @@ IF (NOT DEFINED ESCARGOT_LIBICU_SUPPORT_WITH_DLOPEN)
     SET (ESCARGOT_LIBICU_SUPPORT_WITH_DLOPEN ON)
 ENDIF()
 
+IF (NOT DEFINED ESCARGOT_BYTECODE_OPTIMIZER)
+    SET (ESCARGOT_BYTECODE_OPTIMIZER OFF)
+ENDIF()
+
 
 IF (${ESCARGOT_HOST} STREQUAL "android")
     SET (ESCARGOT_LIBICU_SUPPORT OFF)
@@ -174,6 +185,25 @@ IF (ESCARGOT_WASM)
     SET (ESCARGOT_DEFINITIONS ${ESCARGOT_DEFINITIONS} -DENABLE_WASM)
 ENDIF()
 
+IF (ESCARGOT_IC_STATISTICS)
+    SET (ESCARGOT_DEFINITIONS ${ESCARGOT_DEFINITIONS} -DENABLE_IC_STATISTICS)
+ENDIF()
+
+IF (ESCARGOT_THREADING)
+    SET (ESCARGOT_DEFINITIONS ${ESCARGOT_DEFINITIONS} -DENABLE_THREADING -DGC_THREADS)
+ENDIF()
+
+IF (ESCARGOT_BYTECODE_OPTIMIZER)
+    SET (ESCARGOT_DEFINITIONS ${ESCARGOT_DEFINITIONS} -DENABLE_BYTECODE_OPTIMIZER)
+ENDIF()
+
+IF (ESCARGOT_JIT)
+    IF (NOT ${ESCARGOT_ARCH} STREQUAL "x64")
+        MESSAGE (FATAL_ERROR "Error: ESCARGOT_JIT supports x64 only")
+    ENDIF()
+    SET (ESCARGOT_DEFINITIONS ${ESCARGOT_DEFINITIONS} -DENABLE_JIT)
+ENDIF()
+
 #######################################################
 # flags for $(MODE) : debug/release
 #######################################################
@@ -83,6 +83,10 @@ IF (${ESCARGOT_GC_SMALL_CONFIG} STREQUAL "ON")
     SET (GCUTIL_CFLAGS ${GCUTIL_CFLAGS} -DSMALL_CONFIG -DMAX_HEAP_SECTS=512)
 ENDIF()
 
+IF (ESCARGOT_THREADING)
+    SET (GCUTIL_CFLAGS ${GCUTIL_CFLAGS} -DGC_THREADS -DPARALLEL_MARK -DTHREAD_LOCAL_ALLOC)
+ENDIF()
+
 SET (GCUTIL_MODE ${ESCARGOT_MODE})
 
 ADD_SUBDIRECTORY (third_party/GCutil)
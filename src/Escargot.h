@@ -222,6 +222,13 @@
 #include <vector>
 #include <random>
 
+#if defined(ENABLE_THREADING)
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
 extern "C" {
 #include <libbf.h>
 }
@@ -452,6 +459,11 @@ typedef uint16_t LexicalBlockIndex;
 #define ROPE_STRING_MIN_LENGTH 24
 #endif
 
+// minimum spare capacity of the buffer of a flattened RopeString which can be appended in place
+#ifndef ROPE_STRING_APPEND_MIN_CAPACITY
+#define ROPE_STRING_APPEND_MIN_CAPACITY 64
+#endif
+
 #include "EscargotInfo.h"
 #include "heap/Heap.h"
 #include "util/Util.h"
@@ -44,6 +44,7 @@
 #include "runtime/PromiseObject.h"
 #include "runtime/ProxyObject.h"
 #include "runtime/ArrayBufferObject.h"
+#include "runtime/SharedArrayBufferObject.h"
 #include "runtime/TypedArrayObject.h"
 #include "runtime/SetObject.h"
 #include "runtime/WeakSetObject.h"
@@ -60,6 +61,9 @@
 #include "runtime/BigIntObject.h"
 #include "interpreter/ByteCode.h"
 #include "api/internal/ValueAdapter.h"
+#if defined(ENABLE_CODE_CACHE)
+#include "codecache/CodeCache.h"
+#endif
 
 namespace Escargot {
 
@@ -99,6 +103,10 @@ inline AtomicString toImpl(AtomicStringRef* v)
 void Globals::initialize()
 {
     Heap::initialize();
+    // initialize process-wide data before other threads create VMInstances
+    if (!String::emptyString) {
+        String::emptyString = new (NoGC) ASCIIString("");
+    }
 }
 
 void Globals::finalize()
@@ -106,6 +114,51 @@ void Globals::finalize()
     Heap::finalize();
 }
 
+bool Globals::supportsThreading()
+{
+#if defined(ENABLE_THREADING)
+    return true;
+#else
+    return false;
+#endif
+}
+
+#if defined(ENABLE_THREADING)
+void Globals::initializeThread()
+{
+    Heap::initializeThread();
+}
+
+void Globals::finalizeThread()
+{
+    Heap::finalizeThread();
+}
+
+bool Globals::isInitializedThread()
+{
+    return Heap::isInitializedThread();
+}
+#else
+void Globals::initializeThread()
+{
+    ESCARGOT_LOG_ERROR("If you want to use this function, you should enable threading");
+    RELEASE_ASSERT_NOT_REACHED();
+}
+
+void Globals::finalizeThread()
+{
+    ESCARGOT_LOG_ERROR("If you want to use this function, you should enable threading");
+    RELEASE_ASSERT_NOT_REACHED();
+}
+
+bool Globals::isInitializedThread()
+{
+    ESCARGOT_LOG_ERROR("If you want to use this function, you should enable threading");
+    RELEASE_ASSERT_NOT_REACHED();
+    return false;
+}
+#endif
+
 void* Memory::gcMalloc(size_t siz)
 {
     return GC_MALLOC(siz);
@@ -693,6 +746,21 @@ DEFINE_IS_AS_POINTERVALUE_XXX(ErrorObject)
 DEFINE_IS_AS_POINTERVALUE_XXX(ArrayBufferObject)
 DEFINE_IS_AS_POINTERVALUE_XXX(ArrayBufferView)
 
+#if defined(ENABLE_THREADING)
+DEFINE_IS_AS_POINTERVALUE_XXX(SharedArrayBufferObject)
+#else
+bool ValueRef::isSharedArrayBufferObject()
+{
+    return false;
+}
+
+SharedArrayBufferObjectRef* ValueRef::asSharedArrayBufferObject()
+{
+    RELEASE_ASSERT_NOT_REACHED();
+    return nullptr;
+}
+#endif
+
 bool ValueRef::isArrayPrototypeObject()
 {
     return toImpl(this).isPointerValue() && toImpl(this).asPointerValue()->isArrayPrototypeObject();
@@ -997,6 +1065,47 @@ Evaluator::EvaluatorResult VMInstanceRef::executePendingPromiseJob()
     return toEvaluatorResultRef(result);
 }
 
+size_t VMInstanceRef::droppedWeakEntryCount()
+{
+    return toImpl(this)->droppedWeakEntryCount();
+}
+
+bool VMInstanceRef::canBlock()
+{
+#if defined(ENABLE_THREADING)
+    return toImpl(this)->canBlock();
+#else
+    return false;
+#endif
+}
+
+void VMInstanceRef::setCanBlock(bool canBlock)
+{
+#if defined(ENABLE_THREADING)
+    toImpl(this)->setCanBlock(canBlock);
+#endif
+}
+
+bool VMInstanceRef::dumpInlineCacheStatistics(size_t topN)
+{
+#if defined(ENABLE_IC_STATISTICS)
+    toImpl(this)->dumpInlineCacheStatistics(topN);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool VMInstanceRef::flushCodeCache()
+{
+#if defined(ENABLE_CODE_CACHE)
+    toImpl(this)->codeCache()->flush();
+    return true;
+#else
+    return false;
+#endif
+}
+
 PersistentRefHolder<ContextRef> ContextRef::create(VMInstanceRef* vminstanceref)
 {
     VMInstance* vminstance = toImpl(vminstanceref);
@@ -1009,6 +1118,11 @@ void ContextRef::clearRelatedQueuedPromiseJobs()
     imp->vmInstance()->jobQueue()->clearJobRelatedWithSpecificContext(imp);
 }
 
+void ContextRef::installLazyBuiltins()
+{
+    toImpl(this)->globalObject()->installLazyBuiltinGroups();
+}
+
 ContextRef* ExecutionStateRef::context()
 {
     return toRef(toImpl(this)->context());
@@ -2662,6 +2776,79 @@ bool ArrayBufferObjectRef::isDetachedBuffer()
     return toImpl(this)->isDetachedBuffer();
 }
 
+#if defined(ENABLE_THREADING)
+void* SharedDataBlockInfoRef::data()
+{
+    return toImpl(this)->data();
+}
+
+size_t SharedDataBlockInfoRef::byteLength()
+{
+    return toImpl(this)->byteLength();
+}
+
+void SharedDataBlockInfoRef::release()
+{
+    toImpl(this)->deref();
+}
+
+SharedArrayBufferObjectRef* SharedArrayBufferObjectRef::create(ExecutionStateRef* state, size_t byteLength)
+{
+    ExecutionState* esState = toImpl(state);
+    return toRef(SharedArrayBufferObject::allocateSharedArrayBuffer(*esState, esState->context()->globalObject()->sharedArrayBuffer(), byteLength));
+}
+
+SharedArrayBufferObjectRef* SharedArrayBufferObjectRef::create(ExecutionStateRef* state, SharedDataBlockInfoRef* blockInfo)
+{
+    ExecutionState* esState = toImpl(state);
+    return toRef(new SharedArrayBufferObject(*esState, esState->context()->globalObject()->sharedArrayBufferPrototype(), toImpl(blockInfo)));
+}
+
+SharedDataBlockInfoRef* SharedArrayBufferObjectRef::acquireSharedDataBlockInfo()
+{
+    SharedDataBlockInfo* blockInfo = toImpl(this)->sharedDataBlockInfo();
+    blockInfo->ref();
+    return toRef(blockInfo);
+}
+#else
+void* SharedDataBlockInfoRef::data()
+{
+    RELEASE_ASSERT_NOT_REACHED();
+    return nullptr;
+}
+
+size_t SharedDataBlockInfoRef::byteLength()
+{
+    RELEASE_ASSERT_NOT_REACHED();
+    return 0;
+}
+
+void SharedDataBlockInfoRef::release()
+{
+    RELEASE_ASSERT_NOT_REACHED();
+}
+
+SharedArrayBufferObjectRef* SharedArrayBufferObjectRef::create(ExecutionStateRef* state, size_t byteLength)
+{
+    ESCARGOT_LOG_ERROR("If you want to use this function, you should enable threading");
+    RELEASE_ASSERT_NOT_REACHED();
+    return nullptr;
+}
+
+SharedArrayBufferObjectRef* SharedArrayBufferObjectRef::create(ExecutionStateRef* state, SharedDataBlockInfoRef* blockInfo)
+{
+    ESCARGOT_LOG_ERROR("If you want to use this function, you should enable threading");
+    RELEASE_ASSERT_NOT_REACHED();
+    return nullptr;
+}
+
+SharedDataBlockInfoRef* SharedArrayBufferObjectRef::acquireSharedDataBlockInfo()
+{
+    RELEASE_ASSERT_NOT_REACHED();
+    return nullptr;
+}
+#endif
+
 ArrayBufferObjectRef* ArrayBufferViewRef::buffer()
 {
     return toRef(toImpl(this)->buffer());
@@ -56,6 +56,8 @@ class GlobalObjectRef;
 class FunctionObjectRef;
 class ArrayObjectRef;
 class ArrayBufferObjectRef;
+class SharedArrayBufferObjectRef;
+class SharedDataBlockInfoRef;
 class ArrayBufferViewRef;
 class Int8ArrayObjectRef;
 class Uint8ArrayObjectRef;
@@ -97,6 +99,15 @@ class ESCARGOT_EXPORT Globals {
 public:
     static void initialize();
     static void finalize();
+    // SharedArrayBuffer, Atomics and the functions below are available only when escargot is built with ESCARGOT_THREADING
+    static bool supportsThreading();
+
+    // every thread except the thread which called Globals::initialize should call initializeThread before using escargot
+    // and finalizeThread before the thread exits.
+    // VMInstances can run concurrently on initialized threads, but each VMInstance should be used only on the thread which created it
+    static void initializeThread();
+    static void finalizeThread();
+    static bool isInitializedThread();
 };
 
 class ESCARGOT_EXPORT Memory {
@@ -548,6 +559,7 @@ class ESCARGOT_EXPORT VMInstanceRef {
 public:
     // you can to provide timezone as TZ database name like "US/Pacific".
     // if you don't provide, we try to detect system timezone.
+    // VMInstance is bound to the thread which created it (see Globals::initializeThread)
     static PersistentRefHolder<VMInstanceRef> create(PlatformRef* platform, const char* locale = nullptr, const char* timezone = nullptr);
 
     typedef void (*OnVMInstanceDelete)(VMInstanceRef* instance);
@@ -580,6 +592,24 @@ public:
 
     bool hasPendingPromiseJob();
     Evaluator::EvaluatorResult executePendingPromiseJob();
+
+    // total number of WeakMap and WeakSet entries released by GC because their keys were collected
+    size_t droppedWeakEntryCount();
+
+    // whether Atomics.wait can suspend the thread of this VMInstance (true by default)
+    // if false, Atomics.wait throws TypeError. only meaningful when escargot is built with ESCARGOT_THREADING
+    bool canBlock();
+    void setCanBlock(bool canBlock);
+
+    // print hit and miss counts of every property access inline cache with its source location
+    // sites are sorted by miss count and topN limits the number of printed sites (0 means no limit)
+    // returns false if Escargot is not built with ESCARGOT_IC_STATISTICS
+    bool dumpInlineCacheStatistics(size_t topN = 0);
+
+    // wait until every code cache file is written on disk by the background writer
+    // call this before the process exits without destroying VMInstance
+    // returns false if Escargot is not built with ESCARGOT_CODE_CACHE
+    bool flushCodeCache();
 };
 
 class ESCARGOT_EXPORT ContextRef {
@@ -588,6 +618,10 @@ public:
 
     void clearRelatedQueuedPromiseJobs();
 
+    // some builtins (e.g. Map, Promise, TypedArrays) are installed on their first use to make Context creation cheap
+    // this installs all of them at once, so that a warmed up Context does not pay the cost while running scripts
+    void installLazyBuiltins();
+
     VMInstanceRef* vmInstance();
     ScriptParserRef* scriptParser();
 
@@ -689,6 +723,7 @@ public:
     bool isGlobalObject();
     bool isErrorObject();
     bool isArrayBufferObject();
+    bool isSharedArrayBufferObject();
     bool isArrayBufferView();
     bool isInt8ArrayObject();
     bool isUint8ArrayObject();
@@ -756,6 +791,7 @@ public:
     GlobalObjectRef* asGlobalObject();
     ErrorObjectRef* asErrorObject();
     ArrayBufferObjectRef* asArrayBufferObject();
+    SharedArrayBufferObjectRef* asSharedArrayBufferObject();
     ArrayBufferViewRef* asArrayBufferView();
     Int8ArrayObjectRef* asInt8ArrayObject();
     Uint8ArrayObjectRef* asUint8ArrayObject();
@@ -1435,6 +1471,26 @@ public:
     bool isDetachedBuffer();
 };
 
+// Handle of the data block of a SharedArrayBuffer. it can be passed to another thread
+// and keeps the data block alive until release() is called.
+class ESCARGOT_EXPORT SharedDataBlockInfoRef {
+public:
+    void* data();
+    size_t byteLength();
+    // drop the reference of this handle. the handle should not be used after this call
+    void release();
+};
+
+class ESCARGOT_EXPORT SharedArrayBufferObjectRef : public ArrayBufferObjectRef {
+public:
+    static SharedArrayBufferObjectRef* create(ExecutionStateRef* state, size_t byteLength);
+    // create a SharedArrayBuffer which shares the data block of blockInfo.
+    // blockInfo is not consumed. caller should still release it
+    static SharedArrayBufferObjectRef* create(ExecutionStateRef* state, SharedDataBlockInfoRef* blockInfo);
+    // returns a new handle of the data block. caller should release it
+    SharedDataBlockInfoRef* acquireSharedDataBlockInfo();
+};
+
 class ESCARGOT_EXPORT ArrayBufferViewRef : public ObjectRef {
 public:
     ArrayBufferObjectRef* buffer();
@@ -1741,6 +1797,8 @@ public:
     {
         return calloc(sizeInByte, 1);
     }
+    // whereObjectMade and obj are nullptr when the data block of SharedArrayBuffer is freed by SharedDataBlockInfoRef::release
+    // the data block of SharedArrayBuffer is always freed by the PlatformRef which allocated it
     virtual void onArrayBufferObjectDataBufferFree(ContextRef* whereObjectMade, ArrayBufferObjectRef* obj, void* buffer)
     {
         return free(buffer);
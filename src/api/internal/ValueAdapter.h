@@ -87,6 +87,8 @@ DEFINE_CAST(Job);
 DEFINE_CAST(Script);
 DEFINE_CAST(ScriptParser);
 DEFINE_CAST(ArrayBufferObject);
+DEFINE_CAST(SharedArrayBufferObject);
+DEFINE_CAST(SharedDataBlockInfo);
 DEFINE_CAST(ArrayBufferView);
 DEFINE_CAST(Int8ArrayObject);
 DEFINE_CAST(Uint8ArrayObject);
@@ -26,19 +26,92 @@
 #include "codecache/CodeCacheReaderWriter.h"
 #include "parser/Script.h"
 #include "parser/CodeBlock.h"
+#include "interpreter/ByteCode.h"
+#include "runtime/VMInstance.h"
 
 // file libraries
 #include <dirent.h>
 #include <sys/stat.h>
 #include <sys/file.h>
+#include <sys/mman.h>
 #include <unistd.h>
 
 #define CODE_CACHE_FILE_DIR "/Escargot-cache/"
 #define CODE_CACHE_LIST_FILE_NAME "cache_list"
+#define CODE_CACHE_TEMP_FILE_SUFFIX ".tmp"
 #define CODE_CACHE_MAX_CACHE_NUM 32
+#define CODE_CACHE_DATA_FILE_MAGIC 0x45534343 // "ESCC"
+#define CODE_CACHE_DATA_FILE_VERSION 2
 
 namespace Escargot {
 
+// header placed at the beginning of each cache data file
+// srcHash only names the cache file, so the source is verified again with its length and a 64-bit content hash
+// data after the header is verified with its size and hash before it is deserialized
+struct CodeCacheDataFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t sourceHash;
+    size_t sourceLength;
+    uint64_t dataHash;
+    size_t dataSize;
+};
+
+// 64-bit FNV-1a
+static uint64_t computeContentHash(const uint8_t* data, size_t size)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static uint64_t computeSourceContentHash(String* source)
+{
+    // hash of the raw source buffer
+    auto bufferAccessData = source->bufferAccessData();
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(bufferAccessData.buffer);
+    size_t size = bufferAccessData.has8BitContent ? bufferAccessData.length : bufferAccessData.length * sizeof(char16_t);
+    return computeContentHash(data, size);
+}
+
+template <typename T>
+static void appendCacheBytes(std::vector<char>& data, const T* src, size_t size)
+{
+    const char* bytes = reinterpret_cast<const char*>(src);
+    data.insert(data.end(), bytes, bytes + size);
+}
+
+// write into a temporary file and rename it
+// so that a cache file on disk is always either the old one or the complete new one
+static bool writeCacheFileAtomically(const std::string& filePath, const std::vector<char>& data)
+{
+    std::string tempFilePath = filePath + CODE_CACHE_TEMP_FILE_SUFFIX;
+    FILE* file = fopen(tempFilePath.data(), "wb");
+    if (UNLIKELY(!file)) {
+        ESCARGOT_LOG_ERROR("[CodeCache] can't open the cache file %s\n", tempFilePath.data());
+        return false;
+    }
+
+    if (UNLIKELY(fwrite(data.data(), sizeof(char), data.size(), file) != data.size() || fflush(file) != 0 || fsync(fileno(file)) != 0)) {
+        ESCARGOT_LOG_ERROR("[CodeCache] fwrite of %s failed\n", tempFilePath.data());
+        fclose(file);
+        unlink(tempFilePath.data());
+        return false;
+    }
+    fclose(file);
+
+    if (UNLIKELY(rename(tempFilePath.data(), filePath.data()) != 0)) {
+        ESCARGOT_LOG_ERROR("[CodeCache] can't rename the cache file %s\n", tempFilePath.data());
+        unlink(tempFilePath.data());
+        return false;
+    }
+
+    return true;
+}
+
 void CodeCache::CodeCacheContext::reset()
 {
     m_cacheFilePath.clear();
@@ -49,6 +122,16 @@ void CodeCache::CodeCacheContext::reset()
         m_cacheStringTable = nullptr;
     }
     m_cacheDataOffset = 0;
+    m_sourceHash = 0;
+    m_sourceLength = 0;
+
+    if (m_mappedData) {
+        munmap(m_mappedData, m_mappedSize);
+        m_mappedData = nullptr;
+        m_mappedSize = 0;
+    }
+
+    std::vector<char>().swap(m_cacheData);
 }
 
 CodeCache::CodeCache(const char* baseCacheDir)
@@ -57,6 +140,10 @@ CodeCache::CodeCache(const char* baseCacheDir)
     , m_cacheDirFD(-1)
     , m_enabled(false)
     , m_status(Status::NONE)
+    , m_writerCurrentHash(0)
+    , m_writerBusy(false)
+    , m_writerTerminating(false)
+    , m_writerFailed(false)
 {
     initialize(baseCacheDir);
 }
@@ -255,8 +342,17 @@ void CodeCache::clearCacheDir()
     closedir(cacheDir);
 }
 
+void CodeCache::flush()
+{
+    std::unique_lock<std::mutex> lock(m_writerMutex);
+    m_writerCondition.wait(lock, [this] { return m_writerQueue.empty() && !m_writerBusy; });
+}
+
 void CodeCache::clear()
 {
+    // pending cache writings are finished before the cache directory is unlocked
+    stopWriterThread();
+
     m_currentContext.reset();
 
     unLockAndCloseCacheDir();
@@ -282,6 +378,7 @@ void CodeCache::clearAll()
 {
     // clear CodeCache and all cache files
     ASSERT(m_status == Status::FAILED || m_status == Status::NONE);
+    stopWriterThread();
     clearCacheDir();
     clear();
 }
@@ -303,25 +400,20 @@ void CodeCache::setCacheEntry(const CodeCacheEntryChunk& entryChunk)
     m_cacheList.insert(std::make_pair(entryChunk.m_srcHash, entryChunk.m_entry));
 }
 
-bool CodeCache::addCacheEntry(size_t hash, const CodeCacheEntry& entry)
+void CodeCache::addCacheEntry(size_t hash, const CodeCacheEntry& entry)
 {
     ASSERT(m_enabled);
+    ASSERT(m_cacheList.size() < CODE_CACHE_MAX_CACHE_NUM);
 
 #ifndef NDEBUG
     auto iter = m_cacheList.find(hash);
     ASSERT(iter == m_cacheList.end());
 #endif
-    if (m_cacheList.size() == CODE_CACHE_MAX_CACHE_NUM) {
-        if (UNLIKELY(!removeLRUCacheEntry())) {
-            return false;
-        }
-    }
 
     m_cacheList.insert(std::make_pair(hash, entry));
-    return true;
 }
 
-bool CodeCache::removeLRUCacheEntry()
+size_t CodeCache::removeLRUCacheEntry()
 {
     ASSERT(m_enabled);
     ASSERT(m_cacheList.size() == CODE_CACHE_MAX_CACHE_NUM);
@@ -342,25 +434,110 @@ bool CodeCache::removeLRUCacheEntry()
         }
     }
 
-    if (UNLIKELY(!removeCacheFile(lruHash))) {
-        return false;
-    }
-
+    // the cache file itself is removed later by the writer thread
     size_t eraseReturn = m_cacheList.erase(lruHash);
     ASSERT(eraseReturn == 1 && m_cacheList.size() == CODE_CACHE_MAX_CACHE_NUM - 1);
 
-    return true;
+    return lruHash;
 }
 
-bool CodeCache::removeCacheFile(size_t hash)
+void CodeCache::startWriterThread()
 {
     ASSERT(m_enabled);
-    ASSERT(m_cacheDirPath.length());
+    ASSERT(!m_writerThread.joinable());
+
+    m_writerTerminating = false;
+    m_writerThread = std::thread(&CodeCache::processWriteJobs, this);
+}
+
+void CodeCache::stopWriterThread()
+{
+    if (!m_writerThread.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_writerMutex);
+        m_writerTerminating = true;
+    }
+    m_writerCondition.notify_all();
+    m_writerThread.join();
+
+    ASSERT(m_writerQueue.empty() && !m_writerBusy);
+    m_writerTerminating = false;
+}
+
+void CodeCache::enqueueWriteJob(CodeCacheWriteJob&& job)
+{
+    if (!m_writerThread.joinable()) {
+        startWriterThread();
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_writerMutex);
+        m_writerQueue.push_back(std::move(job));
+    }
+    m_writerCondition.notify_all();
+}
+
+bool CodeCache::hasPendingWrite(size_t hash)
+{
+    std::lock_guard<std::mutex> guard(m_writerMutex);
+    if (m_writerBusy && m_writerCurrentHash == hash) {
+        return true;
+    }
+    for (auto iter = m_writerQueue.begin(); iter != m_writerQueue.end(); iter++) {
+        if (iter->m_srcHash == hash) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CodeCache::processWriteJobs()
+{
+    // writer thread only accesses its own jobs and never touches GC heap
+    std::unique_lock<std::mutex> lock(m_writerMutex);
+    while (true) {
+        m_writerCondition.wait(lock, [this] { return !m_writerQueue.empty() || m_writerTerminating; });
+        if (m_writerQueue.empty()) {
+            // terminate only after every pending job is written
+            ASSERT(m_writerTerminating);
+            break;
+        }
+
+        CodeCacheWriteJob job = std::move(m_writerQueue.front());
+        m_writerQueue.pop_front();
+        m_writerCurrentHash = job.m_srcHash;
+        m_writerBusy = true;
+        bool skip = m_writerFailed;
+
+        lock.unlock();
+        bool success = skip || processWriteJob(job);
+        lock.lock();
+
+        if (UNLIKELY(!success)) {
+            // CodeCache is cleared by the main thread at the next caching
+            m_writerFailed = true;
+        }
+        m_writerBusy = false;
+        m_writerCondition.notify_all();
+    }
+}
 
-    std::string filePath = m_cacheDirPath + std::to_string(hash);
+bool CodeCache::processWriteJob(const CodeCacheWriteJob& job)
+{
+    if (UNLIKELY(!writeCacheFileAtomically(job.m_cacheFilePath, job.m_cacheData))) {
+        return false;
+    }
 
-    if (remove(filePath.data()) != 0) {
-        ESCARGOT_LOG_ERROR("[CodeCache] can`t remove a cache file %s\n", filePath.data());
+    if (UNLIKELY(!writeCacheFileAtomically(job.m_cacheListFilePath, job.m_cacheListData))) {
+        return false;
+    }
+
+    // evicted file is removed after the new cache list no longer refers to it
+    if (job.m_evictedFilePath.length() && UNLIKELY(remove(job.m_evictedFilePath.data()) != 0)) {
+        ESCARGOT_LOG_ERROR("[CodeCache] can`t remove a cache file %s\n", job.m_evictedFilePath.data());
         return false;
     }
 
@@ -378,12 +555,17 @@ std::pair<bool, CodeCacheEntry> CodeCache::searchCache(size_t srcHash)
     if (iter != m_cacheList.end()) {
         cacheHit = true;
         entry = iter->second;
+
+        if (UNLIKELY(hasPendingWrite(srcHash))) {
+            // cache data file is being written by the writer thread
+            flush();
+        }
     }
 
     return std::make_pair(cacheHit, entry);
 }
 
-void CodeCache::prepareCacheLoading(Context* context, size_t srcHash, const CodeCacheEntry& entry)
+void CodeCache::prepareCacheLoading(Context* context, size_t srcHash, String* source, const CodeCacheEntry& entry)
 {
     ASSERT(m_enabled && m_status == Status::READY);
     ASSERT(m_cacheDirPath.length());
@@ -394,10 +576,18 @@ void CodeCache::prepareCacheLoading(Context* context, size_t srcHash, const Code
 
     m_currentContext.m_cacheFilePath = m_cacheDirPath + std::to_string(srcHash);
     m_currentContext.m_cacheEntry = entry;
+    m_currentContext.m_sourceHash = computeSourceContentHash(source);
+    m_currentContext.m_sourceLength = source->length();
+
+    if (UNLIKELY(!mapCacheData())) {
+        m_status = Status::FAILED;
+        return;
+    }
+
     m_currentContext.m_cacheStringTable = loadCacheStringTable(context);
 }
 
-void CodeCache::prepareCacheWriting(size_t srcHash)
+void CodeCache::prepareCacheWriting(size_t srcHash, String* source)
 {
     ASSERT(m_enabled && m_status == Status::READY);
     ASSERT(m_cacheDirPath.length());
@@ -408,6 +598,8 @@ void CodeCache::prepareCacheWriting(size_t srcHash)
 
     m_currentContext.m_cacheFilePath = m_cacheDirPath + std::to_string(srcHash);
     m_currentContext.m_cacheStringTable = new CacheStringTable();
+    m_currentContext.m_sourceHash = computeSourceContentHash(source);
+    m_currentContext.m_sourceLength = source->length();
 }
 
 bool CodeCache::postCacheLoading()
@@ -432,23 +624,52 @@ void CodeCache::postCacheWriting(size_t srcHash)
     ASSERT(m_enabled);
 
     if (LIKELY(m_status == Status::FINISH)) {
-        CodeCacheEntry& entry = m_currentContext.m_cacheEntry;
-        ASSERT(entry.m_lastWrittenTimeStamp == 0);
+        bool writerFailed;
+        {
+            std::lock_guard<std::mutex> guard(m_writerMutex);
+            writerFailed = m_writerFailed;
+        }
 
-        // write time stamp
-        entry.m_lastWrittenTimeStamp = fastTickCount();
+        if (LIKELY(!writerFailed)) {
+            CodeCacheEntry& entry = m_currentContext.m_cacheEntry;
+            ASSERT(entry.m_lastWrittenTimeStamp == 0);
 
-        if (addCacheEntry(srcHash, m_currentContext.m_cacheEntry)) {
-            if (writeCacheList()) {
-                reset();
-                m_status = Status::READY;
+            // write time stamp
+            entry.m_lastWrittenTimeStamp = fastTickCount();
 
-                return;
+            CodeCacheWriteJob job;
+            job.m_srcHash = srcHash;
+            if (m_cacheList.size() == CODE_CACHE_MAX_CACHE_NUM) {
+                job.m_evictedFilePath = m_cacheDirPath + std::to_string(removeLRUCacheEntry());
             }
+            addCacheEntry(srcHash, entry);
+
+            // every data is buffered now, so complete the file header with the hash of them
+            std::vector<char>& cacheData = m_currentContext.m_cacheData;
+            ASSERT(cacheData.size() >= sizeof(CodeCacheDataFileHeader));
+            CodeCacheDataFileHeader header;
+            memcpy(&header, cacheData.data(), sizeof(CodeCacheDataFileHeader));
+            header.dataSize = cacheData.size() - sizeof(CodeCacheDataFileHeader);
+            header.dataHash = computeContentHash(reinterpret_cast<const uint8_t*>(cacheData.data()) + sizeof(CodeCacheDataFileHeader), header.dataSize);
+            memcpy(cacheData.data(), &header, sizeof(CodeCacheDataFileHeader));
+
+            job.m_cacheFilePath = m_currentContext.m_cacheFilePath;
+            job.m_cacheData.swap(cacheData);
+            job.m_cacheListFilePath = m_cacheDirPath + CODE_CACHE_LIST_FILE_NAME;
+            serializeCacheList(job.m_cacheListData);
+
+            // serialized data is written on disk by the writer thread
+            enqueueWriteJob(std::move(job));
+
+            reset();
+            m_status = Status::READY;
+
+            return;
         }
     }
 
     // failed to write cache
+    m_status = Status::FAILED;
     clearAll();
 }
 
@@ -464,10 +685,7 @@ void CodeCache::storeStringTable()
     m_cacheWriter->setStringTable(m_currentContext.m_cacheStringTable);
     m_cacheWriter->storeStringTable();
 
-    if (UNLIKELY(!writeCacheData(CodeCacheType::CACHE_STRING))) {
-        m_status = Status::FAILED;
-        return;
-    }
+    bufferCacheData(CodeCacheType::CACHE_STRING);
 
     // the last stage of writing cache done
     m_status = Status::FINISH;
@@ -486,11 +704,31 @@ void CodeCache::storeCodeBlockTree(InterpretedCodeBlock* topCodeBlock)
 
     m_cacheWriter->setStringTable(m_currentContext.m_cacheStringTable);
 
+    // CodeBlock ids are assigned first because each node refers to its parent and children by id
+    size_t nodeIndex = 0;
+    m_cacheWriter->clearCodeBlockIndex();
+    indexCodeBlockTreeNode(topCodeBlock, nodeIndex);
+
     size_t nodeCount = 0;
     storeCodeBlockTreeNode(topCodeBlock, nodeCount);
+    ASSERT(nodeCount == nodeIndex);
 
-    if (UNLIKELY(!writeCacheData(CodeCacheType::CACHE_CODEBLOCK, nodeCount))) {
-        m_status = Status::FAILED;
+    bufferCacheData(CodeCacheType::CACHE_CODEBLOCK, nodeCount);
+}
+
+void CodeCache::indexCodeBlockTreeNode(InterpretedCodeBlock* codeBlock, size_t& nodeIndex)
+{
+    ASSERT(!!codeBlock);
+
+    // same pre-order as storeCodeBlockTreeNode
+    m_cacheWriter->setCodeBlockIndex(codeBlock, nodeIndex);
+    nodeIndex++;
+
+    if (codeBlock->hasChildren()) {
+        InterpretedCodeBlockVector& childrenVector = codeBlock->children();
+        for (size_t i = 0; i < childrenVector.size(); i++) {
+            indexCodeBlockTreeNode(childrenVector[i], nodeIndex);
+        }
     }
 }
 
@@ -509,6 +747,22 @@ void CodeCache::storeCodeBlockTreeNode(InterpretedCodeBlock* codeBlock, size_t&
     }
 }
 
+void CodeCache::storeModuleData(Script* script)
+{
+    if (m_status != Status::IN_PROGRESS) {
+        // Caching process failed in the previous stage
+        return;
+    }
+
+    ASSERT(!!m_currentContext.m_cacheStringTable);
+    ASSERT(script->isModule());
+
+    m_cacheWriter->setStringTable(m_currentContext.m_cacheStringTable);
+
+    m_cacheWriter->storeModuleData(script);
+    bufferCacheData(CodeCacheType::CACHE_MODULE);
+}
+
 void CodeCache::storeByteCodeBlock(ByteCodeBlock* block)
 {
     if (m_status != Status::IN_PROGRESS) {
@@ -520,10 +774,28 @@ void CodeCache::storeByteCodeBlock(ByteCodeBlock* block)
 
     m_cacheWriter->setStringTable(m_currentContext.m_cacheStringTable);
 
+    if (!block->codeBlock()->isGlobalCodeBlock()) {
+        // function ByteCodeBlocks are collected in the buffer and written at once by storeFunctionByteCodeBlocks
+        m_cacheWriter->storeFunctionByteCodeBlock(block);
+        return;
+    }
+
     m_cacheWriter->storeByteCodeBlock(block);
-    if (UNLIKELY(!writeCacheData(CodeCacheType::CACHE_BYTECODE))) {
-        m_status = Status::FAILED;
+    bufferCacheData(CodeCacheType::CACHE_BYTECODE);
+}
+
+void CodeCache::storeFunctionByteCodeBlocks()
+{
+    if (m_status != Status::IN_PROGRESS) {
+        // Caching process failed in the previous stage
+        m_cacheWriter->clearBuffer();
+        m_cacheWriter->clearCodeBlockIndex();
+        return;
     }
+
+    bufferCacheData(CodeCacheType::CACHE_FUNCTION_BYTECODE);
+    // CodeBlock ids are not used after the function ByteCodeBlocks
+    m_cacheWriter->clearCodeBlockIndex();
 }
 
 CacheStringTable* CodeCache::loadCacheStringTable(Context* context)
@@ -575,46 +847,42 @@ InterpretedCodeBlock* CodeCache::loadCodeBlockTree(Context* context, Script* scr
     }
 
     // temporal vector to keep the loaded InterpretedCodeBlock in GC heap
-    std::unordered_map<size_t, InterpretedCodeBlock*, std::hash<size_t>, std::equal_to<size_t>, GCUtil::gc_malloc_allocator<std::pair<size_t const, InterpretedCodeBlock*>>> tempCodeBlockMap;
+    // CodeBlocks are stored in pre-order, so the index of this vector is the cache id of each CodeBlock
+    std::vector<InterpretedCodeBlock*, GCUtil::gc_malloc_allocator<InterpretedCodeBlock*>> tempCodeBlockVector;
 
     // CodeCacheMetaInfo::codeBlockCount has the value of nodeCount for CACHE_CODEBLOCK
     size_t nodeCount = metaInfo.codeBlockCount;
+    tempCodeBlockVector.reserve(nodeCount);
     for (size_t i = 0; i < nodeCount; i++) {
         InterpretedCodeBlock* codeBlock = m_cacheReader->loadInterpretedCodeBlock(context, script);
-        // end position is used as cache id of each CodeBlock
-        ASSERT(tempCodeBlockMap.find(codeBlock->src().end()) == tempCodeBlockMap.end());
-        tempCodeBlockMap.insert(std::make_pair(codeBlock->src().end(), codeBlock));
-
-        if (i == 0) {
-            // GlobalCodeBlock is firstly stored and loaded
-            topCodeBlock = codeBlock;
-        }
+        tempCodeBlockVector.push_back(codeBlock);
     }
+    // GlobalCodeBlock is firstly stored and loaded
+    ASSERT(nodeCount > 0);
+    topCodeBlock = tempCodeBlockVector[0];
 
     // link CodeBlock tree
-    for (auto iter = tempCodeBlockMap.begin(); iter != tempCodeBlockMap.end(); iter++) {
-        InterpretedCodeBlock* codeBlock = iter->second;
+    for (size_t i = 0; i < nodeCount; i++) {
+        InterpretedCodeBlock* codeBlock = tempCodeBlockVector[i];
         size_t parentIndex = (size_t)codeBlock->parent();
         if (parentIndex == SIZE_MAX) {
             codeBlock->setParent(nullptr);
         } else {
-            auto parentIter = tempCodeBlockMap.find(parentIndex);
-            ASSERT(parentIter != tempCodeBlockMap.end());
-            codeBlock->setParent(parentIter->second);
+            ASSERT(parentIndex < i);
+            codeBlock->setParent(tempCodeBlockVector[parentIndex]);
         }
 
         if (codeBlock->hasChildren()) {
             for (size_t childIndex = 0; childIndex < codeBlock->children().size(); childIndex++) {
-                size_t srcIndex = (size_t)codeBlock->children()[childIndex];
-                auto childIter = tempCodeBlockMap.find(srcIndex);
-                ASSERT(childIter != tempCodeBlockMap.end());
-                codeBlock->children()[childIndex] = childIter->second;
+                size_t blockIndex = (size_t)codeBlock->children()[childIndex];
+                ASSERT(blockIndex > i && blockIndex < nodeCount);
+                codeBlock->children()[childIndex] = tempCodeBlockVector[blockIndex];
             }
         }
     }
 
     // clear
-    tempCodeBlockMap.clear();
+    tempCodeBlockVector.clear();
     m_cacheReader->clearBuffer();
 
     ASSERT(topCodeBlock->isGlobalCodeBlock());
@@ -622,6 +890,33 @@ InterpretedCodeBlock* CodeCache::loadCodeBlockTree(Context* context, Script* scr
     return topCodeBlock;
 }
 
+void CodeCache::loadModuleData(Script* script)
+{
+    if (m_status != Status::IN_PROGRESS) {
+        // Caching process failed in the previous stage
+        return;
+    }
+
+    CodeCacheMetaInfo& metaInfo = m_currentContext.m_cacheEntry.m_metaInfos[(size_t)CodeCacheType::CACHE_MODULE];
+
+    ASSERT(script->isModule());
+    if (UNLIKELY(metaInfo.cacheType != CodeCacheType::CACHE_MODULE)) {
+        m_status = Status::FAILED;
+        return;
+    }
+
+    m_cacheReader->setStringTable(m_currentContext.m_cacheStringTable);
+    if (UNLIKELY(!readCacheData(metaInfo))) {
+        m_status = Status::FAILED;
+        return;
+    }
+
+    m_cacheReader->loadModuleData(script);
+
+    // clear
+    m_cacheReader->clearBuffer();
+}
+
 ByteCodeBlock* CodeCache::loadByteCodeBlock(Context* context, InterpretedCodeBlock* topCodeBlock)
 {
     if (m_status != Status::IN_PROGRESS) {
@@ -644,142 +939,192 @@ ByteCodeBlock* CodeCache::loadByteCodeBlock(Context* context, InterpretedCodeBlo
 
     ByteCodeBlock* block = m_cacheReader->loadByteCodeBlock(context, topCodeBlock);
 
-    // clear and finish
+    // clear
     m_cacheReader->clearBuffer();
-    m_status = Status::FINISH;
 
     return block;
 }
 
-bool CodeCache::writeCacheList()
+void CodeCache::collectCodeBlockTreeNode(InterpretedCodeBlock* codeBlock, std::vector<InterpretedCodeBlock*>& codeBlockVector)
 {
-    ASSERT(m_enabled);
-    ASSERT(m_cacheList.size() > 0 && m_cacheList.size() <= CODE_CACHE_MAX_CACHE_NUM);
-    ASSERT(m_cacheDirPath.length());
+    // pre-order index is used as cache id of each CodeBlock
+    codeBlockVector.push_back(codeBlock);
 
-    std::string cacheListFilePath = m_cacheDirPath + CODE_CACHE_LIST_FILE_NAME;
-    FILE* listFile = fopen(cacheListFilePath.data(), "wb");
-    if (UNLIKELY(!listFile)) {
-        ESCARGOT_LOG_ERROR("[CodeCache] can't open the cache list file %s\n", cacheListFilePath.data());
-        return false;
+    if (codeBlock->hasChildren()) {
+        InterpretedCodeBlockVector& childrenVector = codeBlock->children();
+        for (size_t i = 0; i < childrenVector.size(); i++) {
+            collectCodeBlockTreeNode(childrenVector[i], codeBlockVector);
+        }
+    }
+}
+
+void CodeCache::loadFunctionByteCodeBlocks(Context* context, InterpretedCodeBlock* topCodeBlock)
+{
+    if (m_status != Status::IN_PROGRESS) {
+        // Caching process failed in the previous stage
+        return;
     }
 
+    CodeCacheMetaInfo& metaInfo = m_currentContext.m_cacheEntry.m_metaInfos[(size_t)CodeCacheType::CACHE_FUNCTION_BYTECODE];
+
+    ASSERT(!!context && !!topCodeBlock);
+    ASSERT(metaInfo.cacheType == CodeCacheType::CACHE_FUNCTION_BYTECODE);
+
+    if (metaInfo.dataSize) {
+        m_cacheReader->setStringTable(m_currentContext.m_cacheStringTable);
+        if (UNLIKELY(!readCacheData(metaInfo))) {
+            m_status = Status::FAILED;
+            return;
+        }
+
+        std::vector<InterpretedCodeBlock*> codeBlockVector;
+        collectCodeBlockTreeNode(topCodeBlock, codeBlockVector);
+
+        // loaded ByteCodeBlocks are counted like lazily compiled ones
+        // so that they are dropped under the same memory pressure
+        auto& currentCodeSizeTotal = context->vmInstance()->compiledByteCodeSize();
+        while (m_cacheReader->bufferIndex() < metaInfo.dataSize) {
+            size_t codeBlockId = m_cacheReader->loadCodeBlockId();
+            ASSERT(codeBlockId < codeBlockVector.size());
+            InterpretedCodeBlock* codeBlock = codeBlockVector[codeBlockId];
+            ASSERT(!codeBlock->isGlobalCodeBlock() && !codeBlock->byteCodeBlock());
+
+            codeBlock->m_byteCodeBlock = m_cacheReader->loadByteCodeBlock(context, codeBlock);
+            currentCodeSizeTotal += codeBlock->m_byteCodeBlock->memoryAllocatedSize();
+        }
+        ASSERT(m_cacheReader->bufferIndex() == metaInfo.dataSize);
+    }
+
+    // clear and finish
+    m_cacheReader->clearBuffer();
+    m_status = Status::FINISH;
+}
+
+void CodeCache::serializeCacheList(std::vector<char>& listData)
+{
+    ASSERT(m_enabled);
+    ASSERT(m_cacheList.size() > 0 && m_cacheList.size() <= CODE_CACHE_MAX_CACHE_NUM);
+
     // first write Escargot version
     std::string version = ESCARGOT_VERSION;
     ASSERT(version.length() > 0);
     size_t versionHash = std::hash<std::string>{}(version);
-    if (UNLIKELY(fwrite(&versionHash, sizeof(size_t), 1, listFile) != 1)) {
-        ESCARGOT_LOG_ERROR("[CodeCache] fwrite of %s failed\n", cacheListFilePath.data());
-        fclose(listFile);
-        return false;
-    }
+    appendCacheBytes(listData, &versionHash, sizeof(size_t));
 
-    size_t listSize = m_cacheList.size();
     // write the number of cache entries
-    if (UNLIKELY(fwrite(&listSize, sizeof(size_t), 1, listFile) != 1)) {
-        ESCARGOT_LOG_ERROR("[CodeCache] fwrite of %s failed\n", cacheListFilePath.data());
-        fclose(listFile);
-        return false;
-    }
-
-    size_t entryCount = 0;
-    auto iter = m_cacheList.begin();
-    while (entryCount < listSize) {
-        ASSERT(iter != m_cacheList.end());
+    size_t listSize = m_cacheList.size();
+    appendCacheBytes(listData, &listSize, sizeof(size_t));
 
+    for (auto iter = m_cacheList.begin(); iter != m_cacheList.end(); iter++) {
         CodeCacheEntryChunk entryChunk(iter->first, iter->second);
-        if (UNLIKELY(fwrite(&entryChunk, sizeof(CodeCacheEntryChunk), 1, listFile) != 1)) {
-            ESCARGOT_LOG_ERROR("[CodeCache] fwrite of %s failed\n", cacheListFilePath.data());
-            fclose(listFile);
-            return false;
-        }
-
-        entryCount++;
-        iter++;
+        appendCacheBytes(listData, &entryChunk, sizeof(CodeCacheEntryChunk));
     }
-    ASSERT(iter == m_cacheList.end());
-
-    fflush(listFile);
-    // FIXME frequent fsync calls can slow down the overall performance
-    /* for performance issue, fsync is skipped for now
-    fsync(fileno(listFile));
-    */
-    fclose(listFile);
-    return true;
 }
 
-bool CodeCache::writeCacheData(CodeCacheType type, size_t extraCount)
+void CodeCache::bufferCacheData(CodeCacheType type, size_t extraCount)
 {
     ASSERT(m_enabled);
-    ASSERT(type == CodeCacheType::CACHE_CODEBLOCK || type == CodeCacheType::CACHE_BYTECODE || type == CodeCacheType::CACHE_STRING);
+    ASSERT(type == CodeCacheType::CACHE_CODEBLOCK || type == CodeCacheType::CACHE_BYTECODE || type == CodeCacheType::CACHE_FUNCTION_BYTECODE || type == CodeCacheType::CACHE_MODULE || type == CodeCacheType::CACHE_STRING);
     ASSERT(m_currentContext.m_cacheFilePath.length());
 
-    FILE* dataFile = nullptr;
+    std::vector<char>& cacheData = m_currentContext.m_cacheData;
 
     // meta info
     CodeCacheMetaInfo meta(type, m_currentContext.m_cacheDataOffset, m_cacheWriter->bufferSize());
     if (type == CodeCacheType::CACHE_CODEBLOCK) {
-        ASSERT(m_currentContext.m_cacheDataOffset == 0);
+        ASSERT(m_currentContext.m_cacheDataOffset == 0 && cacheData.empty());
         // extraCount represents the total count of CodeBlocks used only for CodeBlockTree caching
         meta.codeBlockCount = extraCount;
-        dataFile = fopen(m_currentContext.m_cacheFilePath.data(), "wb");
-    } else {
-        dataFile = fopen(m_currentContext.m_cacheFilePath.data(), "ab");
-    }
-    m_currentContext.m_cacheEntry.m_metaInfos[(size_t)type] = meta;
 
-    if (UNLIKELY(!dataFile)) {
-        ESCARGOT_LOG_ERROR("[CodeCache] can't open the cache data file %s\n", m_currentContext.m_cacheFilePath.data());
-        return false;
-    }
-
-    // write cache data
-    if (UNLIKELY(fwrite(m_cacheWriter->bufferData(), sizeof(char), m_cacheWriter->bufferSize(), dataFile) != m_cacheWriter->bufferSize())) {
-        ESCARGOT_LOG_ERROR("[CodeCache] fwrite of %s failed\n", m_currentContext.m_cacheFilePath.data());
-        fclose(dataFile);
-        m_cacheWriter->clearBuffer();
-        return false;
+        // CodeBlockTree is the first data of the file, so the file header is written in front of it
+        CodeCacheDataFileHeader header;
+        header.magic = CODE_CACHE_DATA_FILE_MAGIC;
+        header.version = CODE_CACHE_DATA_FILE_VERSION;
+        header.sourceHash = m_currentContext.m_sourceHash;
+        header.sourceLength = m_currentContext.m_sourceLength;
+        // filled in postCacheWriting after every data is buffered
+        header.dataHash = 0;
+        header.dataSize = 0;
+        appendCacheBytes(cacheData, &header, sizeof(CodeCacheDataFileHeader));
+        m_currentContext.m_cacheDataOffset = sizeof(CodeCacheDataFileHeader);
     }
+    m_currentContext.m_cacheEntry.m_metaInfos[(size_t)type] = meta;
 
-    fflush(dataFile);
-    // FIXME frequent fsync calls can slow down the overall performance
-    /* for performance issue, fsync is skipped for now
-    fsync(fileno(dataFile));
-    */
-    fclose(dataFile);
+    // cache data is kept in memory until the whole file is handed to the writer thread
+    appendCacheBytes(cacheData, m_cacheWriter->bufferData(), m_cacheWriter->bufferSize());
 
     m_currentContext.m_cacheDataOffset += m_cacheWriter->bufferSize();
     m_cacheWriter->clearBuffer();
-    return true;
 }
 
-bool CodeCache::readCacheData(CodeCacheMetaInfo& metaInfo)
+bool CodeCache::mapCacheData()
 {
     ASSERT(m_enabled);
-    ASSERT(metaInfo.cacheType == CodeCacheType::CACHE_CODEBLOCK || metaInfo.cacheType == CodeCacheType::CACHE_BYTECODE || metaInfo.cacheType == CodeCacheType::CACHE_STRING);
     ASSERT(!!m_currentContext.m_cacheFilePath.length());
+    ASSERT(!m_currentContext.m_mappedData);
 
-    size_t dataOffset = metaInfo.cacheType == CodeCacheType::CACHE_CODEBLOCK ? 0 : metaInfo.dataOffset;
-    FILE* dataFile = fopen(m_currentContext.m_cacheFilePath.data(), "rb");
-
-    if (UNLIKELY(!dataFile)) {
+    int fd = open(m_currentContext.m_cacheFilePath.data(), O_RDONLY);
+    if (UNLIKELY(fd == -1)) {
         ESCARGOT_LOG_ERROR("[CodeCache] can't open the cache data file %s\n", m_currentContext.m_cacheFilePath.data());
         return false;
     }
 
-    if (UNLIKELY(fseek(dataFile, dataOffset, SEEK_SET) != 0)) {
-        ESCARGOT_LOG_ERROR("[CodeCache] can't seek the cache data file %s\n", m_currentContext.m_cacheFilePath.data());
-        fclose(dataFile);
+    struct stat statFile;
+    if (UNLIKELY(fstat(fd, &statFile) != 0 || (size_t)statFile.st_size < sizeof(CodeCacheDataFileHeader))) {
+        ESCARGOT_LOG_ERROR("[CodeCache] invalid cache data file %s\n", m_currentContext.m_cacheFilePath.data());
+        close(fd);
+        return false;
+    }
+
+    // cache data is read in place from the page cache instead of being copied into a heap buffer
+    size_t size = statFile.st_size;
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (UNLIKELY(data == MAP_FAILED)) {
+        ESCARGOT_LOG_ERROR("[CodeCache] can't map the cache data file %s\n", m_currentContext.m_cacheFilePath.data());
+        return false;
+    }
+
+    m_currentContext.m_mappedData = static_cast<char*>(data);
+    m_currentContext.m_mappedSize = size;
+
+    CodeCacheDataFileHeader header;
+    memcpy(&header, data, sizeof(CodeCacheDataFileHeader));
+    if (UNLIKELY(header.magic != CODE_CACHE_DATA_FILE_MAGIC || header.version != CODE_CACHE_DATA_FILE_VERSION)) {
+        ESCARGOT_LOG_ERROR("[CodeCache] different cache data file format of %s\n", m_currentContext.m_cacheFilePath.data());
+        return false;
+    }
+
+    if (UNLIKELY(header.sourceLength != m_currentContext.m_sourceLength || header.sourceHash != m_currentContext.m_sourceHash)) {
+        ESCARGOT_LOG_ERROR("[CodeCache] cache data file %s was generated from another source\n", m_currentContext.m_cacheFilePath.data());
         return false;
     }
 
-    if (UNLIKELY(!m_cacheReader->loadData(dataFile, metaInfo.dataSize))) {
+    // readers trust the data, so a truncated or corrupted file is rejected before any of them touches the mapping
+    size_t dataSize = size - sizeof(CodeCacheDataFileHeader);
+    const uint8_t* payload = reinterpret_cast<const uint8_t*>(data) + sizeof(CodeCacheDataFileHeader);
+    if (UNLIKELY(header.dataSize != dataSize || header.dataHash != computeContentHash(payload, dataSize))) {
+        ESCARGOT_LOG_ERROR("[CodeCache] cache data file %s is corrupted\n", m_currentContext.m_cacheFilePath.data());
+        return false;
+    }
+
+    return true;
+}
+
+bool CodeCache::readCacheData(CodeCacheMetaInfo& metaInfo)
+{
+    ASSERT(m_enabled);
+    ASSERT(metaInfo.cacheType == CodeCacheType::CACHE_CODEBLOCK || metaInfo.cacheType == CodeCacheType::CACHE_BYTECODE || metaInfo.cacheType == CodeCacheType::CACHE_FUNCTION_BYTECODE || metaInfo.cacheType == CodeCacheType::CACHE_MODULE || metaInfo.cacheType == CodeCacheType::CACHE_STRING);
+    ASSERT(!!m_currentContext.m_mappedData);
+
+    size_t dataOffset = metaInfo.cacheType == CodeCacheType::CACHE_CODEBLOCK ? sizeof(CodeCacheDataFileHeader) : metaInfo.dataOffset;
+
+    if (UNLIKELY(dataOffset > m_currentContext.m_mappedSize || metaInfo.dataSize > m_currentContext.m_mappedSize - dataOffset)) {
         ESCARGOT_LOG_ERROR("[CodeCache] load cache data of %s failed\n", m_currentContext.m_cacheFilePath.data());
-        fclose(dataFile);
         return false;
     }
 
-    fclose(dataFile);
+    m_cacheReader->loadData(m_currentContext.m_mappedData + dataOffset, metaInfo.dataSize);
     return true;
 }
 } // namespace Escargot
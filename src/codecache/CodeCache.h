@@ -32,9 +32,15 @@
 #define CODE_CACHE_MIN_SOURCE_LENGTH 1024 * 4
 #endif
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 namespace Escargot {
 
 class Script;
+class String;
 class Context;
 class CodeCacheWriter;
 class CodeCacheReader;
@@ -45,8 +51,10 @@ class InterpretedCodeBlock;
 enum class CodeCacheType : uint8_t {
     CACHE_CODEBLOCK = 0,
     CACHE_BYTECODE = 1,
-    CACHE_STRING = 2,
-    CACHE_INVALID = 3,
+    CACHE_FUNCTION_BYTECODE = 2,
+    CACHE_MODULE = 3,
+    CACHE_STRING = 4,
+    CACHE_INVALID = 5,
     CACHE_TYPE_NUM = CACHE_INVALID
 };
 
@@ -105,6 +113,10 @@ public:
         CodeCacheContext()
             : m_cacheStringTable(nullptr)
             , m_cacheDataOffset(0)
+            , m_sourceHash(0)
+            , m_sourceLength(0)
+            , m_mappedData(nullptr)
+            , m_mappedSize(0)
         {
         }
 
@@ -114,6 +126,26 @@ public:
         CodeCacheEntry m_cacheEntry; // current cache entry
         CacheStringTable* m_cacheStringTable; // current CacheStringTable
         size_t m_cacheDataOffset; // current offset in cache data file
+        uint64_t m_sourceHash; // content hash of current source written in the cache data file header
+        size_t m_sourceLength; // length of current source written in the cache data file header
+        char* m_mappedData; // read-only mapping of current cache data file used during the loading
+        size_t m_mappedSize; // size of m_mappedData
+        std::vector<char> m_cacheData; // contents of current cache data file serialized during the writing
+    };
+
+    // file operations of a finished cache writing, processed by the writer thread
+    struct CodeCacheWriteJob {
+        CodeCacheWriteJob()
+            : m_srcHash(0)
+        {
+        }
+
+        size_t m_srcHash;
+        std::string m_cacheFilePath;
+        std::vector<char> m_cacheData;
+        std::string m_cacheListFilePath;
+        std::vector<char> m_cacheListData;
+        std::string m_evictedFilePath; // cache data file of the LRU entry removed from the list (empty if none)
     };
 
     struct CodeCacheEntryChunk {
@@ -138,19 +170,25 @@ public:
     bool enabled() { return m_enabled; }
     std::pair<bool, CodeCacheEntry> searchCache(size_t srcHash);
 
-    void prepareCacheLoading(Context* context, size_t srcHash, const CodeCacheEntry& entry);
-    void prepareCacheWriting(size_t srcHash);
+    void prepareCacheLoading(Context* context, size_t srcHash, String* source, const CodeCacheEntry& entry);
+    void prepareCacheWriting(size_t srcHash, String* source);
     bool postCacheLoading();
     void postCacheWriting(size_t srcHash);
 
     void storeStringTable();
     void storeCodeBlockTree(InterpretedCodeBlock* topCodeBlock);
+    void storeModuleData(Script* script);
     void storeByteCodeBlock(ByteCodeBlock* block);
+    void storeFunctionByteCodeBlocks();
 
     CacheStringTable* loadCacheStringTable(Context* context);
     InterpretedCodeBlock* loadCodeBlockTree(Context* context, Script* script);
+    void loadModuleData(Script* script);
     ByteCodeBlock* loadByteCodeBlock(Context* context, InterpretedCodeBlock* topCodeBlock);
+    void loadFunctionByteCodeBlocks(Context* context, InterpretedCodeBlock* topCodeBlock);
 
+    // wait until every cache writing handed to the writer thread is written on disk
+    void flush();
     void clear();
 
 private:
@@ -169,6 +207,17 @@ private:
 
     Status m_status; // current caching status
 
+    // cache data files and cache list are written by the writer thread
+    // so that script initialization does not wait for disk I/O
+    std::thread m_writerThread;
+    std::mutex m_writerMutex;
+    std::condition_variable m_writerCondition;
+    std::deque<CodeCacheWriteJob> m_writerQueue;
+    size_t m_writerCurrentHash; // srcHash of the job being processed (valid only if m_writerBusy)
+    bool m_writerBusy;
+    bool m_writerTerminating;
+    bool m_writerFailed;
+
     void initialize(const char* baseCacheDir);
     bool tryInitCacheDir();
     bool tryInitCacheList();
@@ -178,16 +227,25 @@ private:
     void clearAll();
     void reset();
     void setCacheEntry(const CodeCacheEntryChunk& entryChunk);
-    bool addCacheEntry(size_t hash, const CodeCacheEntry& entry);
+    void addCacheEntry(size_t hash, const CodeCacheEntry& entry);
+
+    size_t removeLRUCacheEntry();
 
-    bool removeLRUCacheEntry();
-    bool removeCacheFile(size_t hash);
+    void startWriterThread();
+    void stopWriterThread();
+    void enqueueWriteJob(CodeCacheWriteJob&& job);
+    bool hasPendingWrite(size_t hash);
+    void processWriteJobs();
+    bool processWriteJob(const CodeCacheWriteJob& job);
 
+    void indexCodeBlockTreeNode(InterpretedCodeBlock* codeBlock, size_t& nodeIndex);
     void storeCodeBlockTreeNode(InterpretedCodeBlock* codeBlock, size_t& nodeCount);
     InterpretedCodeBlock* loadCodeBlockTreeNode(Script* script);
+    void collectCodeBlockTreeNode(InterpretedCodeBlock* codeBlock, std::vector<InterpretedCodeBlock*>& codeBlockVector);
 
-    bool writeCacheList();
-    bool writeCacheData(CodeCacheType type, size_t extraCount = 0);
+    bool mapCacheData();
+    void serializeCacheList(std::vector<char>& listData);
+    void bufferCacheData(CodeCacheType type, size_t extraCount = 0);
     bool readCacheData(CodeCacheMetaInfo& metaInfo);
 };
 } // namespace Escargot
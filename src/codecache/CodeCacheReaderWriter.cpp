@@ -120,8 +120,8 @@ void CodeCacheWriter::storeInterpretedCodeBlock(InterpretedCodeBlock* codeBlock)
     }
 
     // InterpretedCodeBlock::m_parent
-    // end position is used as cache id of each CodeBlock
-    size = codeBlock->parent() ? codeBlock->parent()->src().end() : SIZE_MAX;
+    // pre-order index is used as cache id of each CodeBlock
+    size = codeBlock->parent() ? codeBlockIndex(codeBlock->parent()) : SIZE_MAX;
     m_buffer.put(size);
 
     // InterpretedCodeBlock::m_children
@@ -129,9 +129,9 @@ void CodeCacheWriter::storeInterpretedCodeBlock(InterpretedCodeBlock* codeBlock)
     m_buffer.put(size);
     m_buffer.ensureSize(size * sizeof(size_t));
     for (size_t i = 0; i < size; i++) {
-        // end position is used as cache id of each CodeBlock
-        size_t srcIndex = codeBlock->children()[i]->src().end();
-        m_buffer.put(srcIndex);
+        // pre-order index is used as cache id of each CodeBlock
+        size_t childIndex = codeBlockIndex(codeBlock->children()[i]);
+        m_buffer.put(childIndex);
     }
 
     // InterpretedCodeBlock::m_parameterNames
@@ -263,6 +263,73 @@ void CodeCacheWriter::storeInterpretedCodeBlock(InterpretedCodeBlock* codeBlock)
     }
 }
 
+void CodeCacheWriter::storeModuleData(Script* script)
+{
+    ASSERT(GC_is_disabled());
+    ASSERT(!!script && script->isModule());
+
+    // ModuleEnvironmentRecord and the evaluation state are created at runtime,
+    // only the data collected by the parser is stored here
+    Script::ModuleData* moduleData = script->moduleData();
+    size_t size;
+
+    // ModuleData::m_requestedModules
+    StringVector& requestedModules = moduleData->m_requestedModules;
+    size = requestedModules.size();
+    m_buffer.ensureSize(sizeof(size_t));
+    m_buffer.put(size);
+    for (size_t i = 0; i < size; i++) {
+        m_buffer.putString(requestedModules[i]);
+    }
+
+    // ModuleData::m_importEntries
+    Script::ImportEntryVector& importEntries = moduleData->m_importEntries;
+    size = importEntries.size();
+    m_buffer.ensureSize(sizeof(size_t));
+    m_buffer.put(size);
+    for (size_t i = 0; i < size; i++) {
+        const Script::ImportEntry& entry = importEntries[i];
+        m_buffer.putString(entry.m_moduleRequest);
+        m_buffer.ensureSize(2 * sizeof(size_t));
+        m_buffer.put(m_stringTable->add(entry.m_importName));
+        m_buffer.put(m_stringTable->add(entry.m_localName));
+    }
+
+    // ModuleData::m_localExportEntries, m_indirectExportEntries and m_starExportEntries
+    storeExportEntries(moduleData->m_localExportEntries);
+    storeExportEntries(moduleData->m_indirectExportEntries);
+    storeExportEntries(moduleData->m_starExportEntries);
+}
+
+void CodeCacheWriter::storeExportEntries(Script::ExportEntryVector& entries)
+{
+    size_t size = entries.size();
+    m_buffer.ensureSize(sizeof(size_t));
+    m_buffer.put(size);
+    for (size_t i = 0; i < size; i++) {
+        Script::ExportEntry& entry = entries[i];
+
+        // each member is optional, so a presence flag is stored in front of the value
+        m_buffer.ensureSize(4 * sizeof(bool) + 3 * sizeof(size_t));
+        m_buffer.put(entry.m_exportName.hasValue());
+        if (entry.m_exportName.hasValue()) {
+            m_buffer.put(m_stringTable->add(entry.m_exportName.value()));
+        }
+        m_buffer.put(entry.m_importName.hasValue());
+        if (entry.m_importName.hasValue()) {
+            m_buffer.put(m_stringTable->add(entry.m_importName.value()));
+        }
+        m_buffer.put(entry.m_localName.hasValue());
+        if (entry.m_localName.hasValue()) {
+            m_buffer.put(m_stringTable->add(entry.m_localName.value()));
+        }
+        m_buffer.put(entry.m_moduleRequest.hasValue());
+        if (entry.m_moduleRequest.hasValue()) {
+            m_buffer.putString(entry.m_moduleRequest.value());
+        }
+    }
+}
+
 void CodeCacheWriter::storeByteCodeBlock(ByteCodeBlock* block)
 {
     ASSERT(GC_is_disabled());
@@ -307,6 +374,17 @@ void CodeCacheWriter::storeByteCodeBlock(ByteCodeBlock* block)
     ASSERT(block->m_inlineCacheDataSize == 0);
 }
 
+void CodeCacheWriter::storeFunctionByteCodeBlock(ByteCodeBlock* block)
+{
+    ASSERT(!!block && !block->codeBlock()->isGlobalCodeBlock());
+
+    // pre-order index is used as cache id of each CodeBlock
+    m_buffer.ensureSize(sizeof(size_t));
+    m_buffer.put(codeBlockIndex(block->codeBlock()));
+
+    storeByteCodeBlock(block);
+}
+
 void CodeCacheWriter::storeStringTable()
 {
     ASSERT(!!m_stringTable);
@@ -564,34 +642,21 @@ void CodeCacheWriter::storeByteCodeStream(ByteCodeBlock* block)
     }
 }
 
-void CodeCacheReader::CacheBuffer::resize(size_t size)
+void CodeCacheReader::CacheBuffer::setData(const char* data, size_t size)
 {
     ASSERT(!m_buffer && m_capacity == 0 && m_index == 0);
 
-    m_buffer = static_cast<char*>(malloc(size));
+    m_buffer = data;
     m_capacity = size;
 }
 
 void CodeCacheReader::CacheBuffer::reset()
 {
-    free(m_buffer);
-
     m_buffer = nullptr;
     m_capacity = 0;
     m_index = 0;
 }
 
-bool CodeCacheReader::loadData(FILE* file, size_t size)
-{
-    m_buffer.resize(size);
-    if (UNLIKELY(fread((void*)bufferData(), sizeof(char), size, file) != size)) {
-        clearBuffer();
-        return false;
-    }
-
-    return true;
-}
-
 InterpretedCodeBlock* CodeCacheReader::loadInterpretedCodeBlock(Context* context, Script* script)
 {
     ASSERT(!!context);
@@ -751,13 +816,67 @@ InterpretedCodeBlock* CodeCacheReader::loadInterpretedCodeBlock(Context* context
     return codeBlock;
 }
 
-ByteCodeBlock* CodeCacheReader::loadByteCodeBlock(Context* context, InterpretedCodeBlock* topCodeBlock)
+void CodeCacheReader::loadModuleData(Script* script)
 {
     ASSERT(GC_is_disabled());
-    ASSERT(!!topCodeBlock);
+    ASSERT(!!script && script->isModule());
 
+    Script::ModuleData* moduleData = script->moduleData();
     size_t size;
-    ByteCodeBlock* block = new ByteCodeBlock(topCodeBlock);
+
+    // ModuleData::m_requestedModules
+    StringVector& requestedModules = moduleData->m_requestedModules;
+    size = m_buffer.get<size_t>();
+    requestedModules.resizeWithUninitializedValues(size);
+    for (size_t i = 0; i < size; i++) {
+        requestedModules[i] = m_buffer.getString();
+    }
+
+    // ModuleData::m_importEntries
+    Script::ImportEntryVector& importEntries = moduleData->m_importEntries;
+    size = m_buffer.get<size_t>();
+    importEntries.resize(size);
+    for (size_t i = 0; i < size; i++) {
+        Script::ImportEntry& entry = importEntries[i];
+        entry.m_moduleRequest = m_buffer.getString();
+        entry.m_importName = m_stringTable->get(m_buffer.get<size_t>());
+        entry.m_localName = m_stringTable->get(m_buffer.get<size_t>());
+    }
+
+    // ModuleData::m_localExportEntries, m_indirectExportEntries and m_starExportEntries
+    loadExportEntries(moduleData->m_localExportEntries);
+    loadExportEntries(moduleData->m_indirectExportEntries);
+    loadExportEntries(moduleData->m_starExportEntries);
+}
+
+void CodeCacheReader::loadExportEntries(Script::ExportEntryVector& entries)
+{
+    size_t size = m_buffer.get<size_t>();
+    entries.resize(size);
+    for (size_t i = 0; i < size; i++) {
+        Script::ExportEntry& entry = entries[i];
+        if (m_buffer.get<bool>()) {
+            entry.m_exportName = m_stringTable->get(m_buffer.get<size_t>());
+        }
+        if (m_buffer.get<bool>()) {
+            entry.m_importName = m_stringTable->get(m_buffer.get<size_t>());
+        }
+        if (m_buffer.get<bool>()) {
+            entry.m_localName = m_stringTable->get(m_buffer.get<size_t>());
+        }
+        if (m_buffer.get<bool>()) {
+            entry.m_moduleRequest = m_buffer.getString();
+        }
+    }
+}
+
+ByteCodeBlock* CodeCacheReader::loadByteCodeBlock(Context* context, InterpretedCodeBlock* codeBlock)
+{
+    ASSERT(GC_is_disabled());
+    ASSERT(!!codeBlock);
+
+    size_t size;
+    ByteCodeBlock* block = new ByteCodeBlock(codeBlock);
 
     block->m_shouldClearStack = m_buffer.get<bool>();
     block->m_isOwnerMayFreed = m_buffer.get<bool>();
@@ -805,37 +924,27 @@ CacheStringTable* CodeCacheReader::loadStringTable(Context* context)
     size_t tableSize = m_buffer.get<size_t>();
 
     if (LIKELY(!has16BitString)) {
-        size_t length;
-        LChar* buffer = new LChar[maxLength + 1];
         for (size_t i = 0; i < tableSize; i++) {
-            length = m_buffer.get<size_t>();
-            m_buffer.getData(buffer, length);
-            buffer[length] = '\0';
+            size_t length = m_buffer.get<size_t>();
 
             if (UNLIKELY(length == 0)) {
                 table->initAdd(AtomicString());
             } else {
-                table->initAdd(AtomicString(context, buffer, length));
+                // AtomicString is made from the mapped cache data without intermediate copy
+                table->initAdd(AtomicString(context, m_buffer.getLatin1DataInPlace(length), length));
             }
         }
-
-        delete[] buffer;
-
     } else {
-        LChar* lBuffer = new LChar[maxLength + 1];
         UChar* uBuffer = new UChar[maxLength + 1];
         for (size_t i = 0; i < tableSize; i++) {
             bool is8Bit = m_buffer.get<bool>();
             size_t length = m_buffer.get<size_t>();
 
             if (is8Bit) {
-                m_buffer.getData(lBuffer, length);
-                lBuffer[length] = '\0';
-
                 if (UNLIKELY(length == 0)) {
                     table->initAdd(AtomicString());
                 } else {
-                    table->initAdd(AtomicString(context, lBuffer, length));
+                    table->initAdd(AtomicString(context, m_buffer.getLatin1DataInPlace(length), length));
                 }
             } else {
                 ASSERT(length > 0);
@@ -846,7 +955,6 @@ CacheStringTable* CodeCacheReader::loadStringTable(Context* context)
             }
         }
 
-        delete[] lBuffer;
         delete[] uBuffer;
     }
 
@@ -23,10 +23,10 @@
 #if defined(ENABLE_CODE_CACHE)
 
 #include "util/Vector.h"
+#include "parser/Script.h"
 
 namespace Escargot {
 
-class Script;
 class Context;
 class StringView;
 class AtomicString;
@@ -180,20 +180,42 @@ public:
     char* bufferData() { return m_buffer.data(); }
     size_t bufferSize() const { return m_buffer.size(); }
     void clearBuffer() { m_buffer.reset(); }
+
+    // pre-order index of each CodeBlock in the tree is used as its cache id
+    void setCodeBlockIndex(InterpretedCodeBlock* codeBlock, size_t index)
+    {
+        ASSERT(m_codeBlockIndexMap.find(codeBlock) == m_codeBlockIndexMap.end());
+        m_codeBlockIndexMap.insert(std::make_pair(codeBlock, index));
+    }
+    void clearCodeBlockIndex() { m_codeBlockIndexMap.clear(); }
+
     void storeInterpretedCodeBlock(InterpretedCodeBlock* codeBlock);
+    void storeModuleData(Script* script);
     void storeByteCodeBlock(ByteCodeBlock* block);
+    void storeFunctionByteCodeBlock(ByteCodeBlock* block);
     void storeStringTable();
 
 private:
     CacheBuffer m_buffer;
     CacheStringTable* m_stringTable;
+    std::unordered_map<InterpretedCodeBlock*, size_t> m_codeBlockIndexMap;
+
+    size_t codeBlockIndex(InterpretedCodeBlock* codeBlock)
+    {
+        auto iter = m_codeBlockIndexMap.find(codeBlock);
+        ASSERT(iter != m_codeBlockIndexMap.end());
+        return iter->second;
+    }
 
     void storeByteCodeStream(ByteCodeBlock* block);
     void storeGlobalVariableAccessCache(Context* context);
+    void storeExportEntries(Script::ExportEntryVector& entries);
 };
 
 class CodeCacheReader {
 public:
+    // CacheBuffer of CodeCacheReader does not own its data
+    // it refers to the cache data file mapped by CodeCache during the loading
     class CacheBuffer {
     public:
         CacheBuffer()
@@ -208,17 +230,17 @@ public:
             reset();
         }
 
-        char* data() const { return m_buffer; }
+        const char* data() const { return m_buffer; }
         size_t size() const { return m_index; }
         size_t index() const { return m_index; }
-        void resize(size_t size);
+        void setData(const char* data, size_t size);
         void reset();
 
         template <typename IntegralType>
         IntegralType get()
         {
-            ASSERT(m_index < m_capacity);
-            IntegralType value = *(reinterpret_cast<IntegralType*>(m_buffer + m_index));
+            ASSERT(m_index + sizeof(IntegralType) <= m_capacity);
+            IntegralType value = *(reinterpret_cast<const IntegralType*>(m_buffer + m_index));
             m_index += sizeof(IntegralType);
             return value;
         }
@@ -227,40 +249,42 @@ public:
         void getData(IntegralType* data, size_t size)
         {
             size_t dataSize = size * sizeof(IntegralType);
+            ASSERT(m_index + dataSize <= m_capacity);
             memcpy(data, m_buffer + m_index, dataSize);
             m_index += dataSize;
         }
 
-        // FIXME
+        // returns the address of bytes in the mapped file and skips them
+        // only byte data is read in place because other types may not be aligned in the cache file
+        const LChar* getLatin1DataInPlace(size_t size)
+        {
+            ASSERT(m_index + size <= m_capacity);
+            const LChar* data = reinterpret_cast<const LChar*>(m_buffer + m_index);
+            m_index += size;
+            return data;
+        }
+
         String* getString()
         {
-            String* str = nullptr;
             bool is8Bit = get<bool>();
+            size_t length = get<size_t>();
             if (LIKELY(is8Bit)) {
-                size_t length = get<size_t>();
                 if (length == 0) {
-                    str = String::emptyString;
-                } else {
-                    LChar* buffer = new LChar[length + 1];
-                    buffer[length] = '\0';
-                    getData(buffer, length);
-                    str = new Latin1String(buffer, length);
-                    delete[] buffer;
+                    return String::emptyString;
                 }
-            } else {
-                size_t length = get<size_t>();
-                ASSERT(length > 0);
-                UChar* buffer = new UChar[length + 1];
-                buffer[length] = '\0';
-                getData(buffer, length);
-                str = new UTF16String(buffer, length);
-                delete[] buffer;
+                return new Latin1String(getLatin1DataInPlace(length), length);
             }
+
+            ASSERT(length > 0);
+            UChar* buffer = new UChar[length];
+            getData(buffer, length);
+            String* str = new UTF16String(buffer, length);
+            delete[] buffer;
             return str;
         }
 
     private:
-        char* m_buffer;
+        const char* m_buffer;
         size_t m_capacity;
         size_t m_index;
     };
@@ -287,13 +311,14 @@ public:
         return m_stringTable;
     }
 
-    char* bufferData() { return m_buffer.data(); }
     size_t bufferIndex() const { return m_buffer.index(); }
     void clearBuffer() { m_buffer.reset(); }
-    bool loadData(FILE*, size_t);
+    void loadData(const char* data, size_t size) { m_buffer.setData(data, size); }
 
     InterpretedCodeBlock* loadInterpretedCodeBlock(Context* context, Script* script);
-    ByteCodeBlock* loadByteCodeBlock(Context* context, InterpretedCodeBlock* topCodeBlock);
+    void loadModuleData(Script* script);
+    size_t loadCodeBlockId() { return m_buffer.get<size_t>(); }
+    ByteCodeBlock* loadByteCodeBlock(Context* context, InterpretedCodeBlock* codeBlock);
     CacheStringTable* loadStringTable(Context* context);
 
 private:
@@ -302,6 +327,7 @@ private:
 
     void loadByteCodeStream(Context* context, ByteCodeBlock* block);
     void loadGlobalVariableAccessCache(Context* context);
+    void loadExportEntries(Script::ExportEntryVector& entries);
 };
 } // namespace Escargot
 
@@ -31,6 +31,72 @@ namespace Escargot {
 
 static int s_gcKinds[HeapObjectKind::NumberOfKind];
 
+#if defined(ENABLE_THREADING) && !defined(GC_DEBUG)
+#define ENABLE_THREAD_LOCAL_ALLOCATION_CACHE
+// bdwgc keeps thread local free lists for its predefined kinds only.
+// objects of custom kinds are allocated under the global allocation lock,
+// so every thread takes a batch of fixed size objects at once and hands them out without locking.
+// cache is uncollectable memory to keep cached objects alive across collections
+#define THREAD_LOCAL_ALLOCATION_CACHE_SIZE 64
+
+struct ThreadLocalAllocationCache {
+    struct FreeList {
+        size_t m_count;
+        void* m_objects[THREAD_LOCAL_ALLOCATION_CACHE_SIZE];
+    };
+
+    FreeList m_freeLists[HeapObjectKind::NumberOfKind];
+};
+
+static thread_local ThreadLocalAllocationCache* t_allocationCache;
+
+static NEVER_INLINE void refillThreadLocalAllocationCache(ThreadLocalAllocationCache::FreeList& freeList, HeapObjectKind kind, size_t size)
+{
+    void* list;
+    GC_generic_malloc_many(size, s_gcKinds[kind], &list);
+    while (list) {
+        void* next = GC_NEXT(list);
+        // objects more than capacity become garbage again
+        if (freeList.m_count < THREAD_LOCAL_ALLOCATION_CACHE_SIZE) {
+            // link field is the only non-cleared word
+            GC_NEXT(list) = nullptr;
+            freeList.m_objects[freeList.m_count++] = list;
+        }
+        list = next;
+    }
+}
+
+template <typename T>
+static ALWAYS_INLINE T* allocateFromThreadLocalCache(HeapObjectKind kind)
+{
+    if (UNLIKELY(!t_allocationCache)) {
+        t_allocationCache = (ThreadLocalAllocationCache*)GC_MALLOC_UNCOLLECTABLE(sizeof(ThreadLocalAllocationCache));
+        memset(t_allocationCache, 0, sizeof(ThreadLocalAllocationCache));
+    }
+
+    ThreadLocalAllocationCache::FreeList& freeList = t_allocationCache->m_freeLists[kind];
+    if (UNLIKELY(!freeList.m_count)) {
+        refillThreadLocalAllocationCache(freeList, kind, sizeof(T));
+    }
+
+    void* ret = freeList.m_objects[--freeList.m_count];
+    freeList.m_objects[freeList.m_count] = nullptr;
+    return (T*)ret;
+}
+
+void finalizeCustomAllocatorsForThread()
+{
+    if (t_allocationCache) {
+        GC_FREE(t_allocationCache);
+        t_allocationCache = nullptr;
+    }
+}
+#elif defined(ENABLE_THREADING)
+void finalizeCustomAllocatorsForThread()
+{
+}
+#endif
+
 template <GC_get_next_pointer_proc proc>
 GC_ms_entry* markAndPushCustomIterable(GC_word* addr,
                                        struct GC_ms_entry* mark_stack_ptr,
@@ -65,6 +131,8 @@ int getValidValueInArrayObject(void* ptr, GC_mark_custom_result* arr)
 #else
     arr[3].to = (GC_word*)current->m_fastModeData;
 #endif
+    arr[4].from = (GC_word*)&current->m_unboxedElements;
+    arr[4].to = (GC_word*)current->m_unboxedElements;
     return 0;
 }
 
@@ -206,6 +274,7 @@ void initializeCustomAllocators()
     GC_set_bit(objBitmap, GC_WORD_OFFSET(ArrayObject, m_prototype));
     GC_set_bit(objBitmap, GC_WORD_OFFSET(ArrayObject, m_values));
     GC_set_bit(objBitmap, GC_WORD_OFFSET(ArrayObject, m_fastModeData));
+    GC_set_bit(objBitmap, GC_WORD_OFFSET(ArrayObject, m_unboxedElements));
     auto descr = GC_make_descriptor(objBitmap, GC_WORD_LEN(ArrayObject));
 
     s_gcKinds[HeapObjectKind::ArrayObjectKind] = GC_new_kind_enumerable(GC_new_free_list(),
@@ -214,7 +283,7 @@ void initializeCustomAllocators()
                                                                         TRUE);
 #else
     s_gcKinds[HeapObjectKind::ArrayObjectKind] = GC_new_kind_enumerable(GC_new_free_list(),
-                                                                        GC_MAKE_PROC(GC_new_proc(markAndPushCustom<getValidValueInArrayObject, 4>), 0),
+                                                                        GC_MAKE_PROC(GC_new_proc(markAndPushCustom<getValidValueInArrayObject, 5>), 0),
                                                                         FALSE,
                                                                         TRUE);
 #endif
@@ -301,8 +370,12 @@ ArrayObject* CustomAllocator<ArrayObject>::allocate(size_type GC_n, const void*)
     // Un-comment this to use default allocator
     // return (ArrayObject*)GC_MALLOC(sizeof(ArrayObject));
     ASSERT(GC_n == 1);
+#if defined(ENABLE_THREAD_LOCAL_ALLOCATION_CACHE)
+    return allocateFromThreadLocalCache<ArrayObject>(HeapObjectKind::ArrayObjectKind);
+#else
     int kind = s_gcKinds[HeapObjectKind::ArrayObjectKind];
     return (ArrayObject*)GC_GENERIC_MALLOC(sizeof(ArrayObject), kind);
+#endif
 }
 
 template <>
@@ -311,8 +384,12 @@ InterpretedCodeBlock* CustomAllocator<InterpretedCodeBlock>::allocate(size_type
     // Un-comment this to use default allocator
     // return (InterpretedCodeBlock*)GC_MALLOC(sizeof(InterpretedCodeBlock));
     ASSERT(GC_n == 1);
+#if defined(ENABLE_THREAD_LOCAL_ALLOCATION_CACHE)
+    return allocateFromThreadLocalCache<InterpretedCodeBlock>(HeapObjectKind::InterpretedCodeBlockKind);
+#else
     int kind = s_gcKinds[HeapObjectKind::InterpretedCodeBlockKind];
     return (InterpretedCodeBlock*)GC_GENERIC_MALLOC(sizeof(InterpretedCodeBlock), kind);
+#endif
 }
 
 template <>
@@ -321,8 +398,12 @@ InterpretedCodeBlockWithRareData* CustomAllocator<InterpretedCodeBlockWithRareDa
     // Un-comment this to use default allocator
     // return (InterpretedCodeBlockWithRareData*)GC_MALLOC(sizeof(InterpretedCodeBlockWithRareData));
     ASSERT(GC_n == 1);
+#if defined(ENABLE_THREAD_LOCAL_ALLOCATION_CACHE)
+    return allocateFromThreadLocalCache<InterpretedCodeBlockWithRareData>(HeapObjectKind::InterpretedCodeBlockWithRareDataKind);
+#else
     int kind = s_gcKinds[HeapObjectKind::InterpretedCodeBlockWithRareDataKind];
     return (InterpretedCodeBlockWithRareData*)GC_GENERIC_MALLOC(sizeof(InterpretedCodeBlockWithRareData), kind);
+#endif
 }
 
 template <>
@@ -331,8 +412,12 @@ ArrayBufferObject* CustomAllocator<ArrayBufferObject>::allocate(size_type GC_n,
     // Un-comment this to use default allocator
     // return (ArrayBufferObject*)GC_MALLOC(sizeof(ArrayBufferObject));
     ASSERT(GC_n == 1);
+#if defined(ENABLE_THREAD_LOCAL_ALLOCATION_CACHE)
+    return allocateFromThreadLocalCache<ArrayBufferObject>(HeapObjectKind::ArrayBufferObjectKind);
+#else
     int kind = s_gcKinds[HeapObjectKind::ArrayBufferObjectKind];
     return (ArrayBufferObject*)GC_GENERIC_MALLOC(sizeof(ArrayBufferObject), kind);
+#endif
 }
 
 template <>
@@ -61,6 +61,10 @@ enum HeapObjectKind : unsigned {
 };
 
 void initializeCustomAllocators();
+#if defined(ENABLE_THREADING)
+// release allocation cache of current thread
+void finalizeCustomAllocatorsForThread();
+#endif
 
 typedef std::function<void(ExecutionState& state, void* obj)> HeapObjectIteratorCallback;
 
@@ -36,6 +36,11 @@ void Heap::initialize()
     RELEASE_ASSERT(GC_get_all_interior_pointers() == 0);
 
     GC_set_force_unmap_on_gcollect(1);
+#if defined(ENABLE_THREADING)
+    // GC_THREADS build scans stacks of registered threads only
+    // other threads can register themselves after this call
+    GC_allow_register_threads();
+#endif
     g_isInited = true;
     initializeCustomAllocators();
 
@@ -51,6 +56,32 @@ void Heap::finalize()
     }
 }
 
+#if defined(ENABLE_THREADING)
+void Heap::initializeThread()
+{
+    ASSERT(g_isInited);
+    if (GC_thread_is_registered()) {
+        return;
+    }
+
+    struct GC_stack_base stackBase;
+    RELEASE_ASSERT(GC_get_stack_base(&stackBase) == GC_SUCCESS);
+    GC_register_my_thread(&stackBase);
+}
+
+void Heap::finalizeThread()
+{
+    ASSERT(GC_thread_is_registered());
+    finalizeCustomAllocatorsForThread();
+    GC_unregister_my_thread();
+}
+
+bool Heap::isInitializedThread()
+{
+    return GC_thread_is_registered();
+}
+#endif
+
 void Heap::printGCHeapUsage()
 {
 #ifdef ESCARGOT_MEM_STATS
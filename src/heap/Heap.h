@@ -27,6 +27,12 @@ class Heap {
 public:
     static void initialize();
     static void finalize();
+#if defined(ENABLE_THREADING)
+    // register/unregister current thread to GC. thread which called initialize is registered already
+    static void initializeThread();
+    static void finalizeThread();
+    static bool isInitializedThread();
+#endif
     static void printGCHeapUsage();
 };
 } // namespace Escargot
@@ -26,6 +26,9 @@
 #include "parser/ScriptParser.h"
 #include "parser/ast/AST.h"
 #include "parser/esprima_cpp/esprima.h"
+#if defined(ENABLE_JIT)
+#include "jit/JITCode.h"
+#endif
 
 namespace Escargot {
 
@@ -80,9 +83,15 @@ void SetGlobalVariable::dump(const char* byteCodeStart)
 ByteCodeBlock::ByteCodeBlock()
     : m_shouldClearStack(false)
     , m_isOwnerMayFreed(false)
+#if defined(ENABLE_JIT)
+    , m_jitCompileFailed(false)
+#endif
     , m_requiredRegisterFileSizeInValueSize(2)
     , m_inlineCacheDataSize(0)
     , m_codeBlock(nullptr)
+#if defined(ENABLE_JIT)
+    , m_jitCode(nullptr)
+#endif
 {
     // This constructor is used to allocate a ByteCodeBlock on the stack
 }
@@ -90,12 +99,21 @@ ByteCodeBlock::ByteCodeBlock()
 ByteCodeBlock::ByteCodeBlock(InterpretedCodeBlock* codeBlock)
     : m_shouldClearStack(false)
     , m_isOwnerMayFreed(false)
+#if defined(ENABLE_JIT)
+    , m_jitCompileFailed(false)
+#endif
     , m_requiredRegisterFileSizeInValueSize(2)
     , m_inlineCacheDataSize(0)
     , m_codeBlock(codeBlock)
+#if defined(ENABLE_JIT)
+    , m_jitCode(nullptr)
+#endif
 {
-    auto& v = m_codeBlock->context()->vmInstance()->compiledByteCodeBlocks();
-    v.push_back(this);
+    {
+        VMInstanceFinalizerLocker locker;
+        auto& v = m_codeBlock->context()->vmInstance()->compiledByteCodeBlocks();
+        v.push_back(this);
+    }
     GC_REGISTER_FINALIZER_NO_ORDER(this, [](void* obj, void*) {
         ByteCodeBlock* self = (ByteCodeBlock*)obj;
 
@@ -108,7 +126,12 @@ ByteCodeBlock::ByteCodeBlock(InterpretedCodeBlock* codeBlock)
 
         self->m_code.clear();
         self->m_numeralLiteralData.clear();
+#if defined(ENABLE_JIT)
+        delete self->m_jitCode;
+        self->m_jitCode = nullptr;
+#endif
 
+        VMInstanceFinalizerLocker locker;
         if (!self->m_isOwnerMayFreed) {
             auto& v = self->m_codeBlock->context()->vmInstance()->compiledByteCodeBlocks();
             v.erase(std::find(v.begin(), v.end(), self));
@@ -200,6 +223,51 @@ ExtendedNodeLOC ByteCodeBlock::computeNodeLOC(StringView src, ExtendedNodeLOC so
     return ExtendedNodeLOC(line, column, index);
 }
 
+#if defined(ENABLE_OPCODE_MAP)
+Opcode opcodeOfRelocatedByteCode(ByteCode* code)
+{
+#if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
+    auto iter = g_opcodeTable.m_opcodeMap.find(code->m_opcodeInAddress);
+    ASSERT(iter != g_opcodeTable.m_opcodeMap.end());
+    return (Opcode)iter->second;
+#else
+    return code->m_opcode;
+#endif
+}
+#endif
+
+#if defined(ENABLE_IC_STATISTICS)
+void ByteCodeBlock::collectInlineCacheSites(std::vector<size_t>& getObjectSites, std::vector<size_t>& setObjectSites)
+{
+    char* code = m_code.data();
+    size_t idx = 0;
+    size_t end = m_code.size();
+
+    while (idx < end) {
+        ByteCode* currentCode = (ByteCode*)(code + idx);
+        Opcode opcode = opcodeOfRelocatedByteCode(currentCode);
+
+        if (opcode == GetObjectPreComputedCaseOpcode) {
+            getObjectSites.push_back(idx);
+        } else if (opcode == SetObjectPreComputedCaseOpcode) {
+            setObjectSites.push_back(idx);
+        } else if (opcode == ExecutionPauseOpcode) {
+            ExecutionPause* cd = (ExecutionPause*)currentCode;
+            if (cd->m_reason == ExecutionPause::Yield) {
+                idx += cd->m_yieldData.m_tailDataLength;
+            } else if (cd->m_reason == ExecutionPause::Await) {
+                idx += cd->m_awaitData.m_tailDataLength;
+            } else if (cd->m_reason == ExecutionPause::GeneratorsInitialize) {
+                idx += cd->m_asyncGeneratorInitializeData.m_tailDataLength;
+            }
+        }
+
+        ASSERT(opcode <= EndOpcode);
+        idx += byteCodeLengths[opcode];
+    }
+}
+#endif
+
 void ByteCodeBlock::initFunctionDeclarationWithinBlock(ByteCodeGenerateContext* context, InterpretedCodeBlock::BlockInfo* bi, Node* node)
 {
     InterpretedCodeBlock* codeBlock = context->m_codeBlock;
@@ -28,6 +28,9 @@ namespace Escargot {
 class Node;
 class ObjectStructure;
 struct GlobalVariableAccessCacheItem;
+#if defined(ENABLE_JIT)
+class JITCode;
+#endif
 
 // <OpcodeName, PushCount, PopCount>
 #define FOR_EACH_BYTECODE_OP(F)                             \
@@ -140,26 +143,35 @@ enum Opcode {
     FOR_EACH_BYTECODE_OP(DECLARE_BYTECODE)
 #undef DECLARE_BYTECODE
         OpcodeKindEnd,
-    // special opcode only used in interpreter
-    GetObjectOpcodeSlowCaseOpcode,
-    SetObjectOpcodeSlowCaseOpcode,
 #if defined(COMPILER_MSVC)
 };
 #else
 };
 #endif
 
+// features which read the opcode back from the label address of relocated bytecode
+#if defined(ENABLE_CODE_CACHE) || defined(ENABLE_IC_STATISTICS) || defined(ENABLE_JIT)
+#define ENABLE_OPCODE_MAP
+#endif
+
 struct OpcodeTable {
     OpcodeTable();
 
     void* m_addressTable[OpcodeKindEnd];
-#if defined(ENABLE_CODE_CACHE)
+#if defined(ENABLE_OPCODE_MAP)
+    // filled with m_addressTable while g_opcodeTable is initialized, so it is read-only afterwards
     std::unordered_map<void*, size_t, std::hash<void*>, std::equal_to<void*>, std::allocator<std::pair<void* const, size_t>>> m_opcodeMap;
 #endif
 };
 
 extern OpcodeTable g_opcodeTable;
 
+#if defined(ENABLE_OPCODE_MAP)
+class ByteCode;
+// opcode of bytecode whose m_opcodeInAddress is already relocated to the address of its label
+Opcode opcodeOfRelocatedByteCode(ByteCode* code);
+#endif
+
 struct ByteCodeLOC {
     size_t index;
 #ifndef NDEBUG
@@ -668,18 +680,21 @@ public:
 
 class CreateObject : public ByteCode {
 public:
-    CreateObject(const ByteCodeLOC& loc, const size_t registerIndex)
+    CreateObject(const ByteCodeLOC& loc, const size_t registerIndex, const size_t inlinePropertySlotCount = 0)
         : ByteCode(Opcode::CreateObjectOpcode, loc)
         , m_registerIndex(registerIndex)
+        , m_inlinePropertySlotCount(inlinePropertySlotCount)
     {
+        ASSERT(inlinePropertySlotCount <= ESCARGOT_OBJECT_INLINE_PROPERTY_SLOT_MAX);
     }
 
     ByteCodeRegisterIndex m_registerIndex;
+    uint16_t m_inlinePropertySlotCount;
 
 #ifndef NDEBUG
     void dump(const char* byteCodeStart)
     {
-        printf("createobject -> r%d", (int)m_registerIndex);
+        printf("createobject(%d) -> r%d", (int)m_inlinePropertySlotCount, (int)m_registerIndex);
     }
 #endif
 };
@@ -911,6 +926,57 @@ struct GetObjectInlineCache {
     GetObjectInlineCacheDataVector m_cache;
 };
 
+#define GET_OBJECT_MEGAMORPHIC_CACHE_SIZE 1024
+#define GET_OBJECT_MEGAMORPHIC_CACHE_MAX_CHAIN_LENGTH 4
+
+// VM-wide cache shared by GetObjectPreComputedCase sites which gave up their own inline cache.
+// Entries are keyed by (receiver structure, property name) and validated with structure chain like GetObjectInlineCacheData.
+// Structures are not marked from here, so VMInstance clears this cache whenever GC starts
+class GetObjectMegamorphicCache {
+public:
+    struct Entry {
+        // ObjectStructurePropertyName::rawValue(). 0 for empty entry
+        size_t m_propertyName;
+        ObjectStructure* m_cachedhiddenClassChain[GET_OBJECT_MEGAMORPHIC_CACHE_MAX_CHAIN_LENGTH];
+        size_t m_cachedhiddenClassChainLength;
+        size_t m_cachedIndex;
+    };
+
+    GetObjectMegamorphicCache()
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        memset(m_entries, 0, sizeof(m_entries));
+    }
+
+    Entry& entry(ObjectStructure* structure, const ObjectStructurePropertyName& name)
+    {
+        size_t h = ((size_t)structure >> 4) ^ (name.rawValue() >> 3) ^ (name.rawValue() >> 13);
+        return m_entries[h & (GET_OBJECT_MEGAMORPHIC_CACHE_SIZE - 1)];
+    }
+
+private:
+    Entry m_entries[GET_OBJECT_MEGAMORPHIC_CACHE_SIZE];
+};
+
+#if defined(ENABLE_IC_STATISTICS)
+// per-site counters of GetObjectPreComputedCase and SetObjectPreComputedCase
+// hit count is (m_accessCount - m_missCount)
+struct InlineCacheSiteStatistics {
+    InlineCacheSiteStatistics()
+        : m_accessCount(0)
+        , m_missCount(0)
+    {
+    }
+
+    uint64_t m_accessCount;
+    uint64_t m_missCount;
+};
+#endif
+
 class GetObjectPreComputedCase : public ByteCode {
 public:
     // [object] -> [value]
@@ -932,6 +998,9 @@ public:
     ByteCodeRegisterIndex m_objectRegisterIndex;
     ByteCodeRegisterIndex m_storeRegisterIndex;
     ObjectStructurePropertyName m_propertyName;
+#if defined(ENABLE_IC_STATISTICS)
+    InlineCacheSiteStatistics m_statistics;
+#endif
 #ifndef NDEBUG
     void dump(const char* byteCodeStart)
     {
@@ -986,6 +1055,9 @@ public:
     SetObjectInlineCache* m_inlineCache;
     bool m_isLength : 1;
     uint16_t m_missCount : 16;
+#if defined(ENABLE_IC_STATISTICS)
+    InlineCacheSiteStatistics m_statistics;
+#endif
 #ifndef NDEBUG
     void dump(const char* byteCodeStart)
     {
@@ -2507,7 +2579,7 @@ public:
             CodeType& t = const_cast<CodeType&>(code);
             char* dumpByteCode = getenv("DUMP_BYTECODE");
             char* dumpCodeblockTree = getenv("DUMP_CODEBLOCK_TREE");
-            if ((dumpByteCode && (strcmp(dumpByteCode, "1") == 0)) || (dumpCodeblockTree && (strcmp(dumpCodeblockTree, "1") == 0))) {
+            if ((dumpByteCode && (strcmp(dumpByteCode, "1") == 0 || strcmp(dumpByteCode, "2") == 0)) || (dumpCodeblockTree && (strcmp(dumpCodeblockTree, "1") == 0))) {
                 if (idx != SIZE_MAX) {
                     auto loc = computeNodeLOC(m_codeBlock->src(), m_codeBlock->functionStart(), idx);
                     t.m_loc.line = loc.line;
@@ -2596,8 +2668,17 @@ public:
     ExtendedNodeLOC computeNodeLOC(StringView src, ExtendedNodeLOC sourceElementStart, size_t index);
     void fillLOCData(Context* c, ByteCodeLOCData* locData);
 
+#if defined(ENABLE_IC_STATISTICS)
+    // collects code positions of GetObjectPreComputedCase and SetObjectPreComputedCase
+    // this block should be relocated already (opcodes are replaced with their addresses)
+    void collectInlineCacheSites(std::vector<size_t>& getObjectSites, std::vector<size_t>& setObjectSites);
+#endif
+
     bool m_shouldClearStack : 1;
     bool m_isOwnerMayFreed : 1;
+#if defined(ENABLE_JIT)
+    bool m_jitCompileFailed : 1;
+#endif
     ByteCodeRegisterIndex m_requiredRegisterFileSizeInValueSize : REGISTER_INDEX_IN_BIT;
     size_t m_inlineCacheDataSize;
 
@@ -2610,6 +2691,10 @@ public:
     ByteCodeOtherLiteralData m_otherLiteralData;
 
     InterpretedCodeBlock* m_codeBlock;
+#if defined(ENABLE_JIT)
+    // machine code compiled by JITCompiler. allocated out of GC heap and freed in the finalizer
+    JITCode* m_jitCode;
+#endif
 };
 } // namespace Escargot
 
@@ -25,6 +25,10 @@
 #include "debugger/Debugger.h"
 #include "runtime/VMInstance.h"
 
+#if defined(ENABLE_BYTECODE_OPTIMIZER)
+#include "interpreter/ByteCodeOptimizer.h"
+#endif
+
 #if defined(ENABLE_CODE_CACHE)
 #include "codecache/CodeCache.h"
 #endif
@@ -221,6 +225,10 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* context, Interpreted
         memcpy(block->m_numeralLiteralData.data(), nData->data(), sizeof(Value) * nData->size());
     }
 
+#if defined(ENABLE_BYTECODE_OPTIMIZER)
+    ByteCodeOptimizer::optimize(block, nullptr);
+#endif
+
     if (block->m_code.capacity() - block->m_code.size() > 1024 * 4) {
         block->m_code.shrinkToFit();
     }
@@ -229,7 +237,6 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* context, Interpreted
     // cache bytecode right before relocation
     if (UNLIKELY(cacheByteCode)) {
         context->vmInstance()->codeCache()->storeByteCodeBlock(block);
-        context->vmInstance()->codeCache()->storeStringTable();
     }
 #endif
 
@@ -305,6 +312,11 @@ void ByteCodeGenerator::collectByteCodeLOCData(Context* context, InterpretedCode
         ast->generateStatementByteCode(&block, &ctx);
     }
 
+#if defined(ENABLE_BYTECODE_OPTIMIZER)
+    // code positions should be same as the ones of the optimized block
+    ByteCodeOptimizer::optimize(&block, locData);
+#endif
+
     // reset ASTAllocator
     context->astAllocator().reset();
     GC_enable();
@@ -783,7 +795,7 @@ void ByteCodeGenerator::printByteCode(Context* context, ByteCodeBlock* block)
     InterpretedCodeBlock* codeBlock = block->codeBlock();
 
     char* dumpByteCode = getenv("DUMP_BYTECODE");
-    if (dumpByteCode && (strcmp(dumpByteCode, "1") == 0)) {
+    if (dumpByteCode && (strcmp(dumpByteCode, "1") == 0 || strcmp(dumpByteCode, "2") == 0)) {
         printf("dumpBytecode %s (%d:%d)>>>>>>>>>>>>>>>>>>>>>>\n", codeBlock->functionName().string()->toUTF8StringData().data(), (int)codeBlock->functionStart().line, (int)codeBlock->functionStart().column);
         printf("register info.. (stack variable total(%d), this + function + var (%d), max lexical depth (%d)) [", (int)codeBlock->totalStackAllocatedVariableSize(), (int)codeBlock->identifierOnStackCount(), (int)codeBlock->lexicalBlockStackAllocatedIdentifierMaximumDepth());
         for (size_t i = 0; i < block->m_requiredRegisterFileSizeInValueSize; i++) {
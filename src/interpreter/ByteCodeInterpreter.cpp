@@ -44,6 +44,9 @@
 #include "runtime/ScriptAsyncGeneratorFunctionObject.h"
 #include "parser/ScriptParser.h"
 #include "CheckedArithmetic.h"
+#if defined(ENABLE_JIT)
+#include "jit/JITCompiler.h"
+#endif
 
 namespace Escargot {
 
@@ -78,6 +81,578 @@ private:
     size_t* m_oldAddress;
 };
 
+// bodies of bytecodes which do not change control flow of interpret by themselves.
+// JIT operations run the same bodies, so both stay in sync
+#define DEFINE_BYTECODE_OPERATION(CodeType) \
+    template <>                             \
+    ALWAYS_INLINE void ByteCodeInterpreter::byteCodeOperation(ExecutionState& state, CodeType* code, Value* registerFile, ByteCodeBlock* byteCodeBlock)
+
+#define DEFINE_JUMP_CONDITION(CodeType) \
+    template <>                         \
+    ALWAYS_INLINE bool ByteCodeInterpreter::shouldJump(ExecutionState& state, CodeType* code, Value* registerFile)
+
+DEFINE_BYTECODE_OPERATION(BinaryPlus)
+{
+    const Value& v0 = registerFile[code->m_srcIndex0];
+    const Value& v1 = registerFile[code->m_srcIndex1];
+    Value ret(Value::ForceUninitialized);
+    if (v0.isInt32() && v1.isInt32()) {
+        int32_t a = v0.asInt32();
+        int32_t b = v1.asInt32();
+        int32_t c;
+        bool result = ArithmeticOperations<int32_t, int32_t, int32_t>::add(a, b, c);
+        if (LIKELY(result)) {
+            ret = Value(c);
+        } else {
+            ret = Value(Value::EncodeAsDouble, (double)a + (double)b);
+        }
+    } else if (v0.isNumber() && v1.isNumber()) {
+        ret = Value(v0.asNumber() + v1.asNumber());
+    } else {
+        ret = plusSlowCase(state, v0, v1);
+    }
+    registerFile[code->m_dstIndex] = ret;
+}
+
+DEFINE_BYTECODE_OPERATION(BinaryMinus)
+{
+    const Value& left = registerFile[code->m_srcIndex0];
+    const Value& right = registerFile[code->m_srcIndex1];
+    Value ret(Value::ForceUninitialized);
+    if (left.isInt32() && right.isInt32()) {
+        int32_t a = left.asInt32();
+        int32_t b = right.asInt32();
+        int32_t c;
+        bool result = ArithmeticOperations<int32_t, int32_t, int32_t>::sub(a, b, c);
+        if (LIKELY(result)) {
+            ret = Value(c);
+        } else {
+            ret = Value(Value::EncodeAsDouble, (double)a - (double)b);
+        }
+    } else if (LIKELY(left.isNumber() && right.isNumber())) {
+        ret = Value(left.asNumber() - right.asNumber());
+    } else {
+        ret = minusSlowCase(state, left, right);
+    }
+    registerFile[code->m_dstIndex] = ret;
+}
+
+DEFINE_BYTECODE_OPERATION(BinaryMultiply)
+{
+    const Value& left = registerFile[code->m_srcIndex0];
+    const Value& right = registerFile[code->m_srcIndex1];
+    Value ret(Value::ForceUninitialized);
+    if (left.isInt32() && right.isInt32()) {
+        int32_t a = left.asInt32();
+        int32_t b = right.asInt32();
+        if (UNLIKELY((!a || !b) && (a >> 31 || b >> 31))) { // -1 * 0 should be treated as -0, not +0
+            ret = Value(left.asNumber() * right.asNumber());
+        } else {
+            int32_t c;
+            bool result = ArithmeticOperations<int32_t, int32_t, int32_t>::multiply(a, b, c);
+            if (LIKELY(result)) {
+                ret = Value(c);
+            } else {
+                ret = Value(Value::EncodeAsDouble, a * (double)b);
+            }
+        }
+    } else if (LIKELY(left.isNumber() && right.isNumber())) {
+        ret = Value(Value::EncodeAsDouble, left.asNumber() * right.asNumber());
+    } else {
+        ret = multiplySlowCase(state, left, right);
+    }
+    registerFile[code->m_dstIndex] = ret;
+}
+
+DEFINE_BYTECODE_OPERATION(BinaryDivision)
+{
+    const Value& left = registerFile[code->m_srcIndex0];
+    const Value& right = registerFile[code->m_srcIndex1];
+    if (LIKELY(left.isNumber() && right.isNumber())) {
+        registerFile[code->m_dstIndex] = Value(left.asNumber() / right.asNumber());
+    } else {
+        registerFile[code->m_dstIndex] = divisionSlowCase(state, left, right);
+    }
+}
+
+DEFINE_BYTECODE_OPERATION(BinaryMod)
+{
+    const Value& left = registerFile[code->m_srcIndex0];
+    const Value& right = registerFile[code->m_srcIndex1];
+    registerFile[code->m_dstIndex] = modOperation(state, left, right);
+}
+
+DEFINE_BYTECODE_OPERATION(BinaryExponentiation)
+{
+    const Value& left = registerFile[code->m_srcIndex0];
+    const Value& right = registerFile[code->m_srcIndex1];
+    registerFile[code->m_dstIndex] = exponentialOperation(state, left, right);
+}
+
+DEFINE_BYTECODE_OPERATION(BinaryEqual)
+{
+    const Value& left = registerFile[code->m_srcIndex0];
+    const Value& right = registerFile[code->m_srcIndex1];
+    registerFile[code->m_dstIndex] = Value(left.abstractEqualsTo(state, right));
+}
+
+DEFINE_BYTECODE_OPERATION(BinaryNotEqual)
+{
+    const Value& left = registerFile[code->m_srcIndex0];
+    const Value& right = registerFile[code->m_srcIndex1];
+    registerFile[code->m_dstIndex] = Value(!left.abstractEqualsTo(state, right));
+}
+
+DEFINE_BYTECODE_OPERATION(BinaryStrictEqual)
+{
+    const Value& left = registerFile[code->m_srcIndex0];
+    const Value& right = registerFile[code->m_srcIndex1];
+    registerFile[code->m_dstIndex] = Value(left.equalsTo(state, right));
+}
+
+DEFINE_BYTECODE_OPERATION(BinaryNotStrictEqual)
+{
+    const Value& left = registerFile[code->m_srcIndex0];
+    const Value& right = registerFile[code->m_srcIndex1];
+    registerFile[code->m_dstIndex] = Value(!left.equalsTo(state, right));
+}
+
+DEFINE_BYTECODE_OPERATION(BinaryLessThan)
+{
+    const Value& left = registerFile[code->m_srcIndex0];
+    const Value& right = registerFile[code->m_srcIndex1];
+    registerFile[code->m_dstIndex] = Value(abstractLeftIsLessThanRight(state, left, right, false));
+}
+
+DEFINE_BYTECODE_OPERATION(BinaryLessThanOrEqual)
+{
+    const Value& left = registerFile[code->m_srcIndex0];
+    const Value& right = registerFile[code->m_srcIndex1];
+    registerFile[code->m_dstIndex] = Value(abstractLeftIsLessThanEqualRight(state, left, right, false));
+}
+
+DEFINE_BYTECODE_OPERATION(BinaryGreaterThan)
+{
+    const Value& left = registerFile[code->m_srcIndex0];
+    const Value& right = registerFile[code->m_srcIndex1];
+    registerFile[code->m_dstIndex] = Value(abstractLeftIsLessThanRight(state, right, left, true));
+}
+
+DEFINE_BYTECODE_OPERATION(BinaryGreaterThanOrEqual)
+{
+    const Value& left = registerFile[code->m_srcIndex0];
+    const Value& right = registerFile[code->m_srcIndex1];
+    registerFile[code->m_dstIndex] = Value(abstractLeftIsLessThanEqualRight(state, right, left, true));
+}
+
+DEFINE_BYTECODE_OPERATION(BinaryBitwiseAnd)
+{
+    const Value& left = registerFile[code->m_srcIndex0];
+    const Value& right = registerFile[code->m_srcIndex1];
+    if (left.isInt32() && right.isInt32()) {
+        registerFile[code->m_dstIndex] = Value(left.asInt32() & right.asInt32());
+    } else {
+        registerFile[code->m_dstIndex] = bitwiseOperationSlowCase(state, left, right, BitwiseOperationKind::And);
+    }
+}
+
+DEFINE_BYTECODE_OPERATION(BinaryBitwiseOr)
+{
+    const Value& left = registerFile[code->m_srcIndex0];
+    const Value& right = registerFile[code->m_srcIndex1];
+    if (left.isInt32() && right.isInt32()) {
+        registerFile[code->m_dstIndex] = Value(left.asInt32() | right.asInt32());
+    } else {
+        registerFile[code->m_dstIndex] = bitwiseOperationSlowCase(state, left, right, BitwiseOperationKind::Or);
+    }
+}
+
+DEFINE_BYTECODE_OPERATION(BinaryBitwiseXor)
+{
+    const Value& left = registerFile[code->m_srcIndex0];
+    const Value& right = registerFile[code->m_srcIndex1];
+    if (left.isInt32() && right.isInt32()) {
+        registerFile[code->m_dstIndex] = Value(left.asInt32() ^ right.asInt32());
+    } else {
+        registerFile[code->m_dstIndex] = bitwiseOperationSlowCase(state, left, right, BitwiseOperationKind::Xor);
+    }
+}
+
+DEFINE_BYTECODE_OPERATION(BinaryLeftShift)
+{
+    const Value& left = registerFile[code->m_srcIndex0];
+    const Value& right = registerFile[code->m_srcIndex1];
+    if (left.isInt32() && right.isInt32()) {
+        int32_t lnum = left.asInt32();
+        int32_t rnum = right.asInt32();
+        lnum <<= ((unsigned int)rnum) & 0x1F;
+        registerFile[code->m_dstIndex] = Value(lnum);
+    } else {
+        registerFile[code->m_dstIndex] = shiftOperationSlowCase(state, left, right, ShiftOperationKind::Left);
+    }
+}
+
+DEFINE_BYTECODE_OPERATION(BinarySignedRightShift)
+{
+    const Value& left = registerFile[code->m_srcIndex0];
+    const Value& right = registerFile[code->m_srcIndex1];
+    if (left.isInt32() && right.isInt32()) {
+        int32_t lnum = left.asInt32();
+        int32_t rnum = right.asInt32();
+        lnum >>= ((unsigned int)rnum) & 0x1F;
+        registerFile[code->m_dstIndex] = Value(lnum);
+    } else {
+        registerFile[code->m_dstIndex] = shiftOperationSlowCase(state, left, right, ShiftOperationKind::SignedRight);
+    }
+}
+
+DEFINE_BYTECODE_OPERATION(BinaryUnsignedRightShift)
+{
+    const Value& left = registerFile[code->m_srcIndex0];
+    const Value& right = registerFile[code->m_srcIndex1];
+    if (left.isUInt32() && right.isUInt32()) {
+        uint32_t lnum = left.asUInt32();
+        uint32_t rnum = right.asUInt32();
+        lnum = (lnum) >> ((rnum)&0x1F);
+        registerFile[code->m_dstIndex] = Value(lnum);
+    } else {
+        registerFile[code->m_dstIndex] = shiftOperationSlowCase(state, left, right, ShiftOperationKind::UnsignedRight);
+    }
+}
+
+DEFINE_BYTECODE_OPERATION(BinaryInOperation)
+{
+    const Value& left = registerFile[code->m_srcIndex0];
+    const Value& right = registerFile[code->m_srcIndex1];
+    bool result = binaryInOperation(state, left, right);
+    registerFile[code->m_dstIndex] = Value(result);
+}
+
+DEFINE_BYTECODE_OPERATION(BinaryInstanceOfOperation)
+{
+    instanceOfOperation(state, code, registerFile);
+}
+
+DEFINE_BYTECODE_OPERATION(UnaryMinus)
+{
+    const Value& val = registerFile[code->m_srcIndex];
+    if (UNLIKELY(val.isPointerValue())) {
+        registerFile[code->m_dstIndex] = unaryMinusSlowCase(state, val);
+    } else {
+        registerFile[code->m_dstIndex] = Value(-val.toNumber(state));
+    }
+}
+
+DEFINE_BYTECODE_OPERATION(UnaryNot)
+{
+    const Value& val = registerFile[code->m_srcIndex];
+    registerFile[code->m_dstIndex] = Value(!val.toBoolean(state));
+}
+
+DEFINE_BYTECODE_OPERATION(UnaryBitwiseNot)
+{
+    const Value& val = registerFile[code->m_srcIndex];
+    if (val.isInt32()) {
+        registerFile[code->m_dstIndex] = Value(~val.asInt32());
+    } else {
+        registerFile[code->m_dstIndex] = bitwiseNotOperationSlowCase(state, val);
+    }
+}
+
+DEFINE_BYTECODE_OPERATION(UnaryTypeof)
+{
+    unaryTypeof(state, code, registerFile);
+}
+
+DEFINE_BYTECODE_OPERATION(ToNumber)
+{
+    const Value& val = registerFile[code->m_srcIndex];
+    registerFile[code->m_dstIndex] = Value(val.toNumber(state));
+}
+
+DEFINE_BYTECODE_OPERATION(Increment)
+{
+    registerFile[code->m_dstIndex] = incrementOperation(state, registerFile[code->m_srcIndex]);
+}
+
+DEFINE_BYTECODE_OPERATION(Decrement)
+{
+    registerFile[code->m_dstIndex] = decrementOperation(state, registerFile[code->m_srcIndex]);
+}
+
+DEFINE_BYTECODE_OPERATION(ToNumericIncrement)
+{
+    registerFile[code->m_dstIndex] = Value(registerFile[code->m_srcIndex].toNumeric(state).first);
+    registerFile[code->m_storeIndex] = incrementOperation(state, registerFile[code->m_dstIndex]);
+}
+
+DEFINE_BYTECODE_OPERATION(ToNumericDecrement)
+{
+    registerFile[code->m_dstIndex] = Value(registerFile[code->m_srcIndex].toNumeric(state).first);
+    registerFile[code->m_storeIndex] = decrementOperation(state, registerFile[code->m_dstIndex]);
+}
+
+DEFINE_BYTECODE_OPERATION(GetObject)
+{
+    const Value& willBeObject = registerFile[code->m_objectRegisterIndex];
+    const Value& property = registerFile[code->m_propertyRegisterIndex];
+    PointerValue* v;
+    if (LIKELY(willBeObject.isObject() && (v = willBeObject.asPointerValue())->isArrayObject())) {
+        ArrayObject* arr = (ArrayObject*)v;
+        if (LIKELY(arr->isFastModeArray())) {
+            uint32_t idx = property.tryToUseAsArrayIndex(state);
+            if (LIKELY(idx != Value::InvalidArrayIndexValue) && LIKELY(idx < arr->arrayLength(state))) {
+                const Value v = arr->fastModeArrayValue(idx);
+                if (LIKELY(!v.isEmpty())) {
+                    registerFile[code->m_storeRegisterIndex] = v;
+                    return;
+                }
+            }
+        }
+    }
+    getObjectOpcodeSlowCase(state, code, registerFile);
+}
+
+DEFINE_BYTECODE_OPERATION(SetObjectOperation)
+{
+    const Value& willBeObject = registerFile[code->m_objectRegisterIndex];
+    const Value& property = registerFile[code->m_propertyRegisterIndex];
+    if (LIKELY(willBeObject.isObject() && (willBeObject.asPointerValue())->isArrayObject())) {
+        ArrayObject* arr = willBeObject.asObject()->asArrayObject();
+        uint32_t idx = property.tryToUseAsArrayIndex(state);
+        if (LIKELY(arr->isFastModeArray())) {
+            if (LIKELY(idx != Value::InvalidArrayIndexValue)) {
+                uint32_t len = arr->arrayLength(state);
+                if (UNLIKELY(len <= idx)) {
+                    if (UNLIKELY(!arr->isExtensible(state))) {
+                        setObjectOpcodeSlowCase(state, code, registerFile);
+                        return;
+                    }
+                    if (UNLIKELY(!arr->setArrayLength(state, idx + 1)) || UNLIKELY(!arr->isFastModeArray())) {
+                        setObjectOpcodeSlowCase(state, code, registerFile);
+                        return;
+                    }
+                }
+                arr->setFastModeArrayValueWithoutExpanding(state, idx, registerFile[code->m_loadRegisterIndex]);
+                return;
+            }
+        }
+    }
+    setObjectOpcodeSlowCase(state, code, registerFile);
+}
+
+DEFINE_BYTECODE_OPERATION(GetObjectPreComputedCase)
+{
+    const Value& willBeObject = registerFile[code->m_objectRegisterIndex];
+    Object* obj;
+    if (LIKELY(willBeObject.isObject())) {
+        obj = willBeObject.asObject();
+    } else {
+        obj = fastToObject(state, willBeObject);
+    }
+    registerFile[code->m_storeRegisterIndex] = getObjectPrecomputedCaseOperation(state, obj, willBeObject, code, byteCodeBlock);
+}
+
+DEFINE_BYTECODE_OPERATION(SetObjectPreComputedCase)
+{
+    setObjectPreComputedCaseOperation(state, registerFile[code->m_objectRegisterIndex], registerFile[code->m_loadRegisterIndex], code, byteCodeBlock);
+}
+
+DEFINE_BYTECODE_OPERATION(GetGlobalVariable)
+{
+    ASSERT(byteCodeBlock->m_codeBlock->context() == state.context());
+    registerFile[code->m_registerIndex] = getGlobalVariable(state, code->m_slot, byteCodeBlock);
+}
+
+DEFINE_BYTECODE_OPERATION(SetGlobalVariable)
+{
+    ASSERT(byteCodeBlock->m_codeBlock->context() == state.context());
+    setGlobalVariable(state, code->m_slot, registerFile[code->m_registerIndex], byteCodeBlock);
+}
+
+DEFINE_BYTECODE_OPERATION(InitializeGlobalVariable)
+{
+    ASSERT(byteCodeBlock->m_codeBlock->context() == state.context());
+    initializeGlobalVariable(state, code, registerFile[code->m_registerIndex]);
+}
+
+DEFINE_BYTECODE_OPERATION(LoadByName)
+{
+    registerFile[code->m_registerIndex] = loadByName(state, state.lexicalEnvironment(), code->m_name);
+}
+
+DEFINE_BYTECODE_OPERATION(StoreByName)
+{
+    storeByName(state, state.lexicalEnvironment(), code->m_name, registerFile[code->m_registerIndex]);
+}
+
+DEFINE_BYTECODE_OPERATION(InitializeByName)
+{
+    initializeByName(state, state.lexicalEnvironment(), code->m_name, code->m_isLexicallyDeclaredName, registerFile[code->m_registerIndex]);
+}
+
+DEFINE_BYTECODE_OPERATION(LoadByHeapIndex)
+{
+    LexicalEnvironment* upperEnv = state.lexicalEnvironment();
+    for (size_t i = 0; i < code->m_upperIndex; i++) {
+        upperEnv = upperEnv->outerEnvironment();
+    }
+    registerFile[code->m_registerIndex] = upperEnv->record()->asDeclarativeEnvironmentRecord()->getHeapValueByIndex(state, code->m_index);
+}
+
+DEFINE_BYTECODE_OPERATION(StoreByHeapIndex)
+{
+    LexicalEnvironment* upperEnv = state.lexicalEnvironment();
+    for (size_t i = 0; i < code->m_upperIndex; i++) {
+        upperEnv = upperEnv->outerEnvironment();
+    }
+    upperEnv->record()->setMutableBindingByIndex(state, code->m_index, registerFile[code->m_registerIndex]);
+}
+
+DEFINE_BYTECODE_OPERATION(InitializeByHeapIndex)
+{
+    state.lexicalEnvironment()->record()->initializeBindingByIndex(state, code->m_index, registerFile[code->m_registerIndex]);
+}
+
+DEFINE_BYTECODE_OPERATION(ResolveNameAddress)
+{
+    resolveNameAddress(state, code, registerFile);
+}
+
+DEFINE_BYTECODE_OPERATION(StoreByNameWithAddress)
+{
+    storeByNameWithAddress(state, code, registerFile);
+}
+
+DEFINE_BYTECODE_OPERATION(GetParameter)
+{
+    if (code->m_paramIndex < state.argc()) {
+        registerFile[code->m_registerIndex] = state.argv()[code->m_paramIndex];
+    } else {
+        registerFile[code->m_registerIndex] = Value();
+    }
+}
+
+DEFINE_BYTECODE_OPERATION(LoadThisBinding)
+{
+    EnvironmentRecord* envRec = state.getThisEnvironment();
+    ASSERT(envRec->isDeclarativeEnvironmentRecord() && envRec->asDeclarativeEnvironmentRecord()->isFunctionEnvironmentRecord());
+    registerFile[code->m_dstIndex] = envRec->asDeclarativeEnvironmentRecord()->asFunctionEnvironmentRecord()->getThisBinding(state);
+}
+
+DEFINE_BYTECODE_OPERATION(CallFunction)
+{
+    const Value& callee = registerFile[code->m_calleeIndex];
+
+    // if PointerValue is not callable, PointerValue::call function throws builtin error
+    // https://www.ecma-international.org/ecma-262/6.0/#sec-call
+    // If IsCallable(F) is false, throw a TypeError exception.
+    if (UNLIKELY(!callee.isPointerValue())) {
+        ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, ErrorObject::Messages::NOT_Callable);
+    }
+    // Return F.[[Call]](V, argumentsList).
+    registerFile[code->m_resultIndex] = callee.asPointerValue()->call(state, Value(), code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+}
+
+DEFINE_BYTECODE_OPERATION(CallFunctionWithReceiver)
+{
+    const Value& callee = registerFile[code->m_calleeIndex];
+    const Value& receiver = registerFile[code->m_receiverIndex];
+
+    // if PointerValue is not callable, PointerValue::call function throws builtin error
+    // https://www.ecma-international.org/ecma-262/6.0/#sec-call
+    // If IsCallable(F) is false, throw a TypeError exception.
+    if (UNLIKELY(!callee.isPointerValue())) {
+        ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, ErrorObject::Messages::NOT_Callable);
+    }
+    // Return F.[[Call]](V, argumentsList).
+    registerFile[code->m_resultIndex] = callee.asPointerValue()->call(state, receiver, code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+}
+
+DEFINE_BYTECODE_OPERATION(CallFunctionComplexCase)
+{
+    callFunctionComplexCase(state, code, registerFile, byteCodeBlock);
+}
+
+DEFINE_BYTECODE_OPERATION(NewOperation)
+{
+    registerFile[code->m_resultIndex] = constructOperation(state, registerFile[code->m_calleeIndex], code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+}
+
+DEFINE_BYTECODE_OPERATION(CreateObject)
+{
+    registerFile[code->m_registerIndex] = Object::createWithInlinePropertySlots(state, state.context()->globalObject()->objectPrototype(), code->m_inlinePropertySlotCount);
+#if defined(ESCARGOT_SMALL_CONFIG)
+    registerFile[code->m_registerIndex].asObject()->markThisObjectDontNeedStructureTransitionTable();
+#endif
+}
+
+DEFINE_BYTECODE_OPERATION(CreateArray)
+{
+    registerFile[code->m_registerIndex] = new ArrayObject(state, (uint64_t)code->m_length);
+}
+
+DEFINE_BYTECODE_OPERATION(CreateFunction)
+{
+    createFunctionOperation(state, code, byteCodeBlock, registerFile);
+}
+
+DEFINE_BYTECODE_OPERATION(ObjectDefineOwnPropertyOperation)
+{
+    objectDefineOwnPropertyOperation(state, code, registerFile);
+}
+
+DEFINE_BYTECODE_OPERATION(ObjectDefineOwnPropertyWithNameOperation)
+{
+    objectDefineOwnPropertyWithNameOperation(state, code, registerFile);
+}
+
+DEFINE_BYTECODE_OPERATION(ArrayDefineOwnPropertyOperation)
+{
+    arrayDefineOwnPropertyOperation(state, code, registerFile);
+}
+
+DEFINE_BYTECODE_OPERATION(TemplateOperation)
+{
+    templateOperation(state, state.lexicalEnvironment(), code, registerFile);
+}
+
+DEFINE_BYTECODE_OPERATION(ThrowOperation)
+{
+    state.context()->throwException(state, registerFile[code->m_registerIndex]);
+}
+
+DEFINE_JUMP_CONDITION(JumpIfTrue)
+{
+    return registerFile[code->m_registerIndex].toBoolean(state);
+}
+
+DEFINE_JUMP_CONDITION(JumpIfFalse)
+{
+    return !registerFile[code->m_registerIndex].toBoolean(state);
+}
+
+DEFINE_JUMP_CONDITION(JumpIfNotFulfilled)
+{
+    const Value& left = registerFile[code->m_leftIndex];
+    const Value& right = registerFile[code->m_rightIndex];
+    bool result = code->m_containEqual ? abstractLeftIsLessThanEqualRight(state, left, right, code->m_switched) : abstractLeftIsLessThanRight(state, left, right, code->m_switched);
+
+    // Jump if the condition is NOT fulfilled
+    return !result;
+}
+
+DEFINE_JUMP_CONDITION(JumpIfEqual)
+{
+    const Value& left = registerFile[code->m_registerIndex0];
+    const Value& right = registerFile[code->m_registerIndex1];
+    bool result = code->m_isStrict ? left.equalsTo(state, right) : left.abstractEqualsTo(state, right);
+    return result ^ code->m_shouldNegate;
+}
+
+#undef DEFINE_BYTECODE_OPERATION
+#undef DEFINE_JUMP_CONDITION
+
 Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteCodeBlock, size_t programCounter, Value* registerFile)
 {
 #if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
@@ -94,6 +669,20 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         char* codeBuffer = byteCodeBlock->m_code.data();
         programCounter = (size_t)(codeBuffer + programCounter);
 
+#if defined(ENABLE_JIT)
+#define RUN_JIT_CODE()                                                                                     \
+    {                                                                                                      \
+        Value jitResult(Value::ForceUninitialized);                                                        \
+        if (byteCodeBlock->m_jitCode->run(*state, byteCodeBlock, programCounter, registerFile, jitResult)) { \
+            return jitResult;                                                                              \
+        }                                                                                                  \
+    }
+
+        if (byteCodeBlock->m_jitCode || (programCounter == (size_t)codeBuffer && JITCompiler::countInvocation(byteCodeBlock))) {
+            RUN_JIT_CODE();
+        }
+#endif
+
 #if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
 #define DEFINE_OPCODE(codeName) codeName##OpcodeLbl
 #define DEFINE_DEFAULT
@@ -147,32 +736,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(GetGlobalVariable)
             :
         {
-            GetGlobalVariable* code = (GetGlobalVariable*)programCounter;
-            ASSERT(byteCodeBlock->m_codeBlock->context() == state->context());
-            Context* ctx = state->context();
-            GlobalObject* globalObject = ctx->globalObject();
-            auto slot = code->m_slot;
-            auto idx = slot->m_lexicalIndexCache;
-            bool isCacheWork = false;
-
-            if (LIKELY(idx != std::numeric_limits<size_t>::max())) {
-                if (LIKELY(ctx->globalDeclarativeStorage()->size() == slot->m_lexicalIndexCache && globalObject->structure() == slot->m_cachedStructure)) {
-                    ASSERT(globalObject->m_values.data() <= slot->m_cachedAddress);
-                    ASSERT(slot->m_cachedAddress < (globalObject->m_values.data() + globalObject->structure()->propertyCount()));
-                    registerFile[code->m_registerIndex] = *((ObjectPropertyValue*)slot->m_cachedAddress);
-                    isCacheWork = true;
-                } else if (slot->m_cachedStructure == nullptr) {
-                    const EncodedValueVectorElement& val = ctx->globalDeclarativeStorage()->at(idx);
-                    isCacheWork = true;
-                    if (UNLIKELY(val.isEmpty())) {
-                        ErrorObject::throwBuiltinError(*state, ErrorObject::ReferenceError, ctx->globalDeclarativeRecord()->at(idx).m_name.string(), false, String::emptyString, ErrorObject::Messages::IsNotInitialized);
-                    }
-                    registerFile[code->m_registerIndex] = val;
-                }
-            }
-            if (UNLIKELY(!isCacheWork)) {
-                registerFile[code->m_registerIndex] = getGlobalVariableSlowCase(*state, globalObject, slot, byteCodeBlock);
-            }
+            byteCodeOperation(*state, (GetGlobalVariable*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(GetGlobalVariable);
             NEXT_INSTRUCTION();
         }
@@ -180,38 +744,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(SetGlobalVariable)
             :
         {
-            SetGlobalVariable* code = (SetGlobalVariable*)programCounter;
-            ASSERT(byteCodeBlock->m_codeBlock->context() == state->context());
-            Context* ctx = state->context();
-            GlobalObject* globalObject = ctx->globalObject();
-            auto slot = code->m_slot;
-            auto idx = slot->m_lexicalIndexCache;
-
-            bool isCacheWork = false;
-            if (LIKELY(idx != std::numeric_limits<size_t>::max())) {
-                if (LIKELY(ctx->globalDeclarativeStorage()->size() == slot->m_lexicalIndexCache && globalObject->structure() == slot->m_cachedStructure)) {
-                    ASSERT(globalObject->m_values.data() <= slot->m_cachedAddress);
-                    ASSERT(slot->m_cachedAddress < (globalObject->m_values.data() + globalObject->structure()->propertyCount()));
-                    *((ObjectPropertyValue*)slot->m_cachedAddress) = registerFile[code->m_registerIndex];
-                    isCacheWork = true;
-                } else if (slot->m_cachedStructure == nullptr) {
-                    isCacheWork = true;
-                    const auto& record = ctx->globalDeclarativeRecord()->at(idx);
-                    auto& storage = ctx->globalDeclarativeStorage()->at(idx);
-                    if (UNLIKELY(storage.isEmpty())) {
-                        ErrorObject::throwBuiltinError(*state, ErrorObject::ReferenceError, record.m_name.string(), false, String::emptyString, ErrorObject::Messages::IsNotInitialized);
-                    }
-                    if (UNLIKELY(!record.m_isMutable)) {
-                        ErrorObject::throwBuiltinError(*state, ErrorObject::TypeError, record.m_name.string(), false, String::emptyString, ErrorObject::Messages::AssignmentToConstantVariable);
-                    }
-                    storage = registerFile[code->m_registerIndex];
-                }
-            }
-
-            if (UNLIKELY(!isCacheWork)) {
-                setGlobalVariableSlowCase(*state, globalObject, slot, registerFile[code->m_registerIndex], byteCodeBlock);
-            }
-
+            byteCodeOperation(*state, (SetGlobalVariable*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(SetGlobalVariable);
             NEXT_INSTRUCTION();
         }
@@ -219,26 +752,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(BinaryPlus)
             :
         {
-            BinaryPlus* code = (BinaryPlus*)programCounter;
-            const Value& v0 = registerFile[code->m_srcIndex0];
-            const Value& v1 = registerFile[code->m_srcIndex1];
-            Value ret(Value::ForceUninitialized);
-            if (v0.isInt32() && v1.isInt32()) {
-                int32_t a = v0.asInt32();
-                int32_t b = v1.asInt32();
-                int32_t c;
-                bool result = ArithmeticOperations<int32_t, int32_t, int32_t>::add(a, b, c);
-                if (LIKELY(result)) {
-                    ret = Value(c);
-                } else {
-                    ret = Value(Value::EncodeAsDouble, (double)a + (double)b);
-                }
-            } else if (v0.isNumber() && v1.isNumber()) {
-                ret = Value(v0.asNumber() + v1.asNumber());
-            } else {
-                ret = plusSlowCase(*state, v0, v1);
-            }
-            registerFile[code->m_dstIndex] = ret;
+            byteCodeOperation(*state, (BinaryPlus*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(BinaryPlus);
             NEXT_INSTRUCTION();
         }
@@ -246,26 +760,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(BinaryMinus)
             :
         {
-            BinaryMinus* code = (BinaryMinus*)programCounter;
-            const Value& left = registerFile[code->m_srcIndex0];
-            const Value& right = registerFile[code->m_srcIndex1];
-            Value ret(Value::ForceUninitialized);
-            if (left.isInt32() && right.isInt32()) {
-                int32_t a = left.asInt32();
-                int32_t b = right.asInt32();
-                int32_t c;
-                bool result = ArithmeticOperations<int32_t, int32_t, int32_t>::sub(a, b, c);
-                if (LIKELY(result)) {
-                    ret = Value(c);
-                } else {
-                    ret = Value(Value::EncodeAsDouble, (double)a - (double)b);
-                }
-            } else if (LIKELY(left.isNumber() && right.isNumber())) {
-                ret = Value(left.asNumber() - right.asNumber());
-            } else {
-                ret = minusSlowCase(*state, left, right);
-            }
-            registerFile[code->m_dstIndex] = ret;
+            byteCodeOperation(*state, (BinaryMinus*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(BinaryMinus);
             NEXT_INSTRUCTION();
         }
@@ -273,30 +768,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(BinaryMultiply)
             :
         {
-            BinaryMultiply* code = (BinaryMultiply*)programCounter;
-            const Value& left = registerFile[code->m_srcIndex0];
-            const Value& right = registerFile[code->m_srcIndex1];
-            Value ret(Value::ForceUninitialized);
-            if (left.isInt32() && right.isInt32()) {
-                int32_t a = left.asInt32();
-                int32_t b = right.asInt32();
-                if (UNLIKELY((!a || !b) && (a >> 31 || b >> 31))) { // -1 * 0 should be treated as -0, not +0
-                    ret = Value(left.asNumber() * right.asNumber());
-                } else {
-                    int32_t c;
-                    bool result = ArithmeticOperations<int32_t, int32_t, int32_t>::multiply(a, b, c);
-                    if (LIKELY(result)) {
-                        ret = Value(c);
-                    } else {
-                        ret = Value(Value::EncodeAsDouble, a * (double)b);
-                    }
-                }
-            } else if (LIKELY(left.isNumber() && right.isNumber())) {
-                ret = Value(Value::EncodeAsDouble, left.asNumber() * right.asNumber());
-            } else {
-                ret = multiplySlowCase(*state, left, right);
-            }
-            registerFile[code->m_dstIndex] = ret;
+            byteCodeOperation(*state, (BinaryMultiply*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(BinaryMultiply);
             NEXT_INSTRUCTION();
         }
@@ -304,14 +776,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(BinaryDivision)
             :
         {
-            BinaryDivision* code = (BinaryDivision*)programCounter;
-            const Value& left = registerFile[code->m_srcIndex0];
-            const Value& right = registerFile[code->m_srcIndex1];
-            if (LIKELY(left.isNumber() && right.isNumber())) {
-                registerFile[code->m_dstIndex] = Value(left.asNumber() / right.asNumber());
-            } else {
-                registerFile[code->m_dstIndex] = divisionSlowCase(*state, left, right);
-            }
+            byteCodeOperation(*state, (BinaryDivision*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(BinaryDivision);
             NEXT_INSTRUCTION();
         }
@@ -319,10 +784,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(BinaryEqual)
             :
         {
-            BinaryEqual* code = (BinaryEqual*)programCounter;
-            const Value& left = registerFile[code->m_srcIndex0];
-            const Value& right = registerFile[code->m_srcIndex1];
-            registerFile[code->m_dstIndex] = Value(left.abstractEqualsTo(*state, right));
+            byteCodeOperation(*state, (BinaryEqual*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(BinaryEqual);
             NEXT_INSTRUCTION();
         }
@@ -330,10 +792,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(BinaryNotEqual)
             :
         {
-            BinaryNotEqual* code = (BinaryNotEqual*)programCounter;
-            const Value& left = registerFile[code->m_srcIndex0];
-            const Value& right = registerFile[code->m_srcIndex1];
-            registerFile[code->m_dstIndex] = Value(!left.abstractEqualsTo(*state, right));
+            byteCodeOperation(*state, (BinaryNotEqual*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(BinaryNotEqual);
             NEXT_INSTRUCTION();
         }
@@ -341,10 +800,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(BinaryStrictEqual)
             :
         {
-            BinaryStrictEqual* code = (BinaryStrictEqual*)programCounter;
-            const Value& left = registerFile[code->m_srcIndex0];
-            const Value& right = registerFile[code->m_srcIndex1];
-            registerFile[code->m_dstIndex] = Value(left.equalsTo(*state, right));
+            byteCodeOperation(*state, (BinaryStrictEqual*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(BinaryStrictEqual);
             NEXT_INSTRUCTION();
         }
@@ -352,10 +808,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(BinaryNotStrictEqual)
             :
         {
-            BinaryNotStrictEqual* code = (BinaryNotStrictEqual*)programCounter;
-            const Value& left = registerFile[code->m_srcIndex0];
-            const Value& right = registerFile[code->m_srcIndex1];
-            registerFile[code->m_dstIndex] = Value(!left.equalsTo(*state, right));
+            byteCodeOperation(*state, (BinaryNotStrictEqual*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(BinaryNotStrictEqual);
             NEXT_INSTRUCTION();
         }
@@ -363,10 +816,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(BinaryLessThan)
             :
         {
-            BinaryLessThan* code = (BinaryLessThan*)programCounter;
-            const Value& left = registerFile[code->m_srcIndex0];
-            const Value& right = registerFile[code->m_srcIndex1];
-            registerFile[code->m_dstIndex] = Value(abstractLeftIsLessThanRight(*state, left, right, false));
+            byteCodeOperation(*state, (BinaryLessThan*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(BinaryLessThan);
             NEXT_INSTRUCTION();
         }
@@ -374,10 +824,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(BinaryLessThanOrEqual)
             :
         {
-            BinaryLessThanOrEqual* code = (BinaryLessThanOrEqual*)programCounter;
-            const Value& left = registerFile[code->m_srcIndex0];
-            const Value& right = registerFile[code->m_srcIndex1];
-            registerFile[code->m_dstIndex] = Value(abstractLeftIsLessThanEqualRight(*state, left, right, false));
+            byteCodeOperation(*state, (BinaryLessThanOrEqual*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(BinaryLessThanOrEqual);
             NEXT_INSTRUCTION();
         }
@@ -385,10 +832,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(BinaryGreaterThan)
             :
         {
-            BinaryGreaterThan* code = (BinaryGreaterThan*)programCounter;
-            const Value& left = registerFile[code->m_srcIndex0];
-            const Value& right = registerFile[code->m_srcIndex1];
-            registerFile[code->m_dstIndex] = Value(abstractLeftIsLessThanRight(*state, right, left, true));
+            byteCodeOperation(*state, (BinaryGreaterThan*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(BinaryGreaterThan);
             NEXT_INSTRUCTION();
         }
@@ -396,10 +840,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(BinaryGreaterThanOrEqual)
             :
         {
-            BinaryGreaterThanOrEqual* code = (BinaryGreaterThanOrEqual*)programCounter;
-            const Value& left = registerFile[code->m_srcIndex0];
-            const Value& right = registerFile[code->m_srcIndex1];
-            registerFile[code->m_dstIndex] = Value(abstractLeftIsLessThanEqualRight(*state, right, left, true));
+            byteCodeOperation(*state, (BinaryGreaterThanOrEqual*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(BinaryGreaterThanOrEqual);
             NEXT_INSTRUCTION();
         }
@@ -407,9 +848,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(ToNumericIncrement)
             :
         {
-            ToNumericIncrement* code = (ToNumericIncrement*)programCounter;
-            registerFile[code->m_dstIndex] = Value(registerFile[code->m_srcIndex].toNumeric(*state).first);
-            registerFile[code->m_storeIndex] = incrementOperation(*state, registerFile[code->m_dstIndex]);
+            byteCodeOperation(*state, (ToNumericIncrement*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(ToNumericIncrement);
             NEXT_INSTRUCTION();
         }
@@ -417,8 +856,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(Increment)
             :
         {
-            Increment* code = (Increment*)programCounter;
-            registerFile[code->m_dstIndex] = incrementOperation(*state, registerFile[code->m_srcIndex]);
+            byteCodeOperation(*state, (Increment*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(Increment);
             NEXT_INSTRUCTION();
         }
@@ -426,9 +864,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(ToNumericDecrement)
             :
         {
-            ToNumericDecrement* code = (ToNumericDecrement*)programCounter;
-            registerFile[code->m_dstIndex] = Value(registerFile[code->m_srcIndex].toNumeric(*state).first);
-            registerFile[code->m_storeIndex] = decrementOperation(*state, registerFile[code->m_dstIndex]);
+            byteCodeOperation(*state, (ToNumericDecrement*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(ToNumericDecrement);
             NEXT_INSTRUCTION();
         }
@@ -436,8 +872,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(Decrement)
             :
         {
-            Decrement* code = (Decrement*)programCounter;
-            registerFile[code->m_dstIndex] = decrementOperation(*state, registerFile[code->m_srcIndex]);
+            byteCodeOperation(*state, (Decrement*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(Decrement);
             NEXT_INSTRUCTION();
         }
@@ -445,9 +880,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(UnaryNot)
             :
         {
-            UnaryNot* code = (UnaryNot*)programCounter;
-            const Value& val = registerFile[code->m_srcIndex];
-            registerFile[code->m_dstIndex] = Value(!val.toBoolean(*state));
+            byteCodeOperation(*state, (UnaryNot*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(UnaryNot);
             NEXT_INSTRUCTION();
         }
@@ -455,68 +888,23 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(GetObject)
             :
         {
-            GetObject* code = (GetObject*)programCounter;
-            const Value& willBeObject = registerFile[code->m_objectRegisterIndex];
-            const Value& property = registerFile[code->m_propertyRegisterIndex];
-            PointerValue* v;
-            if (LIKELY(willBeObject.isObject() && (v = willBeObject.asPointerValue())->isArrayObject())) {
-                ArrayObject* arr = (ArrayObject*)v;
-                if (LIKELY(arr->isFastModeArray())) {
-                    uint32_t idx = property.tryToUseAsArrayIndex(*state);
-                    if (LIKELY(idx != Value::InvalidArrayIndexValue) && LIKELY(idx < arr->arrayLength(*state))) {
-                        const Value& v = arr->m_fastModeData[idx];
-                        if (LIKELY(!v.isEmpty())) {
-                            registerFile[code->m_storeRegisterIndex] = v;
-                            ADD_PROGRAM_COUNTER(GetObject);
-                            NEXT_INSTRUCTION();
-                        }
-                    }
-                }
-            }
-            JUMP_INSTRUCTION(GetObjectOpcodeSlowCase);
+            byteCodeOperation(*state, (GetObject*)programCounter, registerFile, byteCodeBlock);
+            ADD_PROGRAM_COUNTER(GetObject);
+            NEXT_INSTRUCTION();
         }
 
         DEFINE_OPCODE(SetObjectOperation)
             :
         {
-            SetObjectOperation* code = (SetObjectOperation*)programCounter;
-            const Value& willBeObject = registerFile[code->m_objectRegisterIndex];
-            const Value& property = registerFile[code->m_propertyRegisterIndex];
-            if (LIKELY(willBeObject.isObject() && (willBeObject.asPointerValue())->isArrayObject())) {
-                ArrayObject* arr = willBeObject.asObject()->asArrayObject();
-                uint32_t idx = property.tryToUseAsArrayIndex(*state);
-                if (LIKELY(arr->isFastModeArray())) {
-                    if (LIKELY(idx != Value::InvalidArrayIndexValue)) {
-                        uint32_t len = arr->arrayLength(*state);
-                        if (UNLIKELY(len <= idx)) {
-                            if (UNLIKELY(!arr->isExtensible(*state))) {
-                                JUMP_INSTRUCTION(SetObjectOpcodeSlowCase);
-                            }
-                            if (UNLIKELY(!arr->setArrayLength(*state, idx + 1)) || UNLIKELY(!arr->isFastModeArray())) {
-                                JUMP_INSTRUCTION(SetObjectOpcodeSlowCase);
-                            }
-                        }
-                        arr->m_fastModeData[idx] = registerFile[code->m_loadRegisterIndex];
-                        ADD_PROGRAM_COUNTER(SetObjectOperation);
-                        NEXT_INSTRUCTION();
-                    }
-                }
-            }
-            JUMP_INSTRUCTION(SetObjectOpcodeSlowCase);
+            byteCodeOperation(*state, (SetObjectOperation*)programCounter, registerFile, byteCodeBlock);
+            ADD_PROGRAM_COUNTER(SetObjectOperation);
+            NEXT_INSTRUCTION();
         }
 
         DEFINE_OPCODE(GetObjectPreComputedCase)
             :
         {
-            GetObjectPreComputedCase* code = (GetObjectPreComputedCase*)programCounter;
-            const Value& willBeObject = registerFile[code->m_objectRegisterIndex];
-            Object* obj;
-            if (LIKELY(willBeObject.isObject())) {
-                obj = willBeObject.asObject();
-            } else {
-                obj = fastToObject(*state, willBeObject);
-            }
-            registerFile[code->m_storeRegisterIndex] = getObjectPrecomputedCaseOperation(*state, obj, willBeObject, code, byteCodeBlock);
+            byteCodeOperation(*state, (GetObjectPreComputedCase*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(GetObjectPreComputedCase);
             NEXT_INSTRUCTION();
         }
@@ -524,8 +912,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(SetObjectPreComputedCase)
             :
         {
-            SetObjectPreComputedCase* code = (SetObjectPreComputedCase*)programCounter;
-            setObjectPreComputedCaseOperation(*state, registerFile[code->m_objectRegisterIndex], registerFile[code->m_loadRegisterIndex], code, byteCodeBlock);
+            byteCodeOperation(*state, (SetObjectPreComputedCase*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(SetObjectPreComputedCase);
             NEXT_INSTRUCTION();
         }
@@ -536,6 +923,12 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             Jump* code = (Jump*)programCounter;
             ASSERT(code->m_jumpPosition != SIZE_MAX);
             programCounter = code->m_jumpPosition;
+#if defined(ENABLE_JIT)
+            // loop back edge
+            if (programCounter < (size_t)code && (byteCodeBlock->m_jitCode || JITCompiler::countBackEdge(byteCodeBlock))) {
+                RUN_JIT_CODE();
+            }
+#endif
             NEXT_INSTRUCTION();
         }
 
@@ -544,15 +937,10 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         {
             JumpIfNotFulfilled* code = (JumpIfNotFulfilled*)programCounter;
             ASSERT(code->m_jumpPosition != SIZE_MAX);
-            const Value& left = registerFile[code->m_leftIndex];
-            const Value& right = registerFile[code->m_rightIndex];
-            bool result = code->m_containEqual ? abstractLeftIsLessThanEqualRight(*state, left, right, code->m_switched) : abstractLeftIsLessThanRight(*state, left, right, code->m_switched);
-
-            // Jump if the condition is NOT fulfilled
-            if (result) {
-                ADD_PROGRAM_COUNTER(JumpIfNotFulfilled);
-            } else {
+            if (shouldJump(*state, code, registerFile)) {
                 programCounter = code->m_jumpPosition;
+            } else {
+                ADD_PROGRAM_COUNTER(JumpIfNotFulfilled);
             }
             NEXT_INSTRUCTION();
         }
@@ -562,11 +950,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         {
             JumpIfEqual* code = (JumpIfEqual*)programCounter;
             ASSERT(code->m_jumpPosition != SIZE_MAX);
-            const Value& left = registerFile[code->m_registerIndex0];
-            const Value& right = registerFile[code->m_registerIndex1];
-            bool result = code->m_isStrict ? left.equalsTo(*state, right) : left.abstractEqualsTo(*state, right);
-
-            if (result ^ code->m_shouldNegate) {
+            if (shouldJump(*state, code, registerFile)) {
                 programCounter = code->m_jumpPosition;
             } else {
                 ADD_PROGRAM_COUNTER(JumpIfEqual);
@@ -579,7 +963,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         {
             JumpIfTrue* code = (JumpIfTrue*)programCounter;
             ASSERT(code->m_jumpPosition != SIZE_MAX);
-            if (registerFile[code->m_registerIndex].toBoolean(*state)) {
+            if (shouldJump(*state, code, registerFile)) {
                 programCounter = code->m_jumpPosition;
             } else {
                 ADD_PROGRAM_COUNTER(JumpIfTrue);
@@ -607,7 +991,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         {
             JumpIfFalse* code = (JumpIfFalse*)programCounter;
             ASSERT(code->m_jumpPosition != SIZE_MAX);
-            if (!registerFile[code->m_registerIndex].toBoolean(*state)) {
+            if (shouldJump(*state, code, registerFile)) {
                 programCounter = code->m_jumpPosition;
             } else {
                 ADD_PROGRAM_COUNTER(JumpIfFalse);
@@ -618,18 +1002,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(CallFunction)
             :
         {
-            CallFunction* code = (CallFunction*)programCounter;
-            const Value& callee = registerFile[code->m_calleeIndex];
-
-            // if PointerValue is not callable, PointerValue::call function throws builtin error
-            // https://www.ecma-international.org/ecma-262/6.0/#sec-call
-            // If IsCallable(F) is false, throw a TypeError exception.
-            if (UNLIKELY(!callee.isPointerValue())) {
-                ErrorObject::throwBuiltinError(*state, ErrorObject::TypeError, ErrorObject::Messages::NOT_Callable);
-            }
-            // Return F.[[Call]](V, argumentsList).
-            registerFile[code->m_resultIndex] = callee.asPointerValue()->call(*state, Value(), code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
-
+            byteCodeOperation(*state, (CallFunction*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(CallFunction);
             NEXT_INSTRUCTION();
         }
@@ -637,19 +1010,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(CallFunctionWithReceiver)
             :
         {
-            CallFunctionWithReceiver* code = (CallFunctionWithReceiver*)programCounter;
-            const Value& callee = registerFile[code->m_calleeIndex];
-            const Value& receiver = registerFile[code->m_receiverIndex];
-
-            // if PointerValue is not callable, PointerValue::call function throws builtin error
-            // https://www.ecma-international.org/ecma-262/6.0/#sec-call
-            // If IsCallable(F) is false, throw a TypeError exception.
-            if (UNLIKELY(!callee.isPointerValue())) {
-                ErrorObject::throwBuiltinError(*state, ErrorObject::TypeError, ErrorObject::Messages::NOT_Callable);
-            }
-            // Return F.[[Call]](V, argumentsList).
-            registerFile[code->m_resultIndex] = callee.asPointerValue()->call(*state, receiver, code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
-
+            byteCodeOperation(*state, (CallFunctionWithReceiver*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(CallFunctionWithReceiver);
             NEXT_INSTRUCTION();
         }
@@ -657,12 +1018,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(LoadByHeapIndex)
             :
         {
-            LoadByHeapIndex* code = (LoadByHeapIndex*)programCounter;
-            LexicalEnvironment* upperEnv = state->lexicalEnvironment();
-            for (size_t i = 0; i < code->m_upperIndex; i++) {
-                upperEnv = upperEnv->outerEnvironment();
-            }
-            registerFile[code->m_registerIndex] = upperEnv->record()->asDeclarativeEnvironmentRecord()->getHeapValueByIndex(*state, code->m_index);
+            byteCodeOperation(*state, (LoadByHeapIndex*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(LoadByHeapIndex);
             NEXT_INSTRUCTION();
         }
@@ -670,12 +1026,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(StoreByHeapIndex)
             :
         {
-            StoreByHeapIndex* code = (StoreByHeapIndex*)programCounter;
-            LexicalEnvironment* upperEnv = state->lexicalEnvironment();
-            for (size_t i = 0; i < code->m_upperIndex; i++) {
-                upperEnv = upperEnv->outerEnvironment();
-            }
-            upperEnv->record()->setMutableBindingByIndex(*state, code->m_index, registerFile[code->m_registerIndex]);
+            byteCodeOperation(*state, (StoreByHeapIndex*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(StoreByHeapIndex);
             NEXT_INSTRUCTION();
         }
@@ -683,13 +1034,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(UnaryMinus)
             :
         {
-            UnaryMinus* code = (UnaryMinus*)programCounter;
-            const Value& val = registerFile[code->m_srcIndex];
-            if (UNLIKELY(val.isPointerValue())) {
-                registerFile[code->m_dstIndex] = unaryMinusSlowCase(*state, val);
-            } else {
-                registerFile[code->m_dstIndex] = Value(-val.toNumber(*state));
-            }
+            byteCodeOperation(*state, (UnaryMinus*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(UnaryMinus);
             NEXT_INSTRUCTION();
         }
@@ -697,10 +1042,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(BinaryMod)
             :
         {
-            BinaryMod* code = (BinaryMod*)programCounter;
-            const Value& left = registerFile[code->m_srcIndex0];
-            const Value& right = registerFile[code->m_srcIndex1];
-            registerFile[code->m_dstIndex] = modOperation(*state, left, right);
+            byteCodeOperation(*state, (BinaryMod*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(BinaryMod);
             NEXT_INSTRUCTION();
         }
@@ -708,14 +1050,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(BinaryBitwiseAnd)
             :
         {
-            BinaryBitwiseAnd* code = (BinaryBitwiseAnd*)programCounter;
-            const Value& left = registerFile[code->m_srcIndex0];
-            const Value& right = registerFile[code->m_srcIndex1];
-            if (left.isInt32() && right.isInt32()) {
-                registerFile[code->m_dstIndex] = Value(left.asInt32() & right.asInt32());
-            } else {
-                registerFile[code->m_dstIndex] = bitwiseOperationSlowCase(*state, left, right, BitwiseOperationKind::And);
-            }
+            byteCodeOperation(*state, (BinaryBitwiseAnd*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(BinaryBitwiseAnd);
             NEXT_INSTRUCTION();
         }
@@ -723,14 +1058,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(BinaryBitwiseOr)
             :
         {
-            BinaryBitwiseOr* code = (BinaryBitwiseOr*)programCounter;
-            const Value& left = registerFile[code->m_srcIndex0];
-            const Value& right = registerFile[code->m_srcIndex1];
-            if (left.isInt32() && right.isInt32()) {
-                registerFile[code->m_dstIndex] = Value(left.asInt32() | right.asInt32());
-            } else {
-                registerFile[code->m_dstIndex] = bitwiseOperationSlowCase(*state, left, right, BitwiseOperationKind::Or);
-            }
+            byteCodeOperation(*state, (BinaryBitwiseOr*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(BinaryBitwiseOr);
             NEXT_INSTRUCTION();
         }
@@ -738,14 +1066,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(BinaryBitwiseXor)
             :
         {
-            BinaryBitwiseXor* code = (BinaryBitwiseXor*)programCounter;
-            const Value& left = registerFile[code->m_srcIndex0];
-            const Value& right = registerFile[code->m_srcIndex1];
-            if (left.isInt32() && right.isInt32()) {
-                registerFile[code->m_dstIndex] = Value(left.asInt32() ^ right.asInt32());
-            } else {
-                registerFile[code->m_dstIndex] = bitwiseOperationSlowCase(*state, left, right, BitwiseOperationKind::Xor);
-            }
+            byteCodeOperation(*state, (BinaryBitwiseXor*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(BinaryBitwiseXor);
             NEXT_INSTRUCTION();
         }
@@ -753,17 +1074,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(BinaryLeftShift)
             :
         {
-            BinaryLeftShift* code = (BinaryLeftShift*)programCounter;
-            const Value& left = registerFile[code->m_srcIndex0];
-            const Value& right = registerFile[code->m_srcIndex1];
-            if (left.isInt32() && right.isInt32()) {
-                int32_t lnum = left.asInt32();
-                int32_t rnum = right.asInt32();
-                lnum <<= ((unsigned int)rnum) & 0x1F;
-                registerFile[code->m_dstIndex] = Value(lnum);
-            } else {
-                registerFile[code->m_dstIndex] = shiftOperationSlowCase(*state, left, right, ShiftOperationKind::Left);
-            }
+            byteCodeOperation(*state, (BinaryLeftShift*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(BinaryLeftShift);
             NEXT_INSTRUCTION();
         }
@@ -771,17 +1082,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(BinarySignedRightShift)
             :
         {
-            BinarySignedRightShift* code = (BinarySignedRightShift*)programCounter;
-            const Value& left = registerFile[code->m_srcIndex0];
-            const Value& right = registerFile[code->m_srcIndex1];
-            if (left.isInt32() && right.isInt32()) {
-                int32_t lnum = left.asInt32();
-                int32_t rnum = right.asInt32();
-                lnum >>= ((unsigned int)rnum) & 0x1F;
-                registerFile[code->m_dstIndex] = Value(lnum);
-            } else {
-                registerFile[code->m_dstIndex] = shiftOperationSlowCase(*state, left, right, ShiftOperationKind::SignedRight);
-            }
+            byteCodeOperation(*state, (BinarySignedRightShift*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(BinarySignedRightShift);
             NEXT_INSTRUCTION();
         }
@@ -789,17 +1090,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(BinaryUnsignedRightShift)
             :
         {
-            BinaryUnsignedRightShift* code = (BinaryUnsignedRightShift*)programCounter;
-            const Value& left = registerFile[code->m_srcIndex0];
-            const Value& right = registerFile[code->m_srcIndex1];
-            if (left.isUInt32() && right.isUInt32()) {
-                uint32_t lnum = left.asUInt32();
-                uint32_t rnum = right.asUInt32();
-                lnum = (lnum) >> ((rnum)&0x1F);
-                registerFile[code->m_dstIndex] = Value(lnum);
-            } else {
-                registerFile[code->m_dstIndex] = shiftOperationSlowCase(*state, left, right, ShiftOperationKind::UnsignedRight);
-            }
+            byteCodeOperation(*state, (BinaryUnsignedRightShift*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(BinaryUnsignedRightShift);
             NEXT_INSTRUCTION();
         }
@@ -807,10 +1098,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(BinaryExponentiation)
             :
         {
-            BinaryExponentiation* code = (BinaryExponentiation*)programCounter;
-            const Value& left = registerFile[code->m_srcIndex0];
-            const Value& right = registerFile[code->m_srcIndex1];
-            registerFile[code->m_dstIndex] = exponentialOperation(*state, left, right);
+            byteCodeOperation(*state, (BinaryExponentiation*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(BinaryExponentiation);
             NEXT_INSTRUCTION();
         }
@@ -818,13 +1106,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(UnaryBitwiseNot)
             :
         {
-            UnaryBitwiseNot* code = (UnaryBitwiseNot*)programCounter;
-            const Value& val = registerFile[code->m_srcIndex];
-            if (val.isInt32()) {
-                registerFile[code->m_dstIndex] = Value(~val.asInt32());
-            } else {
-                registerFile[code->m_dstIndex] = bitwiseNotOperationSlowCase(*state, val);
-            }
+            byteCodeOperation(*state, (UnaryBitwiseNot*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(UnaryBitwiseNot);
             NEXT_INSTRUCTION();
         }
@@ -832,12 +1114,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(GetParameter)
             :
         {
-            GetParameter* code = (GetParameter*)programCounter;
-            if (code->m_paramIndex < state->argc()) {
-                registerFile[code->m_registerIndex] = state->argv()[code->m_paramIndex];
-            } else {
-                registerFile[code->m_registerIndex] = Value();
-            }
+            byteCodeOperation(*state, (GetParameter*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(GetParameter);
             NEXT_INSTRUCTION();
         }
@@ -856,9 +1133,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(ToNumber)
             :
         {
-            ToNumber* code = (ToNumber*)programCounter;
-            const Value& val = registerFile[code->m_srcIndex];
-            registerFile[code->m_dstIndex] = Value(val.toNumber(*state));
+            byteCodeOperation(*state, (ToNumber*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(ToNumber);
             NEXT_INSTRUCTION();
         }
@@ -866,9 +1141,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(InitializeGlobalVariable)
             :
         {
-            InitializeGlobalVariable* code = (InitializeGlobalVariable*)programCounter;
-            ASSERT(byteCodeBlock->m_codeBlock->context() == state->context());
-            initializeGlobalVariable(*state, code, registerFile[code->m_registerIndex]);
+            byteCodeOperation(*state, (InitializeGlobalVariable*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(InitializeGlobalVariable);
             NEXT_INSTRUCTION();
         }
@@ -876,8 +1149,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(InitializeByHeapIndex)
             :
         {
-            InitializeByHeapIndex* code = (InitializeByHeapIndex*)programCounter;
-            state->lexicalEnvironment()->record()->initializeBindingByIndex(*state, code->m_index, registerFile[code->m_registerIndex]);
+            byteCodeOperation(*state, (InitializeByHeapIndex*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(InitializeByHeapIndex);
             NEXT_INSTRUCTION();
         }
@@ -885,8 +1157,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(ObjectDefineOwnPropertyOperation)
             :
         {
-            ObjectDefineOwnPropertyOperation* code = (ObjectDefineOwnPropertyOperation*)programCounter;
-            objectDefineOwnPropertyOperation(*state, code, registerFile);
+            byteCodeOperation(*state, (ObjectDefineOwnPropertyOperation*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(ObjectDefineOwnPropertyOperation);
             NEXT_INSTRUCTION();
         }
@@ -894,8 +1165,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(ObjectDefineOwnPropertyWithNameOperation)
             :
         {
-            ObjectDefineOwnPropertyWithNameOperation* code = (ObjectDefineOwnPropertyWithNameOperation*)programCounter;
-            objectDefineOwnPropertyWithNameOperation(*state, code, registerFile);
+            byteCodeOperation(*state, (ObjectDefineOwnPropertyWithNameOperation*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(ObjectDefineOwnPropertyWithNameOperation);
             NEXT_INSTRUCTION();
         }
@@ -903,8 +1173,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(ArrayDefineOwnPropertyOperation)
             :
         {
-            ArrayDefineOwnPropertyOperation* code = (ArrayDefineOwnPropertyOperation*)programCounter;
-            arrayDefineOwnPropertyOperation(*state, code, registerFile);
+            byteCodeOperation(*state, (ArrayDefineOwnPropertyOperation*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(ArrayDefineOwnPropertyOperation);
             NEXT_INSTRUCTION();
         }
@@ -930,8 +1199,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(NewOperation)
             :
         {
-            NewOperation* code = (NewOperation*)programCounter;
-            registerFile[code->m_resultIndex] = constructOperation(*state, registerFile[code->m_calleeIndex], code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+            byteCodeOperation(*state, (NewOperation*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(NewOperation);
             NEXT_INSTRUCTION();
         }
@@ -939,35 +1207,15 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(UnaryTypeof)
             :
         {
-            UnaryTypeof* code = (UnaryTypeof*)programCounter;
-            unaryTypeof(*state, code, registerFile);
+            byteCodeOperation(*state, (UnaryTypeof*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(UnaryTypeof);
             NEXT_INSTRUCTION();
         }
 
-        DEFINE_OPCODE(GetObjectOpcodeSlowCase)
-            :
-        {
-            GetObject* code = (GetObject*)programCounter;
-            getObjectOpcodeSlowCase(*state, code, registerFile);
-            ADD_PROGRAM_COUNTER(GetObject);
-            NEXT_INSTRUCTION();
-        }
-
-        DEFINE_OPCODE(SetObjectOpcodeSlowCase)
-            :
-        {
-            SetObjectOperation* code = (SetObjectOperation*)programCounter;
-            setObjectOpcodeSlowCase(*state, code, registerFile);
-            ADD_PROGRAM_COUNTER(SetObjectOperation);
-            NEXT_INSTRUCTION();
-        }
-
         DEFINE_OPCODE(LoadByName)
             :
         {
-            LoadByName* code = (LoadByName*)programCounter;
-            registerFile[code->m_registerIndex] = loadByName(*state, state->lexicalEnvironment(), code->m_name);
+            byteCodeOperation(*state, (LoadByName*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(LoadByName);
             NEXT_INSTRUCTION();
         }
@@ -975,8 +1223,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(StoreByName)
             :
         {
-            StoreByName* code = (StoreByName*)programCounter;
-            storeByName(*state, state->lexicalEnvironment(), code->m_name, registerFile[code->m_registerIndex]);
+            byteCodeOperation(*state, (StoreByName*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(StoreByName);
             NEXT_INSTRUCTION();
         }
@@ -984,8 +1231,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(InitializeByName)
             :
         {
-            InitializeByName* code = (InitializeByName*)programCounter;
-            initializeByName(*state, state->lexicalEnvironment(), code->m_name, code->m_isLexicallyDeclaredName, registerFile[code->m_registerIndex]);
+            byteCodeOperation(*state, (InitializeByName*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(InitializeByName);
             NEXT_INSTRUCTION();
         }
@@ -993,11 +1239,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(CreateObject)
             :
         {
-            CreateObject* code = (CreateObject*)programCounter;
-            registerFile[code->m_registerIndex] = new Object(*state);
-#if defined(ESCARGOT_SMALL_CONFIG)
-            registerFile[code->m_registerIndex].asObject()->markThisObjectDontNeedStructureTransitionTable();
-#endif
+            byteCodeOperation(*state, (CreateObject*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(CreateObject);
             NEXT_INSTRUCTION();
         }
@@ -1005,8 +1247,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(CreateArray)
             :
         {
-            CreateArray* code = (CreateArray*)programCounter;
-            registerFile[code->m_registerIndex] = new ArrayObject(*state, (uint64_t)code->m_length);
+            byteCodeOperation(*state, (CreateArray*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(CreateArray);
             NEXT_INSTRUCTION();
         }
@@ -1014,8 +1255,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(CreateFunction)
             :
         {
-            CreateFunction* code = (CreateFunction*)programCounter;
-            createFunctionOperation(*state, code, byteCodeBlock, registerFile);
+            byteCodeOperation(*state, (CreateFunction*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(CreateFunction);
             NEXT_INSTRUCTION();
         }
@@ -1068,10 +1308,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(LoadThisBinding)
             :
         {
-            LoadThisBinding* code = (LoadThisBinding*)programCounter;
-            EnvironmentRecord* envRec = state->getThisEnvironment();
-            ASSERT(envRec->isDeclarativeEnvironmentRecord() && envRec->asDeclarativeEnvironmentRecord()->isFunctionEnvironmentRecord());
-            registerFile[code->m_dstIndex] = envRec->asDeclarativeEnvironmentRecord()->asFunctionEnvironmentRecord()->getThisBinding(*state);
+            byteCodeOperation(*state, (LoadThisBinding*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(LoadThisBinding);
             NEXT_INSTRUCTION();
         }
@@ -1096,8 +1333,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(ThrowOperation)
             :
         {
-            ThrowOperation* code = (ThrowOperation*)programCounter;
-            state->context()->throwException(*state, registerFile[code->m_registerIndex]);
+            byteCodeOperation(*state, (ThrowOperation*)programCounter, registerFile, byteCodeBlock);
         }
 
         DEFINE_OPCODE(WithOperation)
@@ -1194,8 +1430,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(TemplateOperation)
             :
         {
-            TemplateOperation* code = (TemplateOperation*)programCounter;
-            templateOperation(*state, state->lexicalEnvironment(), code, registerFile);
+            byteCodeOperation(*state, (TemplateOperation*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(TemplateOperation);
             NEXT_INSTRUCTION();
         }
@@ -1203,11 +1438,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(BinaryInOperation)
             :
         {
-            BinaryInOperation* code = (BinaryInOperation*)programCounter;
-            const Value& left = registerFile[code->m_srcIndex0];
-            const Value& right = registerFile[code->m_srcIndex1];
-            bool result = binaryInOperation(*state, left, right);
-            registerFile[code->m_dstIndex] = Value(result);
+            byteCodeOperation(*state, (BinaryInOperation*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(BinaryInOperation);
             NEXT_INSTRUCTION();
         }
@@ -1215,8 +1446,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(BinaryInstanceOfOperation)
             :
         {
-            BinaryInstanceOfOperation* code = (BinaryInstanceOfOperation*)programCounter;
-            instanceOfOperation(*state, code, registerFile);
+            byteCodeOperation(*state, (BinaryInstanceOfOperation*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(BinaryInstanceOfOperation);
             NEXT_INSTRUCTION();
         }
@@ -1252,8 +1482,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(CallFunctionComplexCase)
             :
         {
-            CallFunctionComplexCase* code = (CallFunctionComplexCase*)programCounter;
-            callFunctionComplexCase(*state, code, registerFile, byteCodeBlock);
+            byteCodeOperation(*state, (CallFunctionComplexCase*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(CallFunctionComplexCase);
             NEXT_INSTRUCTION();
         }
@@ -1358,8 +1587,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(ResolveNameAddress)
             :
         {
-            ResolveNameAddress* code = (ResolveNameAddress*)programCounter;
-            resolveNameAddress(*state, code, registerFile);
+            byteCodeOperation(*state, (ResolveNameAddress*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(ResolveNameAddress);
             NEXT_INSTRUCTION();
         }
@@ -1367,8 +1595,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(StoreByNameWithAddress)
             :
         {
-            StoreByNameWithAddress* code = (StoreByNameWithAddress*)programCounter;
-            storeByNameWithAddress(*state, code, registerFile);
+            byteCodeOperation(*state, (StoreByNameWithAddress*)programCounter, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(StoreByNameWithAddress);
             NEXT_INSTRUCTION();
         }
@@ -1408,7 +1635,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
 
 #if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
 FillOpcodeTableLbl:
-#if defined(ENABLE_CODE_CACHE)
+#if defined(ENABLE_OPCODE_MAP)
 #define REGISTER_TABLE(opcode, pushCount, popCount)                     \
     g_opcodeTable.m_addressTable[opcode##Opcode] = &&opcode##OpcodeLbl; \
     g_opcodeTable.m_opcodeMap.insert(std::make_pair(&&opcode##OpcodeLbl, (size_t)opcode##Opcode));
@@ -1424,6 +1651,188 @@ FillOpcodeTableLbl:
     return Value();
 }
 
+ALWAYS_INLINE Value ByteCodeInterpreter::getGlobalVariable(ExecutionState& state, GlobalVariableAccessCacheItem* slot, ByteCodeBlock* block)
+{
+    Context* ctx = state.context();
+    GlobalObject* globalObject = ctx->globalObject();
+    auto idx = slot->m_lexicalIndexCache;
+
+    if (LIKELY(idx != std::numeric_limits<size_t>::max())) {
+        if (LIKELY(ctx->globalDeclarativeStorage()->size() == slot->m_lexicalIndexCache && globalObject->structure() == slot->m_cachedStructure)) {
+            ASSERT(globalObject->m_values.data() <= slot->m_cachedAddress);
+            ASSERT(slot->m_cachedAddress < (globalObject->m_values.data() + globalObject->structure()->propertyCount()));
+            return *((ObjectPropertyValue*)slot->m_cachedAddress);
+        } else if (slot->m_cachedStructure == nullptr) {
+            const EncodedValueVectorElement& val = ctx->globalDeclarativeStorage()->at(idx);
+            if (UNLIKELY(val.isEmpty())) {
+                ErrorObject::throwBuiltinError(state, ErrorObject::ReferenceError, ctx->globalDeclarativeRecord()->at(idx).m_name.string(), false, String::emptyString, ErrorObject::Messages::IsNotInitialized);
+            }
+            return val;
+        }
+    }
+
+    return getGlobalVariableSlowCase(state, globalObject, slot, block);
+}
+
+ALWAYS_INLINE void ByteCodeInterpreter::setGlobalVariable(ExecutionState& state, GlobalVariableAccessCacheItem* slot, const Value& value, ByteCodeBlock* block)
+{
+    Context* ctx = state.context();
+    GlobalObject* globalObject = ctx->globalObject();
+    auto idx = slot->m_lexicalIndexCache;
+
+    if (LIKELY(idx != std::numeric_limits<size_t>::max())) {
+        if (LIKELY(ctx->globalDeclarativeStorage()->size() == slot->m_lexicalIndexCache && globalObject->structure() == slot->m_cachedStructure)) {
+            ASSERT(globalObject->m_values.data() <= slot->m_cachedAddress);
+            ASSERT(slot->m_cachedAddress < (globalObject->m_values.data() + globalObject->structure()->propertyCount()));
+            *((ObjectPropertyValue*)slot->m_cachedAddress) = value;
+            return;
+        } else if (slot->m_cachedStructure == nullptr) {
+            const auto& record = ctx->globalDeclarativeRecord()->at(idx);
+            auto& storage = ctx->globalDeclarativeStorage()->at(idx);
+            if (UNLIKELY(storage.isEmpty())) {
+                ErrorObject::throwBuiltinError(state, ErrorObject::ReferenceError, record.m_name.string(), false, String::emptyString, ErrorObject::Messages::IsNotInitialized);
+            }
+            if (UNLIKELY(!record.m_isMutable)) {
+                ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, record.m_name.string(), false, String::emptyString, ErrorObject::Messages::AssignmentToConstantVariable);
+            }
+            storage = value;
+            return;
+        }
+    }
+
+    setGlobalVariableSlowCase(state, globalObject, slot, value, block);
+}
+
+#if defined(ENABLE_JIT)
+intptr_t ByteCodeInterpreter::jitGetObjectPreComputedCaseCacheHit(JITContext* context, GetObjectPreComputedCase* code, Object* obj, size_t cachedIndex)
+{
+#if defined(ENABLE_IC_STATISTICS)
+    code->m_statistics.m_accessCount++;
+#endif
+    try {
+        Value* registerFile = context->m_registerFile;
+        registerFile[code->m_storeRegisterIndex] = obj->getOwnPropertyUtilForObject(*context->m_state, cachedIndex, Value(obj));
+        return 0;
+    } catch (...) {
+        context->m_exception = std::current_exception();
+        return JIT_OPERATION_EXCEPTION_THROWN;
+    }
+}
+
+template <typename CodeType>
+intptr_t ByteCodeInterpreter::jitOperationFor(JITContext* context, ByteCode* code)
+{
+    // exceptions should not unwind machine code of JIT
+    try {
+        byteCodeOperation(*context->m_state, (CodeType*)code, context->m_registerFile, context->m_byteCodeBlock);
+        return 0;
+    } catch (...) {
+        context->m_exception = std::current_exception();
+        return JIT_OPERATION_EXCEPTION_THROWN;
+    }
+}
+
+template <typename CodeType>
+intptr_t ByteCodeInterpreter::jitJumpOperationFor(JITContext* context, ByteCode* code)
+{
+    try {
+        return shouldJump(*context->m_state, (CodeType*)code, context->m_registerFile) ? 1 : 0;
+    } catch (...) {
+        context->m_exception = std::current_exception();
+        return JIT_OPERATION_EXCEPTION_THROWN;
+    }
+}
+
+#define FOR_EACH_JIT_OPERATION(F)                 \
+    F(BinaryPlus)                                 \
+    F(BinaryMinus)                                \
+    F(BinaryMultiply)                             \
+    F(BinaryDivision)                             \
+    F(BinaryMod)                                  \
+    F(BinaryExponentiation)                       \
+    F(BinaryEqual)                                \
+    F(BinaryNotEqual)                             \
+    F(BinaryStrictEqual)                          \
+    F(BinaryNotStrictEqual)                       \
+    F(BinaryLessThan)                             \
+    F(BinaryLessThanOrEqual)                      \
+    F(BinaryGreaterThan)                          \
+    F(BinaryGreaterThanOrEqual)                   \
+    F(BinaryBitwiseAnd)                           \
+    F(BinaryBitwiseOr)                            \
+    F(BinaryBitwiseXor)                           \
+    F(BinaryLeftShift)                            \
+    F(BinarySignedRightShift)                     \
+    F(BinaryUnsignedRightShift)                   \
+    F(BinaryInOperation)                          \
+    F(BinaryInstanceOfOperation)                  \
+    F(UnaryMinus)                                 \
+    F(UnaryNot)                                   \
+    F(UnaryBitwiseNot)                            \
+    F(UnaryTypeof)                                \
+    F(ToNumber)                                   \
+    F(Increment)                                  \
+    F(Decrement)                                  \
+    F(ToNumericIncrement)                         \
+    F(ToNumericDecrement)                         \
+    F(GetObject)                                  \
+    F(SetObjectOperation)                         \
+    F(GetObjectPreComputedCase)                   \
+    F(SetObjectPreComputedCase)                   \
+    F(GetGlobalVariable)                          \
+    F(SetGlobalVariable)                          \
+    F(InitializeGlobalVariable)                   \
+    F(LoadByName)                                 \
+    F(StoreByName)                                \
+    F(InitializeByName)                           \
+    F(LoadByHeapIndex)                            \
+    F(StoreByHeapIndex)                           \
+    F(InitializeByHeapIndex)                      \
+    F(ResolveNameAddress)                         \
+    F(StoreByNameWithAddress)                     \
+    F(GetParameter)                               \
+    F(LoadThisBinding)                            \
+    F(CallFunction)                               \
+    F(CallFunctionWithReceiver)                   \
+    F(CallFunctionComplexCase)                    \
+    F(NewOperation)                               \
+    F(CreateObject)                               \
+    F(CreateArray)                                \
+    F(CreateFunction)                             \
+    F(ObjectDefineOwnPropertyOperation)           \
+    F(ObjectDefineOwnPropertyWithNameOperation)   \
+    F(ArrayDefineOwnPropertyOperation)            \
+    F(TemplateOperation)                          \
+    F(ThrowOperation)
+
+#define FOR_EACH_JIT_JUMP_OPERATION(F) \
+    F(JumpIfTrue)                      \
+    F(JumpIfFalse)                     \
+    F(JumpIfNotFulfilled)              \
+    F(JumpIfEqual)
+
+ByteCodeInterpreter::JITOperation ByteCodeInterpreter::jitOperation(size_t opcode)
+{
+    switch (opcode) {
+#define RETURN_JIT_OPERATION(name) \
+    case name##Opcode:             \
+        return &jitOperationFor<name>;
+        FOR_EACH_JIT_OPERATION(RETURN_JIT_OPERATION)
+#undef RETURN_JIT_OPERATION
+#define RETURN_JIT_JUMP_OPERATION(name) \
+    case name##Opcode:                  \
+        return &jitJumpOperationFor<name>;
+        FOR_EACH_JIT_JUMP_OPERATION(RETURN_JIT_JUMP_OPERATION)
+#undef RETURN_JIT_JUMP_OPERATION
+    default:
+        return nullptr;
+    }
+}
+
+#undef FOR_EACH_JIT_OPERATION
+#undef FOR_EACH_JIT_JUMP_OPERATION
+#endif // ENABLE_JIT
+
 NEVER_INLINE EnvironmentRecord* ByteCodeInterpreter::getBindedEnvironmentRecordByName(ExecutionState& state, LexicalEnvironment* env, const AtomicString& name, Value& bindedValue, bool throwException)
 {
     while (env) {
@@ -2028,6 +2437,9 @@ NEVER_INLINE bool ByteCodeInterpreter::abstractLeftIsLessThanEqualRightSlowCase(
 
 ALWAYS_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperation(ExecutionState& state, Object* obj, const Value& receiver, GetObjectPreComputedCase* code, ByteCodeBlock* block)
 {
+#if defined(ENABLE_IC_STATISTICS)
+    code->m_statistics.m_accessCount++;
+#endif
     Object* orgObj = obj;
     if (LIKELY(code->m_inlineCache != nullptr)) {
         auto inlineCache = code->m_inlineCache;
@@ -2078,12 +2490,99 @@ ALWAYS_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperation(Execu
     return getObjectPrecomputedCaseOperationCacheMiss(state, orgObj, receiver, code, block);
 }
 
+#if !defined(ESCARGOT_SMALL_CONFIG)
+NEVER_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperationWithMegamorphicCache(ExecutionState& state, Object* obj, const Value& receiver, const ObjectStructurePropertyName& propertyName)
+{
+    // exotic objects can have own properties out of structure
+    if (UNLIKELY(!obj->isInlineCacheable())) {
+        return obj->get(state, ObjectPropertyName(state, propertyName)).value(state, receiver);
+    }
+
+    GetObjectMegamorphicCache::Entry& entry = state.context()->vmInstance()->getObjectMegamorphicCache()->entry(obj->structure(), propertyName);
+
+    if (entry.m_propertyName == propertyName.rawValue()) {
+        Object* holder = obj;
+        const size_t cSiz = entry.m_cachedhiddenClassChainLength - 1;
+        size_t i = 0;
+        for (; i < cSiz; i++) {
+            if (entry.m_cachedhiddenClassChain[i] != holder->structure()) {
+                break;
+            }
+            holder = holder->Object::getPrototypeObject(state);
+            if (!holder) {
+                break;
+            }
+        }
+
+        if (i == cSiz && entry.m_cachedhiddenClassChain[cSiz] == holder->structure()) {
+            // cache hit!
+#if defined(ENABLE_IC_STATISTICS)
+            state.context()->vmInstance()->inlineCacheStatistics().m_megamorphicCacheHitCount++;
+#endif
+            size_t cachedIndex = entry.m_cachedIndex;
+            if (LIKELY(cachedIndex != SIZE_MAX)) {
+                return holder->getOwnPropertyUtilForObject(state, cachedIndex, receiver);
+            } else {
+                return Value();
+            }
+        }
+    }
+
+#if defined(ENABLE_IC_STATISTICS)
+    state.context()->vmInstance()->inlineCacheStatistics().m_megamorphicCacheMissCount++;
+#endif
+
+    ObjectStructure* cachedhiddenClassChain[GET_OBJECT_MEGAMORPHIC_CACHE_MAX_CHAIN_LENGTH];
+    size_t cachedhiddenClassChainLength = 0;
+    size_t cachedIndex;
+    Object* holder = obj;
+    while (true) {
+        if (UNLIKELY(cachedhiddenClassChainLength == GET_OBJECT_MEGAMORPHIC_CACHE_MAX_CHAIN_LENGTH)) {
+            return obj->get(state, ObjectPropertyName(state, propertyName)).value(state, receiver);
+        }
+
+        auto s = holder->structure();
+        cachedhiddenClassChain[cachedhiddenClassChainLength++] = s;
+        auto result = s->findProperty(propertyName);
+        if (result.first != SIZE_MAX) {
+            cachedIndex = result.first;
+            break;
+        }
+
+        holder = holder->Object::getPrototypeObject(state);
+        if (!holder) {
+            cachedIndex = SIZE_MAX;
+            break;
+        }
+
+        if (UNLIKELY(!holder->isInlineCacheable())) {
+            return obj->get(state, ObjectPropertyName(state, propertyName)).value(state, receiver);
+        }
+    }
+
+    entry.m_propertyName = propertyName.rawValue();
+    memcpy(entry.m_cachedhiddenClassChain, cachedhiddenClassChain, sizeof(ObjectStructure*) * cachedhiddenClassChainLength);
+    entry.m_cachedhiddenClassChainLength = cachedhiddenClassChainLength;
+    entry.m_cachedIndex = cachedIndex;
+
+    if (cachedIndex != SIZE_MAX) {
+        return holder->getOwnPropertyUtilForObject(state, cachedIndex, receiver);
+    } else {
+        return Value();
+    }
+}
+#endif
+
 NEVER_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperationCacheMiss(ExecutionState& state, Object* obj, const Value& receiver, GetObjectPreComputedCase* code, ByteCodeBlock* block)
 {
     if (code->m_isLength && obj->isArrayObject()) {
         return Value(obj->asArrayObject()->arrayLength(state));
     }
 
+#if defined(ENABLE_IC_STATISTICS)
+    code->m_statistics.m_missCount++;
+#endif
+
 #if defined(ESCARGOT_SMALL_CONFIG)
     return obj->get(state, ObjectPropertyName(state, code->m_propertyName)).value(state, receiver);
 #endif
@@ -2094,7 +2593,7 @@ NEVER_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperationCacheMi
 
     // cache miss.
     if (code->m_cacheMissCount > maxCacheMissCount) {
-        return obj->get(state, ObjectPropertyName(state, code->m_propertyName)).value(state, receiver);
+        return getObjectPrecomputedCaseOperationWithMegamorphicCache(state, obj, receiver, code->m_propertyName);
     }
 
     code->m_cacheMissCount++;
@@ -2108,10 +2607,11 @@ NEVER_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperationCacheMi
     }
 
     if (UNLIKELY(code->m_cacheMissCount == maxCacheMissCount)) {
+        // this site is megamorphic. use VM-wide cache from now on
         if (code->m_inlineCache) {
             code->m_inlineCache->m_cache.clear();
         }
-        return obj->get(state, ObjectPropertyName(state, code->m_propertyName)).value(state, receiver);
+        return getObjectPrecomputedCaseOperationWithMegamorphicCache(state, obj, receiver, code->m_propertyName);
     }
 
     auto& currentCodeSizeTotal = state.context()->vmInstance()->compiledByteCodeSize();
@@ -2126,7 +2626,7 @@ NEVER_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperationCacheMi
     auto inlineCache = code->m_inlineCache;
 
     if (inlineCache->m_cache.size() > maxCacheCount) {
-        return obj->get(state, ObjectPropertyName(state, code->m_propertyName)).value(state, receiver);
+        return getObjectPrecomputedCaseOperationWithMegamorphicCache(state, obj, receiver, code->m_propertyName);
     }
 
     Object* orgObj = obj;
@@ -2180,6 +2680,9 @@ NEVER_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperationCacheMi
 
 ALWAYS_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperation(ExecutionState& state, const Value& willBeObject, const Value& value, SetObjectPreComputedCase* code, ByteCodeBlock* block)
 {
+#if defined(ENABLE_IC_STATISTICS)
+    code->m_statistics.m_accessCount++;
+#endif
     Object* obj;
     if (UNLIKELY(!willBeObject.isObject())) {
         obj = willBeObject.toObject(state);
@@ -2221,7 +2724,7 @@ ALWAYS_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperation(Execut
                 // cache hit!
                 obj = originalObject;
                 ASSERT(obj->structure()->inTransitionMode());
-                obj->m_values.push_back(value, inlineCache->m_hiddenClassWillBe->propertyCount());
+                obj->pushBackPropertyValue(value, inlineCache->m_hiddenClassWillBe->propertyCount());
                 obj->m_structure = inlineCache->m_hiddenClassWillBe;
                 return;
             }
@@ -2240,6 +2743,10 @@ NEVER_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperationCacheMis
         return;
     }
 
+#if defined(ENABLE_IC_STATISTICS)
+    code->m_statistics.m_missCount++;
+#endif
+
 #if defined(ESCARGOT_SMALL_CONFIG)
     originalObject->markThisObjectDontNeedStructureTransitionTable();
     originalObject->setThrowsExceptionWhenStrictMode(state, ObjectPropertyName(state, code->m_propertyName), value, willBeObject);
@@ -3274,7 +3781,7 @@ NEVER_INLINE void ByteCodeInterpreter::spreadFunctionArguments(ExecutionState& s
             ArrayObject* spreadArray = arg.asObject()->asArrayObject();
             ASSERT(spreadArray->isFastModeArray());
             for (size_t i = 0; i < spreadArray->arrayLength(state); i++) {
-                argVector.push_back(spreadArray->m_fastModeData[i]);
+                argVector.push_back(spreadArray->fastModeArrayValue(i));
             }
         } else {
             argVector.push_back(arg);
@@ -3493,7 +4000,7 @@ NEVER_INLINE void ByteCodeInterpreter::arrayDefineOwnPropertyOperation(Execution
     if (LIKELY(arr->isFastModeArray())) {
         for (size_t i = 0; i < code->m_count; i++) {
             if (LIKELY(code->m_loadRegisterIndexs[i] != REGISTER_LIMIT)) {
-                arr->m_fastModeData[i + code->m_baseIndex] = registerFile[code->m_loadRegisterIndexs[i]];
+                arr->setFastModeArrayValueWithoutExpanding(state, i + code->m_baseIndex, registerFile[code->m_loadRegisterIndexs[i]]);
             }
         }
     } else {
@@ -3534,11 +4041,11 @@ NEVER_INLINE void ByteCodeInterpreter::arrayDefineOwnPropertyBySpreadElementOper
                     ArrayObject* spreadArray = element.asObject()->asArrayObject();
                     ASSERT(spreadArray->isFastModeArray());
                     for (size_t spreadIndex = 0; spreadIndex < spreadArray->arrayLength(state); spreadIndex++) {
-                        arr->m_fastModeData[baseIndex + elementIndex] = spreadArray->m_fastModeData[spreadIndex];
+                        arr->setFastModeArrayValueWithoutExpanding(state, baseIndex + elementIndex, spreadArray->fastModeArrayValue(spreadIndex));
                         elementIndex++;
                     }
                 } else {
-                    arr->m_fastModeData[baseIndex + elementIndex] = element;
+                    arr->setFastModeArrayValueWithoutExpanding(state, baseIndex + elementIndex, element);
                     elementIndex++;
                 }
             } else {
@@ -3566,7 +4073,7 @@ NEVER_INLINE void ByteCodeInterpreter::arrayDefineOwnPropertyBySpreadElementOper
                     ASSERT(spreadArray->isFastModeArray());
                     Value spreadElement;
                     for (size_t spreadIndex = 0; spreadIndex < spreadArray->arrayLength(state); spreadIndex++) {
-                        spreadElement = spreadArray->m_fastModeData[spreadIndex];
+                        spreadElement = spreadArray->fastModeArrayValue(spreadIndex);
                         arr->defineOwnProperty(state, ObjectPropertyName(state, baseIndex + elementIndex), ObjectPropertyDescriptor(spreadElement, ObjectPropertyDescriptor::AllPresent));
                         elementIndex++;
                     }
@@ -33,6 +33,7 @@ class LexicalEnvironment;
 class GetObjectPreComputedCase;
 class SetObjectPreComputedCase;
 struct GetObjectInlineCache;
+class ObjectStructurePropertyName;
 struct SetObjectInlineCache;
 struct GlobalVariableAccessCacheItem;
 class InitializeGlobalVariable;
@@ -67,11 +68,23 @@ class EnumerateObject;
 class CheckLastEnumerateKey;
 class TaggedTemplateOperation;
 class MarkEnumerateKey;
+#if defined(ENABLE_JIT)
+class ByteCode;
+struct JITContext;
+#endif
 
 class ByteCodeInterpreter {
 public:
     static Value interpret(ExecutionState* state, ByteCodeBlock* byteCodeBlock, size_t programCounter, Value* registerFile);
 
+#if defined(ENABLE_JIT)
+    typedef intptr_t (*JITOperation)(JITContext* context, ByteCode* code);
+    // returns operation which JIT code calls to run `opcode`, or nullptr if the opcode is not supported.
+    // operations return JIT_OPERATION_EXCEPTION_THROWN on exception and jump bytecodes return 1 when the jump is taken
+    static JITOperation jitOperation(size_t opcode);
+    static intptr_t jitGetObjectPreComputedCaseCacheHit(JITContext* context, GetObjectPreComputedCase* code, Object* obj, size_t cachedIndex);
+#endif
+
 private:
     static Value loadByName(ExecutionState& state, LexicalEnvironment* env, const AtomicString& name, bool throwException = true);
     static EnvironmentRecord* getBindedEnvironmentRecordByName(ExecutionState& state, LexicalEnvironment* env, const AtomicString& name, Value& bindedValue, bool throwException = true);
@@ -112,12 +125,15 @@ private:
 
     static Value getObjectPrecomputedCaseOperation(ExecutionState& state, Object* obj, const Value& receiver, GetObjectPreComputedCase* code, ByteCodeBlock* block);
     static Value getObjectPrecomputedCaseOperationCacheMiss(ExecutionState& state, Object* obj, const Value& receiver, GetObjectPreComputedCase* code, ByteCodeBlock* block);
+    static Value getObjectPrecomputedCaseOperationWithMegamorphicCache(ExecutionState& state, Object* obj, const Value& receiver, const ObjectStructurePropertyName& propertyName);
     static void setObjectPreComputedCaseOperation(ExecutionState& state, const Value& willBeObject, const Value& value, SetObjectPreComputedCase* code, ByteCodeBlock* block);
     static void setObjectPreComputedCaseOperationCacheMiss(ExecutionState& state, Object* obj, const Value& willBeObject, const Value& value, SetObjectPreComputedCase* code, ByteCodeBlock* block);
 
     static Object* fastToObject(ExecutionState& state, const Value& obj);
 
+    static Value getGlobalVariable(ExecutionState& state, GlobalVariableAccessCacheItem* slot, ByteCodeBlock* block);
     static Value getGlobalVariableSlowCase(ExecutionState& state, Object* go, GlobalVariableAccessCacheItem* slot, ByteCodeBlock* block);
+    static void setGlobalVariable(ExecutionState& state, GlobalVariableAccessCacheItem* slot, const Value& value, ByteCodeBlock* block);
     static void setGlobalVariableSlowCase(ExecutionState& state, Object* go, GlobalVariableAccessCacheItem* slot, const Value& value, ByteCodeBlock* block);
     static void initializeGlobalVariable(ExecutionState& state, InitializeGlobalVariable* code, const Value& value);
 
@@ -171,6 +187,20 @@ private:
     static void taggedTemplateOperation(ExecutionState& state, size_t& programCounter, Value* registerFile, char* codeBuffer, ByteCodeBlock* byteCodeBlock);
 
     static void ensureArgumentsObjectOperation(ExecutionState& state, ByteCodeBlock* byteCodeBlock, Value* registerFile);
+
+    // body of a bytecode which interpret and JIT operations share. specialized for each bytecode in ByteCodeInterpreter.cpp
+    template <typename CodeType>
+    static void byteCodeOperation(ExecutionState& state, CodeType* code, Value* registerFile, ByteCodeBlock* byteCodeBlock);
+    // returns true if conditional jump bytecode should jump
+    template <typename CodeType>
+    static bool shouldJump(ExecutionState& state, CodeType* code, Value* registerFile);
+
+#if defined(ENABLE_JIT)
+    template <typename CodeType>
+    static intptr_t jitOperationFor(JITContext* context, ByteCode* code);
+    template <typename CodeType>
+    static intptr_t jitJumpOperationFor(JITContext* context, ByteCode* code);
+#endif
 };
 } // namespace Escargot
 
@@ -0,0 +1,1145 @@
+/*
+ * Copyright (c) 2021-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#if defined(ENABLE_BYTECODE_OPTIMIZER)
+
+#include "Escargot.h"
+#include "interpreter/ByteCodeOptimizer.h"
+#include "interpreter/ByteCode.h"
+#include "interpreter/ByteCodeGenerator.h"
+
+namespace Escargot {
+
+// fused bytecodes are written over the compare bytecode
+COMPILE_ASSERT(sizeof(JumpIfNotFulfilled) <= sizeof(BinaryLessThan) + sizeof(JumpIfFalse), "");
+COMPILE_ASSERT(sizeof(JumpIfEqual) <= sizeof(BinaryEqual) + sizeof(JumpIfFalse), "");
+// a jump to End is replaced with End itself
+COMPILE_ASSERT(sizeof(End) <= sizeof(Jump), "");
+
+// number of bytecodes visited to prove that a register is dead
+#define BYTECODE_OPTIMIZER_LIVENESS_BUDGET 256
+// number of bytecodes scanned to propagate a copy
+#define BYTECODE_OPTIMIZER_PROPAGATION_WINDOW 32
+// number of registers newly allocated for hoisted literals
+#define BYTECODE_OPTIMIZER_HOISTED_LITERAL_LIMIT 8
+// number of jumps followed when threading a jump
+#define BYTECODE_OPTIMIZER_THREADING_LIMIT 8
+
+static Opcode opcodeOf(ByteCode* code)
+{
+#if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
+    return (Opcode)(size_t)code->m_opcodeInAddress;
+#else
+    return code->m_opcode;
+#endif
+}
+
+static bool isJumpOpcode(Opcode opcode)
+{
+    switch (opcode) {
+    case JumpOpcode:
+    case JumpIfTrueOpcode:
+    case JumpIfFalseOpcode:
+    case JumpIfUndefinedOrNullOpcode:
+    case JumpIfNotFulfilledOpcode:
+    case JumpIfEqualOpcode:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static size_t& jumpPositionOf(ByteCode* code, Opcode opcode)
+{
+    ASSERT(isJumpOpcode(opcode));
+    if (opcode == JumpOpcode) {
+        return ((Jump*)code)->m_jumpPosition;
+    }
+    return ((JumpByteCode*)code)->m_jumpPosition;
+}
+
+// bytecodes which leave the function
+static bool isTerminalOpcode(Opcode opcode)
+{
+    switch (opcode) {
+    case EndOpcode:
+    case ReturnFunctionSlowCaseOpcode:
+    case ThrowOperationOpcode:
+    case ThrowStaticErrorOperationOpcode:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// bytecodes which only compute their destination register from the source registers
+static bool isProducerOpcode(Opcode opcode)
+{
+    switch (opcode) {
+    case BinaryPlusOpcode:
+    case BinaryMinusOpcode:
+    case BinaryMultiplyOpcode:
+    case BinaryDivisionOpcode:
+    case BinaryModOpcode:
+    case BinaryExponentiationOpcode:
+    case BinaryEqualOpcode:
+    case BinaryNotEqualOpcode:
+    case BinaryStrictEqualOpcode:
+    case BinaryNotStrictEqualOpcode:
+    case BinaryLessThanOpcode:
+    case BinaryLessThanOrEqualOpcode:
+    case BinaryGreaterThanOpcode:
+    case BinaryGreaterThanOrEqualOpcode:
+    case BinaryLeftShiftOpcode:
+    case BinarySignedRightShiftOpcode:
+    case BinaryUnsignedRightShiftOpcode:
+    case BinaryBitwiseAndOpcode:
+    case BinaryBitwiseOrOpcode:
+    case BinaryBitwiseXorOpcode:
+    case BinaryInOperationOpcode:
+    case BinaryInstanceOfOperationOpcode:
+    case LoadLiteralOpcode:
+    case LoadByNameOpcode:
+    case LoadByHeapIndexOpcode:
+    case GetObjectOpcode:
+    case GetObjectPreComputedCaseOpcode:
+    case GetGlobalVariableOpcode:
+    case MoveOpcode:
+    case IncrementOpcode:
+    case DecrementOpcode:
+    case ToNumberOpcode:
+    case UnaryMinusOpcode:
+    case UnaryNotOpcode:
+    case UnaryBitwiseNotOpcode:
+    case UnaryTypeofOpcode:
+    case TemplateOperationOpcode:
+    case CallFunctionOpcode:
+    case CallFunctionWithReceiverOpcode:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// registers read and written by a bytecode
+// every bytecode listed here reads all of its source registers before it writes its destination register
+struct RegisterOperands {
+    RegisterOperands()
+        : m_readCount(0)
+        , m_writeCount(0)
+        , m_readRangeStart(0)
+        , m_readRangeLength(0)
+        , m_fixedRead(REGISTER_LIMIT)
+    {
+    }
+
+    void read(ByteCodeRegisterIndex& index)
+    {
+        ASSERT(m_readCount < ARRAY_DEFINE_OPERATION_MERGE_COUNT + 1);
+        m_reads[m_readCount++] = &index;
+    }
+
+    // read of a register index which can not be rewritten (e.g. stored in a bit field)
+    void readFixed(ByteCodeRegisterIndex index)
+    {
+        m_fixedRead = index;
+    }
+
+    void write(ByteCodeRegisterIndex& index)
+    {
+        ASSERT(m_writeCount < 1);
+        m_writes[m_writeCount++] = &index;
+    }
+
+    void readRange(size_t start, size_t length)
+    {
+        m_readRangeStart = start;
+        m_readRangeLength = length;
+    }
+
+    // reads which can not be rewritten
+    bool readsInRange(ByteCodeRegisterIndex index) const
+    {
+        return (index >= m_readRangeStart && index < m_readRangeStart + m_readRangeLength) || index == m_fixedRead;
+    }
+
+    bool reads(ByteCodeRegisterIndex index) const
+    {
+        for (size_t i = 0; i < m_readCount; i++) {
+            if (*m_reads[i] == index) {
+                return true;
+            }
+        }
+        return readsInRange(index);
+    }
+
+    bool writes(ByteCodeRegisterIndex index) const
+    {
+        return m_writeCount && *m_writes[0] == index;
+    }
+
+    ByteCodeRegisterIndex* m_reads[ARRAY_DEFINE_OPERATION_MERGE_COUNT + 1];
+    ByteCodeRegisterIndex* m_writes[1];
+    size_t m_readCount;
+    size_t m_writeCount;
+    size_t m_readRangeStart;
+    size_t m_readRangeLength;
+    ByteCodeRegisterIndex m_fixedRead;
+};
+
+#define DESCRIBE_SRC_DST_OPERATION(CodeName)        \
+    case CodeName##Opcode: {                        \
+        CodeName* cd = (CodeName*)code;             \
+        operands.read(cd->m_srcIndex);              \
+        operands.write(cd->m_dstIndex);             \
+        return true;                                \
+    }
+
+// returns false if the bytecode is not known to the optimizer
+static bool describeOperands(ByteCode* code, Opcode opcode, RegisterOperands& operands)
+{
+    switch (opcode) {
+    case LoadLiteralOpcode:
+        operands.write(((LoadLiteral*)code)->m_registerIndex);
+        return true;
+    case LoadByNameOpcode:
+        operands.write(((LoadByName*)code)->m_registerIndex);
+        return true;
+    case StoreByNameOpcode:
+        operands.read(((StoreByName*)code)->m_registerIndex);
+        return true;
+    case LoadByHeapIndexOpcode:
+        operands.write(((LoadByHeapIndex*)code)->m_registerIndex);
+        return true;
+    case StoreByHeapIndexOpcode:
+        operands.read(((StoreByHeapIndex*)code)->m_registerIndex);
+        return true;
+    case BinaryPlusOpcode:
+    case BinaryMinusOpcode:
+    case BinaryMultiplyOpcode:
+    case BinaryDivisionOpcode:
+    case BinaryModOpcode:
+    case BinaryExponentiationOpcode:
+    case BinaryEqualOpcode:
+    case BinaryNotEqualOpcode:
+    case BinaryStrictEqualOpcode:
+    case BinaryNotStrictEqualOpcode:
+    case BinaryLessThanOpcode:
+    case BinaryLessThanOrEqualOpcode:
+    case BinaryGreaterThanOpcode:
+    case BinaryGreaterThanOrEqualOpcode:
+    case BinaryLeftShiftOpcode:
+    case BinarySignedRightShiftOpcode:
+    case BinaryUnsignedRightShiftOpcode:
+    case BinaryBitwiseAndOpcode:
+    case BinaryBitwiseOrOpcode:
+    case BinaryBitwiseXorOpcode:
+    case BinaryInOperationOpcode:
+    case BinaryInstanceOfOperationOpcode: {
+        // every binary operation has the same layout
+        BinaryPlus* cd = (BinaryPlus*)code;
+        operands.read(cd->m_srcIndex0);
+        operands.read(cd->m_srcIndex1);
+        operands.write(cd->m_dstIndex);
+        return true;
+    }
+    case GetObjectOpcode: {
+        GetObject* cd = (GetObject*)code;
+        operands.read(cd->m_objectRegisterIndex);
+        operands.read(cd->m_propertyRegisterIndex);
+        operands.write(cd->m_storeRegisterIndex);
+        return true;
+    }
+    case SetObjectOperationOpcode: {
+        SetObjectOperation* cd = (SetObjectOperation*)code;
+        operands.read(cd->m_objectRegisterIndex);
+        operands.read(cd->m_propertyRegisterIndex);
+        operands.read(cd->m_loadRegisterIndex);
+        return true;
+    }
+    case GetObjectPreComputedCaseOpcode: {
+        GetObjectPreComputedCase* cd = (GetObjectPreComputedCase*)code;
+        operands.read(cd->m_objectRegisterIndex);
+        operands.write(cd->m_storeRegisterIndex);
+        return true;
+    }
+    case SetObjectPreComputedCaseOpcode: {
+        SetObjectPreComputedCase* cd = (SetObjectPreComputedCase*)code;
+        operands.read(cd->m_objectRegisterIndex);
+        operands.read(cd->m_loadRegisterIndex);
+        return true;
+    }
+    case ObjectDefineOwnPropertyOperationOpcode: {
+        ObjectDefineOwnPropertyOperation* cd = (ObjectDefineOwnPropertyOperation*)code;
+        operands.read(cd->m_objectRegisterIndex);
+        operands.read(cd->m_propertyRegisterIndex);
+        operands.read(cd->m_loadRegisterIndex);
+        return true;
+    }
+    case ObjectDefineOwnPropertyWithNameOperationOpcode: {
+        ObjectDefineOwnPropertyWithNameOperation* cd = (ObjectDefineOwnPropertyWithNameOperation*)code;
+        operands.read(cd->m_objectRegisterIndex);
+        operands.read(cd->m_loadRegisterIndex);
+        return true;
+    }
+    case ArrayDefineOwnPropertyOperationOpcode: {
+        ArrayDefineOwnPropertyOperation* cd = (ArrayDefineOwnPropertyOperation*)code;
+        operands.readFixed(cd->m_objectRegisterIndex);
+        for (size_t i = 0; i < cd->m_count; i++) {
+            operands.read(cd->m_loadRegisterIndexs[i]);
+        }
+        return true;
+    }
+    case GetGlobalVariableOpcode:
+        operands.write(((GetGlobalVariable*)code)->m_registerIndex);
+        return true;
+    case SetGlobalVariableOpcode:
+        operands.read(((SetGlobalVariable*)code)->m_registerIndex);
+        return true;
+    case MoveOpcode: {
+        Move* cd = (Move*)code;
+        operands.read(cd->m_registerIndex0);
+        operands.write(cd->m_registerIndex1);
+        return true;
+    }
+        DESCRIBE_SRC_DST_OPERATION(ToNumber)
+        DESCRIBE_SRC_DST_OPERATION(Increment)
+        DESCRIBE_SRC_DST_OPERATION(Decrement)
+        DESCRIBE_SRC_DST_OPERATION(UnaryMinus)
+        DESCRIBE_SRC_DST_OPERATION(UnaryNot)
+        DESCRIBE_SRC_DST_OPERATION(UnaryBitwiseNot)
+        DESCRIBE_SRC_DST_OPERATION(UnaryTypeof)
+    case TemplateOperationOpcode: {
+        TemplateOperation* cd = (TemplateOperation*)code;
+        operands.read(cd->m_src0Index);
+        operands.read(cd->m_src1Index);
+        operands.write(cd->m_dstIndex);
+        return true;
+    }
+    case JumpOpcode:
+        return true;
+    case JumpIfTrueOpcode:
+        operands.read(((JumpIfTrue*)code)->m_registerIndex);
+        return true;
+    case JumpIfFalseOpcode:
+        operands.read(((JumpIfFalse*)code)->m_registerIndex);
+        return true;
+    case JumpIfUndefinedOrNullOpcode:
+        operands.read(((JumpIfUndefinedOrNull*)code)->m_registerIndex);
+        return true;
+    case JumpIfNotFulfilledOpcode: {
+        JumpIfNotFulfilled* cd = (JumpIfNotFulfilled*)code;
+        operands.read(cd->m_leftIndex);
+        operands.read(cd->m_rightIndex);
+        return true;
+    }
+    case JumpIfEqualOpcode: {
+        JumpIfEqual* cd = (JumpIfEqual*)code;
+        operands.read(cd->m_registerIndex0);
+        operands.read(cd->m_registerIndex1);
+        return true;
+    }
+    case CallFunctionOpcode: {
+        CallFunction* cd = (CallFunction*)code;
+        operands.read(cd->m_calleeIndex);
+        operands.readRange(cd->m_argumentsStartIndex, cd->m_argumentCount);
+        operands.write(cd->m_resultIndex);
+        return true;
+    }
+    case CallFunctionWithReceiverOpcode: {
+        CallFunctionWithReceiver* cd = (CallFunctionWithReceiver*)code;
+        operands.read(cd->m_receiverIndex);
+        operands.read(cd->m_calleeIndex);
+        operands.readRange(cd->m_argumentsStartIndex, cd->m_argumentCount);
+        operands.write(cd->m_resultIndex);
+        return true;
+    }
+    case NewOperationOpcode: {
+        NewOperation* cd = (NewOperation*)code;
+        operands.read(cd->m_calleeIndex);
+        operands.readRange(cd->m_argumentsStartIndex, cd->m_argumentCount);
+        operands.write(cd->m_resultIndex);
+        return true;
+    }
+    case EndOpcode:
+        operands.read(((End*)code)->m_registerIndex);
+        return true;
+    case ReturnFunctionSlowCaseOpcode:
+        operands.read(((ReturnFunctionSlowCase*)code)->m_registerIndex);
+        return true;
+    case ThrowOperationOpcode:
+        operands.read(((ThrowOperation*)code)->m_registerIndex);
+        return true;
+    case ThrowStaticErrorOperationOpcode:
+        return true;
+    case CreateObjectOpcode:
+        operands.write(((CreateObject*)code)->m_registerIndex);
+        return true;
+    case CreateArrayOpcode:
+        operands.write(((CreateArray*)code)->m_registerIndex);
+        return true;
+    case CreateFunctionOpcode: {
+        CreateFunction* cd = (CreateFunction*)code;
+        operands.read(cd->m_homeObjectRegisterIndex);
+        operands.write(cd->m_registerIndex);
+        return true;
+    }
+    case LoadRegExpOpcode:
+        operands.write(((LoadRegExp*)code)->m_registerIndex);
+        return true;
+    case LoadThisBindingOpcode:
+        operands.write(((LoadThisBinding*)code)->m_dstIndex);
+        return true;
+    case GetParameterOpcode:
+        operands.write(((GetParameter*)code)->m_registerIndex);
+        return true;
+    default:
+        return false;
+    }
+}
+
+#undef DESCRIBE_SRC_DST_OPERATION
+
+// calls fn for every code position stored in the bytecode
+template <typename Func>
+static void forEachCodePosition(ByteCode* code, Opcode opcode, const Func& fn)
+{
+    switch (opcode) {
+    case JumpOpcode:
+    case JumpIfTrueOpcode:
+    case JumpIfFalseOpcode:
+    case JumpIfUndefinedOrNullOpcode:
+    case JumpIfNotFulfilledOpcode:
+    case JumpIfEqualOpcode:
+        fn(jumpPositionOf(code, opcode));
+        break;
+    case JumpComplexCaseOpcode: {
+        // each record is owned by one JumpComplexCase
+        ControlFlowRecord* record = ((JumpComplexCase*)code)->m_controlFlowRecord;
+        if (record->reason() == ControlFlowRecord::NeedsJump) {
+            size_t position = record->wordValue();
+            fn(position);
+            record->setWordValue(position);
+        }
+        break;
+    }
+    case TryOperationOpcode: {
+        TryOperation* cd = (TryOperation*)code;
+        fn(cd->m_catchPosition);
+        fn(cd->m_tryCatchEndPosition);
+        fn(cd->m_finallyEndPosition);
+        break;
+    }
+    case CheckLastEnumerateKeyOpcode:
+        fn(((CheckLastEnumerateKey*)code)->m_exitPosition);
+        break;
+    case WithOperationOpcode:
+        fn(((WithOperation*)code)->m_withEndPostion);
+        break;
+    case BlockOperationOpcode:
+        fn(((BlockOperation*)code)->m_blockEndPosition);
+        break;
+    case TaggedTemplateOperationOpcode: {
+        TaggedTemplateOperation* cd = (TaggedTemplateOperation*)code;
+        if (cd->m_operaton == TaggedTemplateOperation::TestCacheOperation) {
+            fn(cd->m_testCacheOperationData.m_jumpPosition);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+class ByteCodeOptimizerContext {
+public:
+    explicit ByteCodeOptimizerContext(ByteCodeBlock* block)
+        : m_block(block)
+        , m_hasTryOperation(false)
+        , m_visitGeneration(0)
+        , m_threadedJumpCount(0)
+        , m_fusedCount(0)
+        , m_removedMoveCount(0)
+    {
+    }
+
+    bool analyze();
+    void collectJumpTargets();
+    void threadJumps();
+    void fuseCompareAndBranch();
+    void coalesceMoves();
+    void propagateCopies();
+    void hoistLoopLiterals();
+    void removeUselessJumps();
+    void compact(ByteCodeLOCData* locData);
+
+#ifndef NDEBUG
+    void dump();
+    void dumpStatistics(size_t countBefore);
+#endif
+
+    size_t instructionCount()
+    {
+        size_t count = m_hoistedLiterals.size();
+        for (size_t i = 0; i < m_instructions.size(); i++) {
+            if (!m_instructions[i].m_isRemoved) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    bool hasTryOperation() const
+    {
+        return m_hasTryOperation;
+    }
+
+private:
+    struct Instruction {
+        size_t m_position;
+        size_t m_size;
+        Opcode m_opcode;
+        bool m_isRemoved;
+        bool m_isJumpTarget;
+        size_t m_visited;
+    };
+
+    ByteCode* codeAt(size_t index)
+    {
+        return (ByteCode*)(m_block->m_code.data() + m_instructions[index].m_position);
+    }
+
+    bool isTemporary(ByteCodeRegisterIndex index)
+    {
+        return index < REGULAR_REGISTER_LIMIT;
+    }
+
+    // index of the bytecode at the position. the size of the code maps to m_instructions.size()
+    size_t indexOf(size_t position)
+    {
+        size_t lo = 0, hi = m_instructions.size();
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (m_instructions[mid].m_position < position) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        ASSERT(lo == m_instructions.size() ? position == m_block->m_code.size() : m_instructions[lo].m_position == position);
+        return lo;
+    }
+
+    // first bytecode not removed from the index
+    size_t resolve(size_t index)
+    {
+        while (index < m_instructions.size() && m_instructions[index].m_isRemoved) {
+            index++;
+        }
+        return index;
+    }
+
+    size_t nextIndex(size_t index)
+    {
+        return resolve(index + 1);
+    }
+
+    size_t positionOf(size_t index)
+    {
+        return index < m_instructions.size() ? m_instructions[index].m_position : m_block->m_code.size();
+    }
+
+    void remove(size_t index)
+    {
+        m_instructions[index].m_isRemoved = true;
+        if (m_instructions[index].m_isJumpTarget) {
+            // jumps arrive at the next bytecode now
+            size_t next = nextIndex(index);
+            if (next < m_instructions.size()) {
+                m_instructions[next].m_isJumpTarget = true;
+            }
+        }
+    }
+
+    // the new bytecode can also use the space of the following removed bytecodes
+    template <typename CodeType>
+    void replace(size_t index, CodeType& code)
+    {
+#ifndef NDEBUG
+        code.m_loc = codeAt(index)->m_loc;
+#endif
+        ASSERT(m_instructions[index].m_position + sizeof(CodeType) <= positionOf(nextIndex(index)));
+        memcpy(codeAt(index), &code, sizeof(CodeType));
+        m_instructions[index].m_opcode = opcodeOf((ByteCode*)&code);
+        m_instructions[index].m_size = sizeof(CodeType);
+    }
+
+    void pushSuccessors(size_t index, std::vector<size_t>& worklist);
+    bool isDead(std::vector<size_t>& worklist, ByteCodeRegisterIndex index);
+    bool isDeadAt(size_t index, ByteCodeRegisterIndex registerIndex);
+    bool isDeadAfter(size_t index, ByteCodeRegisterIndex registerIndex);
+    bool substituteForward(size_t index, ByteCodeRegisterIndex from, ByteCodeRegisterIndex to);
+
+    ByteCodeBlock* m_block;
+    std::vector<Instruction> m_instructions;
+    std::vector<Value> m_hoistedLiterals;
+    bool m_hasTryOperation;
+    size_t m_visitGeneration;
+
+    size_t m_threadedJumpCount;
+    size_t m_fusedCount;
+    size_t m_removedMoveCount;
+};
+
+bool ByteCodeOptimizerContext::analyze()
+{
+    char* start = m_block->m_code.data();
+    char* end = start + m_block->m_code.size();
+    char* code = start;
+
+    while (code < end) {
+        Opcode opcode = opcodeOf((ByteCode*)code);
+        switch (opcode) {
+        case ExecutionPauseOpcode:
+        case ExecutionResumeOpcode:
+        case BreakpointDisabledOpcode:
+        case BreakpointEnabledOpcode:
+            // positions of generators and debugger are recorded out of the bytecode
+            return false;
+        case TryOperationOpcode:
+            m_hasTryOperation = true;
+            break;
+        default:
+            break;
+        }
+
+        Instruction instruction;
+        instruction.m_position = code - start;
+        instruction.m_size = byteCodeLengths[opcode];
+        instruction.m_opcode = opcode;
+        instruction.m_isRemoved = false;
+        instruction.m_isJumpTarget = false;
+        instruction.m_visited = 0;
+        m_instructions.push_back(instruction);
+
+        code += byteCodeLengths[opcode];
+    }
+
+    // every code position should point the start of a bytecode
+    bool isValid = true;
+    for (size_t i = 0; i < m_instructions.size() && isValid; i++) {
+        forEachCodePosition(codeAt(i), m_instructions[i].m_opcode, [&](size_t& position) {
+            if (position == SIZE_MAX) {
+                return;
+            }
+            size_t index = indexOf(position);
+            if (positionOf(index) != position) {
+                isValid = false;
+            }
+        });
+    }
+
+    return isValid;
+}
+
+void ByteCodeOptimizerContext::collectJumpTargets()
+{
+    for (size_t i = 0; i < m_instructions.size(); i++) {
+        m_instructions[i].m_isJumpTarget = false;
+    }
+
+    for (size_t i = 0; i < m_instructions.size(); i++) {
+        if (m_instructions[i].m_isRemoved) {
+            continue;
+        }
+        forEachCodePosition(codeAt(i), m_instructions[i].m_opcode, [&](size_t& position) {
+            if (position == SIZE_MAX) {
+                return;
+            }
+            size_t index = resolve(indexOf(position));
+            if (index < m_instructions.size()) {
+                m_instructions[index].m_isJumpTarget = true;
+            }
+        });
+    }
+}
+
+void ByteCodeOptimizerContext::threadJumps()
+{
+    for (size_t i = 0; i < m_instructions.size(); i++) {
+        Opcode opcode = m_instructions[i].m_opcode;
+        if (m_instructions[i].m_isRemoved || !isJumpOpcode(opcode)) {
+            continue;
+        }
+
+        ByteCode* code = codeAt(i);
+        size_t& jumpPosition = jumpPositionOf(code, opcode);
+        bool threaded = false;
+        for (size_t step = 0; step < BYTECODE_OPTIMIZER_THREADING_LIMIT; step++) {
+            size_t target = resolve(indexOf(jumpPosition));
+            if (target == m_instructions.size() || target == i) {
+                break;
+            }
+
+            ByteCode* targetCode = codeAt(target);
+            Opcode targetOpcode = m_instructions[target].m_opcode;
+            size_t newPosition;
+            if (targetOpcode == JumpOpcode) {
+                newPosition = ((Jump*)targetCode)->m_jumpPosition;
+            } else if ((opcode == JumpIfTrueOpcode || opcode == JumpIfFalseOpcode) && (targetOpcode == JumpIfTrueOpcode || targetOpcode == JumpIfFalseOpcode)
+                       && ((JumpIfTrue*)code)->m_registerIndex == ((JumpIfTrue*)targetCode)->m_registerIndex) {
+                // the condition is known at the target
+                if (opcode == targetOpcode) {
+                    newPosition = ((JumpByteCode*)targetCode)->m_jumpPosition;
+                } else {
+                    newPosition = positionOf(nextIndex(target));
+                }
+            } else {
+                break;
+            }
+
+            if (newPosition == jumpPosition) {
+                break;
+            }
+            jumpPosition = newPosition;
+            threaded = true;
+        }
+
+        if (threaded) {
+            m_threadedJumpCount++;
+        }
+    }
+}
+
+void ByteCodeOptimizerContext::pushSuccessors(size_t index, std::vector<size_t>& worklist)
+{
+    Opcode opcode = m_instructions[index].m_opcode;
+    if (isTerminalOpcode(opcode)) {
+        return;
+    }
+    if (isJumpOpcode(opcode)) {
+        worklist.push_back(indexOf(jumpPositionOf(codeAt(index), opcode)));
+    }
+    if (opcode != JumpOpcode) {
+        worklist.push_back(index + 1);
+    }
+}
+
+bool ByteCodeOptimizerContext::isDead(std::vector<size_t>& worklist, ByteCodeRegisterIndex registerIndex)
+{
+    m_visitGeneration++;
+    size_t budget = BYTECODE_OPTIMIZER_LIVENESS_BUDGET;
+
+    while (!worklist.empty()) {
+        size_t index = resolve(worklist.back());
+        worklist.pop_back();
+
+        if (index == m_instructions.size()) {
+            // falls off the end of the code
+            return false;
+        }
+        if (m_instructions[index].m_visited == m_visitGeneration) {
+            continue;
+        }
+        m_instructions[index].m_visited = m_visitGeneration;
+        if (budget-- == 0) {
+            return false;
+        }
+
+        RegisterOperands operands;
+        if (!describeOperands(codeAt(index), m_instructions[index].m_opcode, operands)) {
+            return false;
+        }
+        if (operands.reads(registerIndex)) {
+            return false;
+        }
+        if (operands.writes(registerIndex)) {
+            continue;
+        }
+        pushSuccessors(index, worklist);
+    }
+
+    return true;
+}
+
+bool ByteCodeOptimizerContext::isDeadAt(size_t index, ByteCodeRegisterIndex registerIndex)
+{
+    std::vector<size_t> worklist;
+    worklist.push_back(index);
+    return isDead(worklist, registerIndex);
+}
+
+bool ByteCodeOptimizerContext::isDeadAfter(size_t index, ByteCodeRegisterIndex registerIndex)
+{
+    std::vector<size_t> worklist;
+    pushSuccessors(index, worklist);
+    return isDead(worklist, registerIndex);
+}
+
+void ByteCodeOptimizerContext::fuseCompareAndBranch()
+{
+    for (size_t i = 0; i < m_instructions.size(); i++) {
+        if (m_instructions[i].m_isRemoved) {
+            continue;
+        }
+
+        Opcode opcode = m_instructions[i].m_opcode;
+        switch (opcode) {
+        case BinaryLessThanOpcode:
+        case BinaryLessThanOrEqualOpcode:
+        case BinaryGreaterThanOpcode:
+        case BinaryGreaterThanOrEqualOpcode:
+        case BinaryEqualOpcode:
+        case BinaryNotEqualOpcode:
+        case BinaryStrictEqualOpcode:
+        case BinaryNotStrictEqualOpcode:
+            break;
+        default:
+            continue;
+        }
+
+        size_t next = nextIndex(i);
+        if (next == m_instructions.size() || m_instructions[next].m_isJumpTarget) {
+            continue;
+        }
+        Opcode jumpOpcode = m_instructions[next].m_opcode;
+        if (jumpOpcode != JumpIfTrueOpcode && jumpOpcode != JumpIfFalseOpcode) {
+            continue;
+        }
+
+        BinaryLessThan* compare = (BinaryLessThan*)codeAt(i);
+        JumpIfTrue* jump = (JumpIfTrue*)codeAt(next);
+        ByteCodeRegisterIndex src0 = compare->m_srcIndex0;
+        ByteCodeRegisterIndex src1 = compare->m_srcIndex1;
+        bool jumpIfTrue = jumpOpcode == JumpIfTrueOpcode;
+
+        if (jump->m_registerIndex != compare->m_dstIndex || !isTemporary(compare->m_dstIndex)) {
+            continue;
+        }
+        // JumpIfNotFulfilled can not express the relational compare being true
+        bool isRelational = opcode == BinaryLessThanOpcode || opcode == BinaryLessThanOrEqualOpcode || opcode == BinaryGreaterThanOpcode || opcode == BinaryGreaterThanOrEqualOpcode;
+        if (isRelational && jumpIfTrue) {
+            continue;
+        }
+        if (!isDeadAfter(next, compare->m_dstIndex)) {
+            continue;
+        }
+
+        size_t jumpPosition = jump->m_jumpPosition;
+        remove(next);
+        if (isRelational) {
+            bool containEqual = opcode == BinaryLessThanOrEqualOpcode || opcode == BinaryGreaterThanOrEqualOpcode;
+            bool switched = opcode == BinaryGreaterThanOpcode || opcode == BinaryGreaterThanOrEqualOpcode;
+            JumpIfNotFulfilled fused(ByteCodeLOC(SIZE_MAX), switched ? src1 : src0, switched ? src0 : src1, containEqual, switched);
+            fused.m_jumpPosition = jumpPosition;
+            replace(i, fused);
+        } else {
+            bool isStrict = opcode == BinaryStrictEqualOpcode || opcode == BinaryNotStrictEqualOpcode;
+            bool isNegated = opcode == BinaryNotEqualOpcode || opcode == BinaryNotStrictEqualOpcode;
+            JumpIfEqual fused(ByteCodeLOC(SIZE_MAX), src0, src1, isStrict, isNegated == jumpIfTrue);
+            fused.m_jumpPosition = jumpPosition;
+            replace(i, fused);
+        }
+        m_fusedCount++;
+    }
+}
+
+void ByteCodeOptimizerContext::coalesceMoves()
+{
+    size_t previous = SIZE_MAX;
+    for (size_t i = 0; i < m_instructions.size(); i++) {
+        if (m_instructions[i].m_isRemoved) {
+            continue;
+        }
+
+        size_t producer = previous;
+        previous = i;
+        if (m_instructions[i].m_opcode != MoveOpcode || m_instructions[i].m_isJumpTarget || producer == SIZE_MAX) {
+            continue;
+        }
+
+        // `op t <- ...; mov v <- t` becomes `op v <- ...` when t is not used anymore
+        Move* move = (Move*)codeAt(i);
+        ByteCodeRegisterIndex src = move->m_registerIndex0;
+        ByteCodeRegisterIndex dst = move->m_registerIndex1;
+        if (!isTemporary(src) || src == dst || !isProducerOpcode(m_instructions[producer].m_opcode)) {
+            continue;
+        }
+
+        RegisterOperands operands;
+        describeOperands(codeAt(producer), m_instructions[producer].m_opcode, operands);
+        if (!operands.writes(src) || !isDeadAfter(i, src)) {
+            continue;
+        }
+
+        *operands.m_writes[0] = dst;
+        remove(i);
+        previous = producer;
+        m_removedMoveCount++;
+    }
+}
+
+// replaces reads of `from` with `to` in the following straight-line bytecodes and removes the bytecode at index,
+// which is a definition of `from` such that `from` and `to` hold the same value
+bool ByteCodeOptimizerContext::substituteForward(size_t index, ByteCodeRegisterIndex from, ByteCodeRegisterIndex to)
+{
+    std::vector<ByteCodeRegisterIndex*> rewrites;
+    size_t current = nextIndex(index);
+    size_t scanned = 0;
+
+    while (true) {
+        if (current == m_instructions.size()) {
+            return false;
+        }
+        if (m_instructions[current].m_isJumpTarget || scanned++ == BYTECODE_OPTIMIZER_PROPAGATION_WINDOW) {
+            if (!isDeadAt(current, from)) {
+                return false;
+            }
+            break;
+        }
+
+        RegisterOperands operands;
+        Opcode opcode = m_instructions[current].m_opcode;
+        if (!describeOperands(codeAt(current), opcode, operands) || operands.readsInRange(from)) {
+            return false;
+        }
+        for (size_t i = 0; i < operands.m_readCount; i++) {
+            if (*operands.m_reads[i] == from) {
+                rewrites.push_back(operands.m_reads[i]);
+            }
+        }
+
+        if (operands.writes(from)) {
+            break;
+        }
+        if (operands.writes(to) || isJumpOpcode(opcode) || isTerminalOpcode(opcode)) {
+            if (!isDeadAfter(current, from)) {
+                return false;
+            }
+            break;
+        }
+        current = nextIndex(current);
+    }
+
+    for (size_t i = 0; i < rewrites.size(); i++) {
+        *rewrites[i] = to;
+    }
+    remove(index);
+    return true;
+}
+
+void ByteCodeOptimizerContext::propagateCopies()
+{
+    for (size_t i = 0; i < m_instructions.size(); i++) {
+        if (m_instructions[i].m_isRemoved || m_instructions[i].m_opcode != MoveOpcode) {
+            continue;
+        }
+
+        Move* move = (Move*)codeAt(i);
+        ByteCodeRegisterIndex src = move->m_registerIndex0;
+        ByteCodeRegisterIndex dst = move->m_registerIndex1;
+        if (!isTemporary(dst) || src == dst) {
+            continue;
+        }
+        if (substituteForward(i, dst, src)) {
+            m_removedMoveCount++;
+        }
+    }
+}
+
+void ByteCodeOptimizerContext::hoistLoopLiterals()
+{
+    // loops are found from backward jumps
+    std::vector<std::pair<size_t, size_t>> loops;
+    for (size_t i = 0; i < m_instructions.size(); i++) {
+        Opcode opcode = m_instructions[i].m_opcode;
+        if (!m_instructions[i].m_isRemoved && isJumpOpcode(opcode)) {
+            size_t jumpPosition = jumpPositionOf(codeAt(i), opcode);
+            if (jumpPosition <= m_instructions[i].m_position) {
+                loops.push_back(std::make_pair(jumpPosition, m_instructions[i].m_position));
+            }
+        }
+    }
+    if (loops.empty()) {
+        return;
+    }
+
+    size_t registerBase = m_block->m_requiredRegisterFileSizeInValueSize;
+    for (size_t i = 0; i < m_instructions.size(); i++) {
+        if (m_instructions[i].m_isRemoved || m_instructions[i].m_opcode != LoadLiteralOpcode) {
+            continue;
+        }
+
+        LoadLiteral* load = (LoadLiteral*)codeAt(i);
+        if (!isTemporary(load->m_registerIndex)) {
+            continue;
+        }
+
+        bool inLoop = false;
+        size_t position = m_instructions[i].m_position;
+        for (size_t j = 0; j < loops.size() && !inLoop; j++) {
+            inLoop = loops[j].first <= position && position < loops[j].second;
+        }
+        if (!inLoop) {
+            continue;
+        }
+
+        size_t literalIndex = 0;
+        while (literalIndex < m_hoistedLiterals.size() && !(m_hoistedLiterals[literalIndex] == load->m_value)) {
+            literalIndex++;
+        }
+        if (literalIndex == BYTECODE_OPTIMIZER_HOISTED_LITERAL_LIMIT || registerBase + literalIndex + 1 >= REGULAR_REGISTER_LIMIT) {
+            continue;
+        }
+
+        Value value = load->m_value;
+        if (substituteForward(i, load->m_registerIndex, registerBase + literalIndex) && literalIndex == m_hoistedLiterals.size()) {
+            m_hoistedLiterals.push_back(value);
+        }
+    }
+
+    m_block->m_requiredRegisterFileSizeInValueSize = registerBase + m_hoistedLiterals.size();
+}
+
+void ByteCodeOptimizerContext::removeUselessJumps()
+{
+    for (size_t i = 0; i < m_instructions.size(); i++) {
+        Opcode opcode = m_instructions[i].m_opcode;
+        if (m_instructions[i].m_isRemoved) {
+            continue;
+        }
+        if (opcode != JumpOpcode && opcode != JumpIfTrueOpcode && opcode != JumpIfFalseOpcode && opcode != JumpIfUndefinedOrNullOpcode) {
+            continue;
+        }
+
+        size_t target = resolve(indexOf(jumpPositionOf(codeAt(i), opcode)));
+        if (target == nextIndex(i)) {
+            remove(i);
+            m_threadedJumpCount++;
+        } else if (opcode == JumpOpcode && target < m_instructions.size() && m_instructions[target].m_opcode == EndOpcode) {
+            End end(ByteCodeLOC(SIZE_MAX), ((End*)codeAt(target))->m_registerIndex);
+            replace(i, end);
+            m_threadedJumpCount++;
+        }
+    }
+}
+
+void ByteCodeOptimizerContext::compact(ByteCodeLOCData* locData)
+{
+    std::vector<char> newCode;
+    std::vector<size_t> newPositions(m_instructions.size() + 1);
+
+    newCode.reserve(m_block->m_code.size());
+    for (size_t i = 0; i < m_hoistedLiterals.size(); i++) {
+        LoadLiteral load(ByteCodeLOC(SIZE_MAX), m_block->m_requiredRegisterFileSizeInValueSize - m_hoistedLiterals.size() + i, m_hoistedLiterals[i]);
+        newCode.insert(newCode.end(), (char*)&load, (char*)&load + sizeof(LoadLiteral));
+    }
+
+    for (size_t i = 0; i < m_instructions.size(); i++) {
+        newPositions[i] = newCode.size();
+        if (!m_instructions[i].m_isRemoved) {
+            char* code = (char*)codeAt(i);
+            newCode.insert(newCode.end(), code, code + m_instructions[i].m_size);
+        }
+    }
+    newPositions[m_instructions.size()] = newCode.size();
+
+    // removed bytecodes are mapped to the next bytecode
+    for (size_t i = 0; i < m_instructions.size(); i++) {
+        if (m_instructions[i].m_isRemoved) {
+            continue;
+        }
+        ByteCode* code = (ByteCode*)(newCode.data() + newPositions[i]);
+        forEachCodePosition(code, m_instructions[i].m_opcode, [&](size_t& position) {
+            if (position != SIZE_MAX) {
+                position = newPositions[resolve(indexOf(position))];
+            }
+        });
+    }
+
+    if (locData) {
+        size_t count = 0;
+        for (size_t i = 0; i < locData->size(); i++) {
+            size_t index = indexOf((*locData)[i].first);
+            if (index < m_instructions.size() && !m_instructions[index].m_isRemoved) {
+                (*locData)[count++] = std::make_pair(newPositions[index], (*locData)[i].second);
+            }
+        }
+        locData->resize(count);
+    }
+
+    m_block->m_code.resizeWithUninitializedValues(newCode.size());
+    memcpy(m_block->m_code.data(), newCode.data(), newCode.size());
+}
+
+#ifndef NDEBUG
+void ByteCodeOptimizerContext::dump()
+{
+    InterpretedCodeBlock* codeBlock = m_block->codeBlock();
+    printf("dumpBytecode before optimization %s (%d:%d)>>>>>>>>>>>>>>>>>>>>>>\n", codeBlock->functionName().string()->toUTF8StringData().data(), (int)codeBlock->functionStart().line, (int)codeBlock->functionStart().column);
+    for (size_t i = 0; i < m_instructions.size(); i++) {
+        codeAt(i)->dumpCode(m_instructions[i].m_position, nullptr);
+    }
+}
+
+void ByteCodeOptimizerContext::dumpStatistics(size_t countBefore)
+{
+    printf("optimized bytecode count %d -> %d (fused %d, threaded jumps %d, removed moves %d, hoisted literals %d)\n", (int)countBefore, (int)instructionCount(),
+           (int)m_fusedCount, (int)m_threadedJumpCount, (int)m_removedMoveCount, (int)m_hoistedLiterals.size());
+}
+#endif
+
+void ByteCodeOptimizer::optimize(ByteCodeBlock* block, ByteCodeLOCData* locData)
+{
+    ByteCodeOptimizerContext ctx(block);
+    if (!ctx.analyze()) {
+        return;
+    }
+
+#ifndef NDEBUG
+    char* dumpByteCode = getenv("DUMP_BYTECODE");
+    bool shouldDump = !locData && dumpByteCode && (strcmp(dumpByteCode, "2") == 0);
+    if (shouldDump) {
+        ctx.dump();
+    }
+    size_t countBefore = ctx.instructionCount();
+#endif
+
+    ctx.threadJumps();
+    if (!ctx.hasTryOperation()) {
+        // liveness of temporary registers is not tracked across exception edges
+        ctx.collectJumpTargets();
+        ctx.fuseCompareAndBranch();
+        ctx.coalesceMoves();
+        ctx.propagateCopies();
+        ctx.hoistLoopLiterals();
+        ctx.threadJumps();
+    }
+    ctx.removeUselessJumps();
+    ctx.compact(locData);
+
+#ifndef NDEBUG
+    if (shouldDump) {
+        ctx.dumpStatistics(countBefore);
+    }
+#endif
+}
+} // namespace Escargot
+
+#endif // ENABLE_BYTECODE_OPTIMIZER
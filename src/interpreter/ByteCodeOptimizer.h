@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2021-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotByteCodeOptimizer__
+#define __EscargotByteCodeOptimizer__
+
+#if defined(ENABLE_BYTECODE_OPTIMIZER)
+
+namespace Escargot {
+
+class ByteCodeBlock;
+
+// rewrites the bytecode of a block after generation (before relocation) to reduce the number of dispatched bytecodes
+// - jump threading: jumps to jumps, jumps to conditional jumps on the same register, jumps to the next bytecode and to End
+// - compare-and-branch fusion: Binary{LessThan, Equal, ...} followed by JumpIfTrue/JumpIfFalse becomes JumpIfNotFulfilled or JumpIfEqual
+// - dead register elimination: a temporary register computed only to be moved into another register is computed there directly
+// - copy propagation: Move of a register read by the following bytecodes only is removed
+// - literals loaded in loops are loaded once at the function entry
+// the optimizations which need liveness of temporary registers are done only on blocks without try statement
+// blocks of generators, async functions and debugger are not changed
+class ByteCodeOptimizer {
+public:
+    // locData is given when only the location info of each bytecode is collected
+    static void optimize(ByteCodeBlock* block, std::vector<std::pair<size_t, size_t>, std::allocator<std::pair<size_t, size_t>>>* locData);
+};
+} // namespace Escargot
+
+#endif // ENABLE_BYTECODE_OPTIMIZER
+
+#endif
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2021-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#if defined(ENABLE_JIT)
+
+#include "Escargot.h"
+#include "jit/JITCode.h"
+#include "interpreter/ByteCode.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace Escargot {
+
+JITCode* JITCode::create(const uint8_t* code, size_t codeSize, std::vector<Entry>&& entries)
+{
+    size_t memorySize;
+    void* memory = allocateExecutableMemory(code, codeSize, memorySize);
+    if (UNLIKELY(!memory)) {
+        return nullptr;
+    }
+
+    return new JITCode(memory, memorySize, codeSize, std::move(entries));
+}
+
+JITCode::~JITCode()
+{
+    freeExecutableMemory(m_memory, m_memorySize);
+}
+
+void* JITCode::allocateExecutableMemory(const uint8_t* code, size_t codeSize, size_t& memorySize)
+{
+    static size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    memorySize = (codeSize + pageSize - 1) & ~(pageSize - 1);
+
+    // write the code and make it executable, never writable and executable at the same time
+    void* memory = mmap(nullptr, memorySize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (UNLIKELY(memory == MAP_FAILED)) {
+        return nullptr;
+    }
+    memcpy(memory, code, codeSize);
+    if (UNLIKELY(mprotect(memory, memorySize, PROT_READ | PROT_EXEC) != 0)) {
+        munmap(memory, memorySize);
+        return nullptr;
+    }
+    return memory;
+}
+
+void JITCode::freeExecutableMemory(void* memory, size_t memorySize)
+{
+    munmap(memory, memorySize);
+}
+
+bool JITCode::run(ExecutionState& state, ByteCodeBlock* block, size_t& programCounter, Value* registerFile, Value& result)
+{
+    const uint32_t position = (uint32_t)(programCounter - (size_t)block->m_code.data());
+    auto iter = m_entries.begin();
+    // most calls start from the first bytecode
+    if (UNLIKELY(position != 0)) {
+        iter = std::lower_bound(m_entries.begin(), m_entries.end(), position, [](const Entry& entry, uint32_t position) {
+            return entry.m_byteCodePosition < position;
+        });
+    }
+    if (iter == m_entries.end() || iter->m_byteCodePosition != position) {
+        // the interpreter should run this bytecode
+        return false;
+    }
+
+    JITContext context;
+    context.m_state = &state;
+    context.m_registerFile = registerFile;
+    context.m_programCounter = &programCounter;
+    context.m_byteCodeBlock = block;
+
+    size_t reason = ((EntryFunction)m_memory)(&context, (uint8_t*)m_memory + iter->m_nativePosition);
+    if (LIKELY(reason == Returned)) {
+        result = context.m_result;
+        return true;
+    } else if (reason == ExceptionThrown) {
+        std::rethrow_exception(context.m_exception);
+    }
+
+    ASSERT(reason == ExitToInterpreter);
+    return false;
+}
+} // namespace Escargot
+
+#endif // ENABLE_JIT
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2021-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotJITCode__
+#define __EscargotJITCode__
+
+#if defined(ENABLE_JIT)
+
+#include "runtime/Value.h"
+#include <exception>
+
+namespace Escargot {
+
+class ExecutionState;
+class ByteCodeBlock;
+
+// state of JIT code shared with the operations it calls
+// JIT code keeps the address of this in a callee-saved register
+struct JITContext {
+    ExecutionState* m_state;
+    Value* m_registerFile;
+    // points the program counter of the interpreter frame which entered JIT code.
+    // JIT code stores the address of current bytecode here before calling operations
+    // so stack traces and exits see the right position
+    size_t* m_programCounter;
+    ByteCodeBlock* m_byteCodeBlock;
+    // return value of End bytecode
+    Value m_result;
+    // exception thrown by an operation. exceptions never unwind through JIT code
+    std::exception_ptr m_exception;
+};
+
+// operations called from JIT code return this when they caught an exception
+#define JIT_OPERATION_EXCEPTION_THROWN -1
+
+// machine code of a ByteCodeBlock
+// it is owned by the ByteCodeBlock and freed with it
+class JITCode {
+public:
+    enum ExitReason : size_t {
+        // End bytecode is executed. return value is in JITContext::m_result
+        Returned = 0,
+        // the interpreter should continue from JITContext::m_programCounter
+        ExitToInterpreter = 1,
+        // exception is in JITContext::m_exception
+        ExceptionThrown = 2,
+    };
+
+    // JIT code entry: size_t code(JITContext* context, void* entryAddress)
+    typedef size_t (*EntryFunction)(JITContext* context, void* entryAddress);
+
+    struct Entry {
+        uint32_t m_byteCodePosition;
+        uint32_t m_nativePosition;
+    };
+
+    // copies `code` to executable memory. `entries` should be sorted by byte code position
+    static JITCode* create(const uint8_t* code, size_t codeSize, std::vector<Entry>&& entries);
+    ~JITCode();
+
+    // copies `code` to newly mapped executable memory. returns nullptr on failure
+    static void* allocateExecutableMemory(const uint8_t* code, size_t codeSize, size_t& memorySize);
+    static void freeExecutableMemory(void* memory, size_t memorySize);
+
+    // run machine code from bytecode at `programCounter` (absolute address) if it has an entry there.
+    // returns true with `result` when the block finished by End bytecode,
+    // or false after updating `programCounter` to where the interpreter should continue
+    bool run(ExecutionState& state, ByteCodeBlock* block, size_t& programCounter, Value* registerFile, Value& result);
+
+    size_t codeSize() const
+    {
+        return m_codeSize;
+    }
+
+private:
+    JITCode(void* memory, size_t memorySize, size_t codeSize, std::vector<Entry>&& entries)
+        : m_memory(memory)
+        , m_memorySize(memorySize)
+        , m_codeSize(codeSize)
+        , m_entries(std::move(entries))
+    {
+    }
+
+    void* m_memory;
+    size_t m_memorySize;
+    size_t m_codeSize;
+    std::vector<Entry> m_entries;
+};
+} // namespace Escargot
+
+#endif // ENABLE_JIT
+
+#endif
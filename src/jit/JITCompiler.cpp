@@ -0,0 +1,552 @@
+/*
+ * Copyright (c) 2021-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#if defined(ENABLE_JIT)
+
+#include "Escargot.h"
+#include "jit/JITCompiler.h"
+#include "jit/X86_64Assembler.h"
+#include "interpreter/ByteCodeGenerator.h"
+#include "interpreter/ByteCodeInterpreter.h"
+#include "runtime/Context.h"
+#include "debugger/Debugger.h"
+
+#if !defined(COMPILER_GCC) && !defined(COMPILER_CLANG)
+#error "JIT needs relocated bytecode of GCC or Clang build"
+#endif
+
+namespace Escargot {
+
+typedef X86_64Assembler Assembler;
+
+// registers kept during JIT code
+static const Assembler::Register ContextRegister = Assembler::R12;
+static const Assembler::Register RegisterFileRegister = Assembler::R13;
+static const Assembler::Register ProgramCounterRegister = Assembler::R14;
+// holds TagTypeNumber. int32 values are unsigned greater than or equal to this
+static const Assembler::Register NumberTagRegister = Assembler::R15;
+
+class JITCodeGenerator {
+public:
+    explicit JITCodeGenerator(ByteCodeBlock* block)
+        : m_block(block)
+        , m_codeBuffer(block->m_code.data())
+    {
+    }
+
+    JITCode* generate();
+
+private:
+    int32_t registerOffset(ByteCodeRegisterIndex index)
+    {
+        return (int32_t)(index * sizeof(Value));
+    }
+
+    void loadRegister(Assembler::Register dst, ByteCodeRegisterIndex index)
+    {
+        m_assembler.load(dst, RegisterFileRegister, registerOffset(index));
+    }
+
+    void storeRegister(ByteCodeRegisterIndex index, Assembler::Register src)
+    {
+        m_assembler.store(RegisterFileRegister, registerOffset(index), src);
+    }
+
+    void branchIfNotInt32(Assembler::Register reg, std::vector<size_t>& slowCases)
+    {
+        m_assembler.compare(reg, NumberTagRegister);
+        slowCases.push_back(m_assembler.jump(Assembler::Below));
+    }
+
+    void linkAll(std::vector<size_t>& jumps)
+    {
+        for (size_t jump : jumps) {
+            m_assembler.link(jump);
+        }
+        jumps.clear();
+    }
+
+    // stores address of `code` to program counter of the interpreter frame. uses r11
+    void storeProgramCounter(ByteCode* code)
+    {
+        m_assembler.moveImmediate(Assembler::R11, (size_t)code);
+        m_assembler.store(ProgramCounterRegister, 0, Assembler::R11);
+    }
+
+    // call operation of ByteCodeInterpreter for `code`
+    // rax has the result and flags of `test rax, rax` remain after this
+    void callOperation(ByteCode* code, Opcode opcode)
+    {
+        ByteCodeInterpreter::JITOperation operation = ByteCodeInterpreter::jitOperation(opcode);
+        ASSERT(operation);
+        storeProgramCounter(code);
+        m_assembler.move(Assembler::RDI, ContextRegister);
+        m_assembler.moveImmediate(Assembler::RSI, (size_t)code);
+        emitCall((void*)operation);
+    }
+
+    void emitCall(void* function)
+    {
+        m_assembler.moveImmediate(Assembler::RAX, (size_t)function);
+        m_assembler.call(Assembler::RAX);
+        m_assembler.test(Assembler::RAX, Assembler::RAX);
+        m_exceptionJumps.push_back(m_assembler.jump(Assembler::Sign));
+    }
+
+    void jumpToEpilogue(JITCode::ExitReason reason)
+    {
+        m_assembler.moveImmediate(Assembler::RAX, reason);
+        m_epilogueJumps.push_back(m_assembler.jump());
+    }
+
+    // jump to bytecode which `code` jumps to
+    void jumpToTarget(size_t jump, JumpByteCode* code)
+    {
+        m_targetJumps.push_back(std::make_pair(jump, code->m_jumpPosition - (size_t)m_codeBuffer));
+    }
+
+    void jumpToTarget(size_t jump, size_t absoluteTarget)
+    {
+        m_targetJumps.push_back(std::make_pair(jump, absoluteTarget - (size_t)m_codeBuffer));
+    }
+
+    void emitPrologue();
+    void emitEpilogue();
+    void emitExit(ByteCode* code);
+
+    template <typename CodeType>
+    void emitInt32Arithmetic(CodeType* code, Opcode opcode, Assembler::ArithmeticOperation op, bool canOverflow);
+    template <typename CodeType>
+    void emitInt32Compare(CodeType* code, Opcode opcode, Assembler::Condition cond);
+    template <typename CodeType>
+    void emitInt32Step(CodeType* code, Opcode opcode, Assembler::ArithmeticOperation op);
+    void emitJumpIfBoolean(JumpByteCode* code, Opcode opcode, ByteCodeRegisterIndex index, bool jumpIfTrue);
+    void emitJumpIfNotFulfilled(JumpIfNotFulfilled* code);
+    void emitJumpIfEqual(JumpIfEqual* code);
+    void emitJumpIfUndefinedOrNull(JumpIfUndefinedOrNull* code);
+    void emitGetObjectPreComputedCase(GetObjectPreComputedCase* code);
+
+    ByteCodeBlock* m_block;
+    char* m_codeBuffer;
+    Assembler m_assembler;
+    std::vector<size_t> m_epilogueJumps;
+    std::vector<size_t> m_exceptionJumps;
+    // (jump, target bytecode position)
+    std::vector<std::pair<size_t, size_t>> m_targetJumps;
+};
+
+void JITCodeGenerator::emitPrologue()
+{
+    // size_t code(JITContext* context /* rdi */, void* entryAddress /* rsi */)
+    m_assembler.push(Assembler::RBP);
+    m_assembler.move(Assembler::RBP, Assembler::RSP);
+    m_assembler.push(Assembler::RBX);
+    m_assembler.push(ContextRegister);
+    m_assembler.push(RegisterFileRegister);
+    m_assembler.push(ProgramCounterRegister);
+    m_assembler.push(NumberTagRegister);
+    // keep rsp 16-byte aligned for calls
+    m_assembler.arithmeticImmediate(Assembler::Sub, Assembler::RSP, 8);
+
+    m_assembler.move(ContextRegister, Assembler::RDI);
+    m_assembler.load(RegisterFileRegister, ContextRegister, offsetof(JITContext, m_registerFile));
+    m_assembler.load(ProgramCounterRegister, ContextRegister, offsetof(JITContext, m_programCounter));
+    m_assembler.moveImmediate(NumberTagRegister, TagTypeNumber);
+    m_assembler.jump(Assembler::RSI);
+}
+
+void JITCodeGenerator::emitEpilogue()
+{
+    // exception stub
+    linkAll(m_exceptionJumps);
+    m_assembler.moveImmediate(Assembler::RAX, JITCode::ExceptionThrown);
+
+    size_t epilogue = m_assembler.size();
+    m_assembler.arithmeticImmediate(Assembler::Add, Assembler::RSP, 8);
+    m_assembler.pop(NumberTagRegister);
+    m_assembler.pop(ProgramCounterRegister);
+    m_assembler.pop(RegisterFileRegister);
+    m_assembler.pop(ContextRegister);
+    m_assembler.pop(Assembler::RBX);
+    m_assembler.pop(Assembler::RBP);
+    m_assembler.ret();
+
+    for (size_t jump : m_epilogueJumps) {
+        m_assembler.link(jump, epilogue);
+    }
+}
+
+void JITCodeGenerator::emitExit(ByteCode* code)
+{
+    storeProgramCounter(code);
+    jumpToEpilogue(JITCode::ExitToInterpreter);
+}
+
+template <typename CodeType>
+void JITCodeGenerator::emitInt32Arithmetic(CodeType* code, Opcode opcode, Assembler::ArithmeticOperation op, bool canOverflow)
+{
+    std::vector<size_t> slowCases;
+    loadRegister(Assembler::RAX, code->m_srcIndex0);
+    branchIfNotInt32(Assembler::RAX, slowCases);
+    loadRegister(Assembler::RCX, code->m_srcIndex1);
+    branchIfNotInt32(Assembler::RCX, slowCases);
+    m_assembler.arithmetic32(op, Assembler::RAX, Assembler::RCX);
+    if (canOverflow) {
+        slowCases.push_back(m_assembler.jump(Assembler::Overflow));
+    }
+    m_assembler.arithmetic(Assembler::Or, Assembler::RAX, NumberTagRegister);
+    storeRegister(code->m_dstIndex, Assembler::RAX);
+    size_t done = m_assembler.jump();
+
+    linkAll(slowCases);
+    callOperation(code, opcode);
+    m_assembler.link(done);
+}
+
+template <typename CodeType>
+void JITCodeGenerator::emitInt32Compare(CodeType* code, Opcode opcode, Assembler::Condition cond)
+{
+    std::vector<size_t> slowCases;
+    loadRegister(Assembler::RAX, code->m_srcIndex0);
+    branchIfNotInt32(Assembler::RAX, slowCases);
+    loadRegister(Assembler::RCX, code->m_srcIndex1);
+    branchIfNotInt32(Assembler::RCX, slowCases);
+    m_assembler.compare32(Assembler::RAX, Assembler::RCX);
+    // mov does not change flags
+    m_assembler.moveImmediate(Assembler::RAX, ValueFalse);
+    m_assembler.moveImmediate(Assembler::RCX, ValueTrue);
+    m_assembler.conditionalMove32(cond, Assembler::RAX, Assembler::RCX);
+    storeRegister(code->m_dstIndex, Assembler::RAX);
+    size_t done = m_assembler.jump();
+
+    linkAll(slowCases);
+    callOperation(code, opcode);
+    m_assembler.link(done);
+}
+
+template <typename CodeType>
+void JITCodeGenerator::emitInt32Step(CodeType* code, Opcode opcode, Assembler::ArithmeticOperation op)
+{
+    std::vector<size_t> slowCases;
+    loadRegister(Assembler::RAX, code->m_srcIndex);
+    branchIfNotInt32(Assembler::RAX, slowCases);
+    m_assembler.arithmeticImmediate32(op, Assembler::RAX, 1);
+    slowCases.push_back(m_assembler.jump(Assembler::Overflow));
+    m_assembler.arithmetic(Assembler::Or, Assembler::RAX, NumberTagRegister);
+    storeRegister(code->m_dstIndex, Assembler::RAX);
+    size_t done = m_assembler.jump();
+
+    linkAll(slowCases);
+    callOperation(code, opcode);
+    m_assembler.link(done);
+}
+
+void JITCodeGenerator::emitJumpIfBoolean(JumpByteCode* code, Opcode opcode, ByteCodeRegisterIndex index, bool jumpIfTrue)
+{
+    std::vector<size_t> notTaken;
+    loadRegister(Assembler::RAX, index);
+    m_assembler.arithmeticImmediate(Assembler::Cmp, Assembler::RAX, jumpIfTrue ? ValueTrue : ValueFalse);
+    jumpToTarget(m_assembler.jump(Assembler::Equal), code);
+    m_assembler.arithmeticImmediate(Assembler::Cmp, Assembler::RAX, jumpIfTrue ? ValueFalse : ValueTrue);
+    notTaken.push_back(m_assembler.jump(Assembler::Equal));
+
+    // int32 0 is TagTypeNumber itself
+    m_assembler.compare(Assembler::RAX, NumberTagRegister);
+    size_t zero = m_assembler.jump(Assembler::Equal);
+    size_t slowCase = m_assembler.jump(Assembler::Below);
+    if (jumpIfTrue) {
+        jumpToTarget(m_assembler.jump(), code);
+        notTaken.push_back(zero);
+    } else {
+        jumpToTarget(zero, code);
+        notTaken.push_back(m_assembler.jump());
+    }
+
+    m_assembler.link(slowCase);
+    callOperation(code, opcode);
+    jumpToTarget(m_assembler.jump(Assembler::NotEqual), code);
+    linkAll(notTaken);
+}
+
+void JITCodeGenerator::emitJumpIfNotFulfilled(JumpIfNotFulfilled* code)
+{
+    std::vector<size_t> slowCases;
+    loadRegister(Assembler::RAX, code->m_leftIndex);
+    branchIfNotInt32(Assembler::RAX, slowCases);
+    loadRegister(Assembler::RCX, code->m_rightIndex);
+    branchIfNotInt32(Assembler::RCX, slowCases);
+    m_assembler.compare32(Assembler::RAX, Assembler::RCX);
+    jumpToTarget(m_assembler.jump(code->m_containEqual ? Assembler::Greater : Assembler::GreaterOrEqual), code);
+    size_t done = m_assembler.jump();
+
+    linkAll(slowCases);
+    callOperation(code, JumpIfNotFulfilledOpcode);
+    jumpToTarget(m_assembler.jump(Assembler::NotEqual), code);
+    m_assembler.link(done);
+}
+
+void JITCodeGenerator::emitJumpIfEqual(JumpIfEqual* code)
+{
+    std::vector<size_t> slowCases;
+    loadRegister(Assembler::RAX, code->m_registerIndex0);
+    branchIfNotInt32(Assembler::RAX, slowCases);
+    loadRegister(Assembler::RCX, code->m_registerIndex1);
+    branchIfNotInt32(Assembler::RCX, slowCases);
+    m_assembler.compare(Assembler::RAX, Assembler::RCX);
+    jumpToTarget(m_assembler.jump(code->m_shouldNegate ? Assembler::NotEqual : Assembler::Equal), code);
+    size_t done = m_assembler.jump();
+
+    linkAll(slowCases);
+    callOperation(code, JumpIfEqualOpcode);
+    jumpToTarget(m_assembler.jump(Assembler::NotEqual), code);
+    m_assembler.link(done);
+}
+
+void JITCodeGenerator::emitJumpIfUndefinedOrNull(JumpIfUndefinedOrNull* code)
+{
+    COMPILE_ASSERT((ValueUndefined & ~(1 << TagTypeShift)) == ValueNull, "");
+    loadRegister(Assembler::RAX, code->m_registerIndex);
+    m_assembler.arithmeticImmediate(Assembler::And, Assembler::RAX, ~(1 << TagTypeShift));
+    m_assembler.arithmeticImmediate(Assembler::Cmp, Assembler::RAX, ValueNull);
+    jumpToTarget(m_assembler.jump(code->m_shouldNegate ? Assembler::NotEqual : Assembler::Equal), code);
+}
+
+void JITCodeGenerator::emitGetObjectPreComputedCase(GetObjectPreComputedCase* code)
+{
+    // probe the first entry of the inline cache when it is for own property of the object
+    std::vector<size_t> slowCases;
+    const int32_t cacheSize = offsetof(GetObjectInlineCache, m_cache) + GetObjectInlineCacheDataVector::offsetOfSize();
+    const int32_t cacheBuffer = offsetof(GetObjectInlineCache, m_cache) + GetObjectInlineCacheDataVector::offsetOfBuffer();
+    // Object::m_structure is the first data area of PointerValue
+    const int32_t structure = sizeof(size_t);
+
+    loadRegister(Assembler::RAX, code->m_objectRegisterIndex);
+    m_assembler.moveImmediate(Assembler::RCX, TagMask);
+    m_assembler.test(Assembler::RAX, Assembler::RCX);
+    slowCases.push_back(m_assembler.jump(Assembler::NotEqual));
+    m_assembler.test(Assembler::RAX, Assembler::RAX);
+    slowCases.push_back(m_assembler.jump(Assembler::Equal));
+    m_assembler.testImmediate(Assembler::RAX, structure, POINTER_VALUE_NOT_OBJECT_TAG_IN_DATA);
+    slowCases.push_back(m_assembler.jump(Assembler::NotEqual));
+
+    // the inline cache is allocated and replaced while running, so read it every time
+    m_assembler.moveImmediate(Assembler::RCX, (size_t)&code->m_inlineCache);
+    m_assembler.load(Assembler::RCX, Assembler::RCX, 0);
+    m_assembler.test(Assembler::RCX, Assembler::RCX);
+    slowCases.push_back(m_assembler.jump(Assembler::Equal));
+    m_assembler.compareImmediate(Assembler::RCX, cacheSize, 0);
+    slowCases.push_back(m_assembler.jump(Assembler::Equal));
+    m_assembler.load(Assembler::RCX, Assembler::RCX, cacheBuffer);
+    m_assembler.compareImmediate(Assembler::RCX, offsetof(GetObjectInlineCacheData, m_cachedhiddenClassChainLength), 1);
+    slowCases.push_back(m_assembler.jump(Assembler::NotEqual));
+    m_assembler.load(Assembler::RDX, Assembler::RAX, structure);
+    m_assembler.compare(Assembler::RDX, Assembler::RCX, offsetof(GetObjectInlineCacheData, m_cachedhiddenClass));
+    slowCases.push_back(m_assembler.jump(Assembler::NotEqual));
+    m_assembler.load(Assembler::RCX, Assembler::RCX, offsetof(GetObjectInlineCacheData, m_cachedIndex));
+    m_assembler.arithmeticImmediate(Assembler::Cmp, Assembler::RCX, -1);
+    slowCases.push_back(m_assembler.jump(Assembler::Equal));
+
+    // jitGetObjectPreComputedCaseCacheHit(context, code, obj, cachedIndex)
+    storeProgramCounter(code);
+    m_assembler.move(Assembler::RDX, Assembler::RAX);
+    m_assembler.move(Assembler::RDI, ContextRegister);
+    m_assembler.moveImmediate(Assembler::RSI, (size_t)code);
+    emitCall((void*)&ByteCodeInterpreter::jitGetObjectPreComputedCaseCacheHit);
+    size_t done = m_assembler.jump();
+
+    linkAll(slowCases);
+    callOperation(code, GetObjectPreComputedCaseOpcode);
+    m_assembler.link(done);
+}
+
+JITCode* JITCodeGenerator::generate()
+{
+    // every bytecode position including exits. used for linking jumps
+    std::vector<JITCode::Entry> positions;
+    // positions where JIT code can be entered
+    std::vector<JITCode::Entry> entries;
+
+    emitPrologue();
+
+    size_t idx = 0;
+    size_t end = m_block->m_code.size();
+    while (idx < end) {
+        ByteCode* code = (ByteCode*)(m_codeBuffer + idx);
+        Opcode opcode = opcodeOfRelocatedByteCode(code);
+        if (UNLIKELY(opcode == ExecutionPauseOpcode)) {
+            // generators and async functions have extra data in bytecode
+            return nullptr;
+        }
+
+        JITCode::Entry entry = { (uint32_t)idx, (uint32_t)m_assembler.size() };
+        positions.push_back(entry);
+        bool isExit = false;
+
+        switch (opcode) {
+        case LoadLiteralOpcode: {
+            LoadLiteral* cd = (LoadLiteral*)code;
+            m_assembler.moveImmediate(Assembler::RAX, (uint64_t)cd->m_value.payload());
+            storeRegister(cd->m_registerIndex, Assembler::RAX);
+            break;
+        }
+        case MoveOpcode: {
+            Move* cd = (Move*)code;
+            loadRegister(Assembler::RAX, cd->m_registerIndex0);
+            storeRegister(cd->m_registerIndex1, Assembler::RAX);
+            break;
+        }
+        case BinaryPlusOpcode:
+            emitInt32Arithmetic((BinaryPlus*)code, opcode, Assembler::Add, true);
+            break;
+        case BinaryMinusOpcode:
+            emitInt32Arithmetic((BinaryMinus*)code, opcode, Assembler::Sub, true);
+            break;
+        case BinaryBitwiseAndOpcode:
+            emitInt32Arithmetic((BinaryBitwiseAnd*)code, opcode, Assembler::And, false);
+            break;
+        case BinaryBitwiseOrOpcode:
+            emitInt32Arithmetic((BinaryBitwiseOr*)code, opcode, Assembler::Or, false);
+            break;
+        case BinaryBitwiseXorOpcode:
+            emitInt32Arithmetic((BinaryBitwiseXor*)code, opcode, Assembler::Xor, false);
+            break;
+        case BinaryLessThanOpcode:
+            emitInt32Compare((BinaryLessThan*)code, opcode, Assembler::Less);
+            break;
+        case BinaryLessThanOrEqualOpcode:
+            emitInt32Compare((BinaryLessThanOrEqual*)code, opcode, Assembler::LessOrEqual);
+            break;
+        case BinaryGreaterThanOpcode:
+            emitInt32Compare((BinaryGreaterThan*)code, opcode, Assembler::Greater);
+            break;
+        case BinaryGreaterThanOrEqualOpcode:
+            emitInt32Compare((BinaryGreaterThanOrEqual*)code, opcode, Assembler::GreaterOrEqual);
+            break;
+        case BinaryStrictEqualOpcode:
+            emitInt32Compare((BinaryStrictEqual*)code, opcode, Assembler::Equal);
+            break;
+        case BinaryNotStrictEqualOpcode:
+            emitInt32Compare((BinaryNotStrictEqual*)code, opcode, Assembler::NotEqual);
+            break;
+        case IncrementOpcode:
+            emitInt32Step((Increment*)code, opcode, Assembler::Add);
+            break;
+        case DecrementOpcode:
+            emitInt32Step((Decrement*)code, opcode, Assembler::Sub);
+            break;
+        case GetObjectPreComputedCaseOpcode:
+            emitGetObjectPreComputedCase((GetObjectPreComputedCase*)code);
+            break;
+        case JumpOpcode:
+            jumpToTarget(m_assembler.jump(), ((Jump*)code)->m_jumpPosition);
+            break;
+        case JumpIfTrueOpcode:
+            emitJumpIfBoolean((JumpIfTrue*)code, opcode, ((JumpIfTrue*)code)->m_registerIndex, true);
+            break;
+        case JumpIfFalseOpcode:
+            emitJumpIfBoolean((JumpIfFalse*)code, opcode, ((JumpIfFalse*)code)->m_registerIndex, false);
+            break;
+        case JumpIfNotFulfilledOpcode:
+            emitJumpIfNotFulfilled((JumpIfNotFulfilled*)code);
+            break;
+        case JumpIfEqualOpcode:
+            emitJumpIfEqual((JumpIfEqual*)code);
+            break;
+        case JumpIfUndefinedOrNullOpcode:
+            emitJumpIfUndefinedOrNull((JumpIfUndefinedOrNull*)code);
+            break;
+        case EndOpcode: {
+#ifdef ESCARGOT_DEBUGGER
+            emitExit(code);
+            isExit = true;
+#else
+            loadRegister(Assembler::RAX, ((End*)code)->m_registerIndex);
+            m_assembler.store(ContextRegister, offsetof(JITContext, m_result), Assembler::RAX);
+            jumpToEpilogue(JITCode::Returned);
+#endif
+            break;
+        }
+        default:
+            if (ByteCodeInterpreter::jitOperation(opcode)) {
+                callOperation(code, opcode);
+            } else {
+                emitExit(code);
+                isExit = true;
+            }
+            break;
+        }
+
+        if (!isExit) {
+            entries.push_back(entry);
+        }
+
+        ASSERT(opcode <= EndOpcode);
+        idx += byteCodeLengths[opcode];
+    }
+
+    // falling through the last bytecode does not happen. End or jump is always the last one
+    emitEpilogue();
+
+    for (auto& jump : m_targetJumps) {
+        auto iter = std::lower_bound(positions.begin(), positions.end(), jump.second, [](const JITCode::Entry& entry, size_t position) {
+            return entry.m_byteCodePosition < position;
+        });
+        RELEASE_ASSERT(iter != positions.end() && iter->m_byteCodePosition == jump.second);
+        m_assembler.link(jump.first, iter->m_nativePosition);
+    }
+
+    return JITCode::create(m_assembler.data(), m_assembler.size(), std::move(entries));
+}
+
+JITCode* JITCompiler::compile(ByteCodeBlock* block)
+{
+    InterpretedCodeBlock* codeBlock = block->m_codeBlock;
+    if (codeBlock->isGenerator() || codeBlock->isAsync()) {
+        return nullptr;
+    }
+
+#ifdef ESCARGOT_DEBUGGER
+    Debugger* debugger = codeBlock->context()->debugger();
+    if (debugger && debugger->enabled()) {
+        // breakpoints are set by rewriting bytecode
+        return nullptr;
+    }
+#endif /* ESCARGOT_DEBUGGER */
+
+    JITCodeGenerator generator(block);
+    return generator.generate();
+}
+
+bool JITCompiler::tierUp(ByteCodeBlock* block)
+{
+    if (block->m_jitCompileFailed) {
+        return false;
+    }
+
+    ASSERT(block->m_jitCode == nullptr);
+    block->m_jitCode = compile(block);
+    if (UNLIKELY(block->m_jitCode == nullptr)) {
+        block->m_jitCompileFailed = true;
+        return false;
+    }
+    return true;
+}
+} // namespace Escargot
+
+#endif // ENABLE_JIT
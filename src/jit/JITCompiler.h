@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2021-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotJITCompiler__
+#define __EscargotJITCompiler__
+
+#if defined(ENABLE_JIT)
+
+#include "interpreter/ByteCode.h"
+#include "jit/JITCode.h"
+
+// a function is compiled after it is called this many times
+#define JIT_INVOCATION_COUNT_THRESHOLD 64
+// or after its loops jumped back this many times
+#define JIT_BACKEDGE_COUNT_THRESHOLD 1024
+
+namespace Escargot {
+
+// baseline JIT which translates ByteCodeBlock into x86-64 machine code opcode by opcode
+// fast paths of int32 arithmetic, comparison, jumps and monomorphic GetObjectPreComputedCase are emitted inline
+// and other supported bytecodes call ByteCodeInterpreter::jitOperation.
+// bytecodes which change control flow of the interpreter (try, with, block, generator...) exit to the interpreter
+class JITCompiler {
+public:
+    // count a call of the function. returns true when the block has JIT code
+    ALWAYS_INLINE static bool countInvocation(ByteCodeBlock* block)
+    {
+        InterpretedCodeBlock* codeBlock = block->m_codeBlock;
+        if (LIKELY(++codeBlock->m_jitInvocationCount < JIT_INVOCATION_COUNT_THRESHOLD)) {
+            return false;
+        }
+        return tierUp(block);
+    }
+
+    // count a backward jump of loop. returns true when the block has JIT code
+    ALWAYS_INLINE static bool countBackEdge(ByteCodeBlock* block)
+    {
+        InterpretedCodeBlock* codeBlock = block->m_codeBlock;
+        if (LIKELY(++codeBlock->m_jitBackEdgeCount < JIT_BACKEDGE_COUNT_THRESHOLD)) {
+            return false;
+        }
+        return tierUp(block);
+    }
+
+    // returns nullptr when the block cannot be compiled
+    static JITCode* compile(ByteCodeBlock* block);
+
+private:
+    static bool tierUp(ByteCodeBlock* block);
+};
+} // namespace Escargot
+
+#endif // ENABLE_JIT
+
+#endif
@@ -0,0 +1,442 @@
+/*
+ * Copyright (c) 2021-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotX86_64Assembler__
+#define __EscargotX86_64Assembler__
+
+#if defined(ENABLE_JIT)
+
+namespace Escargot {
+
+// minimal x86-64 instruction encoder used by JITCompiler and the Yarr JIT
+// only the forms which the JITs emit are supported.
+// memory operands are [base + disp32] or [base + index * scale + disp32]
+class X86_64Assembler {
+public:
+    enum Register : uint8_t {
+        RAX = 0,
+        RCX,
+        RDX,
+        RBX,
+        RSP,
+        RBP,
+        RSI,
+        RDI,
+        R8,
+        R9,
+        R10,
+        R11,
+        R12,
+        R13,
+        R14,
+        R15,
+    };
+
+    enum Condition : uint8_t {
+        Overflow = 0x0,
+        Below = 0x2,
+        AboveOrEqual = 0x3,
+        Equal = 0x4,
+        NotEqual = 0x5,
+        BelowOrEqual = 0x6,
+        Above = 0x7,
+        Sign = 0x8,
+        Less = 0xC,
+        GreaterOrEqual = 0xD,
+        LessOrEqual = 0xE,
+        Greater = 0xF,
+    };
+
+    // extension of opcode 0x81 (group 1)
+    enum ArithmeticOperation : uint8_t {
+        Add = 0,
+        Or = 1,
+        And = 4,
+        Sub = 5,
+        Xor = 6,
+        Cmp = 7,
+    };
+
+    static Condition invert(Condition cond)
+    {
+        return (Condition)(cond ^ 1);
+    }
+
+    const uint8_t* data() const
+    {
+        return m_buffer.data();
+    }
+
+    size_t size() const
+    {
+        return m_buffer.size();
+    }
+
+    void push(Register reg)
+    {
+        emitRex(false, 0, reg);
+        emit(0x50 + (reg & 7));
+    }
+
+    void pop(Register reg)
+    {
+        emitRex(false, 0, reg);
+        emit(0x58 + (reg & 7));
+    }
+
+    void ret()
+    {
+        emit(0xC3);
+    }
+
+    // mov dst, src (64-bit)
+    void move(Register dst, Register src)
+    {
+        emitRex(true, src, dst);
+        emit(0x89);
+        emitModRM(3, src, dst);
+    }
+
+    // mov dst, src (32-bit. upper 32 bits of dst are cleared)
+    void move32(Register dst, Register src)
+    {
+        emitRex(false, src, dst);
+        emit(0x89);
+        emitModRM(3, src, dst);
+    }
+
+    // mov dst, imm
+    void moveImmediate(Register dst, uint64_t imm)
+    {
+        if (imm <= 0xffffffffu) {
+            // mov r32, imm32 clears upper bits
+            emitRex(false, 0, dst);
+            emit(0xB8 + (dst & 7));
+            emit32((uint32_t)imm);
+        } else {
+            emitRex(true, 0, dst);
+            emit(0xB8 + (dst & 7));
+            emit64(imm);
+        }
+    }
+
+    // mov dst, [base + disp]
+    void load(Register dst, Register base, int32_t disp)
+    {
+        emitRex(true, dst, base);
+        emit(0x8B);
+        emitMemoryOperand(dst, base, disp);
+    }
+
+    // mov [base + disp], src
+    void store(Register base, int32_t disp, Register src)
+    {
+        emitRex(true, src, base);
+        emit(0x89);
+        emitMemoryOperand(src, base, disp);
+    }
+
+    // mov dword [base + disp], src
+    void store32(Register base, int32_t disp, Register src)
+    {
+        emitRex(false, src, base);
+        emit(0x89);
+        emitMemoryOperand(src, base, disp);
+    }
+
+    // mov qword [base + disp], imm32 (sign extended)
+    void storeImmediate(Register base, int32_t disp, int32_t imm)
+    {
+        emitRex(true, 0, base);
+        emit(0xC7);
+        emitMemoryOperand(0, base, disp);
+        emit32((uint32_t)imm);
+    }
+
+    // movzx dst, byte [base + index + disp]
+    void load8(Register dst, Register base, Register index, int32_t disp)
+    {
+        emitRex(false, dst, index, base);
+        emit(0x0F);
+        emit(0xB6);
+        emitMemoryOperand(dst, base, index, 0, disp);
+    }
+
+    // movzx dst, word [base + index * 2 + disp]
+    void load16(Register dst, Register base, Register index, int32_t disp)
+    {
+        emitRex(false, dst, index, base);
+        emit(0x0F);
+        emit(0xB7);
+        emitMemoryOperand(dst, base, index, 1, disp);
+    }
+
+    // lea dst, [rip + disp32]. returns position of the end of the instruction,
+    // which should be patched by patch32 with the distance to the target
+    size_t loadEffectiveAddressRelative(Register dst)
+    {
+        emitRex(true, dst, 0);
+        emit(0x8D);
+        emitModRM(0, dst, 5);
+        emit32(0);
+        return m_buffer.size();
+    }
+
+    // cmp left, right (64-bit)
+    void compare(Register left, Register right)
+    {
+        emitRex(true, right, left);
+        emit(0x39);
+        emitModRM(3, right, left);
+    }
+
+    // cmp left, right (32-bit)
+    void compare32(Register left, Register right)
+    {
+        emitRex(false, right, left);
+        emit(0x39);
+        emitModRM(3, right, left);
+    }
+
+    // cmp left, [base + disp]
+    void compare(Register left, Register base, int32_t disp)
+    {
+        emitRex(true, left, base);
+        emit(0x3B);
+        emitMemoryOperand(left, base, disp);
+    }
+
+    // cmp qword [base + disp], imm32 (sign extended)
+    void compareImmediate(Register base, int32_t disp, int32_t imm)
+    {
+        emitRex(true, 0, base);
+        emit(0x81);
+        emitMemoryOperand(Cmp, base, disp);
+        emit32((uint32_t)imm);
+    }
+
+    // cmp byte [base + index], imm8
+    void compareByteImmediate(Register base, Register index, int8_t imm)
+    {
+        emitRex(false, 0, index, base);
+        emit(0x80);
+        emitMemoryOperand(Cmp, base, index, 0, 0);
+        emit((uint8_t)imm);
+    }
+
+    // test qword [base + disp], imm32 (sign extended)
+    void testImmediate(Register base, int32_t disp, int32_t imm)
+    {
+        emitRex(true, 0, base);
+        emit(0xF7);
+        emitMemoryOperand(0, base, disp);
+        emit32((uint32_t)imm);
+    }
+
+    // test left, right (64-bit)
+    void test(Register left, Register right)
+    {
+        emitRex(true, right, left);
+        emit(0x85);
+        emitModRM(3, right, left);
+    }
+
+    // op dst, src (32-bit. upper 32 bits of dst are cleared)
+    void arithmetic32(ArithmeticOperation op, Register dst, Register src)
+    {
+        emitRex(false, src, dst);
+        emit((op << 3) | 0x1);
+        emitModRM(3, src, dst);
+    }
+
+    // op dst, src (64-bit)
+    void arithmetic(ArithmeticOperation op, Register dst, Register src)
+    {
+        emitRex(true, src, dst);
+        emit((op << 3) | 0x1);
+        emitModRM(3, src, dst);
+    }
+
+    // op dst, imm32 (32-bit)
+    void arithmeticImmediate32(ArithmeticOperation op, Register dst, int32_t imm)
+    {
+        emitRex(false, 0, dst);
+        emit(0x81);
+        emitModRM(3, op, dst);
+        emit32((uint32_t)imm);
+    }
+
+    // op dst, imm32 (64-bit, imm is sign extended)
+    void arithmeticImmediate(ArithmeticOperation op, Register dst, int32_t imm)
+    {
+        emitRex(true, 0, dst);
+        emit(0x81);
+        emitModRM(3, op, dst);
+        emit32((uint32_t)imm);
+    }
+
+    // cmovcc dst, src (32-bit)
+    void conditionalMove32(Condition cond, Register dst, Register src)
+    {
+        emitRex(false, dst, src);
+        emit(0x0F);
+        emit(0x40 + cond);
+        emitModRM(3, dst, src);
+    }
+
+    // cmovcc dst, src (64-bit)
+    void conditionalMove(Condition cond, Register dst, Register src)
+    {
+        emitRex(true, dst, src);
+        emit(0x0F);
+        emit(0x40 + cond);
+        emitModRM(3, dst, src);
+    }
+
+    // call reg
+    void call(Register target)
+    {
+        emitRex(false, 0, target);
+        emit(0xFF);
+        emitModRM(3, 2, target);
+    }
+
+    // jmp reg
+    void jump(Register target)
+    {
+        emitRex(false, 0, target);
+        emit(0xFF);
+        emitModRM(3, 4, target);
+    }
+
+    // jmp rel32. returns position of the jump which should be linked later
+    size_t jump()
+    {
+        emit(0xE9);
+        emit32(0);
+        return m_buffer.size();
+    }
+
+    // jcc rel32. returns position of the jump which should be linked later
+    size_t jump(Condition cond)
+    {
+        emit(0x0F);
+        emit(0x80 + cond);
+        emit32(0);
+        return m_buffer.size();
+    }
+
+    // link jump returned by jump() to `target` position
+    void link(size_t jump, size_t target)
+    {
+        patch32(jump, (int32_t)((intptr_t)target - (intptr_t)jump));
+    }
+
+    // link jump returned by jump() to current position
+    void link(size_t jump)
+    {
+        link(jump, m_buffer.size());
+    }
+
+    // overwrite the 32-bit immediate or displacement which ends at `position`
+    void patch32(size_t position, int32_t value)
+    {
+        memcpy(&m_buffer[position - sizeof(int32_t)], &value, sizeof(int32_t));
+    }
+
+    void emitBytes(const uint8_t* bytes, size_t length)
+    {
+        m_buffer.insert(m_buffer.end(), bytes, bytes + length);
+    }
+
+    // pad with int3 until the size is a multiple of `alignment`
+    void align(size_t alignment)
+    {
+        while (m_buffer.size() % alignment) {
+            emit(0xCC);
+        }
+    }
+
+private:
+    void emit(uint8_t byte)
+    {
+        m_buffer.push_back(byte);
+    }
+
+    void emit32(uint32_t v)
+    {
+        for (size_t i = 0; i < 4; i++) {
+            emit((uint8_t)(v >> (i * 8)));
+        }
+    }
+
+    void emit64(uint64_t v)
+    {
+        for (size_t i = 0; i < 8; i++) {
+            emit((uint8_t)(v >> (i * 8)));
+        }
+    }
+
+    // `reg` is ModRM.reg field, `rm` is ModRM.rm (or base) field
+    void emitRex(bool is64Bit, uint8_t reg, uint8_t rm)
+    {
+        uint8_t rex = 0x40 | (is64Bit ? 0x8 : 0) | ((reg & 8) ? 0x4 : 0) | ((rm & 8) ? 0x1 : 0);
+        if (rex != 0x40) {
+            emit(rex);
+        }
+    }
+
+    void emitRex(bool is64Bit, uint8_t reg, uint8_t index, uint8_t rm)
+    {
+        uint8_t rex = 0x40 | (is64Bit ? 0x8 : 0) | ((reg & 8) ? 0x4 : 0) | ((index & 8) ? 0x2 : 0) | ((rm & 8) ? 0x1 : 0);
+        if (rex != 0x40) {
+            emit(rex);
+        }
+    }
+
+    void emitModRM(uint8_t mod, uint8_t reg, uint8_t rm)
+    {
+        emit((mod << 6) | ((reg & 7) << 3) | (rm & 7));
+    }
+
+    void emitMemoryOperand(uint8_t reg, Register base, int32_t disp)
+    {
+        emitModRM(2, reg, base);
+        if ((base & 7) == RSP) {
+            // rsp and r12 need SIB byte
+            emit(0x24);
+        }
+        emit32((uint32_t)disp);
+    }
+
+    // [base + index << scale + disp32]. `index` cannot be rsp
+    void emitMemoryOperand(uint8_t reg, Register base, Register index, uint8_t scale, int32_t disp)
+    {
+        emitModRM(2, reg, RSP);
+        emit((scale << 6) | ((index & 7) << 3) | (base & 7));
+        emit32((uint32_t)disp);
+    }
+
+    std::vector<uint8_t> m_buffer;
+};
+} // namespace Escargot
+
+#endif // ENABLE_JIT
+
+#endif
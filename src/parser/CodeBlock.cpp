@@ -213,6 +213,11 @@ InterpretedCodeBlock::InterpretedCodeBlock(Context* ctx, Script* script, StringV
     , m_hasParameterOtherThanIdentifier(false)
     , m_allowSuperCall(false)
     , m_allowSuperProperty(false)
+    , m_inlinePropertySlotCountForConstruct(0)
+#if defined(ENABLE_JIT)
+    , m_jitInvocationCount(0)
+    , m_jitBackEdgeCount(0)
+#endif
 #ifndef NDEBUG
     , m_scopeContext(scopeCtx)
 #endif
@@ -268,6 +273,11 @@ InterpretedCodeBlock::InterpretedCodeBlock(Context* ctx, Script* script, StringV
     , m_hasParameterOtherThanIdentifier(false)
     , m_allowSuperCall(false)
     , m_allowSuperProperty(false)
+    , m_inlinePropertySlotCountForConstruct(0)
+#if defined(ENABLE_JIT)
+    , m_jitInvocationCount(0)
+    , m_jitBackEdgeCount(0)
+#endif
 #ifndef NDEBUG
     , m_scopeContext(scopeCtx)
 #endif
@@ -323,6 +333,11 @@ InterpretedCodeBlock::InterpretedCodeBlock(Context* ctx, Script* script)
     , m_hasParameterOtherThanIdentifier(false)
     , m_allowSuperCall(false)
     , m_allowSuperProperty(false)
+    , m_inlinePropertySlotCountForConstruct(0)
+#if defined(ENABLE_JIT)
+    , m_jitInvocationCount(0)
+    , m_jitBackEdgeCount(0)
+#endif
 #ifndef NDEBUG
     , m_scopeContext(nullptr)
 #endif
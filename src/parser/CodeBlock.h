@@ -191,9 +191,13 @@ class InterpretedCodeBlock : public CodeBlock {
     friend class VMInstance;
     friend int getValidValueInInterpretedCodeBlock(void* ptr, GC_mark_custom_result* arr);
 #if defined(ENABLE_CODE_CACHE)
+    friend class CodeCache;
     friend class CodeCacheWriter;
     friend class CodeCacheReader;
 #endif
+#if defined(ENABLE_JIT)
+    friend class JITCompiler;
+#endif
 
 public:
     struct IndexedIdentifierInfo {
@@ -600,6 +604,19 @@ public:
         return m_allowSuperProperty;
     }
 
+    size_t inlinePropertySlotCountForConstruct() const
+    {
+        return m_inlinePropertySlotCountForConstruct;
+    }
+
+    void updateInlinePropertySlotCountForConstruct(size_t propertyCount)
+    {
+        propertyCount = std::min(propertyCount, (size_t)ESCARGOT_OBJECT_INLINE_PROPERTY_SLOT_MAX);
+        if (propertyCount > m_inlinePropertySlotCountForConstruct) {
+            m_inlinePropertySlotCountForConstruct = propertyCount;
+        }
+    }
+
     bool isFunctionNameSaveOnHeap() const
     {
         return m_isFunctionNameSaveOnHeap;
@@ -842,6 +859,15 @@ protected:
     bool m_hasParameterOtherThanIdentifier : 1;
     bool m_allowSuperCall : 1;
     bool m_allowSuperProperty : 1;
+    // inline property slots of objects created by `new` with this function
+    // grows to the largest property count seen at the end of construction
+    uint8_t m_inlinePropertySlotCountForConstruct : 5;
+
+#if defined(ENABLE_JIT)
+    // tier-up counters of JITCompiler. kept here to survive regeneration of ByteCodeBlock
+    uint32_t m_jitInvocationCount;
+    uint32_t m_jitBackEdgeCount;
+#endif
 
 #ifndef NDEBUG
     ASTScopeContext* m_scopeContext;
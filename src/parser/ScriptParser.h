@@ -74,6 +74,10 @@ private:
     void dumpCodeBlockTree(InterpretedCodeBlock* topCodeBlock);
 #endif
 
+#if defined(ENABLE_CODE_CACHE)
+    void recursivelyGenerateChildrenByteCodeForCache(InterpretedCodeBlock* parent);
+#endif
+
 #ifdef ESCARGOT_DEBUGGER
     void recursivelyGenerateChildrenByteCode(InterpretedCodeBlock* topCodeBlock);
     InitializeScriptResult initializeScriptWithDebugger(String* source, String* srcName, InterpretedCodeBlock* parentCodeBlock, bool isModule, bool isEvalMode, bool isEvalCodeInFunction, bool inWithOperation, bool strictFromOutside, bool allowSuperCall, bool allowSuperProperty, bool allowNewTarget);
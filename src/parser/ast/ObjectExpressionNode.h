@@ -44,7 +44,14 @@ public:
     virtual ASTNodeType type() override { return ASTNodeType::ObjectExpression; }
     virtual void generateExpressionByteCode(ByteCodeBlock* codeBlock, ByteCodeGenerateContext* context, ByteCodeRegisterIndex dstRegister) override
     {
-        codeBlock->pushCode(CreateObject(ByteCodeLOC(m_loc.index), dstRegister), context, this);
+        // reserve inline slots for properties written in the literal
+        size_t propertyCount = 0;
+        for (SentinelNode* property = m_properties.begin(); property != m_properties.end(); property = property->next()) {
+            if (property->astNode()->isProperty()) {
+                propertyCount++;
+            }
+        }
+        codeBlock->pushCode(CreateObject(ByteCodeLOC(m_loc.index), dstRegister, std::min(propertyCount, (size_t)ESCARGOT_OBJECT_INLINE_PROPERTY_SLOT_MAX)), context, this);
         size_t objIndex = dstRegister;
         for (SentinelNode* property = m_properties.begin(); property != m_properties.end(); property = property->next()) {
             if (property->astNode()->isProperty()) {
@@ -79,8 +79,13 @@ ArrayBufferObject::ArrayBufferObject(ExecutionState& state, Object* proto)
                                    nullptr, nullptr, nullptr);
 }
 
-ArrayBufferObject::ArrayBufferObject(ExecutionState& state, ArrayBufferObject::FromExternalMemoryTag)
-    : Object(state, state.context()->globalObject()->arrayBufferPrototype(), ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER)
+ArrayBufferObject::ArrayBufferObject(ExecutionState& state, ArrayBufferObject::FromExternalMemoryTag tag)
+    : ArrayBufferObject(state, state.context()->globalObject()->arrayBufferPrototype(), tag)
+{
+}
+
+ArrayBufferObject::ArrayBufferObject(ExecutionState& state, Object* proto, ArrayBufferObject::FromExternalMemoryTag)
+    : Object(state, proto, ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER)
     , m_context(state.context())
     , m_data(nullptr)
     , m_bytelength(0)
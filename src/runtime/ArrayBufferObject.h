@@ -97,7 +97,10 @@ public:
     void* operator new(size_t size);
     void* operator new[](size_t size) = delete;
 
-private:
+protected:
+    // buffer memory is managed by subclass. finalizer is not registered
+    ArrayBufferObject(ExecutionState& state, Object* proto, FromExternalMemoryTag);
+
     Context* m_context;
     uint8_t* m_data;
     size_t m_bytelength;
@@ -34,9 +34,11 @@ ArrayObject::ArrayObject(ExecutionState& state)
 ArrayObject::ArrayObject(ExecutionState& state, Object* proto)
     : Object(state, proto, ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER)
     , m_arrayLength(0)
+    , m_elementKind(Int32Elements)
 #if !defined(ESCARGOT_64) || !defined(ESCARGOT_USE_32BIT_IN_64BIT)
     , m_fastModeData(nullptr)
 #endif
+    , m_unboxedElements(nullptr)
 {
     if (UNLIKELY(state.context()->vmInstance()->didSomePrototypeObjectDefineIndexedProperty())) {
         ensureRareData()->m_isFastModeArrayObject = false;
@@ -83,9 +85,32 @@ ArrayObject::ArrayObject(ExecutionState& state, const Value* src, const uint64_t
 {
 }
 
+static ArrayObject::ElementKind elementKindForValues(const Value* src, const uint64_t& size)
+{
+    ArrayObject::ElementKind kind = ArrayObject::Int32Elements;
+    for (size_t i = 0; i < size; i++) {
+        if (src[i].isInt32() && src[i].asInt32() != ESCARGOT_ARRAY_INT32_ELEMENT_HOLE) {
+            continue;
+        } else if (src[i].isNumber()) {
+            kind = ArrayObject::DoubleElements;
+        } else {
+            return ArrayObject::GenericElements;
+        }
+    }
+    return kind;
+}
+
 ArrayObject::ArrayObject(ExecutionState& state, Object* proto, const Value* src, const uint64_t& size)
-    : ArrayObject(state, proto, size)
+    : ArrayObject(state, proto)
 {
+    if (UNLIKELY(size > ((1LL << 32LL) - 1LL))) {
+        ErrorObject::throwBuiltinError(state, ErrorObject::RangeError, ErrorObject::Messages::GlobalObject_InvalidArrayLength);
+    }
+
+    // pick backing store up front to avoid transitions while copying
+    m_elementKind = elementKindForValues(src, size);
+    setArrayLength(state, size, true);
+
     // Let array be ! ArrayCreate(0).
     // Let n be 0.
     // For each element e of elements, do
@@ -186,7 +211,7 @@ bool ArrayObject::defineOwnProperty(ExecutionState& state, const ObjectPropertyN
     if (LIKELY(isFastModeArray())) {
         if (LIKELY(idx != Value::InvalidArrayIndexValue)) {
             uint32_t len = arrayLength(state);
-            if (len > idx && !m_fastModeData[idx].isEmpty()) {
+            if (len > idx && !fastModeArrayValue(idx).isEmpty()) {
                 // Non-empty slot of fast-mode array always has {writable:true, enumerable:true, configurable:true}.
                 // So, when new desciptor is not present, keep {w:true, e:true, c:true}
                 if (UNLIKELY(!(desc.isValuePresentAlone() || desc.isDataWritableEnumerableConfigurable()))) {
@@ -213,7 +238,7 @@ bool ArrayObject::defineOwnProperty(ExecutionState& state, const ObjectPropertyN
                     goto NonFastPath;
                 }
             }
-            m_fastModeData[idx] = desc.value();
+            setFastModeArrayValueWithoutExpanding(state, idx, desc.value());
             return true;
         }
     }
@@ -248,8 +273,8 @@ bool ArrayObject::deleteOwnProperty(ExecutionState& state, const ObjectPropertyN
         if (LIKELY(idx != Value::InvalidArrayIndexValue)) {
             uint64_t len = arrayLength(state);
             if (idx < len) {
-                if (!m_fastModeData[idx].isEmpty()) {
-                    m_fastModeData[idx] = Value(Value::EmptyValue);
+                if (!fastModeArrayValue(idx).isEmpty()) {
+                    setFastModeArrayValueWithoutExpanding(state, idx, Value(Value::EmptyValue));
                     ensureRareData()->m_shouldUpdateEnumerateObject = true;
                 }
                 return true;
@@ -266,7 +291,7 @@ void ArrayObject::enumeration(ExecutionState& state, bool (*callback)(ExecutionS
         size_t len = arrayLength(state);
         for (size_t i = 0; i < len; i++) {
             ASSERT(isFastModeArray());
-            if (m_fastModeData[i].isEmpty())
+            if (fastModeArrayValue(i).isEmpty())
                 continue;
             if (!callback(state, this, ObjectPropertyName(state, Value(i)), ObjectStructurePropertyDescriptor::createDataDescriptor(ObjectStructurePropertyDescriptor::AllPresent), data)) {
                 return;
@@ -292,7 +317,7 @@ void ArrayObject::sort(ExecutionState& state, int64_t length, const std::functio
             Value* tempBuffer = canUseStack ? (Value*)alloca(byteLength) : CustomAllocator<Value>().allocate(orgLength);
 
             for (size_t i = 0; i < orgLength; i++) {
-                tempBuffer[i] = m_fastModeData[i];
+                tempBuffer[i] = fastModeArrayValue(i);
             }
 
             if (orgLength) {
@@ -314,7 +339,7 @@ void ArrayObject::sort(ExecutionState& state, int64_t length, const std::functio
 
             if (isFastModeArray()) {
                 for (size_t i = 0; i < orgLength; i++) {
-                    m_fastModeData[i] = tempBuffer[i];
+                    setFastModeArrayValueWithoutExpanding(state, i, tempBuffer[i]);
                 }
             }
 
@@ -348,11 +373,19 @@ void ArrayObject::convertIntoNonFastMode(ExecutionState& state)
 
     auto length = arrayLength(state);
     for (size_t i = 0; i < length; i++) {
-        if (!m_fastModeData[i].isEmpty()) {
-            defineOwnPropertyThrowsExceptionWhenStrictMode(state, ObjectPropertyName(state, Value(i)), ObjectPropertyDescriptor(m_fastModeData[i], ObjectPropertyDescriptor::AllPresent));
+        Value v = fastModeArrayValue(i);
+        if (!v.isEmpty()) {
+            defineOwnPropertyThrowsExceptionWhenStrictMode(state, ObjectPropertyName(state, Value(i)), ObjectPropertyDescriptor(v, ObjectPropertyDescriptor::AllPresent));
         }
     }
 
+    if (m_elementKind != GenericElements) {
+        GC_FREE(m_unboxedElements);
+        m_unboxedElements = nullptr;
+        m_elementKind = GenericElements;
+        return;
+    }
+
 #if defined(ESCARGOT_64) && defined(ESCARGOT_USE_32BIT_IN_64BIT)
     m_fastModeData.resizeWithUninitializedValues(length, 0);
 #else
@@ -361,6 +394,255 @@ void ArrayObject::convertIntoNonFastMode(ExecutionState& state)
 #endif
 }
 
+size_t ArrayObject::fastModeBufferCapacity()
+{
+    size_t capacity = hasRareData() ? (size_t)rareData()->m_arrayObjectFastModeBufferCapacity : 0;
+    return std::max(capacity, (size_t)m_arrayLength);
+}
+
+void ArrayObject::setFastModeArrayValueSlowCase(ExecutionState& state, size_t idx, const Value& v)
+{
+    ASSERT(m_elementKind != GenericElements);
+    if (v.isEmpty()) {
+        if (m_elementKind == Int32Elements) {
+            int32Elements()[idx] = ESCARGOT_ARRAY_INT32_ELEMENT_HOLE;
+        } else {
+            setDoubleElementHole(doubleElements(), idx);
+        }
+        return;
+    }
+
+    transitionElementKind(v.isNumber() ? DoubleElements : GenericElements);
+    setFastModeArrayValueWithoutExpanding(state, idx, v);
+}
+
+void ArrayObject::transitionElementKind(ElementKind newKind)
+{
+    ASSERT(isFastModeArray());
+    ASSERT(newKind > m_elementKind);
+
+    size_t length = m_arrayLength;
+    size_t capacity = fastModeBufferCapacity();
+    void* oldElements = m_unboxedElements;
+    ElementKind oldKind = (ElementKind)m_elementKind;
+
+    if (newKind == DoubleElements) {
+        ASSERT(oldKind == Int32Elements);
+        int32_t* from = int32Elements();
+        double* to = capacity ? (double*)GC_MALLOC_ATOMIC(sizeof(double) * capacity) : nullptr;
+        for (size_t i = 0; i < length; i++) {
+            if (from[i] == ESCARGOT_ARRAY_INT32_ELEMENT_HOLE) {
+                setDoubleElementHole(to, i);
+            } else {
+                to[i] = from[i];
+            }
+        }
+        m_unboxedElements = to;
+        m_elementKind = DoubleElements;
+    } else {
+        ASSERT(newKind == GenericElements);
+        // read elements through current kind while filling generic storage
+#if defined(ESCARGOT_64) && defined(ESCARGOT_USE_32BIT_IN_64BIT)
+        m_fastModeData.resizeWithUninitializedValues(0, capacity);
+#else
+        m_fastModeData = capacity ? (EncodedValue*)GC_MALLOC(sizeof(EncodedValue) * capacity) : nullptr;
+#endif
+        for (size_t i = 0; i < length; i++) {
+            m_fastModeData[i] = fastModeArrayValue(i);
+        }
+        m_unboxedElements = nullptr;
+        m_elementKind = GenericElements;
+    }
+
+    if (oldElements) {
+        GC_FREE(oldElements);
+    }
+}
+
+void ArrayObject::resizeUnboxedElements(uint32_t oldLength, uint32_t newLength, bool useFitStorage)
+{
+    ASSERT(m_elementKind != GenericElements);
+    // same growing policy with generic storage in setArrayLength
+    size_t elementSize = m_elementKind == Int32Elements ? sizeof(int32_t) : sizeof(double);
+    size_t newCapacity = 0;
+    bool shouldReallocate = true;
+    if (useFitStorage || oldLength == 0 || newLength <= 128) {
+        newCapacity = newLength;
+        if (hasRareData()) {
+            rareData()->m_arrayObjectFastModeBufferCapacity = 0;
+        }
+    } else {
+        const size_t minExpandCountForUsingLog2Function = 3;
+        auto rd = ensureRareData();
+        size_t oldCapacity = rd->m_arrayObjectFastModeBufferCapacity ? (size_t)rd->m_arrayObjectFastModeBufferCapacity : oldLength;
+        if (newLength > oldCapacity) {
+            if (rd->m_arrayObjectFastModeBufferExpandCount >= minExpandCountForUsingLog2Function) {
+                ComputeReservedCapacityFunctionWithLog2<> f;
+                newCapacity = f(newLength);
+            } else {
+                ComputeReservedCapacityFunctionWithPercent<130> f;
+                newCapacity = f(newLength);
+            }
+            rd->m_arrayObjectFastModeBufferCapacity = newCapacity;
+            if (rd->m_arrayObjectFastModeBufferExpandCount < minExpandCountForUsingLog2Function) {
+                rd->m_arrayObjectFastModeBufferExpandCount++;
+            }
+        } else {
+            rd->m_arrayObjectFastModeBufferCapacity = oldCapacity;
+            shouldReallocate = false;
+        }
+    }
+
+    if (shouldReallocate) {
+        void* newElements = newCapacity ? GC_MALLOC_ATOMIC(elementSize * newCapacity) : nullptr;
+        if (m_unboxedElements) {
+            memcpy(newElements, m_unboxedElements, elementSize * std::min(oldLength, newLength));
+            GC_FREE(m_unboxedElements);
+        }
+        m_unboxedElements = newElements;
+    }
+
+    if (m_elementKind == Int32Elements) {
+        int32_t* elements = int32Elements();
+        for (size_t i = oldLength; i < newLength; i++) {
+            elements[i] = ESCARGOT_ARRAY_INT32_ELEMENT_HOLE;
+        }
+    } else {
+        double* elements = doubleElements();
+        for (size_t i = oldLength; i < newLength; i++) {
+            setDoubleElementHole(elements, i);
+        }
+    }
+}
+
+// Int32Elements can only match a search value which is exactly an int32.
+// others are mapped to hole value so that only empty slots stop the typed loops
+static int32_t searchValueForInt32Elements(double search)
+{
+    // range check comes first because casting NaN or out of range value to int32_t is undefined
+    if (search >= std::numeric_limits<int32_t>::min() && search <= std::numeric_limits<int32_t>::max()) {
+        int32_t searchInt32 = (int32_t)search;
+        if (searchInt32 == search) {
+            return searchInt32;
+        }
+    }
+    return ESCARGOT_ARRAY_INT32_ELEMENT_HOLE;
+}
+
+// Empty slots can be filled from prototype chain, so the typed loops stop there
+// and report the position through `index` for the generic path to resume
+bool ArrayObject::indexOfNumberInUnboxedElements(ExecutionState& state, const Value& searchElement, int64_t& index, int64_t length, int64_t& result)
+{
+    if (!isFastModeArray() || m_elementKind == GenericElements || !searchElement.isNumber()) {
+        return false;
+    }
+
+    int64_t to = std::min(length, (int64_t)arrayLength(state));
+    double search = searchElement.asNumber();
+    if (m_elementKind == Int32Elements) {
+        const int32_t* elements = int32Elements();
+        int32_t searchInt32 = searchValueForInt32Elements(search);
+        for (; index < to; index++) {
+            int32_t e = elements[index];
+            if (e == searchInt32) {
+                if (UNLIKELY(e == ESCARGOT_ARRAY_INT32_ELEMENT_HOLE)) {
+                    return false;
+                }
+                result = index;
+                return true;
+            }
+            if (UNLIKELY(e == ESCARGOT_ARRAY_INT32_ELEMENT_HOLE)) {
+                return false;
+            }
+        }
+    } else {
+        const double* elements = doubleElements();
+        for (; index < to; index++) {
+            // hole is a NaN, so it never matches
+            if (elements[index] == search) {
+                result = index;
+                return true;
+            }
+            if (UNLIKELY(isDoubleElementHole(elements, index))) {
+                return false;
+            }
+        }
+    }
+
+    if (to < length) {
+        return false;
+    }
+    result = -1;
+    return true;
+}
+
+bool ArrayObject::includesNumberInUnboxedElements(ExecutionState& state, const Value& searchElement, int64_t& index, int64_t length, bool& result)
+{
+    if (!isFastModeArray() || m_elementKind == GenericElements || !searchElement.isNumber()) {
+        return false;
+    }
+
+    int64_t to = std::min(length, (int64_t)arrayLength(state));
+    double search = searchElement.asNumber();
+    if (m_elementKind == Int32Elements) {
+        const int32_t* elements = int32Elements();
+        int32_t searchInt32 = searchValueForInt32Elements(search);
+        for (; index < to; index++) {
+            int32_t e = elements[index];
+            if (UNLIKELY(e == ESCARGOT_ARRAY_INT32_ELEMENT_HOLE)) {
+                return false;
+            }
+            if (e == searchInt32) {
+                result = true;
+                return true;
+            }
+        }
+    } else {
+        const double* elements = doubleElements();
+        bool searchNaN = std::isnan(search);
+        for (; index < to; index++) {
+            if (UNLIKELY(isDoubleElementHole(elements, index))) {
+                return false;
+            }
+            if (elements[index] == search || (searchNaN && std::isnan(elements[index]))) {
+                result = true;
+                return true;
+            }
+        }
+    }
+
+    if (to < length) {
+        return false;
+    }
+    result = false;
+    return true;
+}
+
+bool ArrayObject::fillFastModeArrayValues(ExecutionState& state, const Value& value, uint32_t from, uint32_t to)
+{
+    if (!isFastModeArray() || to > arrayLength(state)) {
+        return false;
+    }
+
+    if (from >= to) {
+        return true;
+    }
+
+    // store first one through normal path, so element kind becomes one which can hold the value
+    setFastModeArrayValueWithoutExpanding(state, from, value);
+    if (m_elementKind == Int32Elements) {
+        std::fill(int32Elements() + from + 1, int32Elements() + to, value.asInt32());
+    } else if (m_elementKind == DoubleElements) {
+        double d = doubleElements()[from];
+        std::fill(doubleElements() + from + 1, doubleElements() + to, d);
+    } else {
+        for (uint32_t i = from + 1; i < to; i++) {
+            m_fastModeData[i] = value;
+        }
+    }
+    return true;
+}
+
 bool ArrayObject::setArrayLength(ExecutionState& state, const Value& newLength)
 {
     bool isPrimitiveValue;
@@ -401,7 +683,9 @@ bool ArrayObject::setArrayLength(ExecutionState& state, const uint32_t newLength
         auto oldLength = arrayLength(state);
         if (LIKELY(oldLength != newLength)) {
             m_arrayLength = newLength;
-            if (useFitStorage || oldLength == 0 || newLength <= 128) {
+            if (m_elementKind != GenericElements) {
+                resizeUnboxedElements(oldLength, newLength, useFitStorage);
+            } else if (useFitStorage || oldLength == 0 || newLength <= 128) {
                 bool hasRD = hasRareData();
                 size_t oldCapacity = hasRD ? (size_t)rareData()->m_arrayObjectFastModeBufferCapacity : 0;
 #if defined(ESCARGOT_64) && defined(ESCARGOT_USE_32BIT_IN_64BIT)
@@ -543,7 +827,7 @@ ObjectGetResult ArrayObject::getVirtualValue(ExecutionState& state, const Object
     if (LIKELY(isFastModeArray())) {
         uint64_t idx = P.tryToUseAsArrayIndex();
         if (LIKELY(idx != Value::InvalidArrayIndexValue) && LIKELY(idx < arrayLength(state))) {
-            Value v = m_fastModeData[idx];
+            Value v = fastModeArrayValue(idx);
             if (LIKELY(!v.isEmpty())) {
                 return ObjectGetResult(v, true, true, true);
             }
@@ -558,7 +842,7 @@ ObjectHasPropertyResult ArrayObject::hasIndexedProperty(ExecutionState& state, c
     if (LIKELY(isFastModeArray())) {
         uint32_t idx = propertyName.tryToUseAsArrayIndex(state);
         if (LIKELY(idx != Value::InvalidArrayIndexValue) && LIKELY(idx < arrayLength(state))) {
-            Value v = m_fastModeData[idx];
+            Value v = fastModeArrayValue(idx);
             if (LIKELY(!v.isEmpty())) {
                 return ObjectHasPropertyResult(ObjectGetResult(v, true, true, true));
             }
@@ -572,7 +856,7 @@ ObjectGetResult ArrayObject::getIndexedProperty(ExecutionState& state, const Val
     if (LIKELY(isFastModeArray())) {
         uint32_t idx = property.tryToUseAsArrayIndex(state);
         if (LIKELY(idx != Value::InvalidArrayIndexValue) && LIKELY(idx < arrayLength(state))) {
-            Value v = m_fastModeData[idx];
+            Value v = fastModeArrayValue(idx);
             if (LIKELY(!v.isEmpty())) {
                 return ObjectGetResult(v, true, true, true);
             }
@@ -597,11 +881,11 @@ bool ArrayObject::setIndexedProperty(ExecutionState& state, const Value& propert
                 }
                 // fast, non-fast mode can be changed while changing length
                 if (LIKELY(isFastModeArray())) {
-                    m_fastModeData[idx] = value;
+                    setFastModeArrayValueWithoutExpanding(state, idx, value);
                     return true;
                 }
             } else {
-                m_fastModeData[idx] = value;
+                setFastModeArrayValueWithoutExpanding(state, idx, value);
                 return true;
             }
         }
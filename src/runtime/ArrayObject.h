@@ -28,6 +28,10 @@ namespace Escargot {
 
 #define ESCARGOT_ARRAY_NON_FASTMODE_MIN_SIZE 65536 * 16
 #define ESCARGOT_ARRAY_NON_FASTMODE_START_MIN_GAP 1024
+// Empty slot markers of unboxed element buffers.
+// int32 min is stored as double and every NaN is canonicalized on store, so these patterns never collide with a value
+#define ESCARGOT_ARRAY_INT32_ELEMENT_HOLE std::numeric_limits<int32_t>::min()
+#define ESCARGOT_ARRAY_DOUBLE_ELEMENT_HOLE 0x7ff4000000000000ULL
 
 class ArrayIteratorObject;
 
@@ -36,11 +40,22 @@ class ArrayObject : public Object {
     friend class ByteCodeInterpreter;
     friend class EnumerateObjectWithDestruction;
     friend class EnumerateObjectWithIteration;
+    friend class JSONStringifier;
     friend Value builtinArrayConstructor(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget);
     friend void initializeCustomAllocators();
     friend int getValidValueInArrayObject(void* ptr, GC_mark_custom_result* arr);
 
 public:
+    // Backing store of fast mode array. Arrays start with Int32Elements and move only forward
+    // (Int32Elements -> DoubleElements -> GenericElements) when a value which does not fit is stored.
+    // Int32Elements and DoubleElements keep raw numbers in a pointer-free buffer(m_unboxedElements),
+    // GenericElements uses m_fastModeData
+    enum ElementKind : uint8_t {
+        Int32Elements,
+        DoubleElements,
+        GenericElements,
+    };
+
     explicit ArrayObject(ExecutionState& state);
     explicit ArrayObject(ExecutionState& state, Object* proto);
     ArrayObject(ExecutionState& state, double size); // http://www.ecma-international.org/ecma-262/7.0/index.html#sec-arraycreate
@@ -80,6 +95,26 @@ public:
 
     static void iterateArrays(ExecutionState& state, HeapObjectIteratorCallback callback);
 
+    ElementKind elementKind() const
+    {
+        return (ElementKind)m_elementKind;
+    }
+
+    // Typed loops for Array.prototype builtins.
+    // They return false when this array is not in a shape they can handle, then caller should continue generic path from `index`
+    bool indexOfNumberInUnboxedElements(ExecutionState& state, const Value& searchElement, int64_t& index, int64_t length, int64_t& result);
+    bool includesNumberInUnboxedElements(ExecutionState& state, const Value& searchElement, int64_t& index, int64_t length, bool& result);
+    bool fillFastModeArrayValues(ExecutionState& state, const Value& value, uint32_t from, uint32_t to);
+    // returns false when idx is out of fast mode storage or slot is empty
+    bool tryGetFastModeArrayValue(ExecutionState& state, size_t idx, Value& result)
+    {
+        if (LIKELY(isFastModeArray() && idx < arrayLength(state))) {
+            result = fastModeArrayValue(idx);
+            return !result.isEmpty();
+        }
+        return false;
+    }
+
     void defineOwnIndexedPropertyWithExpandedLength(ExecutionState& state, const size_t& index, const Value& value)
     {
         ASSERT(index < arrayLength(state));
@@ -104,13 +139,71 @@ private:
         return hasRareData() ? rareData()->m_isArrayObjectLengthWritable : true;
     }
 
-    void setFastModeArrayValueWithoutExpanding(ExecutionState& state, size_t idx, const Value& v)
+    int32_t* int32Elements()
+    {
+        ASSERT(m_elementKind == Int32Elements);
+        return reinterpret_cast<int32_t*>(m_unboxedElements);
+    }
+
+    double* doubleElements()
+    {
+        ASSERT(m_elementKind == DoubleElements);
+        return reinterpret_cast<double*>(m_unboxedElements);
+    }
+
+    static bool isDoubleElementHole(const double* elements, size_t idx)
+    {
+        return reinterpret_cast<const uint64_t*>(elements)[idx] == ESCARGOT_ARRAY_DOUBLE_ELEMENT_HOLE;
+    }
+
+    static void setDoubleElementHole(double* elements, size_t idx)
+    {
+        reinterpret_cast<uint64_t*>(elements)[idx] = ESCARGOT_ARRAY_DOUBLE_ELEMENT_HOLE;
+    }
+
+    // returns EmptyValue for empty slot
+    ALWAYS_INLINE Value fastModeArrayValue(size_t idx)
+    {
+        ASSERT(idx < m_arrayLength);
+        if (LIKELY(m_elementKind == GenericElements)) {
+            return m_fastModeData[idx];
+        } else if (m_elementKind == Int32Elements) {
+            int32_t v = int32Elements()[idx];
+            return UNLIKELY(v == ESCARGOT_ARRAY_INT32_ELEMENT_HOLE) ? Value(Value::EmptyValue) : Value(v);
+        }
+        double* elements = doubleElements();
+        return UNLIKELY(isDoubleElementHole(elements, idx)) ? Value(Value::EmptyValue) : Value(elements[idx]);
+    }
+
+    // storing EmptyValue makes the slot empty
+    ALWAYS_INLINE void setFastModeArrayValueWithoutExpanding(ExecutionState& state, size_t idx, const Value& v)
     {
         ASSERT(isFastModeArray());
         ASSERT(idx < arrayLength(state));
-        m_fastModeData[idx] = v;
+        if (LIKELY(m_elementKind == GenericElements)) {
+            m_fastModeData[idx] = v;
+            return;
+        } else if (m_elementKind == Int32Elements) {
+            if (LIKELY(v.isInt32() && v.asInt32() != ESCARGOT_ARRAY_INT32_ELEMENT_HOLE)) {
+                int32Elements()[idx] = v.asInt32();
+                return;
+            }
+        } else if (LIKELY(v.isNumber())) {
+            double d = v.asNumber();
+            if (UNLIKELY(std::isnan(d))) {
+                d = std::numeric_limits<double>::quiet_NaN();
+            }
+            doubleElements()[idx] = d;
+            return;
+        }
+        setFastModeArrayValueSlowCase(state, idx, v);
     }
 
+    void setFastModeArrayValueSlowCase(ExecutionState& state, size_t idx, const Value& v);
+    void transitionElementKind(ElementKind newKind);
+    void resizeUnboxedElements(uint32_t oldLength, uint32_t newLength, bool useFitStorage);
+    size_t fastModeBufferCapacity();
+
     ALWAYS_INLINE uint32_t arrayLength(ExecutionState&)
     {
         return m_arrayLength;
@@ -123,11 +216,14 @@ private:
     ObjectGetResult getVirtualValue(ExecutionState& state, const ObjectPropertyName& P);
 
     uint32_t m_arrayLength;
+    uint8_t m_elementKind;
 #if defined(ESCARGOT_64) && defined(ESCARGOT_USE_32BIT_IN_64BIT)
     TightVectorWithNoSize<EncodedSmallValue, CustomAllocator<EncodedSmallValue>> m_fastModeData;
 #else
     ObjectPropertyValue* m_fastModeData;
 #endif
+    // int32_t or double buffer allocated as atomic. nullptr for GenericElements
+    void* m_unboxedElements;
 };
 
 class ArrayPrototypeObject : public ArrayObject {
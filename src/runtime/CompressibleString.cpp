@@ -49,8 +49,11 @@ CompressibleString::CompressibleString(VMInstance* instance)
 {
     m_bufferData.hasSpecialImpl = true;
 
-    auto& v = instance->compressibleStrings();
-    v.push_back(this);
+    {
+        VMInstanceFinalizerLocker locker;
+        auto& v = instance->compressibleStrings();
+        v.push_back(this);
+    }
     GC_REGISTER_FINALIZER_NO_ORDER(this, [](void* obj, void*) {
         CompressibleString* self = (CompressibleString*)obj;
         if (self->isCompressed()) {
@@ -59,6 +62,7 @@ CompressibleString::CompressibleString(VMInstance* instance)
             deallocateStringDataBuffer(const_cast<void*>(self->m_bufferData.buffer), self->m_bufferData.length * (self->m_bufferData.has8BitContent ? 1 : 2));
         }
 
+        VMInstanceFinalizerLocker locker;
         if (!self->m_isOwnerMayFreed) {
             self->m_vmInstance->compressibleStringsUncomressedBufferSize() -= self->decomressedBufferSize();
 
@@ -93,6 +93,7 @@ Context::Context(VMInstance* instance)
     m_globalObject->installBuiltins(stateForInit);
 
     // initialize object tag values after installation of builtins
+    PointerValue::g_plainObjectTag = Object(stateForInit).getTag();
     PointerValue::g_arrayObjectTag = ArrayObject(stateForInit).getTag();
     PointerValue::g_arrayPrototypeObjectTag = ArrayPrototypeObject(stateForInit).getTag();
 }
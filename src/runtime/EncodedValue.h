@@ -139,11 +139,36 @@ const int kSmiValueSize = PlatformSmiTagging::kSmiValueSize;
 #define HAS_SMI_TAG(value) \
     ((reinterpret_cast<intptr_t>(value) & ::Escargot::EncodedValueImpl::kSmiTagMask) == ::Escargot::EncodedValueImpl::kSmiTag)
 #endif
+
+#if defined(ESCARGOT_64)
+// On 64-bit, EncodedValue stores a double with the same bits as Value(Value::EncodeAsDouble, d)
+// Upper 16 bits of these are in 0x0001..0xFFFE while SMI, tags and pointers have 0x0000 or 0xFFFF there
+inline bool hasDoubleTag(intptr_t payload)
+{
+    return ((uint64_t)payload + DoubleEncodeOffset) >= ((uint64_t)DoubleEncodeOffset << 1);
+}
+
+inline intptr_t encodeDouble(const Value& from)
+{
+    ASSERT(from.isNumber());
+    if (from.isInt32()) {
+        return Value(Value::EncodeAsDouble, (double)from.asInt32()).payload();
+    }
+    return from.payload();
+}
+
+inline double decodeDouble(intptr_t payload)
+{
+    ASSERT(hasDoubleTag(payload));
+    return bitwise_cast<double>((int64_t)payload - DoubleEncodeOffset);
+}
+#endif
 } // namespace EncodedValueImpl
 
 
 // EncodedValue turns int, double values into pointer or odd value
 // so there is no conservative gc leak(there is no even value looks like pointer without pointers)
+// on 64-bit, double values are stored without allocation. their upper bits never look like an address
 // developers should use this class if want to save some Value on Heap
 // developers should not copy this value because this class changes DoubleInEncodedValue without copy it
 // just convert into Value and use it.
@@ -195,6 +220,11 @@ public:
         if (HAS_SMI_TAG(m_data.payload)) {
             return false;
         }
+#if defined(ESCARGOT_64)
+        if (EncodedValueImpl::hasDoubleTag(m_data.payload)) {
+            return false;
+        }
+#endif
 
         PointerValue* v = (PointerValue*)m_data.payload;
         return ((size_t)v) > ValueLast;
@@ -217,6 +247,11 @@ public:
 
     ALWAYS_INLINE operator Value() const
     {
+#if defined(ESCARGOT_64)
+        if (EncodedValueImpl::hasDoubleTag(m_data.payload)) {
+            return Value(EncodedValueImpl::decodeDouble(m_data.payload));
+        }
+#endif
         if (HAS_SMI_TAG(m_data.payload)) {
             int32_t value = EncodedValueImpl::PlatformSmiTagging::SmiToInt(m_data.payload);
             return Value(value);
@@ -237,26 +272,30 @@ public:
 
     bool isInt32()
     {
+#if defined(ESCARGOT_64)
+        return HAS_SMI_TAG(m_data.payload) && !EncodedValueImpl::hasDoubleTag(m_data.payload);
+#else
         return HAS_SMI_TAG(m_data.payload);
+#endif
     }
 
     uint32_t asInt32()
     {
-        ASSERT(HAS_SMI_TAG(m_data.payload));
+        ASSERT(isInt32());
         int32_t value = EncodedValueImpl::PlatformSmiTagging::SmiToInt(m_data.payload);
         return (uint32_t)value;
     }
 
     uint32_t asUint32()
     {
-        ASSERT(HAS_SMI_TAG(m_data.payload));
+        ASSERT(isInt32());
         int32_t value = EncodedValueImpl::PlatformSmiTagging::SmiToInt(m_data.payload);
         return (uint32_t)value;
     }
 
     uint32_t toUint32(ExecutionState& state)
     {
-        if (LIKELY(HAS_SMI_TAG(m_data.payload))) {
+        if (LIKELY(isInt32())) {
             int32_t value = EncodedValueImpl::PlatformSmiTagging::SmiToInt(m_data.payload);
             return (uint32_t)value;
         }
@@ -292,6 +331,9 @@ public:
         }
 
         if (from.isNumber()) {
+#if defined(ESCARGOT_64)
+            m_data.payload = EncodedValueImpl::encodeDouble(from);
+#else
             auto payload = m_data.payload;
 
             if (!HAS_SMI_TAG(payload) && ((size_t)payload > (size_t)ValueLast)) {
@@ -302,6 +344,7 @@ public:
                 }
             }
             m_data.payload = reinterpret_cast<intptr_t>(new DoubleInEncodedValue(from.asNumber()));
+#endif
             return;
         }
 
@@ -325,7 +368,11 @@ protected:
             if (from.isInt32() && EncodedValueImpl::PlatformSmiTagging::IsValidSmi(i32 = from.asInt32())) {
                 m_data.payload = EncodedValueImpl::PlatformSmiTagging::IntToSmi(i32);
             } else if (from.isNumber()) {
+#if defined(ESCARGOT_64)
+                m_data.payload = EncodedValueImpl::encodeDouble(from);
+#else
                 m_data.payload = reinterpret_cast<intptr_t>(new DoubleInEncodedValue(from.asNumber()));
+#endif
             } else {
 #ifdef ESCARGOT_32
                 m_data.payload = ~from.tag();
@@ -383,6 +430,10 @@ public:
 
     EncodedSmallValue(const EncodedValue& from)
     {
+        if (UNLIKELY(EncodedValueImpl::hasDoubleTag(from.payload()))) {
+            m_data = EncodedSmallValueData(new DoubleInEncodedValue(EncodedValueImpl::decodeDouble(from.payload())));
+            return;
+        }
         ASSERT(from.payload() <= std::numeric_limits<uint32_t>::max());
         m_data.payload = from.payload();
     }
@@ -455,6 +506,10 @@ public:
 
     ALWAYS_INLINE void operator=(const EncodedValue& from)
     {
+        if (UNLIKELY(EncodedValueImpl::hasDoubleTag(from.payload()))) {
+            operator=(Value(from));
+            return;
+        }
         ASSERT(from.payload() <= std::numeric_limits<uint32_t>::max());
         m_data.payload = from.payload();
     }
@@ -46,6 +46,8 @@ namespace Escargot {
 GlobalObject::GlobalObject(ExecutionState& state)
     : Object(state, ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER, Object::__ForGlobalBuiltin__)
     , m_context(state.context())
+    , m_lazyBuiltinGroups(0)
+    , m_inLazyBuiltinInstallation(false)
 #define INIT_BUILTIN_VALUE(builtin, TYPE, NAME) \
     , m_##builtin(nullptr)
 
@@ -64,6 +66,8 @@ void GlobalObject::installBuiltins(ExecutionState& state)
     // m_objectPrototype has been initialized ahead of any other builtins
     ASSERT(!!m_objectPrototype);
 
+    // builtin groups that are not used by other builtins during the initialization
+    // are deferred to reduce the cost of creating a new Context
     installFunction(state);
     installObject(state);
     installIterator(state);
@@ -74,34 +78,209 @@ void GlobalObject::installBuiltins(ExecutionState& state)
     installNumber(state);
     installBoolean(state);
     installArray(state);
-    installMath(state);
-    installDate(state);
-    installRegExp(state);
-    installJSON(state);
+    deferBuiltinGroupInstallation(state, BuiltinGroup::Math);
+    deferBuiltinGroupInstallation(state, BuiltinGroup::Date);
+    deferBuiltinGroupInstallation(state, BuiltinGroup::RegExp);
+    deferBuiltinGroupInstallation(state, BuiltinGroup::JSON);
 #if defined(ENABLE_ICU) && defined(ENABLE_INTL)
-    installIntl(state);
+    deferBuiltinGroupInstallation(state, BuiltinGroup::Intl);
 #endif
-    installPromise(state);
-    installProxy(state);
-    installReflect(state);
-    installArrayBuffer(state);
-    installDataView(state);
-    installTypedArray(state);
-    installMap(state);
-    installSet(state);
-    installWeakMap(state);
-    installWeakSet(state);
+    deferBuiltinGroupInstallation(state, BuiltinGroup::Promise);
+    deferBuiltinGroupInstallation(state, BuiltinGroup::Proxy);
+    deferBuiltinGroupInstallation(state, BuiltinGroup::Reflect);
+    deferBuiltinGroupInstallation(state, BuiltinGroup::ArrayBuffer);
+    deferBuiltinGroupInstallation(state, BuiltinGroup::DataView);
+    deferBuiltinGroupInstallation(state, BuiltinGroup::TypedArray);
+    deferBuiltinGroupInstallation(state, BuiltinGroup::Map);
+    deferBuiltinGroupInstallation(state, BuiltinGroup::Set);
+    deferBuiltinGroupInstallation(state, BuiltinGroup::WeakMap);
+    deferBuiltinGroupInstallation(state, BuiltinGroup::WeakSet);
     installGenerator(state);
     installAsyncFunction(state);
     installAsyncIterator(state);
     installAsyncFromSyncIterator(state);
     installAsyncGeneratorFunction(state);
+#if defined(ENABLE_THREADING)
+    deferBuiltinGroupInstallation(state, BuiltinGroup::SharedArrayBuffer);
+    deferBuiltinGroupInstallation(state, BuiltinGroup::Atomics);
+#endif
 #if defined(ENABLE_WASM)
     installWASM(state);
 #endif
     installOthers(state);
 }
 
+struct LazyBuiltinGlobal {
+    GlobalObject::BuiltinGroup m_group;
+    AtomicString StaticStrings::*m_name;
+};
+
+// globals defined by each deferred builtin group, in the order of their definition
+static const LazyBuiltinGlobal g_lazyBuiltinGlobals[] = {
+    { GlobalObject::BuiltinGroup::Math, &StaticStrings::Math },
+    { GlobalObject::BuiltinGroup::Date, &StaticStrings::Date },
+    { GlobalObject::BuiltinGroup::RegExp, &StaticStrings::RegExp },
+    { GlobalObject::BuiltinGroup::JSON, &StaticStrings::JSON },
+#if defined(ENABLE_ICU) && defined(ENABLE_INTL)
+    { GlobalObject::BuiltinGroup::Intl, &StaticStrings::Intl },
+#endif
+    { GlobalObject::BuiltinGroup::Promise, &StaticStrings::Promise },
+    { GlobalObject::BuiltinGroup::Proxy, &StaticStrings::Proxy },
+    { GlobalObject::BuiltinGroup::Reflect, &StaticStrings::Reflect },
+    { GlobalObject::BuiltinGroup::ArrayBuffer, &StaticStrings::ArrayBuffer },
+    { GlobalObject::BuiltinGroup::DataView, &StaticStrings::DataView },
+    { GlobalObject::BuiltinGroup::TypedArray, &StaticStrings::Int8Array },
+    { GlobalObject::BuiltinGroup::TypedArray, &StaticStrings::Int16Array },
+    { GlobalObject::BuiltinGroup::TypedArray, &StaticStrings::Int32Array },
+    { GlobalObject::BuiltinGroup::TypedArray, &StaticStrings::Uint8Array },
+    { GlobalObject::BuiltinGroup::TypedArray, &StaticStrings::Uint8ClampedArray },
+    { GlobalObject::BuiltinGroup::TypedArray, &StaticStrings::Uint16Array },
+    { GlobalObject::BuiltinGroup::TypedArray, &StaticStrings::Uint32Array },
+    { GlobalObject::BuiltinGroup::TypedArray, &StaticStrings::Float32Array },
+    { GlobalObject::BuiltinGroup::TypedArray, &StaticStrings::Float64Array },
+    { GlobalObject::BuiltinGroup::TypedArray, &StaticStrings::BigInt64Array },
+    { GlobalObject::BuiltinGroup::TypedArray, &StaticStrings::BigUint64Array },
+    { GlobalObject::BuiltinGroup::Map, &StaticStrings::Map },
+    { GlobalObject::BuiltinGroup::Set, &StaticStrings::Set },
+    { GlobalObject::BuiltinGroup::WeakMap, &StaticStrings::WeakMap },
+    { GlobalObject::BuiltinGroup::WeakSet, &StaticStrings::WeakSet },
+#if defined(ENABLE_THREADING)
+    { GlobalObject::BuiltinGroup::SharedArrayBuffer, &StaticStrings::SharedArrayBuffer },
+    { GlobalObject::BuiltinGroup::Atomics, &StaticStrings::Atomics },
+#endif
+};
+
+static ObjectPropertyNativeGetterSetterData lazyBuiltinPlaceholderGetterSetterData(
+    true, false, true, &GlobalObject::lazyBuiltinPlaceholderGetter, &GlobalObject::lazyBuiltinPlaceholderSetter);
+
+static uint64_t builtinGroupBit(GlobalObject::BuiltinGroup group)
+{
+    return static_cast<uint64_t>(1) << static_cast<size_t>(group);
+}
+
+void GlobalObject::deferBuiltinGroupInstallation(ExecutionState& state, BuiltinGroup group)
+{
+    m_lazyBuiltinGroups |= builtinGroupBit(group);
+
+    const StaticStrings& strings = state.context()->staticStrings();
+    for (size_t i = 0; i < sizeof(g_lazyBuiltinGlobals) / sizeof(LazyBuiltinGlobal); i++) {
+        if (g_lazyBuiltinGlobals[i].m_group == group) {
+            // placeholder has the same attributes as the global defined by the installer
+            defineNativeDataAccessorProperty(state, ObjectPropertyName(strings.*(g_lazyBuiltinGlobals[i].m_name)),
+                                             &lazyBuiltinPlaceholderGetterSetterData, Value(i));
+        }
+    }
+}
+
+void GlobalObject::installLazyBuiltinGroup(BuiltinGroup group)
+{
+    if (!(m_lazyBuiltinGroups & builtinGroupBit(group))) {
+        return;
+    }
+    m_lazyBuiltinGroups &= ~builtinGroupBit(group);
+
+    ExecutionState state(m_context);
+    bool inLazyBuiltinInstallation = m_inLazyBuiltinInstallation;
+    m_inLazyBuiltinInstallation = true;
+
+    switch (group) {
+    case BuiltinGroup::Math:
+        installMath(state);
+        break;
+    case BuiltinGroup::Date:
+        installDate(state);
+        break;
+    case BuiltinGroup::RegExp:
+        installRegExp(state);
+        break;
+    case BuiltinGroup::JSON:
+        installJSON(state);
+        break;
+#if defined(ENABLE_ICU) && defined(ENABLE_INTL)
+    case BuiltinGroup::Intl:
+        installIntl(state);
+        break;
+#endif
+    case BuiltinGroup::Promise:
+        installPromise(state);
+        break;
+    case BuiltinGroup::Proxy:
+        installProxy(state);
+        break;
+    case BuiltinGroup::Reflect:
+        installReflect(state);
+        break;
+    case BuiltinGroup::ArrayBuffer:
+        installArrayBuffer(state);
+        break;
+    case BuiltinGroup::DataView:
+        installDataView(state);
+        break;
+    case BuiltinGroup::TypedArray:
+        installTypedArray(state);
+        break;
+    case BuiltinGroup::Map:
+        installMap(state);
+        break;
+    case BuiltinGroup::Set:
+        installSet(state);
+        break;
+    case BuiltinGroup::WeakMap:
+        installWeakMap(state);
+        break;
+    case BuiltinGroup::WeakSet:
+        installWeakSet(state);
+        break;
+#if defined(ENABLE_THREADING)
+    case BuiltinGroup::SharedArrayBuffer:
+        installSharedArrayBuffer(state);
+        break;
+    case BuiltinGroup::Atomics:
+        installAtomics(state);
+        break;
+#endif
+    default:
+        ASSERT_NOT_REACHED();
+        break;
+    }
+
+    m_inLazyBuiltinInstallation = inLazyBuiltinInstallation;
+}
+
+void GlobalObject::installLazyBuiltinGroups()
+{
+    for (size_t i = 0; i < sizeof(g_lazyBuiltinGlobals) / sizeof(LazyBuiltinGlobal); i++) {
+        installLazyBuiltinGroup(g_lazyBuiltinGlobals[i].m_group);
+    }
+    ASSERT(!m_lazyBuiltinGroups);
+}
+
+bool GlobalObject::isLazyBuiltinPlaceholder(const ObjectStructureItem& item)
+{
+    return item.m_descriptor.isNativeAccessorProperty() && item.m_descriptor.nativeGetterSetterData()->m_getter == lazyBuiltinPlaceholderGetter;
+}
+
+Value GlobalObject::lazyBuiltinPlaceholderGetter(ExecutionState& state, Object* self, const EncodedValue& privateDataFromObjectPrivateArea)
+{
+    GlobalObject* globalObject = self->asGlobalObject();
+    AtomicString name = state.context()->staticStrings().*(g_lazyBuiltinGlobals[Value(privateDataFromObjectPrivateArea).asUInt32()].m_name);
+    globalObject->installLazyBuiltinGroup(g_lazyBuiltinGlobals[Value(privateDataFromObjectPrivateArea).asUInt32()].m_group);
+
+    // the placeholder has been replaced with the global defined by the installer
+    auto findResult = globalObject->structure()->findProperty(name);
+    ASSERT(findResult.first != SIZE_MAX && findResult.second.value()->m_descriptor.isPlainDataProperty());
+    return globalObject->m_values[findResult.first];
+}
+
+bool GlobalObject::lazyBuiltinPlaceholderSetter(ExecutionState& state, Object* self, EncodedValue& privateDataFromObjectPrivateArea, const Value& setterInputData)
+{
+    // privateDataFromObjectPrivateArea refers to the value slot of the placeholder,
+    // which keeps its position when the installer replaces the placeholder
+    self->asGlobalObject()->installLazyBuiltinGroup(g_lazyBuiltinGlobals[Value(privateDataFromObjectPrivateArea).asUInt32()].m_group);
+    privateDataFromObjectPrivateArea = setterInputData;
+    return true;
+}
+
 Value builtinSpeciesGetter(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
 {
     return thisValue;
@@ -184,6 +363,30 @@ ObjectGetResult GlobalObject::getOwnProperty(ExecutionState& state, const Object
     return r;
 }
 
+bool GlobalObject::defineOwnProperty(ExecutionState& state, const ObjectPropertyName& P, const ObjectPropertyDescriptor& desc) ESCARGOT_OBJECT_SUBCLASS_MUST_REDEFINE
+{
+    if (UNLIKELY(m_lazyBuiltinGroups || m_inLazyBuiltinInstallation)) {
+        auto findResult = structure()->findProperty(P.toObjectStructurePropertyName(state));
+        if (findResult.first != SIZE_MAX && isLazyBuiltinPlaceholder(*findResult.second.value())) {
+            size_t idx = findResult.first;
+            if (m_inLazyBuiltinInstallation) {
+                // the installer defines the global in place of its placeholder
+                ASSERT(desc.isDataDescriptor() && desc.isValuePresent());
+                auto attributes = findResult.second.value()->m_descriptor.nativeGetterSetterData()->m_presentAttributes;
+                m_structure = m_structure->replacePropertyDescriptor(idx, ObjectStructurePropertyDescriptor::createDataDescriptor((ObjectStructurePropertyDescriptor::PresentAttribute)attributes));
+                m_values[idx] = desc.value();
+                return true;
+            }
+            installLazyBuiltinGroup(g_lazyBuiltinGlobals[Value(m_values[idx]).asUInt32()].m_group);
+        } else if (m_inLazyBuiltinInstallation) {
+            // the placeholder was deleted or replaced before the installation
+            return true;
+        }
+    }
+
+    return Object::defineOwnProperty(state, P, desc);
+}
+
 Value GlobalObject::eval(ExecutionState& state, const Value& arg)
 {
     if (arg.isString()) {
@@ -201,13 +201,23 @@ class FunctionObject;
 #define GLOBALOBJECT_BUILTIN_WEAKSET(F, NAME) \
     F(weakSet, FunctionObject, NAME)          \
     F(weakSetPrototype, Object, NAME)
+#if defined(ENABLE_THREADING)
+#define GLOBALOBJECT_BUILTIN_ATOMICS(F, NAME) \
+    F(atomics, Object, NAME)
+#define GLOBALOBJECT_BUILTIN_SHAREDARRAYBUFFER(F, NAME) \
+    F(sharedArrayBuffer, FunctionObject, NAME)          \
+    F(sharedArrayBufferPrototype, Object, NAME)
+#else
+#define GLOBALOBJECT_BUILTIN_ATOMICS(F, NAME)
+#define GLOBALOBJECT_BUILTIN_SHAREDARRAYBUFFER(F, NAME)
+#endif
 //WebAssembly
 #if defined(ENABLE_WASM)
 #define GLOBALOBJECT_BUILTIN_WASM(F, NAME)     \
-    F(wasmModulePrototype, Object, Name)       \
-    F(wasmMemoryPrototype, Object, Name)       \
-    F(wasmTablePrototype, Object, Name)        \
-    F(wasmGlobalPrototype, Object, Name)       \
+    F(wasmModulePrototype, Object, NAME)       \
+    F(wasmMemoryPrototype, Object, NAME)       \
+    F(wasmTablePrototype, Object, NAME)        \
+    F(wasmGlobalPrototype, Object, NAME)       \
     F(wasmCompileErrorPrototype, Object, NAME) \
     F(wasmLinkErrorPrototype, Object, NAME)    \
     F(wasmRuntimeErrorPrototype, Object, NAME)
@@ -223,6 +233,7 @@ class FunctionObject;
     GLOBALOBJECT_BUILTIN_ASYNCFUNCTION(F, AsyncFunction)                 \
     GLOBALOBJECT_BUILTIN_ASYNCGENERATOR(F, AsyncGenerator)               \
     GLOBALOBJECT_BUILTIN_ASYNCITERATOR(F, AsyncIterator)                 \
+    GLOBALOBJECT_BUILTIN_ATOMICS(F, Atomics)                             \
     GLOBALOBJECT_BUILTIN_BOOLEAN(F, Boolean)                             \
     GLOBALOBJECT_BUILTIN_DATAVIEW(F, DataView)                           \
     GLOBALOBJECT_BUILTIN_DATE(F, Date)                                   \
@@ -243,6 +254,7 @@ class FunctionObject;
     GLOBALOBJECT_BUILTIN_REFLECT(F, Reflect)                             \
     GLOBALOBJECT_BUILTIN_REGEXP(F, RegExp)                               \
     GLOBALOBJECT_BUILTIN_SET(F, Set)                                     \
+    GLOBALOBJECT_BUILTIN_SHAREDARRAYBUFFER(F, SharedArrayBuffer)         \
     GLOBALOBJECT_BUILTIN_STRING(F, String)                               \
     GLOBALOBJECT_BUILTIN_SYMBOL(F, Symbol)                               \
     GLOBALOBJECT_BUILTIN_BIGINT(F, BigInt)                               \
@@ -260,6 +272,45 @@ public:
     friend class GlobalEnvironmentRecord;
     friend class IdentifierNode;
 
+    // group names used in GLOBALOBJECT_BUILTIN_LIST
+    enum class BuiltinGroup : uint8_t {
+        ArrayBuffer,
+        Array,
+        AsyncFromSyncIterator,
+        AsyncFunction,
+        AsyncGenerator,
+        AsyncIterator,
+        Atomics,
+        Boolean,
+        DataView,
+        Date,
+        Error,
+        Eval,
+        Function,
+        Generator,
+        Intl,
+        Iterator,
+        JSON,
+        Map,
+        Math,
+        Number,
+        Object,
+        Others,
+        Promise,
+        Proxy,
+        Reflect,
+        RegExp,
+        Set,
+        SharedArrayBuffer,
+        String,
+        Symbol,
+        BigInt,
+        TypedArray,
+        WeakMap,
+        WeakSet,
+        WebAssembly,
+    };
+
     explicit GlobalObject(ExecutionState& state);
 
     virtual bool isGlobalObject() const override
@@ -268,15 +319,23 @@ public:
     }
 
     void installBuiltins(ExecutionState& state);
+    // install every builtin group whose installation has been deferred until its first use
+    void installLazyBuiltinGroups();
+
+    static Value lazyBuiltinPlaceholderGetter(ExecutionState& state, Object* self, const EncodedValue& privateDataFromObjectPrivateArea);
+    static bool lazyBuiltinPlaceholderSetter(ExecutionState& state, Object* self, EncodedValue& privateDataFromObjectPrivateArea, const Value& setterInputData);
 
     Value eval(ExecutionState& state, const Value& arg);
     Value evalLocal(ExecutionState& state, const Value& arg, Value thisValue, InterpretedCodeBlock* parentCodeBlock, bool inWithOperation); // we get isInWithOperation as parameter because this affects bytecode
 
-#define DECLARE_BUILTIN_FUNC(builtin, TYPE, NAME) \
-    TYPE* builtin()                               \
-    {                                             \
-        ASSERT(!!m_##builtin);                    \
-        return m_##builtin;                       \
+#define DECLARE_BUILTIN_FUNC(builtin, TYPE, NAME)        \
+    TYPE* builtin()                                      \
+    {                                                    \
+        if (UNLIKELY(!m_##builtin)) {                    \
+            installLazyBuiltinGroup(BuiltinGroup::NAME); \
+        }                                                \
+        ASSERT(!!m_##builtin);                           \
+        return m_##builtin;                              \
     }
 
     GLOBALOBJECT_BUILTIN_LIST(DECLARE_BUILTIN_FUNC)
@@ -289,6 +348,7 @@ public:
 
     virtual ObjectHasPropertyResult hasProperty(ExecutionState& state, const ObjectPropertyName& P) override ESCARGOT_OBJECT_SUBCLASS_MUST_REDEFINE;
     virtual ObjectGetResult getOwnProperty(ExecutionState& state, const ObjectPropertyName& P) override ESCARGOT_OBJECT_SUBCLASS_MUST_REDEFINE;
+    virtual bool defineOwnProperty(ExecutionState& state, const ObjectPropertyName& P, const ObjectPropertyDescriptor& desc) override ESCARGOT_OBJECT_SUBCLASS_MUST_REDEFINE;
 
     void* operator new(size_t size)
     {
@@ -298,6 +358,8 @@ public:
 
 private:
     Context* m_context;
+    uint64_t m_lazyBuiltinGroups; // bit set of BuiltinGroup whose installation is deferred
+    bool m_inLazyBuiltinInstallation;
 
 #define DECLARE_BUILTIN_VALUE(builtin, TYPE, NAME) \
     TYPE* m_##builtin;
@@ -339,10 +401,20 @@ private:
     void installAsyncIterator(ExecutionState& state);
     void installAsyncFromSyncIterator(ExecutionState& state);
     void installAsyncGeneratorFunction(ExecutionState& state);
+#if defined(ENABLE_THREADING)
+    void installSharedArrayBuffer(ExecutionState& state);
+    void installAtomics(ExecutionState& state);
+#endif
 #if defined(ENABLE_WASM)
     void installWASM(ExecutionState& state);
 #endif
     void installOthers(ExecutionState& state);
+
+    // a deferred builtin group leaves a placeholder property for each of its globals
+    // and the group is installed when any of its builtins or placeholders is accessed
+    void deferBuiltinGroupInstallation(ExecutionState& state, BuiltinGroup group);
+    void installLazyBuiltinGroup(BuiltinGroup group);
+    static bool isLazyBuiltinPlaceholder(const ObjectStructureItem& item);
 };
 } // namespace Escargot
 
@@ -68,7 +68,7 @@ Value builtinArrayConstructor(ExecutionState& state, Value thisValue, size_t arg
         if (argc > 1 || !val.isInt32()) {
             if (array->isFastModeArray()) {
                 for (size_t idx = 0; idx < argc; idx++) {
-                    array->m_fastModeData[idx] = argv[idx];
+                    array->setFastModeArrayValueWithoutExpanding(state, idx, argv[idx]);
                 }
             } else {
                 for (size_t idx = 0; idx < argc; idx++) {
@@ -871,6 +871,13 @@ static Value builtinArrayIndexOf(ExecutionState& state, Value thisValue, size_t
     ASSERT(doubleK >= 0);
     int64_t k = doubleK;
 
+    if (O->isArrayObject()) {
+        int64_t result;
+        if (O->asArrayObject()->indexOfNumberInUnboxedElements(state, argv[0], k, len, result)) {
+            return Value(result);
+        }
+    }
+
     // Repeat, while k<len
     while (k < len) {
         // Let kPresent be the result of calling the [[HasProperty]] internal method of O with argument ToString(k).
@@ -1034,6 +1041,9 @@ static Value builtinArrayFill(ExecutionState& state, Value thisValue, size_t arg
     int64_t fin = (relativeEnd < 0) ? std::max(len + relativeEnd, 0.0) : std::min(relativeEnd, (double)len);
 
     Value value = argv[0];
+    if (O->isArrayObject() && O->asArrayObject()->fillFastModeArrayValues(state, value, k, fin)) {
+        return O;
+    }
     while (k < fin) {
         O->setIndexedPropertyThrowsException(state, Value(k), value);
         k++;
@@ -1244,6 +1254,15 @@ static Value builtinArrayIncludes(ExecutionState& state, Value thisValue, size_t
 
     ASSERT(doubleK >= 0);
 
+    if (O->isArrayObject() && doubleK < len) {
+        int64_t k = doubleK;
+        bool result;
+        if (O->asArrayObject()->includesNumberInUnboxedElements(state, searchElement, k, len, result)) {
+            return Value(result);
+        }
+        doubleK = k;
+    }
+
     // Repeat, while k < len
     while (doubleK < len) {
         // Let elementK be the result of ? Get(O, ! ToString(k)).
@@ -1347,7 +1366,16 @@ static Value builtinArrayReduce(ExecutionState& state, Value thisValue, size_t a
         if (!kPresent)
             ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, state.context()->staticStrings().Array.string(), true, state.context()->staticStrings().reduce.string(), ErrorObject::Messages::GlobalObject_ReduceError);
     }
+    ArrayObject* array = O->isArrayObject() ? O->asArrayObject() : nullptr;
     while (k < len) { // 9
+        Value fastModeValue;
+        // callback can change the array, so fast path is checked for every element
+        if (array && array->tryGetFastModeArrayValue(state, k, fastModeValue)) {
+            Value fnargs[] = { accumulator, fastModeValue, Value(k), O };
+            accumulator = Object::call(state, callbackfn, Value(), 4, fnargs);
+            k++;
+            continue;
+        }
         ObjectHasPropertyResult kPresent = O->hasIndexedProperty(state, Value(k)); // 9.b
         if (kPresent) { // 9.c
             Value kValue = kPresent.value(state, ObjectPropertyName(state, k), O); // 9.c.i
@@ -26,8 +26,17 @@
 
 namespace Escargot {
 
+static inline bool isNonSharedArrayBufferObject(Object* obj)
+{
+#if defined(ENABLE_THREADING)
+    return obj->isArrayBufferObject() && !obj->isSharedArrayBufferObject();
+#else
+    return obj->isArrayBufferObject();
+#endif
+}
+
 #define RESOLVE_THIS_BINDING_TO_ARRAYBUFFER(NAME, OBJ, BUILT_IN_METHOD)                                                                                                                                                                                  \
-    if (!thisValue.isObject() || !thisValue.asObject()->isArrayBufferObject()) {                                                                                                                                                                         \
+    if (!thisValue.isObject() || !isNonSharedArrayBufferObject(thisValue.asObject())) {                                                                                                                                                                  \
         ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, state.context()->staticStrings().OBJ.string(), true, state.context()->staticStrings().BUILT_IN_METHOD.string(), ErrorObject::Messages::GlobalObject_CalledOnIncompatibleReceiver); \
     }                                                                                                                                                                                                                                                    \
     ArrayBufferObject* NAME = thisValue.asObject()->asArrayBufferObject();                                                                                                                                                                               \
@@ -85,7 +94,7 @@ static Value builtinArrayBufferSlice(ExecutionState& state, Value thisValue, siz
     Value constructor = obj->speciesConstructor(state, state.context()->globalObject()->arrayBuffer());
     Value arguments[] = { Value(newLen) };
     Object* newValue = Object::construct(state, constructor, 1, arguments).toObject(state);
-    if (!newValue->isArrayBufferObject()) {
+    if (!isNonSharedArrayBufferObject(newValue)) {
         ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, state.context()->staticStrings().ArrayBuffer.string(), true, state.context()->staticStrings().slice.string(), "%s: return value of constructor ArrayBuffer is not valid ArrayBuffer");
     }
 
@@ -0,0 +1,454 @@
+/*
+ * Copyright (c) 2021-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#if defined(ENABLE_THREADING)
+
+#include "Escargot.h"
+#include "GlobalObject.h"
+#include "Context.h"
+#include "VMInstance.h"
+#include "NativeFunctionObject.h"
+#include "TypedArrayObject.h"
+#include "TypedArrayInlines.h"
+#include "SharedArrayBufferObject.h"
+#include "BigInt.h"
+
+namespace Escargot {
+
+enum class AtomicOps : uint8_t {
+    Load,
+    Store,
+    Add,
+    Sub,
+    And,
+    Or,
+    Xor,
+    Exchange,
+    CompareExchange,
+};
+
+// rawValue has operand of the operation (expected value for CompareExchange)
+// and receives the value which was in the memory before the operation
+template <typename T>
+static void atomicOperation(uint8_t* ptr, uint8_t* rawValue, uint8_t* rawReplacement, AtomicOps op)
+{
+    T* address = reinterpret_cast<T*>(ptr);
+    T value;
+    memcpy(&value, rawValue, sizeof(T));
+
+    T result;
+    switch (op) {
+    case AtomicOps::Load:
+        result = __atomic_load_n(address, __ATOMIC_SEQ_CST);
+        break;
+    case AtomicOps::Store:
+        __atomic_store_n(address, value, __ATOMIC_SEQ_CST);
+        result = value;
+        break;
+    case AtomicOps::Add:
+        result = __atomic_fetch_add(address, value, __ATOMIC_SEQ_CST);
+        break;
+    case AtomicOps::Sub:
+        result = __atomic_fetch_sub(address, value, __ATOMIC_SEQ_CST);
+        break;
+    case AtomicOps::And:
+        result = __atomic_fetch_and(address, value, __ATOMIC_SEQ_CST);
+        break;
+    case AtomicOps::Or:
+        result = __atomic_fetch_or(address, value, __ATOMIC_SEQ_CST);
+        break;
+    case AtomicOps::Xor:
+        result = __atomic_fetch_xor(address, value, __ATOMIC_SEQ_CST);
+        break;
+    case AtomicOps::Exchange:
+        result = __atomic_exchange_n(address, value, __ATOMIC_SEQ_CST);
+        break;
+    case AtomicOps::CompareExchange: {
+        T replacement;
+        memcpy(&replacement, rawReplacement, sizeof(T));
+        // value is updated to the current value when comparison fails
+        __atomic_compare_exchange_n(address, &value, replacement, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+        result = value;
+        break;
+    }
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+        result = 0;
+        break;
+    }
+
+    memcpy(rawValue, &result, sizeof(T));
+}
+
+static void atomicOperation(uint8_t* ptr, size_t elementSize, uint8_t* rawValue, uint8_t* rawReplacement, AtomicOps op)
+{
+    // signed and unsigned types have same bit patterns for every operation we use
+    switch (elementSize) {
+    case 1:
+        atomicOperation<uint8_t>(ptr, rawValue, rawReplacement, op);
+        break;
+    case 2:
+        atomicOperation<uint16_t>(ptr, rawValue, rawReplacement, op);
+        break;
+    case 4:
+        atomicOperation<uint32_t>(ptr, rawValue, rawReplacement, op);
+        break;
+    case 8:
+        atomicOperation<uint64_t>(ptr, rawValue, rawReplacement, op);
+        break;
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+        break;
+    }
+}
+
+// https://tc39.es/ecma262/#sec-validateintegertypedarray
+static ArrayBufferObject* validateIntegerTypedArray(ExecutionState& state, const Value& typedArray, bool waitable = false)
+{
+    if (!typedArray.isObject() || !typedArray.asObject()->isTypedArrayObject()) {
+        ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, state.context()->staticStrings().Atomics.string(), false, String::emptyString, ErrorObject::Messages::GlobalObject_IllegalFirstArgument);
+    }
+
+    TypedArrayObject* ta = typedArray.asObject()->asTypedArrayObject();
+    ArrayBufferObject* buffer = ta->buffer();
+    buffer->throwTypeErrorIfDetached(state);
+
+    TypedArrayType type = ta->typedArrayType();
+    bool isValidType;
+    if (waitable) {
+        isValidType = (type == TypedArrayType::Int32 || type == TypedArrayType::BigInt64);
+    } else {
+        isValidType = (type != TypedArrayType::Float32 && type != TypedArrayType::Float64 && type != TypedArrayType::Uint8Clamped);
+    }
+
+    if (!isValidType) {
+        ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, state.context()->staticStrings().Atomics.string(), false, String::emptyString, ErrorObject::Messages::GlobalObject_IllegalFirstArgument);
+    }
+
+    return buffer;
+}
+
+// https://tc39.es/ecma262/#sec-validateatomicaccess
+static size_t validateAtomicAccess(ExecutionState& state, TypedArrayObject* typedArray, const Value& requestIndex)
+{
+    uint64_t accessIndex = requestIndex.toIndex(state);
+    if (accessIndex == Value::InvalidIndexValue || accessIndex >= typedArray->arrayLength()) {
+        ErrorObject::throwBuiltinError(state, ErrorObject::RangeError, state.context()->staticStrings().Atomics.string(), false, String::emptyString, ErrorObject::Messages::GlobalObject_RangeError);
+    }
+
+    return accessIndex * typedArray->elementSize() + typedArray->byteOffset();
+}
+
+static Value toIntegerOrBigInt(ExecutionState& state, TypedArrayType type, const Value& v)
+{
+    if (type == TypedArrayType::BigInt64 || type == TypedArrayType::BigUint64) {
+        return Value(v.toBigInt(state));
+    }
+
+    double d = v.toInteger(state);
+    // -0 is stored and returned as +0
+    return Value(d == 0 ? 0 : d);
+}
+
+// https://tc39.es/ecma262/#sec-atomicreadmodifywrite
+static Value atomicReadModifyWrite(ExecutionState& state, Value* argv, AtomicOps op)
+{
+    ArrayBufferObject* buffer = validateIntegerTypedArray(state, argv[0]);
+    TypedArrayObject* ta = argv[0].asObject()->asTypedArrayObject();
+    size_t indexedPosition = validateAtomicAccess(state, ta, argv[1]);
+    TypedArrayType type = ta->typedArrayType();
+
+    Value v = toIntegerOrBigInt(state, type, argv[2]);
+    // conversion can detach the buffer
+    buffer->throwTypeErrorIfDetached(state);
+
+    uint8_t rawBytes[8];
+    TypedArrayHelper::numberToRawBytes(state, type, v, rawBytes);
+    atomicOperation((uint8_t*)buffer->data() + indexedPosition, ta->elementSize(), rawBytes, nullptr, op);
+    return TypedArrayHelper::rawBytesToNumber(state, type, rawBytes);
+}
+
+static Value builtinAtomicsAdd(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
+{
+    return atomicReadModifyWrite(state, argv, AtomicOps::Add);
+}
+
+static Value builtinAtomicsAnd(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
+{
+    return atomicReadModifyWrite(state, argv, AtomicOps::And);
+}
+
+static Value builtinAtomicsExchange(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
+{
+    return atomicReadModifyWrite(state, argv, AtomicOps::Exchange);
+}
+
+static Value builtinAtomicsOr(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
+{
+    return atomicReadModifyWrite(state, argv, AtomicOps::Or);
+}
+
+static Value builtinAtomicsSub(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
+{
+    return atomicReadModifyWrite(state, argv, AtomicOps::Sub);
+}
+
+static Value builtinAtomicsXor(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
+{
+    return atomicReadModifyWrite(state, argv, AtomicOps::Xor);
+}
+
+// https://tc39.es/ecma262/#sec-atomics.compareexchange
+static Value builtinAtomicsCompareExchange(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
+{
+    ArrayBufferObject* buffer = validateIntegerTypedArray(state, argv[0]);
+    TypedArrayObject* ta = argv[0].asObject()->asTypedArrayObject();
+    size_t indexedPosition = validateAtomicAccess(state, ta, argv[1]);
+    TypedArrayType type = ta->typedArrayType();
+
+    Value expected = toIntegerOrBigInt(state, type, argv[2]);
+    Value replacement = toIntegerOrBigInt(state, type, argv[3]);
+    buffer->throwTypeErrorIfDetached(state);
+
+    uint8_t expectedBytes[8];
+    uint8_t replacementBytes[8];
+    TypedArrayHelper::numberToRawBytes(state, type, expected, expectedBytes);
+    TypedArrayHelper::numberToRawBytes(state, type, replacement, replacementBytes);
+    atomicOperation((uint8_t*)buffer->data() + indexedPosition, ta->elementSize(), expectedBytes, replacementBytes, AtomicOps::CompareExchange);
+    return TypedArrayHelper::rawBytesToNumber(state, type, expectedBytes);
+}
+
+// https://tc39.es/ecma262/#sec-atomics.islockfree
+static Value builtinAtomicsIsLockFree(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
+{
+    double n = argv[0].toInteger(state);
+    if (n == 1 || n == 2 || n == 4) {
+        return Value(true);
+    } else if (n == 8) {
+        return Value(__atomic_always_lock_free(8, 0));
+    }
+    return Value(false);
+}
+
+// https://tc39.es/ecma262/#sec-atomics.load
+static Value builtinAtomicsLoad(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
+{
+    ArrayBufferObject* buffer = validateIntegerTypedArray(state, argv[0]);
+    TypedArrayObject* ta = argv[0].asObject()->asTypedArrayObject();
+    size_t indexedPosition = validateAtomicAccess(state, ta, argv[1]);
+    buffer->throwTypeErrorIfDetached(state);
+
+    uint8_t rawBytes[8] = { 0 };
+    atomicOperation((uint8_t*)buffer->data() + indexedPosition, ta->elementSize(), rawBytes, nullptr, AtomicOps::Load);
+    return TypedArrayHelper::rawBytesToNumber(state, ta->typedArrayType(), rawBytes);
+}
+
+// https://tc39.es/ecma262/#sec-atomics.store
+static Value builtinAtomicsStore(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
+{
+    ArrayBufferObject* buffer = validateIntegerTypedArray(state, argv[0]);
+    TypedArrayObject* ta = argv[0].asObject()->asTypedArrayObject();
+    size_t indexedPosition = validateAtomicAccess(state, ta, argv[1]);
+    TypedArrayType type = ta->typedArrayType();
+
+    Value v = toIntegerOrBigInt(state, type, argv[2]);
+    buffer->throwTypeErrorIfDetached(state);
+
+    uint8_t rawBytes[8];
+    TypedArrayHelper::numberToRawBytes(state, type, v, rawBytes);
+    atomicOperation((uint8_t*)buffer->data() + indexedPosition, ta->elementSize(), rawBytes, nullptr, AtomicOps::Store);
+    return v;
+}
+
+// Waiters of every agent in FIFO order. Atomics.notify wakes waiters on the same address
+// from the front of the list. Waiters live on the stack of waiting threads.
+struct AtomicsWaiter {
+    explicit AtomicsWaiter(void* address)
+        : m_address(address)
+        , m_notified(false)
+    {
+    }
+
+    void* m_address;
+    bool m_notified;
+    std::condition_variable m_condition;
+};
+
+static std::mutex& atomicsWaiterListLock()
+{
+    static std::mutex lock;
+    return lock;
+}
+
+static std::list<AtomicsWaiter*>& atomicsWaiterList()
+{
+    static std::list<AtomicsWaiter*> list;
+    return list;
+}
+
+// https://tc39.es/ecma262/#sec-atomics.wait
+static Value builtinAtomicsWait(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
+{
+    ArrayBufferObject* buffer = validateIntegerTypedArray(state, argv[0], true);
+    if (!buffer->isSharedArrayBufferObject()) {
+        ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, state.context()->staticStrings().Atomics.string(), false, state.context()->staticStrings().wait.string(), "%s: TypedArray is not backed by SharedArrayBuffer");
+    }
+
+    TypedArrayObject* ta = argv[0].asObject()->asTypedArrayObject();
+    size_t indexedPosition = validateAtomicAccess(state, ta, argv[1]);
+    bool isBigInt64 = (ta->typedArrayType() == TypedArrayType::BigInt64);
+
+    int64_t v;
+    if (isBigInt64) {
+        v = argv[2].toBigInt(state)->toInt64();
+    } else {
+        v = argv[2].toInt32(state);
+    }
+
+    double q = argv[3].toNumber(state);
+    double t = std::isnan(q) ? std::numeric_limits<double>::infinity() : std::max(q, 0.0);
+
+    if (!state.context()->vmInstance()->canBlock()) {
+        ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, state.context()->staticStrings().Atomics.string(), false, state.context()->staticStrings().wait.string(), "%s: agent can not be suspended");
+    }
+
+    uint8_t* ptr = (uint8_t*)buffer->data() + indexedPosition;
+    std::unique_lock<std::mutex> lock(atomicsWaiterListLock());
+
+    int64_t w;
+    if (isBigInt64) {
+        w = __atomic_load_n(reinterpret_cast<int64_t*>(ptr), __ATOMIC_SEQ_CST);
+    } else {
+        w = __atomic_load_n(reinterpret_cast<int32_t*>(ptr), __ATOMIC_SEQ_CST);
+    }
+    if (v != w) {
+        return Value(state.context()->staticStrings().lazyNotEqual().string());
+    }
+
+    AtomicsWaiter waiter(ptr);
+    auto& list = atomicsWaiterList();
+    list.push_back(&waiter);
+
+    // a timeout whose deadline can not be represented by the clock is waited like an infinite one.
+    // otherwise the deadline overflows while it is converted to clock ticks and wait returns at once
+    auto now = std::chrono::steady_clock::now();
+    double maxTimeout = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::time_point::max() - now).count();
+    if (t >= maxTimeout) {
+        waiter.m_condition.wait(lock, [&waiter]() { return waiter.m_notified; });
+    } else {
+        auto deadline = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>(t));
+        waiter.m_condition.wait_until(lock, deadline, [&waiter]() { return waiter.m_notified; });
+    }
+
+    if (!waiter.m_notified) {
+        list.erase(std::find(list.begin(), list.end(), &waiter));
+        return Value(state.context()->staticStrings().lazyTimedOut().string());
+    }
+    return Value(state.context()->staticStrings().lazyOk().string());
+}
+
+// https://tc39.es/ecma262/#sec-atomics.notify
+static Value builtinAtomicsNotify(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
+{
+    ArrayBufferObject* buffer = validateIntegerTypedArray(state, argv[0], true);
+    TypedArrayObject* ta = argv[0].asObject()->asTypedArrayObject();
+    size_t indexedPosition = validateAtomicAccess(state, ta, argv[1]);
+
+    double c = std::numeric_limits<double>::infinity();
+    if (!argv[2].isUndefined()) {
+        c = std::max(argv[2].toInteger(state), 0.0);
+    }
+
+    if (!buffer->isSharedArrayBufferObject()) {
+        return Value(0);
+    }
+
+    void* ptr = (uint8_t*)buffer->data() + indexedPosition;
+    size_t n = 0;
+    {
+        std::lock_guard<std::mutex> guard(atomicsWaiterListLock());
+        auto& list = atomicsWaiterList();
+        auto iter = list.begin();
+        while (iter != list.end() && n < c) {
+            AtomicsWaiter* waiter = *iter;
+            if (waiter->m_address == ptr) {
+                waiter->m_notified = true;
+                waiter->m_condition.notify_one();
+                iter = list.erase(iter);
+                n++;
+            } else {
+                iter++;
+            }
+        }
+    }
+
+    return Value(n);
+}
+
+void GlobalObject::installAtomics(ExecutionState& state)
+{
+    const StaticStrings* strings = &state.context()->staticStrings();
+    m_atomics = new Object(state);
+    m_atomics->setGlobalIntrinsicObject(state);
+
+    m_atomics->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->vmInstance()->globalSymbols().toStringTag),
+                                                ObjectPropertyDescriptor(Value(strings->Atomics.string()), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::ConfigurablePresent)));
+
+    m_atomics->defineOwnPropertyThrowsException(state, ObjectPropertyName(strings->add),
+                                                ObjectPropertyDescriptor(new NativeFunctionObject(state, NativeFunctionInfo(strings->add, builtinAtomicsAdd, 3, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+
+    m_atomics->defineOwnPropertyThrowsException(state, ObjectPropertyName(strings->stringAnd),
+                                                ObjectPropertyDescriptor(new NativeFunctionObject(state, NativeFunctionInfo(strings->stringAnd, builtinAtomicsAnd, 3, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+
+    m_atomics->defineOwnPropertyThrowsException(state, ObjectPropertyName(strings->compareExchange),
+                                                ObjectPropertyDescriptor(new NativeFunctionObject(state, NativeFunctionInfo(strings->compareExchange, builtinAtomicsCompareExchange, 4, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+
+    m_atomics->defineOwnPropertyThrowsException(state, ObjectPropertyName(strings->exchange),
+                                                ObjectPropertyDescriptor(new NativeFunctionObject(state, NativeFunctionInfo(strings->exchange, builtinAtomicsExchange, 3, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+
+    m_atomics->defineOwnPropertyThrowsException(state, ObjectPropertyName(strings->isLockFree),
+                                                ObjectPropertyDescriptor(new NativeFunctionObject(state, NativeFunctionInfo(strings->isLockFree, builtinAtomicsIsLockFree, 1, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+
+    m_atomics->defineOwnPropertyThrowsException(state, ObjectPropertyName(strings->load),
+                                                ObjectPropertyDescriptor(new NativeFunctionObject(state, NativeFunctionInfo(strings->load, builtinAtomicsLoad, 2, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+
+    m_atomics->defineOwnPropertyThrowsException(state, ObjectPropertyName(strings->notify),
+                                                ObjectPropertyDescriptor(new NativeFunctionObject(state, NativeFunctionInfo(strings->notify, builtinAtomicsNotify, 3, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+
+    m_atomics->defineOwnPropertyThrowsException(state, ObjectPropertyName(strings->stringOr),
+                                                ObjectPropertyDescriptor(new NativeFunctionObject(state, NativeFunctionInfo(strings->stringOr, builtinAtomicsOr, 3, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+
+    m_atomics->defineOwnPropertyThrowsException(state, ObjectPropertyName(strings->store),
+                                                ObjectPropertyDescriptor(new NativeFunctionObject(state, NativeFunctionInfo(strings->store, builtinAtomicsStore, 3, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+
+    m_atomics->defineOwnPropertyThrowsException(state, ObjectPropertyName(strings->sub),
+                                                ObjectPropertyDescriptor(new NativeFunctionObject(state, NativeFunctionInfo(strings->sub, builtinAtomicsSub, 3, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+
+    m_atomics->defineOwnPropertyThrowsException(state, ObjectPropertyName(strings->wait),
+                                                ObjectPropertyDescriptor(new NativeFunctionObject(state, NativeFunctionInfo(strings->wait, builtinAtomicsWait, 4, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+
+    m_atomics->defineOwnPropertyThrowsException(state, ObjectPropertyName(strings->stringXor),
+                                                ObjectPropertyDescriptor(new NativeFunctionObject(state, NativeFunctionInfo(strings->stringXor, builtinAtomicsXor, 3, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+
+    defineOwnProperty(state, ObjectPropertyName(strings->Atomics),
+                      ObjectPropertyDescriptor(m_atomics, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+}
+} // namespace Escargot
+
+#endif
@@ -28,147 +28,547 @@
 #include "BigIntObject.h"
 #include "NativeFunctionObject.h"
 
-#define RAPIDJSON_PARSE_DEFAULT_FLAGS kParseFullPrecisionFlag
-#define RAPIDJSON_ERROR_CHARTYPE char
-#include <rapidjson/document.h>
-#include <rapidjson/filereadstream.h>
-#include <rapidjson/memorystream.h>
-#include <rapidjson/internal/dtoa.h>
-#include <rapidjson/stringbuffer.h>
-#include <rapidjson/writer.h>
-#include <rapidjson/error/en.h>
+#include "ieee.h"
+#include "double-conversion.h"
 
 namespace Escargot {
 
-template <typename Encoding>
-struct JSONStringStream {
-    typedef typename Encoding::Ch Ch;
+static void checkJSONStackLimit(ExecutionState& state)
+{
+    volatile int sp;
+    size_t currentStackBase = (size_t)&sp;
+#ifdef STACK_GROWS_DOWN
+    if (UNLIKELY(state.stackLimit() > currentStackBase)) {
+#else
+    if (UNLIKELY(state.stackLimit() < currentStackBase)) {
+#endif
+        ErrorObject::throwBuiltinError(state, ErrorObject::RangeError, "Maximum call stack size exceeded");
+    }
+}
+
+#define JSON_PARSE_STRUCTURE_CACHE_DEPTH 8
 
-    JSONStringStream(const Ch* src, size_t length)
-        : src_(src)
-        , head_(src)
-        , tail_(src + length)
+// single pass JSON parser which builds values directly from source characters.
+// 8-bit source is parsed without converting it into 16-bit buffer
+// https://tc39.es/ecma262/#sec-json.parse
+template <typename CharType>
+class JSONParser {
+public:
+    JSONParser(ExecutionState& state, const CharType* data, size_t length)
+        : m_state(state)
+        , m_cursor(data)
+        , m_end(data + length)
+        , m_depth(0)
     {
+        for (size_t i = 0; i < JSON_PARSE_STRUCTURE_CACHE_DEPTH; i++) {
+            m_structureCache[i] = nullptr;
+        }
     }
 
-    Ch Peek() const
+    Value parse()
     {
-        if (UNLIKELY(tail_ <= src_)) {
-            return 0;
+        skipWhitespace();
+        if (UNLIKELY(m_cursor == m_end)) {
+            throwError("The document is empty.");
         }
-        return *src_;
+        Value result = parseValue();
+        skipWhitespace();
+        if (UNLIKELY(m_cursor != m_end)) {
+            throwError("The document root must not be followed by other values.");
+        }
+        return result;
     }
-    Ch Take()
+
+private:
+    // characters of parsed string. points source directly if the string has no escape sequence
+    struct StringSpan {
+        const CharType* m_source;
+        size_t m_length;
+        bool m_inBuffer;
+        // bitwise OR of every character. used for selecting string type
+        char16_t m_orOfCharacters;
+    };
+
+    NEVER_INLINE void throwError(const char* message)
     {
-        if (UNLIKELY(tail_ <= src_)) {
-            return 0;
+        auto strings = &m_state.context()->staticStrings();
+        ErrorObject::throwBuiltinError(m_state, ErrorObject::SyntaxError, strings->JSON.string(), true, strings->parse.string(), message);
+    }
+
+    static bool isWhitespace(CharType c)
+    {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    static bool isDigit(CharType c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    void skipWhitespace()
+    {
+        while (m_cursor != m_end && isWhitespace(*m_cursor)) {
+            m_cursor++;
+        }
+    }
+
+    bool consumeKeyword(const char* keyword, size_t length)
+    {
+        if ((size_t)(m_end - m_cursor) < length) {
+            return false;
         }
-        return *src_++;
+        for (size_t i = 0; i < length; i++) {
+            if (m_cursor[i] != (CharType)keyword[i]) {
+                return false;
+            }
+        }
+        m_cursor += length;
+        return true;
     }
-    size_t Tell() const { return static_cast<size_t>(src_ - head_); }
-    Ch* PutBegin()
+
+    Value parseValue()
     {
-        RAPIDJSON_ASSERT(false);
-        return 0;
+        if (UNLIKELY(m_cursor == m_end)) {
+            throwError("Invalid value.");
+        }
+
+        switch (*m_cursor) {
+        case '{':
+            return parseObject();
+        case '[':
+            return parseArray();
+        case '"': {
+            m_cursor++;
+            StringSpan span;
+            scanString(span);
+            return createString(span);
+        }
+        case 't':
+            if (consumeKeyword("true", 4)) {
+                return Value(true);
+            }
+            break;
+        case 'f':
+            if (consumeKeyword("false", 5)) {
+                return Value(false);
+            }
+            break;
+        case 'n':
+            if (consumeKeyword("null", 4)) {
+                return Value(Value::Null);
+            }
+            break;
+        default:
+            if (*m_cursor == '-' || isDigit(*m_cursor)) {
+                return parseNumber();
+            }
+            break;
+        }
+        throwError("Invalid value.");
+        return Value();
     }
-    void Put(Ch) { RAPIDJSON_ASSERT(false); }
-    void Flush() { RAPIDJSON_ASSERT(false); }
-    size_t PutEnd(Ch*)
+
+    void checkStackLimit()
     {
-        RAPIDJSON_ASSERT(false);
-        return 0;
+        checkJSONStackLimit(m_state);
     }
 
-    const Ch* src_; //!< Current read position.
-    const Ch* head_; //!< Original head of the string.
-    const Ch* tail_;
-};
+    Value parseArray()
+    {
+        checkStackLimit();
+        ASSERT(*m_cursor == '[');
+        m_cursor++;
 
-template <typename CharType, typename JSONCharType>
-static Value parseJSONWorker(ExecutionState& state, rapidjson::GenericValue<JSONCharType>& value)
-{
-    volatile int sp;
-    size_t currentStackBase = (size_t)&sp;
-#ifdef STACK_GROWS_DOWN
-    if (UNLIKELY(state.stackLimit() > currentStackBase)) {
-#else
-    if (UNLIKELY(state.stackLimit() < currentStackBase)) {
-#endif
-        ErrorObject::throwBuiltinError(state, ErrorObject::RangeError, "Maximum call stack size exceeded");
+        // elements are collected first to create fast mode array with proper storage at once
+        ValueVectorWithInlineStorage elements;
+        skipWhitespace();
+        if (m_cursor != m_end && *m_cursor == ']') {
+            m_cursor++;
+            return new ArrayObject(m_state);
+        }
+
+        while (true) {
+            skipWhitespace();
+            m_depth++;
+            elements.pushBack(parseValue());
+            m_depth--;
+            skipWhitespace();
+            if (LIKELY(m_cursor != m_end)) {
+                if (*m_cursor == ',') {
+                    m_cursor++;
+                    continue;
+                } else if (*m_cursor == ']') {
+                    m_cursor++;
+                    break;
+                }
+            }
+            throwError("Missing a comma or ']' after an array element.");
+        }
+
+        return new ArrayObject(m_state, elements.data(), elements.size());
     }
 
-    if (value.IsBool()) {
-        return Value(value.GetBool());
-    } else if (value.IsInt()) {
-        return Value(value.GetInt());
-    } else if (value.IsUint()) {
-        return Value(value.GetUint());
-    } else if (value.IsInt64()) {
-        return Value(value.GetInt64());
-    } else if (value.IsUint64()) {
-        return Value(value.GetUint64());
-    } else if (value.IsDouble()) {
-        return Value(value.GetDouble());
-    } else if (value.IsNull()) {
-        return Value(Value::Null);
-    } else if (value.IsString()) {
-        if (std::is_same<CharType, char16_t>::value) {
-            const char16_t* chars = (const char16_t*)value.GetString();
-            unsigned len = value.GetStringLength();
-            if (isAllLatin1(chars, len)) {
-                return new Latin1String(chars, len);
-            } else {
-                return new UTF16String(chars, len);
+    Value parseObject()
+    {
+        checkStackLimit();
+        ASSERT(*m_cursor == '{');
+        m_cursor++;
+
+        skipWhitespace();
+        if (m_cursor != m_end && *m_cursor == '}') {
+            m_cursor++;
+            return createObject();
+        }
+
+        // records of same layout are usually repeated at same nesting level (e.g. rows of an array)
+        // while keys follow properties of the structure of last object, values are just collected
+        // and the object is created with the final structure at once
+        ObjectStructure* cachedStructure = m_depth < JSON_PARSE_STRUCTURE_CACHE_DEPTH ? m_structureCache[m_depth] : nullptr;
+        size_t cachedPropertyCount = cachedStructure ? cachedStructure->propertyCount() : 0;
+        ValueVectorWithInlineStorage cachedValues;
+        Object* obj = nullptr;
+
+        while (true) {
+            skipWhitespace();
+            if (UNLIKELY(m_cursor == m_end || *m_cursor != '"')) {
+                throwError("Missing a name for object member.");
             }
-        } else {
-            const char* valueAsString = (const char*)value.GetString();
-            if (isAllASCII(valueAsString, strlen(valueAsString))) {
-                return new ASCIIString(valueAsString);
+            m_cursor++;
+
+            StringSpan span;
+            scanString(span);
+            // keys which can be array index go through canonical conversion of ObjectPropertyName
+            bool mayBeIndex = span.m_length && isDigit(span.m_source[0]);
+            AtomicString key = createAtomicString(span);
+
+            skipWhitespace();
+            if (UNLIKELY(m_cursor == m_end || *m_cursor != ':')) {
+                throwError("Missing a colon after a name of object member.");
+            }
+            m_cursor++;
+            skipWhitespace();
+
+            m_depth++;
+            Value value = parseValue();
+            m_depth--;
+
+            size_t cachedIndex = cachedValues.size();
+            if (!obj && cachedIndex < cachedPropertyCount && cachedStructure->readProperty(cachedIndex).m_propertyName == key) {
+                cachedValues.pushBack(value);
             } else {
-                return new UTF16String(utf8StringToUTF16String(valueAsString, strlen(valueAsString)));
+                if (!obj) {
+                    obj = createObjectWithCachedProperties(cachedStructure, cachedValues);
+                }
+                if (UNLIKELY(mayBeIndex)) {
+                    obj->defineOwnProperty(m_state, ObjectPropertyName(m_state, Value(key.string())), ObjectPropertyDescriptor(value, ObjectPropertyDescriptor::AllPresent));
+                } else {
+                    obj->defineOwnProperty(m_state, ObjectPropertyName(key), ObjectPropertyDescriptor(value, ObjectPropertyDescriptor::AllPresent));
+                }
+            }
+
+            skipWhitespace();
+            if (LIKELY(m_cursor != m_end)) {
+                if (*m_cursor == ',') {
+                    m_cursor++;
+                    continue;
+                } else if (*m_cursor == '}') {
+                    m_cursor++;
+                    break;
+                }
+            }
+            throwError("Missing a comma or '}' after an object member.");
+        }
+
+        if (!obj) {
+            if (cachedValues.size() == cachedPropertyCount) {
+                return Object::createWithStructure(m_state, m_state.context()->globalObject()->objectPrototype(), cachedStructure, cachedValues.data(), cachedValues.size());
             }
+            obj = createObjectWithCachedProperties(cachedStructure, cachedValues);
         }
-    } else if (value.IsArray()) {
-        ArrayObject* arr = new ArrayObject(state);
-        size_t i = 0;
-        auto iter = value.Begin();
-        while (iter != value.End()) {
-            arr->defineOwnProperty(state, ObjectPropertyName(state, Value(i++)), ObjectPropertyDescriptor(parseJSONWorker<CharType, JSONCharType>(state, *iter), ObjectPropertyDescriptor::AllPresent));
-            iter++;
+
+        if (m_depth < JSON_PARSE_STRUCTURE_CACHE_DEPTH) {
+            ObjectStructure* structure = obj->structureForSharing();
+            if (structure) {
+                m_structureCache[m_depth] = structure;
+            }
         }
-        return arr;
-    } else if (value.IsObject()) {
-        Object* obj = new Object(state);
+
+        return obj;
+    }
+
+    Object* createObject()
+    {
+        Object* obj = new Object(m_state);
 #if defined(ESCARGOT_SMALL_CONFIG)
         obj->markThisObjectDontNeedStructureTransitionTable();
 #endif
-        auto iter = value.MemberBegin();
-        while (iter != value.MemberEnd()) {
-            Value propertyName = parseJSONWorker<CharType, JSONCharType>(state, iter->name);
-            ASSERT(propertyName.isString());
-            obj->defineOwnProperty(state, ObjectPropertyName(state, propertyName), ObjectPropertyDescriptor(parseJSONWorker<CharType, JSONCharType>(state, iter->value), ObjectPropertyDescriptor::AllPresent));
-            iter++;
+        return obj;
+    }
+
+    // layout of current object diverged from cached structure. define values matched so far one by one
+    Object* createObjectWithCachedProperties(ObjectStructure* cachedStructure, const ValueVectorWithInlineStorage& cachedValues)
+    {
+        Object* obj = createObject();
+        for (size_t i = 0; i < cachedValues.size(); i++) {
+            obj->defineOwnProperty(m_state, ObjectPropertyName(cachedStructure->readProperty(i).m_propertyName), ObjectPropertyDescriptor(cachedValues[i], ObjectPropertyDescriptor::AllPresent));
         }
         return obj;
-    } else {
-        RELEASE_ASSERT_NOT_REACHED();
     }
-}
 
-template <typename CharType, typename JSONCharType>
-Value parseJSON(ExecutionState& state, const CharType* data, size_t length)
-{
-    auto strings = &state.context()->staticStrings();
-    rapidjson::GenericDocument<JSONCharType> jsonDocument;
+    Value parseNumber()
+    {
+        const CharType* start = m_cursor;
+        bool isNegative = false;
+        if (*m_cursor == '-') {
+            isNegative = true;
+            m_cursor++;
+        }
+
+        if (UNLIKELY(m_cursor == m_end || !isDigit(*m_cursor))) {
+            throwError("Invalid value.");
+        }
+
+        // integers up to 9 digits fit in int32
+        int32_t intValue = 0;
+        size_t digitCount = 0;
+        if (*m_cursor == '0') {
+            m_cursor++;
+            digitCount = 1;
+        } else {
+            while (m_cursor != m_end && isDigit(*m_cursor)) {
+                intValue = intValue * 10 + (*m_cursor - '0');
+                m_cursor++;
+                if (++digitCount > 9) {
+                    break;
+                }
+            }
+            while (m_cursor != m_end && isDigit(*m_cursor)) {
+                m_cursor++;
+                digitCount++;
+            }
+        }
+
+        bool isInteger = true;
+        if (m_cursor != m_end && *m_cursor == '.') {
+            isInteger = false;
+            m_cursor++;
+            if (UNLIKELY(m_cursor == m_end || !isDigit(*m_cursor))) {
+                throwError("Missing fraction part in number.");
+            }
+            while (m_cursor != m_end && isDigit(*m_cursor)) {
+                m_cursor++;
+            }
+        }
+
+        if (m_cursor != m_end && (*m_cursor == 'e' || *m_cursor == 'E')) {
+            isInteger = false;
+            m_cursor++;
+            if (m_cursor != m_end && (*m_cursor == '+' || *m_cursor == '-')) {
+                m_cursor++;
+            }
+            if (UNLIKELY(m_cursor == m_end || !isDigit(*m_cursor))) {
+                throwError("Missing exponent in number.");
+            }
+            while (m_cursor != m_end && isDigit(*m_cursor)) {
+                m_cursor++;
+            }
+        }
+
+        if (isInteger && digitCount <= 9) {
+            if (isNegative) {
+                if (!intValue) {
+                    return Value(-0.0);
+                }
+                return Value(-intValue);
+            }
+            return Value(intValue);
+        }
 
-    JSONStringStream<JSONCharType> stringStream(data, length);
-    jsonDocument.ParseStream(stringStream);
-    if (jsonDocument.HasParseError()) {
-        ErrorObject::throwBuiltinError(state, ErrorObject::SyntaxError, strings->JSON.string(), true, strings->parse.string(), rapidjson::GetParseError_En(jsonDocument.GetParseError()));
+        return Value(stringToDouble(start, m_cursor - start));
     }
 
-    return parseJSONWorker<CharType, JSONCharType>(state, jsonDocument);
-}
+    static double stringToDouble(const char* start, size_t length)
+    {
+        int lengthDummy;
+        double_conversion::StringToDoubleConverter converter(double_conversion::StringToDoubleConverter::NO_FLAGS,
+                                                             0.0, double_conversion::Double::NaN(), nullptr, nullptr);
+        return converter.StringToDouble(start, length, &lengthDummy);
+    }
+
+    static double stringToDouble(const LChar* start, size_t length)
+    {
+        return stringToDouble((const char*)start, length);
+    }
+
+    static double stringToDouble(const char16_t* start, size_t length)
+    {
+        // number consists of ASCII characters only
+        std::string buffer(start, start + length);
+        return stringToDouble(buffer.data(), length);
+    }
+
+    static int hexValue(CharType c)
+    {
+        if (c >= '0' && c <= '9') {
+            return c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            return c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            return c - 'A' + 10;
+        }
+        return -1;
+    }
+
+    // m_cursor should point next of opening quotation mark
+    void scanString(StringSpan& span)
+    {
+        const CharType* start = m_cursor;
+        char16_t orOfCharacters = 0;
+        while (true) {
+            if (UNLIKELY(m_cursor == m_end)) {
+                throwError("Missing a closing quotation mark in string.");
+            }
+            CharType c = *m_cursor;
+            if (c == '"') {
+                span.m_source = start;
+                span.m_length = m_cursor - start;
+                span.m_inBuffer = false;
+                span.m_orOfCharacters = orOfCharacters;
+                m_cursor++;
+                return;
+            } else if (c == '\\') {
+                break;
+            } else if (UNLIKELY(c < 0x20)) {
+                throwError("Invalid encoding in string.");
+            }
+            orOfCharacters |= c;
+            m_cursor++;
+        }
+
+        // string has escape sequence. characters are copied into buffer from here
+        m_buffer.assign(start, m_cursor);
+        while (true) {
+            if (UNLIKELY(m_cursor == m_end)) {
+                throwError("Missing a closing quotation mark in string.");
+            }
+            CharType c = *m_cursor++;
+            if (c == '"') {
+                break;
+            } else if (c == '\\') {
+                if (UNLIKELY(m_cursor == m_end)) {
+                    throwError("Missing a closing quotation mark in string.");
+                }
+                char16_t escaped;
+                switch (*m_cursor++) {
+                case '"':
+                    escaped = '"';
+                    break;
+                case '\\':
+                    escaped = '\\';
+                    break;
+                case '/':
+                    escaped = '/';
+                    break;
+                case 'b':
+                    escaped = '\b';
+                    break;
+                case 'f':
+                    escaped = '\f';
+                    break;
+                case 'n':
+                    escaped = '\n';
+                    break;
+                case 'r':
+                    escaped = '\r';
+                    break;
+                case 't':
+                    escaped = '\t';
+                    break;
+                case 'u': {
+                    if (UNLIKELY(m_end - m_cursor < 4)) {
+                        throwError("Incorrect hex digit after \\u escape in string.");
+                    }
+                    int code = 0;
+                    for (size_t i = 0; i < 4; i++) {
+                        int digit = hexValue(m_cursor[i]);
+                        if (UNLIKELY(digit < 0)) {
+                            throwError("Incorrect hex digit after \\u escape in string.");
+                        }
+                        code = (code << 4) | digit;
+                    }
+                    m_cursor += 4;
+                    // lone surrogates are valid in JavaScript strings
+                    escaped = (char16_t)code;
+                    break;
+                }
+                default:
+                    throwError("Invalid escape character in string.");
+                    escaped = 0;
+                    break;
+                }
+                orOfCharacters |= escaped;
+                m_buffer.push_back(escaped);
+            } else if (UNLIKELY(c < 0x20)) {
+                throwError("Invalid encoding in string.");
+            } else {
+                orOfCharacters |= c;
+                m_buffer.push_back(c);
+            }
+        }
+
+        span.m_source = nullptr;
+        span.m_length = m_buffer.length();
+        span.m_inBuffer = true;
+        span.m_orOfCharacters = orOfCharacters;
+    }
+
+    static String* createString(const LChar* chars, size_t length, char16_t orOfCharacters)
+    {
+        if (orOfCharacters < 0x80) {
+            return new ASCIIString((const char*)chars, length);
+        }
+        return new Latin1String(chars, length);
+    }
+
+    static String* createString(const char16_t* chars, size_t length, char16_t orOfCharacters)
+    {
+        if (orOfCharacters < 0x80) {
+            return new ASCIIString(chars, length);
+        } else if (orOfCharacters < 0x100) {
+            return new Latin1String(chars, length);
+        }
+        return new UTF16String(chars, length);
+    }
+
+    String* createString(const StringSpan& span)
+    {
+        if (!span.m_length) {
+            return String::emptyString;
+        }
+        if (span.m_inBuffer) {
+            return createString(m_buffer.data(), span.m_length, span.m_orOfCharacters);
+        }
+        return createString(span.m_source, span.m_length, span.m_orOfCharacters);
+    }
+
+    AtomicString createAtomicString(const StringSpan& span)
+    {
+        if (span.m_inBuffer) {
+            return AtomicString(m_state.context(), m_buffer.data(), span.m_length);
+        }
+        return AtomicString(m_state.context(), span.m_source, span.m_length);
+    }
+
+    ExecutionState& m_state;
+    const CharType* m_cursor;
+    const CharType* m_end;
+    UTF16StringDataNonGCStd m_buffer;
+    // nesting level of value being parsed
+    size_t m_depth;
+    // final structure of last object parsed at each nesting level.
+    // parser lives on the stack, so the structures are kept alive while parsing
+    ObjectStructure* m_structureCache[JSON_PARSE_STRUCTURE_CACHE_DEPTH];
+};
 
 String* codePointTo4digitString(int codepoint)
 {
@@ -201,17 +601,11 @@ static Value builtinJSONParse(ExecutionState& state, Value thisValue, size_t arg
     String* JText = argv[0].toString(state);
     Value unfiltered;
 
-    if (JText->has8BitContent()) {
-        size_t len = JText->length();
-        char16_t* char16Buf = new char16_t[len];
-        std::unique_ptr<char16_t[]> buf(char16Buf);
-        const LChar* srcBuf = JText->characters8();
-        for (size_t i = 0; i < len; i++) {
-            char16Buf[i] = srcBuf[i];
-        }
-        unfiltered = parseJSON<char16_t, rapidjson::UTF16<char16_t>>(state, buf.get(), JText->length());
+    const auto& bufferAccessData = JText->bufferAccessData();
+    if (bufferAccessData.has8BitContent) {
+        unfiltered = JSONParser<LChar>(state, (const LChar*)bufferAccessData.bufferAs8Bit, bufferAccessData.length).parse();
     } else {
-        unfiltered = parseJSON<char16_t, rapidjson::UTF16<char16_t>>(state, JText->characters16(), JText->length());
+        unfiltered = JSONParser<char16_t>(state, bufferAccessData.bufferAs16Bit, bufferAccessData.length).parse();
     }
 
     // 4
@@ -316,6 +710,363 @@ static void builtinJSONArrayReplacerHelper(ExecutionState& state, ObjectProperty
     propertyList.push_back(ObjectPropertyName(state, Value(item)));
 }
 
+// serializer for trees of plain data (ordinary objects with data properties and fast mode arrays)
+// it reads property slots and array elements directly, and writes 8-bit characters into one buffer
+// until a character which does not fit is seen.
+// it never calls user code, so it gives up (returns false) on anything whose serialization is observable
+// (toJSON, getters, proxies, wrapper objects, functions, ...) and caller should start the spec path from scratch
+class JSONStringifier {
+public:
+    JSONStringifier(ExecutionState& state, String* gap)
+        : m_state(state)
+        , m_strings(&state.context()->staticStrings())
+        , m_objectPrototype(state.context()->globalObject()->objectPrototype())
+        , m_arrayPrototype(state.context()->globalObject()->arrayPrototype())
+        , m_gap(gap)
+        , m_is8Bit(true)
+        , m_depth(0)
+    {
+    }
+
+    bool serialize(const Value& value)
+    {
+        // toJSON added to prototypes is seen by every object
+        if (m_objectPrototype->m_structure->findProperty(m_strings->toJSON).first != SIZE_MAX
+            || m_arrayPrototype->m_structure->findProperty(m_strings->toJSON).first != SIZE_MAX) {
+            return false;
+        }
+        return serializeValue(value);
+    }
+
+    String* finalize()
+    {
+        if (m_is8Bit) {
+            return new Latin1String(m_latin1Buffer.data(), m_latin1Buffer.length());
+        }
+        return new UTF16String(m_utf16Buffer.data(), m_utf16Buffer.length());
+    }
+
+private:
+    // undefined and symbol values are omitted from objects and become null in arrays
+    static bool isOmitted(const Value& value)
+    {
+        return value.isUndefined() || (value.isPointerValue() && value.asPointerValue()->isSymbol());
+    }
+
+    bool serializeValue(const Value& value)
+    {
+        if (value.isNull()) {
+            append("null", 4);
+        } else if (value.isBoolean()) {
+            if (value.asBoolean()) {
+                append("true", 4);
+            } else {
+                append("false", 5);
+            }
+        } else if (value.isInt32()) {
+            appendInt32(value.asInt32());
+        } else if (value.isNumber()) {
+            if (std::isfinite(value.asNumber())) {
+                appendString(value.toString(m_state));
+            } else {
+                append("null", 4);
+            }
+        } else if (value.isString()) {
+            appendQuotedString(value.asString());
+        } else if (value.isObject()) {
+            Object* obj = value.asObject();
+            if (obj->isArrayObject()) {
+                return serializeArray(obj->asArrayObject());
+            } else if (obj->isPlainObject()) {
+                return serializeObject(obj);
+            }
+            return false;
+        } else {
+            // BigInt
+            return false;
+        }
+        return true;
+    }
+
+    bool serializeObject(Object* obj)
+    {
+        if (obj->getPrototypeObject(m_state) != m_objectPrototype) {
+            return false;
+        }
+        ObjectStructure* structure = obj->m_structure;
+        // index property names are enumerated before other names regardless of their order in the structure
+        if (structure->hasIndexPropertyName()) {
+            return false;
+        }
+        if (!enter(obj)) {
+            return false;
+        }
+
+        append('{');
+        bool isFirst = true;
+        size_t count = structure->propertyCount();
+        for (size_t i = 0; i < count; i++) {
+            const ObjectStructureItem& item = structure->readProperty(i);
+            if (!item.m_propertyName.isPlainString()) {
+                continue;
+            }
+            if (UNLIKELY(item.m_propertyName == m_strings->toJSON)) {
+                return false;
+            }
+            if (!item.m_descriptor.isEnumerable()) {
+                continue;
+            }
+            if (!item.m_descriptor.isPlainDataProperty()) {
+                return false;
+            }
+            Value value = obj->uncheckedGetOwnDataProperty(i);
+            if (isOmitted(value)) {
+                continue;
+            }
+
+            if (!isFirst) {
+                append(',');
+            }
+            isFirst = false;
+            appendIndent();
+            appendQuotedString(item.m_propertyName.plainString());
+            append(':');
+            if (m_gap->length()) {
+                append(' ');
+            }
+            if (!serializeValue(value)) {
+                return false;
+            }
+        }
+
+        leave();
+        if (!isFirst) {
+            appendIndent();
+        }
+        append('}');
+        return true;
+    }
+
+    bool serializeArray(ArrayObject* arr)
+    {
+        if (!arr->isFastModeArray() || arr->getPrototypeObject(m_state) != m_arrayPrototype) {
+            return false;
+        }
+        if (arr->m_structure->findProperty(m_strings->toJSON).first != SIZE_MAX) {
+            return false;
+        }
+        if (!enter(arr)) {
+            return false;
+        }
+
+        append('[');
+        uint32_t length = arr->arrayLength(m_state);
+        for (uint32_t i = 0; i < length; i++) {
+            // element can be a hole which is read through the prototype chain
+            Value value = arr->fastModeArrayValue(i);
+            if (value.isEmpty()) {
+                return false;
+            }
+
+            if (i) {
+                append(',');
+            }
+            appendIndent();
+            if (isOmitted(value)) {
+                append("null", 4);
+            } else if (!serializeValue(value)) {
+                return false;
+            }
+        }
+
+        leave();
+        if (length) {
+            appendIndent();
+        }
+        append(']');
+        return true;
+    }
+
+    // cyclic structure is reported by the spec path
+    bool enter(Object* obj)
+    {
+        checkJSONStackLimit(m_state);
+        for (size_t i = 0; i < m_stack.size(); i++) {
+            if (m_stack[i] == obj) {
+                return false;
+            }
+        }
+        m_stack.pushBack(obj);
+        m_depth++;
+        return true;
+    }
+
+    void leave()
+    {
+        m_stack.pop_back();
+        m_depth--;
+    }
+
+    void appendIndent()
+    {
+        if (m_gap->length()) {
+            append('\n');
+            for (size_t i = 0; i < m_depth; i++) {
+                appendString(m_gap);
+            }
+        }
+    }
+
+    void widen()
+    {
+        ASSERT(m_is8Bit);
+        m_utf16Buffer.reserve(m_latin1Buffer.length() * 2);
+        m_utf16Buffer.assign(m_latin1Buffer.begin(), m_latin1Buffer.end());
+        m_latin1Buffer.clear();
+        m_latin1Buffer.shrink_to_fit();
+        m_is8Bit = false;
+    }
+
+    void append(char16_t ch)
+    {
+        if (LIKELY(m_is8Bit)) {
+            if (LIKELY(ch < 256)) {
+                m_latin1Buffer.push_back((LChar)ch);
+                return;
+            }
+            widen();
+        }
+        m_utf16Buffer.push_back(ch);
+    }
+
+    void append(const char* str, size_t length)
+    {
+        if (LIKELY(m_is8Bit)) {
+            m_latin1Buffer.append((const LChar*)str, length);
+        } else {
+            m_utf16Buffer.append(str, str + length);
+        }
+    }
+
+    void appendInt32(int32_t value)
+    {
+        char buffer[12];
+        char* end = buffer + sizeof(buffer);
+        char* p = end;
+        uint32_t u = value < 0 ? -(uint32_t)value : value;
+        do {
+            *--p = '0' + (u % 10);
+            u /= 10;
+        } while (u);
+        if (value < 0) {
+            *--p = '-';
+        }
+        append(p, end - p);
+    }
+
+    void appendString(String* str)
+    {
+        const auto& data = str->bufferAccessData();
+        if (data.has8BitContent) {
+            const LChar* src = (const LChar*)data.bufferAs8Bit;
+            if (LIKELY(m_is8Bit)) {
+                m_latin1Buffer.append(src, data.length);
+            } else {
+                m_utf16Buffer.append(src, src + data.length);
+            }
+        } else {
+            for (size_t i = 0; i < data.length; i++) {
+                append(data.bufferAs16Bit[i]);
+            }
+        }
+    }
+
+    // https://www.ecma-international.org/ecma-262/6.0/#sec-quotejsonstring
+    template <typename CharType>
+    void appendQuotedCharacters(const CharType* src, size_t length)
+    {
+        size_t start = 0;
+        for (size_t i = 0; i < length; i++) {
+            CharType c = src[i];
+            if (LIKELY(c >= ' ' && c != '"' && c != '\\')) {
+                continue;
+            }
+            appendCharacters(src + start, i - start);
+            start = i + 1;
+
+            append('\\');
+            switch (c) {
+            case '"':
+            case '\\':
+                append(c);
+                break;
+            case '\b':
+                append('b');
+                break;
+            case '\f':
+                append('f');
+                break;
+            case '\n':
+                append('n');
+                break;
+            case '\r':
+                append('r');
+                break;
+            case '\t':
+                append('t');
+                break;
+            default: {
+                const char* hex = "0123456789abcdef";
+                char buffer[5] = { 'u', '0', '0', hex[c >> 4], hex[c & 0xf] };
+                append(buffer, 5);
+                break;
+            }
+            }
+        }
+        appendCharacters(src + start, length - start);
+    }
+
+    void appendCharacters(const LChar* src, size_t length)
+    {
+        if (LIKELY(m_is8Bit)) {
+            m_latin1Buffer.append(src, length);
+        } else {
+            m_utf16Buffer.append(src, src + length);
+        }
+    }
+
+    void appendCharacters(const char16_t* src, size_t length)
+    {
+        for (size_t i = 0; i < length; i++) {
+            append(src[i]);
+        }
+    }
+
+    void appendQuotedString(String* str)
+    {
+        const auto& data = str->bufferAccessData();
+        append('"');
+        if (data.has8BitContent) {
+            appendQuotedCharacters((const LChar*)data.bufferAs8Bit, data.length);
+        } else {
+            appendQuotedCharacters(data.bufferAs16Bit, data.length);
+        }
+        append('"');
+    }
+
+    ExecutionState& m_state;
+    const StaticStrings* m_strings;
+    Object* m_objectPrototype;
+    Object* m_arrayPrototype;
+    String* m_gap;
+    bool m_is8Bit;
+    size_t m_depth;
+    // objects being serialized. used for detecting cyclic structure
+    VectorWithInlineStorage<32, Object*, GCUtil::gc_malloc_allocator<Object*>> m_stack;
+    Latin1StringDataNonGCStd m_latin1Buffer;
+    UTF16StringDataNonGCStd m_utf16Buffer;
+};
+
 static Value builtinJSONStringify(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
 {
     auto strings = &state.context()->staticStrings();
@@ -396,6 +1147,16 @@ static Value builtinJSONStringify(ExecutionState& state, Value thisValue, size_t
         }
     }
 
+    if (replacer.isUndefined() && value.isObject()) {
+        JSONStringifier stringifier(state, gap);
+        if (stringifier.serialize(value)) {
+            String* result = stringifier.finalize();
+            if (LIKELY(result->length() <= STRING_MAXIMUM_LENGTH)) {
+                return result;
+            }
+        }
+    }
+
     std::function<Value(ObjectPropertyName key, Object * holder)> Str;
     std::function<String*(Object*)> JA;
     std::function<String*(Object*)> JO;
@@ -147,15 +147,13 @@ static Value builtinMapForEach(ExecutionState& state, Value thisValue, size_t ar
         T = argv[1];
     }
     // Let entries be the List that is the value of M's [[MapData]] internal slot.
-    const MapObject::MapObjectData& entries = M->storage();
+    MapObject::MapObjectData::Cursor entries(M->storage());
     // Repeat for each Record {[[Key]], [[Value]]} e that is an element of entries, in original key insertion order
-    for (size_t i = 0; i < entries.size(); i++) {
-        // If e.[[Key]] is not empty, then
-        if (!entries[i].first.isEmpty()) {
-            // Perform ? Call(callbackfn, T, « e.[[Value]], e.[[Key]], M »).
-            Value argv[3] = { Value(entries[i].second), Value(entries[i].first), Value(M) };
-            Object::call(state, callbackfn, T, 3, argv);
-        }
+    // If e.[[Key]] is not empty, then
+    while (auto e = entries.next()) {
+        // Perform ? Call(callbackfn, T, « e.[[Value]], e.[[Key]], M »).
+        Value argv[3] = { Value(e->second), Value(e->first), Value(M) };
+        Object::call(state, callbackfn, T, 3, argv);
     }
 
     return Value();
@@ -688,6 +688,22 @@ static Value builtinStringSplit(ExecutionState& state, Value thisValue, size_t a
                 q = p;
             }
         }
+    } else if (P->asString()->length()) {
+        String* R = P->asString();
+        size_t r = R->length();
+        while (q != s) {
+            // a match always ends after p since R is not empty
+            q = S->find(R, q);
+            if (q == SIZE_MAX) {
+                break;
+            }
+            String* T = S->substring(p, q);
+            A->defineOwnProperty(state, ObjectPropertyName(state, Value(lengthA++)), ObjectPropertyDescriptor(T, ObjectPropertyDescriptor::AllPresent));
+            if (lengthA == lim)
+                return A;
+            p = q + r;
+            q = p;
+        }
     } else {
         String* R = P->asString();
         while (q != s) {
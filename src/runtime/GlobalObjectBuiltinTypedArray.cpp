@@ -23,6 +23,7 @@
 #include "VMInstance.h"
 #include "Object.h"
 #include "TypedArrayObject.h"
+#include "TypedArrayInlines.h"
 #include "IteratorObject.h"
 #include "NativeFunctionObject.h"
 
@@ -51,6 +52,247 @@ static ArrayBufferObject* validateTypedArray(ExecutionState& state, const Value&
     return buffer;
 }
 
+// typed loops over the raw element buffer used by the builtins below.
+// they are plain loops over one element type, which compilers vectorize
+#define FOR_EACH_NUMBER_TYPEDARRAY_TYPES(F) \
+    F(Int8, int8_t)                         \
+    F(Int16, int16_t)                       \
+    F(Int32, int32_t)                       \
+    F(Uint8, uint8_t)                       \
+    F(Uint16, uint16_t)                     \
+    F(Uint32, uint32_t)                     \
+    F(Uint8Clamped, uint8_t)                \
+    F(Float32, float)                       \
+    F(Float64, double)
+
+// the element which is strictly equal to the number
+template <typename Type>
+static bool typedArrayElementFromNumber(double number, Type& element)
+{
+    if (std::is_floating_point<Type>::value) {
+        element = static_cast<Type>(number);
+        return static_cast<double>(element) == number;
+    }
+    if (!(number >= static_cast<double>(std::numeric_limits<Type>::min()) && number <= static_cast<double>(std::numeric_limits<Type>::max()))) {
+        return false;
+    }
+    element = static_cast<Type>(number);
+    return static_cast<double>(element) == number;
+}
+
+template <typename Type>
+static size_t typedArrayFindElement(const Type* elements, size_t k, size_t length, Type element)
+{
+    if (sizeof(Type) == 1) {
+        const void* found = memchr(elements + k, (uint8_t)element, length - k);
+        return found ? (const Type*)found - elements : SIZE_MAX;
+    }
+    for (; k < length; k++) {
+        if (elements[k] == element) {
+            return k;
+        }
+    }
+    return SIZE_MAX;
+}
+
+template <typename Type>
+static size_t typedArrayFindElementBackward(const Type* elements, size_t k, Type element)
+{
+    while (true) {
+        if (elements[k] == element) {
+            return k;
+        }
+        if (k-- == 0) {
+            return SIZE_MAX;
+        }
+    }
+}
+
+template <typename Type>
+static size_t typedArrayFindNaN(const Type* elements, size_t k, size_t length)
+{
+    for (; k < length; k++) {
+        if (std::isnan(elements[k])) {
+            return k;
+        }
+    }
+    return SIZE_MAX;
+}
+
+// finds the number in [k, length) of a non-BigInt typed array by strict equality, or by SameValueZero when sameValueZero is true
+// returns length when the number is not found
+static size_t typedArrayFindNumber(TypedArrayObject* O, size_t k, size_t length, double number, bool sameValueZero)
+{
+    ASSERT(k < length);
+    uint8_t* buffer = O->rawBuffer();
+    size_t result = SIZE_MAX;
+    switch (O->typedArrayType()) {
+#define DECLARE_FIND_NUMBER(TYPE, Type)                                                          \
+    case TypedArrayType::TYPE: {                                                                 \
+        Type element;                                                                            \
+        if (typedArrayElementFromNumber<Type>(number, element)) {                                \
+            result = typedArrayFindElement<Type>((const Type*)buffer, k, length, element);       \
+        } else if (sameValueZero && std::is_floating_point<Type>::value && std::isnan(number)) { \
+            result = typedArrayFindNaN<Type>((const Type*)buffer, k, length);                    \
+        }                                                                                        \
+        break;                                                                                   \
+    }
+        FOR_EACH_NUMBER_TYPEDARRAY_TYPES(DECLARE_FIND_NUMBER)
+#undef DECLARE_FIND_NUMBER
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+    return result == SIZE_MAX ? length : result;
+}
+
+// finds the number in [0, k] backward by strict equality. returns SIZE_MAX when the number is not found
+static size_t typedArrayFindNumberBackward(TypedArrayObject* O, size_t k, double number)
+{
+    uint8_t* buffer = O->rawBuffer();
+    switch (O->typedArrayType()) {
+#define DECLARE_FIND_NUMBER_BACKWARD(TYPE, Type)                                         \
+    case TypedArrayType::TYPE: {                                                         \
+        Type element;                                                                    \
+        if (typedArrayElementFromNumber<Type>(number, element)) {                        \
+            return typedArrayFindElementBackward<Type>((const Type*)buffer, k, element); \
+        }                                                                                \
+        return SIZE_MAX;                                                                 \
+    }
+        FOR_EACH_NUMBER_TYPEDARRAY_TYPES(DECLARE_FIND_NUMBER_BACKWARD)
+#undef DECLARE_FIND_NUMBER_BACKWARD
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+        return SIZE_MAX;
+    }
+}
+
+// fill and reverse move element values by their size only
+template <template <typename> class Kernel, typename... Args>
+static void callWithElementSize(size_t elementSize, Args... args)
+{
+    switch (elementSize) {
+    case 1:
+        Kernel<uint8_t>::call(args...);
+        break;
+    case 2:
+        Kernel<uint16_t>::call(args...);
+        break;
+    case 4:
+        Kernel<uint32_t>::call(args...);
+        break;
+    case 8:
+        Kernel<uint64_t>::call(args...);
+        break;
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+}
+
+template <typename Type>
+struct TypedArrayFillKernel {
+    static void call(uint8_t* buffer, size_t k, size_t fin, const uint8_t* rawElement)
+    {
+        Type element;
+        memcpy(&element, rawElement, sizeof(Type));
+        std::fill((Type*)buffer + k, (Type*)buffer + fin, element);
+    }
+};
+
+template <typename Type>
+struct TypedArrayReverseKernel {
+    static void call(uint8_t* buffer, size_t length)
+    {
+        std::reverse((Type*)buffer, (Type*)buffer + length);
+    }
+};
+
+// conversion of elements between non-BigInt types of different kinds. values are converted through double like SetValueInBuffer does
+template <typename Type>
+struct TypedArrayElementConverter {
+    static Type fromDouble(ExecutionState& state, double value)
+    {
+        return IntegralTypedArrayAdapter<Type>::toNativeFromDouble(state, value);
+    }
+};
+
+template <>
+struct TypedArrayElementConverter<float> {
+    static float fromDouble(ExecutionState& state, double value)
+    {
+        return static_cast<float>(value);
+    }
+};
+
+template <>
+struct TypedArrayElementConverter<double> {
+    static double fromDouble(ExecutionState& state, double value)
+    {
+        return value;
+    }
+};
+
+struct TypedArrayClampedElementConverter {
+    static uint8_t fromDouble(ExecutionState& state, double value)
+    {
+        return Uint8ClampedAdaptor::toNativeFromDouble(state, value);
+    }
+};
+
+template <typename SrcType, typename DstType, typename Converter>
+static void typedArrayConvertElements(ExecutionState& state, const uint8_t* srcBuffer, uint8_t* dstBuffer, size_t length)
+{
+    const SrcType* src = (const SrcType*)srcBuffer;
+    DstType* dst = (DstType*)dstBuffer;
+    for (size_t i = 0; i < length; i++) {
+        dst[i] = Converter::fromDouble(state, static_cast<double>(src[i]));
+    }
+}
+
+template <typename DstType, typename Converter>
+static void typedArrayConvertElementsTo(ExecutionState& state, TypedArrayType srcType, const uint8_t* srcBuffer, uint8_t* dstBuffer, size_t length)
+{
+    switch (srcType) {
+#define DECLARE_CONVERT_FROM(TYPE, Type)                                                          \
+    case TypedArrayType::TYPE:                                                                    \
+        typedArrayConvertElements<Type, DstType, Converter>(state, srcBuffer, dstBuffer, length); \
+        break;
+        FOR_EACH_NUMBER_TYPEDARRAY_TYPES(DECLARE_CONVERT_FROM)
+#undef DECLARE_CONVERT_FROM
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+}
+
+// converts elements of a non-BigInt typed array into the buffer of another non-BigInt type
+static void typedArrayConvertElements(ExecutionState& state, TypedArrayType srcType, const uint8_t* srcBuffer, TypedArrayType dstType, uint8_t* dstBuffer, size_t length)
+{
+    switch (dstType) {
+    case TypedArrayType::Uint8Clamped:
+        typedArrayConvertElementsTo<uint8_t, TypedArrayClampedElementConverter>(state, srcType, srcBuffer, dstBuffer, length);
+        break;
+#define DECLARE_CONVERT_TO(TYPE, Type)                                                                                     \
+    case TypedArrayType::TYPE:                                                                                             \
+        typedArrayConvertElementsTo<Type, TypedArrayElementConverter<Type>>(state, srcType, srcBuffer, dstBuffer, length); \
+        break;
+        DECLARE_CONVERT_TO(Int8, int8_t)
+        DECLARE_CONVERT_TO(Int16, int16_t)
+        DECLARE_CONVERT_TO(Int32, int32_t)
+        DECLARE_CONVERT_TO(Uint8, uint8_t)
+        DECLARE_CONVERT_TO(Uint16, uint16_t)
+        DECLARE_CONVERT_TO(Uint32, uint32_t)
+        DECLARE_CONVERT_TO(Float32, float)
+        DECLARE_CONVERT_TO(Float64, double)
+#undef DECLARE_CONVERT_TO
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+}
+
+static bool isBigIntTypedArrayType(TypedArrayType type)
+{
+    return type == TypedArrayType::BigInt64 || type == TypedArrayType::BigUint64;
+}
+
 // https://www.ecma-international.org/ecma-262/10.0/#typedarray-create
 static Object* createTypedArray(ExecutionState& state, const Value& constructor, size_t argc, Value* argv)
 {
@@ -491,33 +733,9 @@ static Value builtinTypedArrayCopyWithin(ExecutionState& state, Value thisValue,
         // Let countBytes be count × elementSize.
         size_t countBytes = count * elementSize;
 
-        int8_t direction = 0;
-        // If fromByteIndex < toByteIndex and toByteIndex < fromByteIndex + countBytes, then
-        if (fromByteIndex < toByteIndex && toByteIndex < fromByteIndex + countBytes) {
-            // Let direction be -1.
-            direction = -1;
-            // Set fromByteIndex to fromByteIndex + countBytes - 1.
-            fromByteIndex = fromByteIndex + countBytes - 1;
-            // Set toByteIndex to toByteIndex + countBytes - 1.
-            toByteIndex = toByteIndex + countBytes - 1;
-        } else {
-            // Let direction be 1.
-            direction = 1;
-        }
-
-        // Repeat, while countBytes > 0
-        while (countBytes > 0) {
-            // Let value be GetValueFromBuffer(buffer, fromByteIndex, "Uint8", true, "Unordered").
-            Value value = buffer->getValueFromBuffer(state, fromByteIndex, TypedArrayType::Uint8);
-            // Perform SetValueInBuffer(buffer, toByteIndex, "Uint8", value, true, "Unordered").
-            buffer->setValueInBuffer(state, toByteIndex, TypedArrayType::Uint8, value);
-            // Set fromByteIndex to fromByteIndex + direction.
-            fromByteIndex += direction;
-            // Set toByteIndex to toByteIndex + direction.
-            toByteIndex += direction;
-            // Decrease countBytes by 1.
-            countBytes--;
-        }
+        // memmove copies overlapping bytes in the same direction as the byte by byte copy of the spec
+        uint8_t* data = const_cast<uint8_t*>(buffer->data());
+        memmove(data + toByteIndex, data + fromByteIndex, countBytes);
     }
 
     // return O.
@@ -567,6 +785,16 @@ static Value builtinTypedArrayIndexOf(ExecutionState& state, Value thisValue, si
     }
     size_t k = (size_t)doubleK;
 
+    TypedArrayObject* T = O->asTypedArrayObject();
+    if (LIKELY(!T->buffer()->isDetachedBuffer() && !isBigIntTypedArrayType(T->typedArrayType()))) {
+        // only a number can be strictly equal to an element
+        if (!argv[0].isNumber()) {
+            return Value(-1);
+        }
+        size_t index = typedArrayFindNumber(T, k, len, argv[0].asNumber(), false);
+        return index == len ? Value(-1) : Value(index);
+    }
+
     // Repeat, while k<len
     while (k < len) {
         // Let kPresent be the result of calling the [[HasProperty]] internal method of O with argument ToString(k).
@@ -628,6 +856,15 @@ static Value builtinTypedArrayLastIndexOf(ExecutionState& state, Value thisValue
     }
     int64_t k = (int64_t)doubleK;
 
+    TypedArrayObject* T = O->asTypedArrayObject();
+    if (LIKELY(!T->buffer()->isDetachedBuffer() && !isBigIntTypedArrayType(T->typedArrayType()))) {
+        if (!argv[0].isNumber()) {
+            return Value(-1);
+        }
+        size_t index = typedArrayFindNumberBackward(T, k, argv[0].asNumber());
+        return index == SIZE_MAX ? Value(-1) : Value(index);
+    }
+
     // Repeat, while k≥ 0
     while (k >= 0) {
         // Let kPresent be the result of calling the [[HasProperty]] internal method of O with argument ToString(k).
@@ -692,6 +929,14 @@ static Value builtinTypedArrayIncludes(ExecutionState& state, Value thisValue, s
     }
     size_t k = (size_t)doubleK;
 
+    TypedArrayObject* T = O->asTypedArrayObject();
+    if (LIKELY(!T->buffer()->isDetachedBuffer() && !isBigIntTypedArrayType(T->typedArrayType()))) {
+        if (!searchElement.isNumber()) {
+            return Value(false);
+        }
+        return Value(typedArrayFindNumber(T, k, len, searchElement.asNumber(), true) != len);
+    }
+
     // Repeat, while k < len
     while (k < len) {
         // Let elementK be the result of ? Get(O, ! ToString(k)).
@@ -786,6 +1031,15 @@ static Value builtinTypedArraySet(ExecutionState& state, Value thisValue, size_t
         ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, strings->TypedArray.string(), true, strings->set.string(), "Cannot mix BigIntArray with other Array");
     }
 
+    size_t targetByteIndex = targetOffset * targetElementSize + targetByteOffset;
+    uint8_t* targetData = const_cast<uint8_t*>(targetBuffer->data());
+
+    if (srcTypedArrayType == typedArrayType) {
+        // the elements are copied by bytes. memmove also copies the overlapping elements of the same buffer
+        memmove(targetData + targetByteIndex, srcBuffer->data() + srcByteOffset, srcElementSize * srcLength);
+        return Value();
+    }
+
     size_t srcByteIndex = srcByteOffset;
     if (srcBuffer == targetBuffer) {
         size_t srcByteLength = srcTypedArray->byteLength();
@@ -793,27 +1047,19 @@ static Value builtinTypedArraySet(ExecutionState& state, Value thisValue, size_t
         srcByteIndex = 0;
     }
 
-    size_t targetByteIndex = targetOffset * targetElementSize + targetByteOffset;
-    size_t limit = targetByteIndex + targetElementSize * srcLength;
+    if (!isBigIntArray) {
+        typedArrayConvertElements(state, srcTypedArrayType, srcBuffer->data() + srcByteIndex, typedArrayType, targetData + targetByteIndex, srcLength);
+        return Value();
+    }
 
-    if (srcTypedArray->typedArrayType() == target->typedArrayType()) {
-        while (targetByteIndex < limit) {
-            // Let value be GetValueFromBuffer(srcBuffer, srcByteIndex, "Uint8", true, "Unordered").
-            Value value = srcBuffer->getValueFromBuffer(state, srcByteIndex, TypedArrayType::Uint8);
-            // Perform SetValueInBuffer(targetBuffer, targetByteIndex, "Uint8", value, true, "Unordered").
-            targetBuffer->setValueInBuffer(state, targetByteIndex, TypedArrayType::Uint8, value);
-            srcByteIndex++;
-            targetByteIndex++;
-        }
-    } else {
-        while (targetByteIndex < limit) {
-            // Let value be GetValueFromBuffer(srcBuffer, srcByteIndex, srcType, true, "Unordered").
-            Value value = srcBuffer->getValueFromBuffer(state, srcByteIndex, srcTypedArray->typedArrayType());
-            // Perform SetValueInBuffer(targetBuffer, targetByteIndex, targetType, value, true, "Unordered").
-            targetBuffer->setValueInBuffer(state, targetByteIndex, target->typedArrayType(), value);
-            srcByteIndex += srcElementSize;
-            targetByteIndex += targetElementSize;
-        }
+    size_t limit = targetByteIndex + targetElementSize * srcLength;
+    while (targetByteIndex < limit) {
+        // Let value be GetValueFromBuffer(srcBuffer, srcByteIndex, srcType, true, "Unordered").
+        Value value = srcBuffer->getValueFromBuffer(state, srcByteIndex, srcTypedArrayType);
+        // Perform SetValueInBuffer(targetBuffer, targetByteIndex, targetType, value, true, "Unordered").
+        targetBuffer->setValueInBuffer(state, targetByteIndex, typedArrayType, value);
+        srcByteIndex += srcElementSize;
+        targetByteIndex += targetElementSize;
     }
 
     return Value();
@@ -885,40 +1131,23 @@ static Value builtinTypedArraySort(ExecutionState& state, Value thisValue, size_
     }
     bool defaultSort = (argc == 0) || cmpfn.isUndefined();
 
-    // [defaultSort, &cmpfn, &state, &buffer]
+    if (defaultSort) {
+        // no user code runs while sorting, so the buffer can be sorted in place
+        O->asTypedArrayObject()->sortInDefaultOrder();
+        return O;
+    }
+
+    // [&cmpfn, &state, &buffer]
     O->sort(state, len, [&](const Value& x, const Value& y) -> bool {
         ASSERT((x.isNumber() || x.isBigInt()) && (y.isNumber() || y.isBigInt()));
-        if (!defaultSort) {
-            Value args[] = { x, y };
-            double v = Object::call(state, cmpfn, Value(), 2, args).toNumber(state);
-            buffer->throwTypeErrorIfDetached(state);
-            if (std::isnan(v)) {
-                return false;
-            }
-            return (v < 0);
-        } else {
-            if (LIKELY(x.isNumber())) {
-                double xNum = x.asNumber();
-                double yNum = y.asNumber();
-
-                // 22.2.3.25.3-10
-                if (std::isnan(xNum)) {
-                    return false;
-                }
-
-                if (std::isnan(yNum)) {
-                    return true;
-                }
-
-                if (xNum == 0.0 && xNum == yNum) {
-                    return std::signbit(xNum);
-                }
-
-                return xNum <= yNum;
-            } else {
-                return x.asBigInt()->lessThanEqual(y.asBigInt());
-            }
-        } });
+        Value args[] = { x, y };
+        double v = Object::call(state, cmpfn, Value(), 2, args).toNumber(state);
+        buffer->throwTypeErrorIfDetached(state);
+        if (std::isnan(v)) {
+            return false;
+        }
+        return (v < 0);
+    });
     return O;
 }
 
@@ -1046,9 +1275,11 @@ static Value builtinTypedArrayFill(ExecutionState& state, Value thisValue, size_
     O->buffer()->throwTypeErrorIfDetached(state);
 
     // Repeat, while k < final
-    while (k < fin) {
-        O->setIndexedPropertyThrowsException(state, Value(k), value);
-        k++;
+    if (k < fin) {
+        // value is already a Number or a BigInt, so converting it has no side effect
+        uint64_t rawElement;
+        TypedArrayHelper::numberToRawBytes(state, typedArrayType, value, (uint8_t*)&rawElement);
+        callWithElementSize<TypedArrayFillKernel>(O->elementSize(), O->rawBuffer(), k, fin, (const uint8_t*)&rawElement);
     }
     // return O.
     return O;
@@ -1430,27 +1661,10 @@ static Value builtinTypedArrayReverse(ExecutionState& state, Value thisValue, si
     // Array.prototype.reverse as defined in 22.1.3.20 except
     // that the this object’s [[ArrayLength]] internal slot is accessed
     // in place of performing a [[Get]] of "length"
-    size_t len = O->asTypedArrayObject()->arrayLength();
-    size_t middle = std::floor(len / 2);
-    size_t lower = 0;
-    while (middle > lower) {
-        size_t upper = len - lower - 1;
-
-        ObjectGetResult upperResult = O->getIndexedProperty(state, Value(upper));
-        ObjectGetResult lowerResult = O->getIndexedProperty(state, Value(lower));
-        RELEASE_ASSERT(upperResult.hasValue() && lowerResult.hasValue());
-
-        Value upperValue = upperResult.value(state, O);
-        Value lowerValue = lowerResult.value(state, O);
-
-        if (!O->setIndexedProperty(state, Value(lower), upperValue)) {
-            ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, state.context()->staticStrings().TypedArray.string(), false, String::emptyString, ErrorObject::Messages::DefineProperty_NotWritable);
-        }
-        if (!O->setIndexedProperty(state, Value(upper), lowerValue)) {
-            ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, state.context()->staticStrings().TypedArray.string(), false, String::emptyString, ErrorObject::Messages::DefineProperty_NotWritable);
-        }
-
-        lower++;
+    TypedArrayObject* T = O->asTypedArrayObject();
+    size_t len = T->arrayLength();
+    if (len > 1) {
+        callWithElementSize<TypedArrayReverseKernel>(T->elementSize(), T->rawBuffer(), len);
     }
     return O;
 }
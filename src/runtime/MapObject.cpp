@@ -52,85 +52,46 @@ void* MapObject::operator new(size_t size)
 
 void MapObject::clear(ExecutionState& state)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        m_storage[i] = std::make_pair(Value(Value::EmptyValue), Value(Value::EmptyValue));
-    }
+    m_storage.clear();
 }
 
 size_t MapObject::size(ExecutionState& state)
 {
-    size_t siz = 0;
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i].first;
-        if (existingKey.isEmpty()) {
-            continue;
-        }
-        siz++;
-    }
-    return siz;
+    return m_storage.size();
 }
 
 bool MapObject::deleteOperation(ExecutionState& state, const Value& key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i].first;
-        if (existingKey.isEmpty()) {
-            continue;
-        }
-        if (existingKey.equalsToByTheSameValueZeroAlgorithm(state, key)) {
-            m_storage[i] = std::make_pair(Value(Value::EmptyValue), Value(Value::EmptyValue));
-            return true;
-        }
-    }
-    return false;
+    return m_storage.remove(state, key);
 }
 
 Value MapObject::get(ExecutionState& state, const Value& key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i].first;
-        if (existingKey.isEmpty()) {
-            continue;
-        }
-        if (existingKey.equalsToByTheSameValueZeroAlgorithm(state, key)) {
-            return m_storage[i].second;
-        }
+    auto entry = m_storage.find(state, key);
+    if (entry) {
+        return entry->second;
     }
     return Value();
 }
 
 bool MapObject::has(ExecutionState& state, const Value& key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i].first;
-        if (existingKey.isEmpty()) {
-            continue;
-        }
-        if (existingKey.equalsToByTheSameValueZeroAlgorithm(state, key)) {
-            return true;
-        }
-    }
-    return false;
+    return m_storage.find(state, key) != nullptr;
 }
 
 void MapObject::set(ExecutionState& state, const Value& key, const Value& value)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i].first;
-        if (existingKey.isEmpty()) {
-            continue;
-        }
-        if (existingKey.equalsToByTheSameValueZeroAlgorithm(state, key)) {
-            m_storage[i].second = value;
-            return;
-        }
+    auto entry = m_storage.find(state, key);
+    if (entry) {
+        entry->second = value;
+        return;
     }
 
     // If key is -0, let key be +0.
     if (key.isNumber() && key.asNumber() == 0 && std::signbit(key.asNumber())) {
-        m_storage.pushBack(std::make_pair(Value(0), value));
+        m_storage.add(std::make_pair(Value(0), value));
     } else {
-        m_storage.pushBack(std::make_pair(key, value));
+        m_storage.add(std::make_pair(key, value));
     }
 }
 
@@ -151,8 +112,7 @@ IteratorObject* MapObject::entries(ExecutionState& state)
 
 MapIteratorObject::MapIteratorObject(ExecutionState& state, MapObject* map, Type type)
     : IteratorObject(state, state.context()->globalObject()->mapIteratorPrototype())
-    , m_map(map)
-    , m_iteratorIndex(0)
+    , m_iteratorCursor(map->m_storage)
     , m_type(type)
 {
 }
@@ -166,7 +126,7 @@ void* MapIteratorObject::operator new(size_t size)
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(MapIteratorObject, m_structure));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(MapIteratorObject, m_prototype));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(MapIteratorObject, m_values));
-        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(MapIteratorObject, m_map));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(MapIteratorObject, m_iteratorCursor));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(MapIteratorObject));
         typeInited = true;
     }
@@ -178,29 +138,19 @@ std::pair<Value, bool> MapIteratorObject::advance(ExecutionState& state)
     // Let m be the value of the [[Map]] internal slot of O.
     // Let index be the value of the [[MapNextIndex]] internal slot of O.
     // Let itemKind be the value of the [[MapIterationKind]] internal slot of O.
-    MapObject* m = m_map;
-    size_t index = m_iteratorIndex;
     Type itemKind = m_type;
 
     // If m is undefined, return CreateIterResultObject(undefined, true).
-    if (m == nullptr) {
-        return std::make_pair(Value(), true);
-    }
-
     // Let entries be the List that is the value of the [[MapData]] internal slot of m.
     // Repeat while index is less than the total number of elements of entries. The number of elements must be redetermined each time this method is evaluated.
-    while (index < m->m_storage.size()) {
-        // Let e be the Record {[[Key]], [[Value]]} that is the value of entries[index].
-        auto e = m->m_storage[index];
-        // Set index to index+1.
-        index++;
-        // Set the [[MapNextIndex]] internal slot of O to index.
-        m_iteratorIndex = index;
-
-        if (e.first.isEmpty()) {
-            continue;
-        }
-        // If e.[[Key]] is not empty, then
+    // Let e be the Record {[[Key]], [[Value]]} that is the value of entries[index].
+    // Set index to index+1.
+    // Set the [[MapNextIndex]] internal slot of O to index.
+    // If e.[[Key]] is not empty, then
+    // NOTE m_iteratorCursor skips empty entries and keeps its position valid across rehashing of [[MapData]]
+    auto entry = m_iteratorCursor.next();
+    if (entry) {
+        auto e = *entry;
         // If itemKind is "key", let result be e.[[Key]].
         // Else if itemKind is "value", let result be e.[[Value]].
         // Else,
@@ -222,7 +172,7 @@ std::pair<Value, bool> MapIteratorObject::advance(ExecutionState& state)
     }
 
     // Set the [[Map]] internal slot of O to undefined.
-    m_map = nullptr;
+    // (cursor is finished)
     // Return CreateIterResultObject(undefined, true).
     return std::make_pair(Value(), true);
 }
@@ -22,6 +22,7 @@
 
 #include "runtime/Object.h"
 #include "runtime/IteratorObject.h"
+#include "runtime/OrderedHashTable.h"
 
 namespace Escargot {
 
@@ -31,7 +32,7 @@ class MapObject : public Object {
     friend class MapIteratorObject;
 
 public:
-    typedef TightVector<std::pair<EncodedValue, EncodedValue>, GCUtil::gc_malloc_allocator<std::pair<EncodedValue, EncodedValue>>> MapObjectData;
+    typedef OrderedHashMap MapObjectData;
 
     explicit MapObject(ExecutionState& state);
     explicit MapObject(ExecutionState& state, Object* proto);
@@ -85,8 +86,8 @@ public:
     void* operator new[](size_t size) = delete;
 
 private:
-    MapObject* m_map;
-    size_t m_iteratorIndex;
+    // [[Map]] and [[MapNextIndex]]. m_iteratorCursor.m_table becomes nullptr when iteration is done
+    MapObject::MapObjectData::Cursor m_iteratorCursor;
     Type m_type;
 };
 } // namespace Escargot
@@ -489,6 +489,93 @@ bool Object::isConcatSpreadable(ExecutionState& state)
     return isArray(state);
 }
 
+// gc heap blocks start at granule (two words) aligned addresses.
+// inline slots must never be aligned like that, or a separate vector of an object
+// which is allocated right after this one would be taken for inline slots
+COMPILE_ASSERT((sizeof(Object) + sizeof(size_t)) % (sizeof(void*) * 2) != 0, "");
+
+Object* Object::createWithInlinePropertySlots(ExecutionState& state, Object* proto, size_t inlineSlotCount)
+{
+    if (!inlineSlotCount) {
+        return new Object(state, proto);
+    }
+
+    ASSERT(inlineSlotCount <= ESCARGOT_OBJECT_INLINE_PROPERTY_SLOT_MAX);
+    size_t allocSize = sizeof(Object) + sizeof(size_t) + sizeof(ObjectPropertyValue) * inlineSlotCount;
+#if defined(ESCARGOT_64) && defined(ESCARGOT_USE_32BIT_IN_64BIT)
+    // slots hold 32-bit encoded values. allocate whole block as property value vector
+    // so GC scans it by 4 bytes (pointers in the header are under 4GB too)
+    COMPILE_ASSERT((sizeof(Object) + sizeof(size_t)) % sizeof(ObjectPropertyValue) == 0, "");
+    void* buf = CustomAllocator<ObjectPropertyValue>().allocate(allocSize / sizeof(ObjectPropertyValue));
+#else
+    void* buf = GC_MALLOC(allocSize);
+#endif
+    Object* obj = new (buf) Object(state, proto);
+    *reinterpret_cast<size_t*>(reinterpret_cast<size_t>(obj) + sizeof(Object)) = inlineSlotCount;
+    obj->m_values.setBufferWithoutOwnership(obj->inlinePropertySlots());
+    return obj;
+}
+
+Object* Object::createWithStructure(ExecutionState& state, Object* proto, ObjectStructure* structure, const Value* values, size_t valueCount)
+{
+    ASSERT(structure->inTransitionMode());
+    ASSERT(structure->propertyCount() == valueCount);
+
+    if (valueCount <= ESCARGOT_OBJECT_INLINE_PROPERTY_SLOT_MAX) {
+        Object* obj = createWithInlinePropertySlots(state, proto, valueCount);
+        obj->m_structure = structure;
+        ObjectPropertyValue* slots = obj->m_values.data();
+        for (size_t i = 0; i < valueCount; i++) {
+            slots[i] = values[i];
+        }
+        return obj;
+    }
+
+    ObjectPropertyValueVector propertyValues;
+    propertyValues.resizeWithUninitializedValues(0, valueCount);
+    for (size_t i = 0; i < valueCount; i++) {
+        propertyValues[i] = values[i];
+    }
+    return new Object(structure, std::move(propertyValues), proto);
+}
+
+void Object::pushBackPropertyValue(const Value& value, size_t newSize)
+{
+    if (hasInlinePropertySlots()) {
+        ObjectPropertyValue* slots = inlinePropertySlots();
+        if (LIKELY(newSize <= inlinePropertySlotCapacity())) {
+            slots[newSize - 1] = value;
+            return;
+        }
+
+        // out of inline slots. move every value into a separate vector
+        m_values.setBufferWithoutOwnership(nullptr);
+        m_values.resizeWithUninitializedValues(0, newSize);
+        for (size_t i = 0; i < newSize - 1; i++) {
+            m_values[i] = slots[i];
+            slots[i] = ObjectPropertyValue(ObjectPropertyValue::EmptyValue);
+        }
+        m_values[newSize - 1] = value;
+        return;
+    }
+
+    m_values.pushBack(value, newSize);
+}
+
+void Object::erasePropertyValue(size_t idx, size_t currentSize)
+{
+    if (hasInlinePropertySlots()) {
+        ObjectPropertyValue* slots = inlinePropertySlots();
+        for (size_t i = idx + 1; i < currentSize; i++) {
+            slots[i - 1] = slots[i];
+        }
+        slots[currentSize - 1] = ObjectPropertyValue(ObjectPropertyValue::EmptyValue);
+        return;
+    }
+
+    m_values.erase(idx, currentSize);
+}
+
 Object* Object::createBuiltinObjectPrototype(ExecutionState& state)
 {
     Object* obj = new Object(state, ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER, Object::__ForGlobalBuiltin__);
@@ -563,6 +650,12 @@ bool Object::setPrototype(ExecutionState& state, const Value& proto)
         }
     }
 
+    // megamorphic get cache remembers absent properties by structures up to the end of prototype chain.
+    // structure of this object does not change here, so drop them when the chain is extended
+    if (UNLIKELY(hasRareData() ? !rareData()->m_prototype : !m_prototype)) {
+        state.context()->vmInstance()->clearGetObjectMegamorphicCache();
+    }
+
     //9. Set the value of the [[Prototype]] internal slot of O to V.
     Object* o = nullptr;
     if (LIKELY(proto.isObject())) {
@@ -638,9 +731,9 @@ bool Object::defineOwnProperty(ExecutionState& state, const ObjectPropertyName&
         ASSERT(structureBefore != m_structure);
         if (LIKELY(desc.isDataProperty())) {
             const Value& val = desc.isValuePresent() ? desc.value() : Value();
-            m_values.pushBack(val, m_structure->propertyCount());
+            pushBackPropertyValue(val, m_structure->propertyCount());
         } else {
-            m_values.pushBack(Value(new JSGetterSetter(desc.getterSetter())), m_structure->propertyCount());
+            pushBackPropertyValue(Value(new JSGetterSetter(desc.getterSetter())), m_structure->propertyCount());
         }
 
         // ASSERT(m_values.size() == m_structure->propertyCount());
@@ -1339,7 +1432,7 @@ ValueVector Object::createListFromArrayLike(ExecutionState& state, Value obj, ui
 void Object::deleteOwnProperty(ExecutionState& state, size_t idx)
 {
     m_structure = m_structure->removeProperty(idx);
-    m_values.erase(idx, m_structure->propertyCount() + 1);
+    erasePropertyValue(idx, m_structure->propertyCount() + 1);
 
     // ASSERT(m_values.size() == m_structure->propertyCount());
 }
@@ -1531,7 +1624,7 @@ bool Object::defineNativeDataAccessorProperty(ExecutionState& state, const Objec
     ASSERT(isExtensible(state));
 
     m_structure = m_structure->addProperty(P.toObjectStructurePropertyName(state), ObjectStructurePropertyDescriptor::createDataButHasNativeGetterSetterDescriptor(data));
-    m_values.pushBack(objectInternalData, m_structure->propertyCount());
+    pushBackPropertyValue(objectInternalData, m_structure->propertyCount());
 
     return true;
 }
@@ -701,6 +701,8 @@ private:
 };
 
 #define ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER 0
+// upper bound of property slots allocated together with an ordinary object
+#define ESCARGOT_OBJECT_INLINE_PROPERTY_SLOT_MAX 16
 #define ESCARGOT_OBJECT_SUBCLASS_MUST_REDEFINE
 
 enum class EnumerableOwnPropertiesType {
@@ -728,6 +730,7 @@ class Object : public PointerValue {
     friend class EnumerateObjectWithIteration;
     friend struct ObjectRareData;
     friend class ObjectTemplate;
+    friend class JSONStringifier;
 
 public:
     explicit Object(ExecutionState& state);
@@ -735,6 +738,22 @@ public:
     enum PrototypeIsNullTag { PrototypeIsNull };
     explicit Object(ExecutionState& state, PrototypeIsNullTag); // I added new function for reducing checking null for prototype
 
+    // create an ordinary object whose first `inlineSlotCount` property values are stored in the same allocation
+    // the object moves its values to a separate vector when it gets more properties than that
+    static Object* createWithInlinePropertySlots(ExecutionState& state, Object* proto, size_t inlineSlotCount);
+    // create an ordinary object which already has every property of `structure`
+    // `values` are ordered as properties of the structure. the structure should be shared one (in transition mode)
+    static Object* createWithStructure(ExecutionState& state, Object* proto, ObjectStructure* structure, const Value* values, size_t valueCount);
+    // structure of this object if it can be given to createWithStructure, otherwise nullptr
+    ObjectStructure* structureForSharing() const
+    {
+        return (m_structure->inTransitionMode() && !m_structure->hasIndexPropertyName()) ? m_structure : nullptr;
+    }
+    // number of own property values. used to size inline slots of objects created later
+    size_t propertyValueCount() const
+    {
+        return m_structure->propertyCount();
+    }
     static Object* createBuiltinObjectPrototype(ExecutionState& state);
     static Object* createFunctionPrototypeObject(ExecutionState& state, FunctionObject* function);
 
@@ -1094,6 +1113,30 @@ protected:
         ASSERT(hasRareData());
         return (ObjectRareData*)m_prototype;
     }
+
+    // layout of object created by createWithInlinePropertySlots
+    // [Object][size_t capacity][ObjectPropertyValue x capacity]
+    // the slots start at an address no other heap block can start at (see COMPILE_ASSERT in Object.cpp),
+    // so m_values points there only if the object owns inline slots
+    ObjectPropertyValue* inlinePropertySlots() const
+    {
+        return reinterpret_cast<ObjectPropertyValue*>(reinterpret_cast<size_t>(this) + sizeof(Object) + sizeof(size_t));
+    }
+
+    bool hasInlinePropertySlots()
+    {
+        return m_values.data() == inlinePropertySlots();
+    }
+
+    size_t inlinePropertySlotCapacity() const
+    {
+        return *reinterpret_cast<size_t*>(reinterpret_cast<size_t>(this) + sizeof(Object));
+    }
+
+    // every growing or shrinking of m_values should be done through these functions
+    void pushBackPropertyValue(const Value& value, size_t newSize);
+    void erasePropertyValue(size_t idx, size_t currentSize);
+
     ObjectStructure* m_structure;
     Object* m_prototype;
     ObjectPropertyValueVector m_values;
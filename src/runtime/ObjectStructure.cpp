@@ -22,6 +22,16 @@
 
 namespace Escargot {
 
+#if defined(ENABLE_IC_STATISTICS)
+size_t ObjectStructureStatistics::s_withTransitionToWithoutTransitionCount;
+size_t ObjectStructureStatistics::s_withTransitionToWithMapCount;
+size_t ObjectStructureStatistics::s_withoutTransitionToWithMapCount;
+
+#define COUNT_OBJECT_STRUCTURE_CONVERSION(name) ObjectStructureStatistics::s_##name##Count++
+#else
+#define COUNT_OBJECT_STRUCTURE_CONVERSION(name)
+#endif
+
 void* ObjectStructureItemVector::operator new(size_t size)
 {
     static bool typeInited = false;
@@ -100,6 +110,7 @@ ObjectStructure* ObjectStructureWithoutTransition::addProperty(const ObjectStruc
     m_properties->push_back(newItem);
 
     if (m_properties->size() + 1 > ESCARGOT_OBJECT_STRUCTURE_ACCESS_CACHE_BUILD_MIN_SIZE) {
+        COUNT_OBJECT_STRUCTURE_CONVERSION(withoutTransitionToWithMap);
         newStructure = new ObjectStructureWithMap(m_properties, ObjectStructureWithMap::createPropertyNameMap(m_properties), m_hasIndexPropertyName | nameIsIndexString);
     } else {
         newStructure = new ObjectStructureWithoutTransition(m_properties, nameIsIndexString, hasNonAtomicName);
@@ -227,8 +238,10 @@ ObjectStructure* ObjectStructureWithTransition::addProperty(const ObjectStructur
 
     size_t nextSize = m_properties.size() + 1;
     if (nextSize > ESCARGOT_OBJECT_STRUCTURE_ACCESS_CACHE_BUILD_MIN_SIZE) {
+        COUNT_OBJECT_STRUCTURE_CONVERSION(withTransitionToWithMap);
         newObjectStructure = new ObjectStructureWithMap(nameIsIndexString, m_properties, newItem);
     } else if (nextSize > ESCARGOT_OBJECT_STRUCTURE_TRANSITION_MODE_MAX_SIZE) {
+        COUNT_OBJECT_STRUCTURE_CONVERSION(withTransitionToWithoutTransition);
         ObjectStructureItemVector* newProperties = new ObjectStructureItemVector(m_properties, newItem);
         newObjectStructure = new ObjectStructureWithoutTransition(newProperties, nameIsIndexString, hasNonAtomicName);
     } else {
@@ -287,6 +300,7 @@ ObjectStructure* ObjectStructureWithTransition::removeProperty(size_t pIndex)
         newIdx++;
     }
 
+    COUNT_OBJECT_STRUCTURE_CONVERSION(withTransitionToWithoutTransition);
     return new ObjectStructureWithoutTransition(newProperties, hasIndexString, hasNonAtomicName);
 }
 
@@ -294,11 +308,13 @@ ObjectStructure* ObjectStructureWithTransition::replacePropertyDescriptor(size_t
 {
     ObjectStructureItemVector* newProperties = new ObjectStructureItemVector(m_properties);
     newProperties->at(idx).m_descriptor = newDesc;
+    COUNT_OBJECT_STRUCTURE_CONVERSION(withTransitionToWithoutTransition);
     return new ObjectStructureWithoutTransition(newProperties, m_hasIndexPropertyName, m_hasNonAtomicPropertyName);
 }
 
 ObjectStructure* ObjectStructureWithTransition::convertToNonTransitionStructure()
 {
+    COUNT_OBJECT_STRUCTURE_CONVERSION(withTransitionToWithoutTransition);
     ObjectStructureItemVector* newProperties = new ObjectStructureItemVector(m_properties);
     return new ObjectStructureWithoutTransition(newProperties, m_hasIndexPropertyName, m_hasNonAtomicPropertyName);
 }
@@ -110,6 +110,16 @@ public:
 #define ESCARGOT_OBJECT_STRUCTURE_TRANSITION_MAP_MIN_SIZE 32
 #endif
 
+#if defined(ENABLE_IC_STATISTICS)
+// counts structure conversions which make inline caching harder.
+// structures do not know their VMInstance, so these counters are process-wide
+struct ObjectStructureStatistics {
+    static size_t s_withTransitionToWithoutTransitionCount;
+    static size_t s_withTransitionToWithMapCount;
+    static size_t s_withoutTransitionToWithMapCount;
+};
+#endif
+
 class ObjectStructure : public gc {
 public:
     virtual ~ObjectStructure() {}
@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2021-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "OrderedHashTable.h"
+#include "Value.h"
+#include "EncodedValue.h"
+#include "BigInt.h"
+
+namespace Escargot {
+
+#define ORDERED_HASH_TABLE_MIN_CAPACITY 8
+#define ORDERED_HASH_TABLE_NOT_FOUND std::numeric_limits<uint32_t>::max()
+
+static inline const EncodedValue& entryKey(const EncodedValue& e)
+{
+    return e;
+}
+
+static inline const EncodedValue& entryKey(const OrderedHashMapEntry& e)
+{
+    return e.first;
+}
+
+static inline void clearEntry(EncodedValue& e)
+{
+    e = EncodedValue(EncodedValue::EmptyValue);
+}
+
+static inline void clearEntry(OrderedHashMapEntry& e)
+{
+    e.first = EncodedValue(EncodedValue::EmptyValue);
+    e.second = EncodedValue(EncodedValue::EmptyValue);
+}
+
+static inline size_t mixHash(uint64_t h)
+{
+    // finalizer of MurmurHash3
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return (size_t)h;
+}
+
+// Keys which are equal by SameValueZero should have same hash value
+static size_t hashKey(const Value& key)
+{
+    if (key.isNumber()) {
+        double d = key.asNumber();
+        if (std::isnan(d)) {
+            return mixHash(0x7ff8000000000000ULL);
+        }
+        // +0 and -0 are same key
+        if (d == 0) {
+            return mixHash(0);
+        }
+        uint64_t bits;
+        memcpy(&bits, &d, sizeof(double));
+        return mixHash(bits);
+    }
+
+    if (key.isPointerValue()) {
+        PointerValue* p = key.asPointerValue();
+        if (p->isString()) {
+            return mixHash(p->asString()->hashValue());
+        } else if (UNLIKELY(p->isBigInt())) {
+            return mixHash((uint64_t)p->asBigInt()->toInt64());
+        }
+        return mixHash((uint64_t)(size_t)p);
+    }
+
+    return mixHash((uint64_t)key.payload());
+}
+
+// The Table is allocated as one block
+// [Table][Entry x capacity][uint32_t bucket x bucketCount][uint32_t chain x capacity]
+template <typename Entry>
+class OrderedHashTable<Entry>::Table {
+public:
+    static Table* create(size_t capacity)
+    {
+        ASSERT(capacity >= ORDERED_HASH_TABLE_MIN_CAPACITY);
+        ASSERT(capacity < ORDERED_HASH_TABLE_NOT_FOUND);
+        size_t bucketCount = capacity / 2;
+        ASSERT((bucketCount & (bucketCount - 1)) == 0);
+        size_t allocSize = sizeof(Table) + sizeof(Entry) * capacity + sizeof(uint32_t) * (bucketCount + capacity);
+        Table* t = new (GC_MALLOC(allocSize)) Table(capacity, bucketCount);
+        memset(t->buckets(), 0xff, sizeof(uint32_t) * bucketCount);
+        return t;
+    }
+
+    Entry* entries()
+    {
+        return reinterpret_cast<Entry*>(this + 1);
+    }
+
+    uint32_t* buckets()
+    {
+        return reinterpret_cast<uint32_t*>(entries() + m_capacity);
+    }
+
+    uint32_t* chain()
+    {
+        return buckets() + m_bucketCount;
+    }
+
+    size_t bucketIndex(const Value& key)
+    {
+        return hashKey(key) & (m_bucketCount - 1);
+    }
+
+    bool isFull() const
+    {
+        return m_usedCount == m_capacity;
+    }
+
+    void append(const Entry& entry)
+    {
+        ASSERT(!isFull());
+        size_t bucket = bucketIndex(entryKey(entry));
+        size_t idx = m_usedCount++;
+        entries()[idx] = entry;
+        chain()[idx] = buckets()[bucket];
+        buckets()[bucket] = idx;
+        m_liveCount++;
+    }
+
+    uint32_t lookup(ExecutionState& state, const Value& key)
+    {
+        Entry* e = entries();
+        uint32_t* c = chain();
+        uint32_t idx = buckets()[bucketIndex(key)];
+        while (idx != ORDERED_HASH_TABLE_NOT_FOUND) {
+            const EncodedValue& k = entryKey(e[idx]);
+            // removed entries stay in the chain as empty
+            if (!k.isEmpty()) {
+                Value existingKey(k);
+                if (existingKey.payload() == key.payload() || existingKey.equalsToByTheSameValueZeroAlgorithm(state, key)) {
+                    return idx;
+                }
+            }
+            idx = c[idx];
+        }
+        return ORDERED_HASH_TABLE_NOT_FOUND;
+    }
+
+    // translate index of frozen table into index of m_nextTable
+    size_t liveCountBefore(size_t index)
+    {
+        ASSERT(m_nextTable);
+        if (m_cleared) {
+            return 0;
+        }
+
+        size_t count = 0;
+        Entry* e = entries();
+        size_t end = std::min(index, (size_t)m_usedCount);
+        for (size_t i = 0; i < end; i++) {
+            if (!entryKey(e[i]).isEmpty()) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    uint32_t m_capacity;
+    uint32_t m_bucketCount;
+    uint32_t m_usedCount;
+    uint32_t m_liveCount;
+    Table* m_nextTable;
+    bool m_cleared;
+
+private:
+    Table(size_t capacity, size_t bucketCount)
+        : m_capacity(capacity)
+        , m_bucketCount(bucketCount)
+        , m_usedCount(0)
+        , m_liveCount(0)
+        , m_nextTable(nullptr)
+        , m_cleared(false)
+    {
+    }
+};
+
+template <typename Entry>
+Entry* OrderedHashTable<Entry>::Cursor::next()
+{
+    while (m_table) {
+        if (UNLIKELY(m_table->m_nextTable != nullptr)) {
+            m_index = m_table->liveCountBefore(m_index);
+            m_table = m_table->m_nextTable;
+            continue;
+        }
+
+        Entry* e = m_table->entries();
+        while (m_index < m_table->m_usedCount) {
+            Entry* current = &e[m_index++];
+            if (!entryKey(*current).isEmpty()) {
+                return current;
+            }
+        }
+
+        m_table = nullptr;
+    }
+    return nullptr;
+}
+
+template <typename Entry>
+OrderedHashTable<Entry>::OrderedHashTable()
+    : m_table(Table::create(ORDERED_HASH_TABLE_MIN_CAPACITY))
+{
+}
+
+template <typename Entry>
+size_t OrderedHashTable<Entry>::size() const
+{
+    return m_table->m_liveCount;
+}
+
+template <typename Entry>
+Entry* OrderedHashTable<Entry>::find(ExecutionState& state, const Value& key) const
+{
+    uint32_t idx = m_table->lookup(state, key);
+    if (idx == ORDERED_HASH_TABLE_NOT_FOUND) {
+        return nullptr;
+    }
+    return &m_table->entries()[idx];
+}
+
+template <typename Entry>
+void OrderedHashTable<Entry>::add(const Entry& entry)
+{
+    if (UNLIKELY(m_table->isFull())) {
+        // compact in place when at least half of entries are removed, otherwise grow
+        size_t capacity = m_table->m_capacity;
+        if (m_table->m_liveCount >= capacity / 2) {
+            capacity *= 2;
+        }
+        rehash(capacity);
+    }
+    m_table->append(entry);
+}
+
+template <typename Entry>
+bool OrderedHashTable<Entry>::remove(ExecutionState& state, const Value& key)
+{
+    uint32_t idx = m_table->lookup(state, key);
+    if (idx == ORDERED_HASH_TABLE_NOT_FOUND) {
+        return false;
+    }
+
+    clearEntry(m_table->entries()[idx]);
+    m_table->m_liveCount--;
+
+    size_t capacity = m_table->m_capacity;
+    if (capacity > ORDERED_HASH_TABLE_MIN_CAPACITY && m_table->m_liveCount < capacity / 4) {
+        rehash(capacity / 2);
+    }
+    return true;
+}
+
+template <typename Entry>
+void OrderedHashTable<Entry>::clear()
+{
+    Table* newTable = Table::create(ORDERED_HASH_TABLE_MIN_CAPACITY);
+    m_table->m_cleared = true;
+    m_table->m_nextTable = newTable;
+    m_table = newTable;
+}
+
+template <typename Entry>
+void OrderedHashTable<Entry>::rehash(size_t newCapacity)
+{
+    Table* oldTable = m_table;
+    Table* newTable = Table::create(newCapacity);
+    ASSERT(oldTable->m_liveCount <= newCapacity);
+
+    Entry* e = oldTable->entries();
+    for (size_t i = 0; i < oldTable->m_usedCount; i++) {
+        if (!entryKey(e[i]).isEmpty()) {
+            newTable->append(e[i]);
+        }
+    }
+
+    // old table is frozen from now on. cursors pointing it will move to new table
+    oldTable->m_nextTable = newTable;
+    m_table = newTable;
+}
+
+template class OrderedHashTable<OrderedHashMapEntry>;
+template class OrderedHashTable<EncodedValue>;
+} // namespace Escargot
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2021-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotOrderedHashTable__
+#define __EscargotOrderedHashTable__
+
+namespace Escargot {
+
+class ExecutionState;
+class Value;
+class EncodedValue;
+
+// Insertion-ordered hash table for [[MapData]] and [[SetData]] (CloseTable layout).
+// Entries are appended to one array in insertion order and chained per hash bucket by index.
+// Deleted entries are left as tombstones (empty key) until the array is full,
+// then live entries are copied into a fresh table and the old table is frozen
+// with a forwarding pointer, so a Cursor that still points into the old table
+// can translate its index when it advances next time.
+template <typename Entry>
+class OrderedHashTable {
+    class Table;
+
+public:
+    struct Cursor {
+        Cursor()
+            : m_table(nullptr)
+            , m_index(0)
+        {
+        }
+
+        explicit Cursor(const OrderedHashTable& from)
+            : m_table(from.m_table)
+            , m_index(0)
+        {
+        }
+
+        bool isFinished() const
+        {
+            return !m_table;
+        }
+
+        // Returns the next live entry or nullptr. Once nullptr is returned the cursor stays finished
+        Entry* next();
+
+        Table* m_table; // should be first member for GC bitmap of owner
+        size_t m_index;
+    };
+
+    OrderedHashTable();
+
+    size_t size() const;
+    Entry* find(ExecutionState& state, const Value& key) const;
+    // caller should make sure that key of entry is not in the table
+    void add(const Entry& entry);
+    bool remove(ExecutionState& state, const Value& key);
+    void clear();
+
+private:
+    void rehash(size_t newCapacity);
+
+    Table* m_table;
+};
+
+typedef std::pair<EncodedValue, EncodedValue> OrderedHashMapEntry;
+typedef OrderedHashTable<OrderedHashMapEntry> OrderedHashMap;
+typedef OrderedHashTable<EncodedValue> OrderedHashSet;
+} // namespace Escargot
+
+#endif
@@ -24,6 +24,7 @@
 
 namespace Escargot {
 
+size_t PointerValue::g_plainObjectTag;
 size_t PointerValue::g_arrayObjectTag;
 size_t PointerValue::g_arrayPrototypeObjectTag;
 size_t PointerValue::g_objectRareDataTag;
@@ -69,6 +69,9 @@ class IntlLocaleObject;
 class IntlPluralRulesObject;
 class IntlRelativeTimeFormatObject;
 #endif
+#if defined(ENABLE_THREADING)
+class SharedArrayBufferObject;
+#endif
 #if defined(ENABLE_WASM)
 class WASMModuleObject;
 class WASMMemoryObject;
@@ -102,6 +105,7 @@ class PointerValue : public gc {
 
     // tag values for fast type check
     // these values actually have unique virtual table address of each object class
+    static size_t g_plainObjectTag;
     static size_t g_arrayObjectTag;
     static size_t g_arrayPrototypeObjectTag;
     static size_t g_objectRareDataTag;
@@ -130,6 +134,12 @@ public:
         return getTagInFirstDataArea() & POINTER_VALUE_BIGINT_TAG_IN_DATA;
     }
 
+    // ordinary object which is exactly Object (not an instance of subclass)
+    inline bool isPlainObject() const
+    {
+        return hasTag(g_plainObjectTag);
+    }
+
     inline bool isArrayObject() const
     {
         return hasTag(g_arrayObjectTag) || hasTag(g_arrayPrototypeObjectTag);
@@ -398,6 +408,13 @@ public:
     }
 #endif
 
+#if defined(ENABLE_THREADING)
+    virtual bool isSharedArrayBufferObject() const
+    {
+        return false;
+    }
+#endif
+
 #if defined(ENABLE_WASM)
     virtual bool isWASMModuleObject() const
     {
@@ -702,6 +719,14 @@ public:
     }
 #endif
 
+#if defined(ENABLE_THREADING)
+    SharedArrayBufferObject* asSharedArrayBufferObject()
+    {
+        ASSERT(isSharedArrayBufferObject());
+        return (SharedArrayBufferObject*)this;
+    }
+#endif
+
 #if defined(ENABLE_WASM)
     WASMModuleObject* asWASMModuleObject()
     {
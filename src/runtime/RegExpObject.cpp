@@ -333,6 +333,12 @@ bool RegExpObject::match(ExecutionState& state, String* str, RegexMatchResult& m
     bool isSticky = option() & RegExpObject::Option::Sticky;
     bool gotResult = false;
     unsigned* outputBuf = ALLOCA(sizeof(unsigned) * 2 * (subPatternNum + 1), unsigned int, state);
+#if defined(ENABLE_JIT)
+    JSC::Yarr::YarrCodeBlock* jitCode = &m_bytecodePattern->m_jitCode;
+    if (!jitCode->ensureCompiled(*m_yarrPattern, str->has8BitContent() ? JSC::Yarr::Char8 : JSC::Yarr::Char16)) {
+        jitCode = nullptr;
+    }
+#endif
     outputBuf[1] = start;
     do {
         start = outputBuf[1];
@@ -340,10 +346,20 @@ bool RegExpObject::match(ExecutionState& state, String* str, RegexMatchResult& m
         if (start > length) {
             break;
         }
-        if (LIKELY(str->has8BitContent()))
-            result = JSC::Yarr::interpret(m_bytecodePattern, str->characters8(), length, start, outputBuf);
-        else
-            result = JSC::Yarr::interpret(m_bytecodePattern, (const UChar*)str->characters16(), length, start, outputBuf);
+#if defined(ENABLE_JIT)
+        if (jitCode) {
+            if (LIKELY(str->has8BitContent()))
+                result = jitCode->execute(str->characters8(), start, length, outputBuf, subPatternNum);
+            else
+                result = jitCode->execute((const UChar*)str->characters16(), start, length, outputBuf, subPatternNum);
+        } else
+#endif
+        {
+            if (LIKELY(str->has8BitContent()))
+                result = JSC::Yarr::interpret(m_bytecodePattern, str->characters8(), length, start, outputBuf);
+            else
+                result = JSC::Yarr::interpret(m_bytecodePattern, (const UChar*)str->characters16(), length, start, outputBuf);
+        }
 
         if (result != JSC::Yarr::offsetNoMatch) {
             gotResult = true;
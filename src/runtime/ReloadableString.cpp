@@ -54,13 +54,17 @@ ReloadableString::ReloadableString(VMInstance* instance, bool is8Bit, size_t str
     m_bufferData.length = stringLength;
     m_bufferData.buffer = nullptr;
 
-    auto& v = instance->reloadableStrings();
-    v.push_back(this);
+    {
+        VMInstanceFinalizerLocker locker;
+        auto& v = instance->reloadableStrings();
+        v.push_back(this);
+    }
     GC_REGISTER_FINALIZER_NO_ORDER(this, [](void* obj, void*) {
         ReloadableString* self = (ReloadableString*)obj;
         if (!self->m_isUnloaded) {
             self->m_stringUnloadCallback(const_cast<void*>(self->m_bufferData.buffer), self->m_callbackData);
         }
+        VMInstanceFinalizerLocker locker;
         if (!self->m_isOwnerMayFreed) {
             auto& v = self->m_vmInstance->reloadableStrings();
             v.erase(std::find(v.begin(), v.end(), self));
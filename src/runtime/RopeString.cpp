@@ -38,6 +38,59 @@ void* RopeString::operator new(size_t size)
     return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
 }
 
+template <typename ResultType>
+static void copyStringBufferData(ResultType* result, const StringBufferAccessData& data)
+{
+    if (data.has8BitContent) {
+        if (sizeof(ResultType) == sizeof(LChar)) {
+            memcpy(result, data.buffer, data.length);
+        } else {
+            auto ptr = (const LChar*)data.buffer;
+            for (size_t i = 0; i < data.length; i++) {
+                result[i] = ptr[i];
+            }
+        }
+    } else {
+        ASSERT(sizeof(ResultType) == sizeof(char16_t));
+        memcpy(result, data.buffer, sizeof(char16_t) * data.length);
+    }
+}
+
+bool RopeString::has8BitContentOf(String* str)
+{
+    if (str->isRopeString()) {
+        // do not flatten the rope to know it
+        return ((RopeString*)str)->m_bufferData.has8BitContent;
+    }
+    return str->has8BitContent();
+}
+
+// copies rstr after the content of lstr in the spare capacity of the buffer of lstr.
+// the new string takes over the capacity and lstr keeps seeing its own prefix of the buffer
+String* RopeString::appendInPlace(RopeString* lstr, String* rstr)
+{
+    ASSERT(lstr->wasFlattened() && lstr->m_appendCapacity);
+    size_t llen = lstr->length();
+    const auto& rData = rstr->bufferAccessData();
+    ASSERT(llen + rData.length <= lstr->m_appendCapacity);
+
+    if (lstr->m_bufferData.has8BitContent) {
+        ASSERT(rData.has8BitContent);
+        copyStringBufferData((LChar*)lstr->m_bufferData.buffer + llen, rData);
+    } else {
+        copyStringBufferData((char16_t*)lstr->m_bufferData.buffer + llen, rData);
+    }
+
+    RopeString* result = new RopeString();
+    result->m_bufferData.hasSpecialImpl = false;
+    result->m_bufferData.has8BitContent = lstr->m_bufferData.has8BitContent;
+    result->m_bufferData.length = llen + rData.length;
+    result->m_bufferData.buffer = lstr->m_bufferData.buffer;
+    result->m_appendCapacity = lstr->m_appendCapacity;
+    lstr->m_appendCapacity = 0;
+    return result;
+}
+
 String* RopeString::createRopeString(String* lstr, String* rstr, ExecutionState* state)
 {
     size_t llen = lstr->length();
@@ -59,16 +112,8 @@ String* RopeString::createRopeString(String* lstr, String* rstr, ExecutionState*
             ret.resizeWithUninitializedValues(len);
 
             LChar* result = ret.data();
-            const LChar* buffer = (const LChar*)lData.buffer;
-            for (size_t i = 0; i < lData.length; i++) {
-                result[i] = buffer[i];
-            }
-
-            result += lData.length;
-            buffer = (const LChar*)rData.buffer;
-            for (size_t i = 0; i < rData.length; i++) {
-                result[i] = buffer[i];
-            }
+            memcpy(result, lData.buffer, lData.length);
+            memcpy(result + lData.length, rData.buffer, rData.length);
             return new Latin1String(std::move(ret));
         } else {
             StringBuilder builder;
@@ -82,25 +127,20 @@ String* RopeString::createRopeString(String* lstr, String* rstr, ExecutionState*
         ErrorObject::throwBuiltinError(*state, ErrorObject::RangeError, ErrorObject::Messages::String_InvalidStringLength);
     }
 
-    RopeString* rope = new RopeString();
-    rope->m_bufferData.length = llen + rlen;
-    rope->m_left = lstr;
-    rope->m_bufferData.buffer = rstr;
+    bool l8bit = has8BitContentOf(lstr);
+    bool r8bit = has8BitContentOf(rstr);
 
-    bool l8bit;
     if (lstr->isRopeString()) {
-        l8bit = ((RopeString*)lstr)->m_bufferData.has8BitContent;
-    } else {
-        l8bit = lstr->has8BitContent();
-    }
-
-    bool r8bit;
-    if (rstr->isRopeString()) {
-        r8bit = ((RopeString*)rstr)->m_bufferData.has8BitContent;
-    } else {
-        r8bit = rstr->has8BitContent();
+        RopeString* lrope = (RopeString*)lstr;
+        if (lrope->wasFlattened() && lrope->m_appendCapacity >= llen + rlen && (!l8bit || r8bit)) {
+            return appendInPlace(lrope, rstr);
+        }
     }
 
+    RopeString* rope = new RopeString();
+    rope->m_bufferData.length = llen + rlen;
+    rope->m_left = lstr;
+    rope->m_bufferData.buffer = rstr;
     rope->m_bufferData.has8BitContent = l8bit & r8bit;
     return rope;
 }
@@ -108,11 +148,26 @@ String* RopeString::createRopeString(String* lstr, String* rstr, ExecutionState*
 template <typename ResultType>
 void RopeString::flattenRopeStringWorker()
 {
-    ResultType* result = (ResultType*)GC_MALLOC_ATOMIC(sizeof(ResultType) * m_bufferData.length);
+    size_t length = m_bufferData.length;
+    size_t capacity = length;
+    // when the leftmost string is a flattened rope, a string which was already read is appended and read again.
+    // this may be a key made from a prefix, so the first time only marks the result with a capacity equal to its length.
+    // when a marked string or one which has spare capacity is appended again, as with s += chunk in a loop,
+    // leave space to append next strings in place. ropes like a + b + c get an exact buffer
+    String* leftmost = left();
+    while (leftmost->isRopeString() && !((RopeString*)leftmost)->wasFlattened()) {
+        leftmost = ((RopeString*)leftmost)->left();
+    }
+    bool appendedAfterRead = leftmost->isRopeString();
+    if (appendedAfterRead && ((RopeString*)leftmost)->m_appendCapacity && length < STRING_MAXIMUM_LENGTH) {
+        capacity = std::min<size_t>(length + std::max<size_t>(length / 2, ROPE_STRING_APPEND_MIN_CAPACITY), STRING_MAXIMUM_LENGTH);
+    }
+
+    ResultType* result = (ResultType*)GC_MALLOC_ATOMIC(sizeof(ResultType) * capacity);
     std::vector<String*> queue;
     queue.push_back(left());
     queue.push_back(right());
-    size_t pos = m_bufferData.length;
+    size_t pos = length;
     while (!queue.empty()) {
         String* cur = queue.back();
         queue.pop_back();
@@ -124,29 +179,15 @@ void RopeString::flattenRopeStringWorker()
                 continue;
             }
         }
-        String* sub = cur;
-        const auto& data = sub->bufferAccessData();
-
+        const auto& data = cur->bufferAccessData();
         pos -= data.length;
-        size_t subLength = data.length;
-
-        if (data.has8BitContent) {
-            auto ptr = (const LChar*)data.buffer;
-            for (size_t i = 0; i < subLength; i++) {
-                result[i + pos] = ptr[i];
-            }
-        } else {
-            auto ptr = (const char16_t*)data.buffer;
-            for (size_t i = 0; i < subLength; i++) {
-                result[i + pos] = ptr[i];
-            }
-        }
+        copyStringBufferData(result + pos, data);
     }
 
     m_bufferData.hasSpecialImpl = false;
     m_bufferData.buffer = result;
 
-    m_left = nullptr;
+    m_appendCapacity = (capacity > length || appendedAfterRead) ? capacity : 0;
 }
 
 void RopeString::flattenRopeString()
@@ -97,8 +97,17 @@ protected:
     void flattenRopeStringWorker();
     void flattenRopeString();
 
+    static bool has8BitContentOf(String* str);
+    static String* appendInPlace(RopeString* lstr, String* rstr);
+
 private:
-    String* m_left;
+    union {
+        String* m_left;
+        // after flattening, the number of code units the buffer can hold.
+        // only the string whose content ends at the end of the used part of the buffer has it, otherwise it is 0.
+        // it is equal to the length when the string has no spare capacity but was appended to after being read
+        size_t m_appendCapacity;
+    };
     // String* m_right; // Right String is stored in m_bufferAccessData.buffer if string is not flattened
 };
 } // namespace Escargot
@@ -108,7 +108,7 @@ Value ScriptClassConstructorFunctionObject::construct(ExecutionState& state, con
             return constructorRealm->globalObject()->objectPrototype();
         });
         // Set the [[Prototype]] internal slot of obj to proto.
-        thisArgument = new Object(state, proto);
+        thisArgument = Object::createWithInlinePropertySlots(state, proto, interpretedCodeBlock()->inlinePropertySlotCountForConstruct());
         // ReturnIfAbrupt(thisArgument).
     }
 
@@ -123,8 +123,12 @@ Value ScriptClassConstructorFunctionObject::construct(ExecutionState& state, con
     // Else, ReturnIfAbrupt(result).
     // Return envRec.GetThisBinding().
     // -> perform at ScriptClassConstructorFunctionObjectReturnValueBinderWithConstruct
-    return FunctionObjectProcessCallGenerator::processCall<ScriptClassConstructorFunctionObject, true, true, true, ScriptClassConstructorFunctionObjectThisValueBinder,
-                                                           ScriptClassConstructorFunctionObjectNewTargetBinderWithConstruct, ScriptClassConstructorFunctionObjectReturnValueBinderWithConstruct>(state, this, thisArgument, argc, argv, newTarget)
-        .asObject();
+    Value result = FunctionObjectProcessCallGenerator::processCall<ScriptClassConstructorFunctionObject, true, true, true, ScriptClassConstructorFunctionObjectThisValueBinder,
+                                                                   ScriptClassConstructorFunctionObjectNewTargetBinderWithConstruct, ScriptClassConstructorFunctionObjectReturnValueBinderWithConstruct>(state, this, thisArgument, argc, argv, newTarget);
+    if (thisArgument) {
+        // next objects get as many inline slots as properties this constructor has added
+        interpretedCodeBlock()->updateInlinePropertySlotCountForConstruct(thisArgument->propertyValueCount());
+    }
+    return result.asObject();
 }
 } // namespace Escargot
@@ -130,10 +130,14 @@ Value ScriptFunctionObject::construct(ExecutionState& state, const size_t argc,
         return constructorRealm->globalObject()->objectPrototype();
     });
     // Set the [[Prototype]] internal slot of obj to proto.
-    Object* thisArgument = new Object(state, proto);
+    InterpretedCodeBlock* codeBlock = interpretedCodeBlock();
+    Object* thisArgument = Object::createWithInlinePropertySlots(state, proto, codeBlock->inlinePropertySlotCountForConstruct());
 
     // ReturnIfAbrupt(thisArgument).
-    return FunctionObjectProcessCallGenerator::processCall<ScriptFunctionObject, true, true, false, ScriptFunctionObjectObjectThisValueBinderWithConstruct, ScriptFunctionObjectNewTargetBinderWithConstruct, ScriptFunctionObjectReturnValueBinderWithConstruct>(state, this, Value(thisArgument), argc, argv, newTarget).asObject();
+    Value result = FunctionObjectProcessCallGenerator::processCall<ScriptFunctionObject, true, true, false, ScriptFunctionObjectObjectThisValueBinderWithConstruct, ScriptFunctionObjectNewTargetBinderWithConstruct, ScriptFunctionObjectReturnValueBinderWithConstruct>(state, this, Value(thisArgument), argc, argv, newTarget);
+    // next objects get as many inline slots as properties this constructor has added
+    codeBlock->updateInlinePropertySlotCountForConstruct(thisArgument->propertyValueCount());
+    return result.asObject();
 }
 
 void ScriptFunctionObject::generateArgumentsObject(ExecutionState& state, size_t argc, Value* argv, FunctionEnvironmentRecord* environmentRecordWillArgumentsObjectBeLocatedIn, Value* stackStorage, bool isMapped)
@@ -22,6 +22,7 @@
 
 #include "runtime/Object.h"
 #include "runtime/IteratorObject.h"
+#include "runtime/OrderedHashTable.h"
 
 namespace Escargot {
 
@@ -31,7 +32,7 @@ class SetObject : public Object {
     friend class SetIteratorObject;
 
 public:
-    typedef TightVector<EncodedValue, GCUtil::gc_malloc_allocator<EncodedValue>> SetObjectData;
+    typedef OrderedHashSet SetObjectData;
 
     explicit SetObject(ExecutionState& state);
     explicit SetObject(ExecutionState& state, Object* proto);
@@ -84,8 +85,8 @@ public:
     void* operator new[](size_t size) = delete;
 
 private:
-    SetObject* m_set;
-    size_t m_iteratorIndex;
+    // [[IteratedSet]] and [[SetNextIndex]]. m_iteratorCursor.m_table becomes nullptr when iteration is done
+    SetObject::SetObjectData::Cursor m_iteratorCursor;
     Type m_type;
 };
 } // namespace Escargot
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2021-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#if defined(ENABLE_THREADING)
+
+#include "Escargot.h"
+#include "runtime/SharedArrayBufferObject.h"
+#include "runtime/VMInstance.h"
+#include "runtime/Platform.h"
+
+namespace Escargot {
+
+void SharedDataBlockInfo::deref(Context* whereObjectMade, ArrayBufferObject* obj)
+{
+    if (m_refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        if (m_data) {
+            m_platform->onArrayBufferObjectDataBufferFree(whereObjectMade, obj, m_data);
+        }
+        delete this;
+    }
+}
+
+SharedArrayBufferObject::SharedArrayBufferObject(ExecutionState& state, Object* proto, size_t byteLength)
+    : ArrayBufferObject(state, proto, ArrayBufferObject::FromExternalMemory)
+    , m_sharedDataBlockInfo(nullptr)
+{
+    ASSERT(byteLength < (size_t)ArrayBufferObject::maxArrayBufferSize);
+
+    Platform* platform = m_context->vmInstance()->platform();
+    m_data = (uint8_t*)platform->onArrayBufferObjectDataBufferMalloc(m_context, this, byteLength);
+    m_bytelength = byteLength;
+    m_sharedDataBlockInfo = new (NoGC) SharedDataBlockInfo(platform, m_data, byteLength);
+    registerFinalizer();
+}
+
+SharedArrayBufferObject::SharedArrayBufferObject(ExecutionState& state, Object* proto, SharedDataBlockInfo* blockInfo)
+    : ArrayBufferObject(state, proto, ArrayBufferObject::FromExternalMemory)
+    , m_sharedDataBlockInfo(blockInfo)
+{
+    blockInfo->ref();
+    m_data = (uint8_t*)blockInfo->data();
+    m_bytelength = blockInfo->byteLength();
+    registerFinalizer();
+}
+
+void SharedArrayBufferObject::registerFinalizer()
+{
+    GC_REGISTER_FINALIZER_NO_ORDER(this, [](void* obj, void*) {
+        SharedArrayBufferObject* self = (SharedArrayBufferObject*)obj;
+        self->m_sharedDataBlockInfo->deref(self->m_context, self);
+    },
+                                   nullptr, nullptr, nullptr);
+}
+
+SharedArrayBufferObject* SharedArrayBufferObject::allocateSharedArrayBuffer(ExecutionState& state, Object* constructor, uint64_t byteLength)
+{
+    // https://tc39.es/ecma262/#sec-allocatesharedarraybuffer
+    Object* proto = Object::getPrototypeFromConstructor(state, constructor, [](ExecutionState& state, Context* constructorRealm) -> Object* {
+        return constructorRealm->globalObject()->sharedArrayBufferPrototype();
+    });
+
+    if (byteLength >= (uint64_t)ArrayBufferObject::maxArrayBufferSize) {
+        ErrorObject::throwBuiltinError(state, ErrorObject::RangeError, state.context()->staticStrings().SharedArrayBuffer.string(), false, String::emptyString, ErrorObject::Messages::GlobalObject_InvalidArrayBufferSize);
+    }
+
+    return new SharedArrayBufferObject(state, proto, byteLength);
+}
+
+void* SharedArrayBufferObject::operator new(size_t size)
+{
+    static bool typeInited = false;
+    static GC_descr descr;
+    if (!typeInited) {
+        GC_word obj_bitmap[GC_BITMAP_SIZE(SharedArrayBufferObject)] = { 0 };
+        Object::fillGCDescriptor(obj_bitmap);
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SharedArrayBufferObject, m_context));
+        descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(SharedArrayBufferObject));
+        typeInited = true;
+    }
+    return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+}
+} // namespace Escargot
+
+#endif
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2021-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#if defined(ENABLE_THREADING)
+
+#ifndef __EscargotSharedArrayBufferObject__
+#define __EscargotSharedArrayBufferObject__
+
+#include "runtime/ArrayBufferObject.h"
+
+namespace Escargot {
+
+class Platform;
+
+// [[ArrayBufferData]] of SharedArrayBuffer. one data block can be shared by
+// SharedArrayBufferObjects of several Contexts running on different threads.
+// the block is allocated as uncollectable so it keeps the Platform which allocated the data alive,
+// and it is released when the last reference is dropped.
+class SharedDataBlockInfo : public gc {
+public:
+    SharedDataBlockInfo(Platform* platform, void* data, size_t byteLength)
+        : m_platform(platform)
+        , m_data(data)
+        , m_byteLength(byteLength)
+        , m_refCount(1)
+    {
+    }
+
+    void* data() const
+    {
+        return m_data;
+    }
+
+    size_t byteLength() const
+    {
+        return m_byteLength;
+    }
+
+    void ref()
+    {
+        m_refCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // the data block is freed through the platform which allocated it when the last reference is dropped.
+    // whereObjectMade and obj are the SharedArrayBufferObject dropping the reference (null for a public handle)
+    void deref(Context* whereObjectMade = nullptr, ArrayBufferObject* obj = nullptr);
+
+private:
+    Platform* m_platform;
+    void* m_data;
+    size_t m_byteLength;
+    std::atomic<size_t> m_refCount;
+};
+
+class SharedArrayBufferObject : public ArrayBufferObject {
+public:
+    // allocate new data block
+    SharedArrayBufferObject(ExecutionState& state, Object* proto, size_t byteLength);
+    // share existing data block
+    SharedArrayBufferObject(ExecutionState& state, Object* proto, SharedDataBlockInfo* blockInfo);
+
+    static SharedArrayBufferObject* allocateSharedArrayBuffer(ExecutionState& state, Object* constructor, uint64_t byteLength);
+
+    virtual bool isSharedArrayBufferObject() const override
+    {
+        return true;
+    }
+
+    SharedDataBlockInfo* sharedDataBlockInfo()
+    {
+        return m_sharedDataBlockInfo;
+    }
+
+    void* operator new(size_t size);
+    void* operator new[](size_t size) = delete;
+
+private:
+    void registerFinalizer();
+
+    SharedDataBlockInfo* m_sharedDataBlockInfo;
+};
+} // namespace Escargot
+#endif // __EscargotSharedArrayBufferObject__
+#endif // ENABLE_THREADING
@@ -31,6 +31,7 @@ void StaticStrings::initStaticStrings()
 #define INIT_STATIC_STRING(name) name.initStaticString(atomicStringMap, new ASCIIStringFromExternalMemory(#name, sizeof(#name) - 1));
     FOR_EACH_STATIC_STRING(INIT_STATIC_STRING)
     FOR_EACH_STATIC_WASM_STRING(INIT_STATIC_STRING)
+    FOR_EACH_STATIC_THREADING_STRING(INIT_STATIC_STRING)
 #undef INIT_STATIC_STRING
 
 #define INIT_STATIC_STRING(atomicString, name) atomicString.initStaticString(atomicStringMap, new ASCIIStringFromExternalMemory(name, sizeof(name) - 1))
@@ -132,6 +133,12 @@ void StaticStrings::initStaticStrings()
     INIT_STATIC_STRING(WebAssemblyDotTable, "WebAssembly.Table");
     INIT_STATIC_STRING(WebAssemblyDotGlobal, "WebAssembly.Global");
 #endif
+
+#if defined(ENABLE_THREADING)
+    INIT_STATIC_STRING(stringAnd, "and");
+    INIT_STATIC_STRING(stringOr, "or");
+    INIT_STATIC_STRING(stringXor, "xor");
+#endif
 #undef INIT_STATIC_STRING
 
 #define INIT_STATIC_NUMBER(num) numbers[num].initStaticString(atomicStringMap, new ASCIIString(#num, sizeof(#num) - 1));
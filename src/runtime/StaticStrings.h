@@ -486,6 +486,20 @@ namespace Escargot {
 #define FOR_EACH_STATIC_WASM_STRING(F)
 #endif
 
+#if defined(ENABLE_THREADING)
+#define FOR_EACH_STATIC_THREADING_STRING(F) \
+    F(Atomics)                              \
+    F(SharedArrayBuffer)                    \
+    F(compareExchange)                      \
+    F(exchange)                             \
+    F(isLockFree)                           \
+    F(notify)                               \
+    F(store)                                \
+    F(wait)
+#else
+#define FOR_EACH_STATIC_THREADING_STRING(F)
+#endif
+
 #define FOR_EACH_STATIC_NUMBER(F) \
     F(0)                          \
     F(1)                          \
@@ -638,7 +652,10 @@ namespace Escargot {
     F(Fulfilled, "fulfilled")                        \
     F(Reason, "reason")                              \
     F(Rejected, "rejected")                          \
-    F(URL, "url")
+    F(URL, "url")                                    \
+    F(Ok, "ok")                                      \
+    F(NotEqual, "not-equal")                         \
+    F(TimedOut, "timed-out")
 
 #if defined(ENABLE_INTL)
 #define FOR_EACH_LAZY_INTL_STATIC_STRING(F)                   \
@@ -846,6 +863,13 @@ public:
     AtomicString WebAssemblyDotGlobal;
 #endif
 
+#if defined(ENABLE_THREADING)
+    // and, or and xor are alternative tokens of C++
+    AtomicString stringAnd;
+    AtomicString stringOr;
+    AtomicString stringXor;
+#endif
+
 #define ESCARGOT_ASCII_TABLE_MAX 256
     AtomicString asciiTable[ESCARGOT_ASCII_TABLE_MAX];
 
@@ -855,6 +879,7 @@ public:
 #define DECLARE_STATIC_STRING(name) AtomicString name;
     FOR_EACH_STATIC_STRING(DECLARE_STATIC_STRING);
     FOR_EACH_STATIC_WASM_STRING(DECLARE_STATIC_STRING);
+    FOR_EACH_STATIC_THREADING_STRING(DECLARE_STATIC_STRING);
 #undef DECLARE_STATIC_STRING
 
 #define DECLARE_LAZY_STATIC_STRING(Name, unused) AtomicString lazy##Name();
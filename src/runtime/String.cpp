@@ -774,6 +774,170 @@ uint64_t String::tryToUseAsIndex() const
     return number;
 }
 
+// Hash reads four code units at once, each widened to 16 bits,
+// so 8-bit and 16-bit content of same characters gets same hash
+static ALWAYS_INLINE uint64_t loadHashBlock(const LChar* src)
+{
+#ifdef ESCARGOT_LITTLE_ENDIAN
+    uint32_t v;
+    memcpy(&v, src, sizeof(uint32_t));
+    uint64_t w = v;
+    w = (w | (w << 16)) & 0x0000FFFF0000FFFFULL;
+    return (w | (w << 8)) & 0x00FF00FF00FF00FFULL;
+#else
+    return (uint64_t)src[0] | ((uint64_t)src[1] << 16) | ((uint64_t)src[2] << 32) | ((uint64_t)src[3] << 48);
+#endif
+}
+
+static ALWAYS_INLINE uint64_t loadHashBlock(const char16_t* src)
+{
+#ifdef ESCARGOT_LITTLE_ENDIAN
+    uint64_t w;
+    memcpy(&w, src, sizeof(uint64_t));
+    return w;
+#else
+    return (uint64_t)src[0] | ((uint64_t)src[1] << 16) | ((uint64_t)src[2] << 32) | ((uint64_t)src[3] << 48);
+#endif
+}
+
+template <typename T>
+static size_t stringHash(const T* src, size_t length)
+{
+    const uint64_t m = 0x9e3779b97f4a7c15ULL;
+    uint64_t h = 0xc70f6907ULL ^ (length * m);
+
+    const T* end = src + (length & ~(size_t)3);
+    for (; src != end; src += 4) {
+        h = (h ^ loadHashBlock(src)) * m;
+        h ^= h >> 32;
+    }
+    for (size_t i = 0; i < (length & 3); i++) {
+        h = (h ^ src[i]) * m;
+    }
+
+    // finalizer of MurmurHash3
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return (uint32_t)h;
+}
+
+size_t String::computeHashValue() const
+{
+    const auto& data = bufferAccessData();
+    size_t hash;
+    if (LIKELY(data.has8BitContent)) {
+        hash = stringHash((const LChar*)data.buffer, data.length);
+    } else {
+        hash = stringHash((const char16_t*)data.buffer, data.length);
+    }
+
+    if (UNLIKELY((hash % sizeof(size_t)) == 0)) {
+        hash++;
+    }
+
+    return hash;
+}
+
+// needles shorter than this are searched by filtering the first code unit
+#define STRING_FIND_HORSPOOL_MIN_NEEDLE_LENGTH 16
+// the shift table of Horspool search does not pay off on short haystacks
+#define STRING_FIND_HORSPOOL_MIN_HAYSTACK_LENGTH 256
+
+template <typename SubjectChar, typename PatternChar>
+static bool matchesAt(const SubjectChar* subject, const PatternChar* pattern, size_t length)
+{
+    if (sizeof(SubjectChar) == sizeof(PatternChar)) {
+        return memcmp(subject, pattern, length * sizeof(SubjectChar)) == 0;
+    }
+    for (size_t i = 0; i < length; i++) {
+        if (subject[i] != pattern[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// returns the first index of ch in [pos, end) or end
+static ALWAYS_INLINE size_t findCodeUnit(const LChar* subject, size_t pos, size_t end, char16_t ch)
+{
+    if (ch > 0xFF) {
+        return end;
+    }
+    // memchr is vectorized by libc
+    const void* found = memchr(subject + pos, ch, end - pos);
+    return found ? (const LChar*)found - subject : end;
+}
+
+static ALWAYS_INLINE size_t findCodeUnit(const char16_t* subject, size_t pos, size_t end, char16_t ch)
+{
+    for (; pos < end; pos++) {
+        if (subject[pos] == ch) {
+            break;
+        }
+    }
+    return pos;
+}
+
+// looks for the first code unit with memchr and checks the last code unit before comparing the rest
+template <typename SubjectChar, typename PatternChar>
+static size_t findByFirstCodeUnit(const SubjectChar* subject, size_t subjectLength, const PatternChar* pattern, size_t patternLength, size_t pos)
+{
+    const size_t end = subjectLength - patternLength + 1;
+    const char16_t first = pattern[0];
+    const char16_t last = pattern[patternLength - 1];
+    while (pos < end) {
+        pos = findCodeUnit(subject, pos, end, first);
+        if (pos == end) {
+            break;
+        }
+        if (subject[pos + patternLength - 1] == last && matchesAt(subject + pos + 1, pattern + 1, patternLength - 1)) {
+            return pos;
+        }
+        pos++;
+    }
+    return SIZE_MAX;
+}
+
+// Boyer-Moore-Horspool search. 16-bit code units share the shift of their low byte
+template <typename SubjectChar, typename PatternChar>
+static size_t findByHorspool(const SubjectChar* subject, size_t subjectLength, const PatternChar* pattern, size_t patternLength, size_t pos)
+{
+    size_t shift[256];
+    for (size_t i = 0; i < 256; i++) {
+        shift[i] = patternLength;
+    }
+    for (size_t i = 0; i < patternLength - 1; i++) {
+        shift[pattern[i] & 0xFF] = patternLength - 1 - i;
+    }
+
+    const char16_t last = pattern[patternLength - 1];
+    const size_t end = subjectLength - patternLength;
+    while (pos <= end) {
+        char16_t ch = subject[pos + patternLength - 1];
+        if (ch == last && matchesAt(subject + pos, pattern, patternLength - 1)) {
+            return pos;
+        }
+        pos += shift[ch & 0xFF];
+    }
+    return SIZE_MAX;
+}
+
+template <typename SubjectChar, typename PatternChar>
+static size_t findSubstring(const SubjectChar* subject, size_t subjectLength, const PatternChar* pattern, size_t patternLength, size_t pos)
+{
+    ASSERT(patternLength && patternLength <= subjectLength);
+    if (patternLength == 1) {
+        size_t end = subjectLength;
+        pos = findCodeUnit(subject, pos, end, pattern[0]);
+        return pos == end ? SIZE_MAX : pos;
+    }
+    if (patternLength >= STRING_FIND_HORSPOOL_MIN_NEEDLE_LENGTH && subjectLength - pos >= STRING_FIND_HORSPOOL_MIN_HAYSTACK_LENGTH) {
+        return findByHorspool(subject, subjectLength, pattern, patternLength, pos);
+    }
+    return findByFirstCodeUnit(subject, subjectLength, pattern, patternLength, pos);
+}
+
 size_t String::find(String* str, size_t pos)
 {
     const size_t srcStrLen = str->length();
@@ -782,40 +946,28 @@ size_t String::find(String* str, size_t pos)
     if (srcStrLen == 0)
         return pos <= size ? pos : SIZE_MAX;
 
-    if (srcStrLen <= size) {
-        char32_t src0 = str->charAt(0);
-        const auto& data = bufferAccessData();
-        if (data.has8BitContent) {
-            for (; pos <= size - srcStrLen; ++pos) {
-                if (((const LChar*)data.buffer)[pos] == src0) {
-                    bool same = true;
-                    for (size_t k = 1; k < srcStrLen; k++) {
-                        if (((const LChar*)data.buffer)[pos + k] != str->charAt(k)) {
-                            same = false;
-                            break;
-                        }
-                    }
-                    if (same)
-                        return pos;
-                }
-            }
-        } else {
-            for (; pos <= size - srcStrLen; ++pos) {
-                if (((const char16_t*)data.buffer)[pos] == src0) {
-                    bool same = true;
-                    for (size_t k = 1; k < srcStrLen; k++) {
-                        if (((const char16_t*)data.buffer)[pos + k] != str->charAt(k)) {
-                            same = false;
-                            break;
-                        }
-                    }
-                    if (same)
-                        return pos;
-                }
+    if (srcStrLen > size || pos > size - srcStrLen) {
+        return SIZE_MAX;
+    }
+
+    const auto& data = bufferAccessData();
+    const auto& srcData = str->bufferAccessData();
+    if (data.has8BitContent) {
+        if (srcData.has8BitContent) {
+            return findSubstring((const LChar*)data.buffer, size, (const LChar*)srcData.buffer, srcStrLen, pos);
+        }
+        // 8-bit content can not contain a code unit over 0xFF
+        for (size_t i = 0; i < srcStrLen; i++) {
+            if (srcData.bufferAs16Bit[i] > 0xFF) {
+                return SIZE_MAX;
             }
         }
+        return findSubstring((const LChar*)data.buffer, size, srcData.bufferAs16Bit, srcStrLen, pos);
     }
-    return SIZE_MAX;
+    if (srcData.has8BitContent) {
+        return findSubstring(data.bufferAs16Bit, size, (const LChar*)srcData.buffer, srcStrLen, pos);
+    }
+    return findSubstring(data.bufferAs16Bit, size, srcData.bufferAs16Bit, srcStrLen, pos);
 }
 
 size_t String::rfind(String* str, size_t pos)
@@ -203,16 +203,19 @@ protected:
             : has8BitContent(true)
             , hasSpecialImpl(false)
             , length(0)
+#if !defined(ESCARGOT_32)
+            , hash(0)
+#endif
             , buffer(nullptr)
         {
         }
 
         bool has8BitContent : 1;
         bool hasSpecialImpl : 1;
-#if defined(ESCARGOT_32)
         size_t length : 30;
-#else
-        size_t length : 62;
+#if !defined(ESCARGOT_32)
+        // lazily computed hash value. 0 means it is not computed yet
+        size_t hash : 32;
 #endif
         union {
             const void* buffer;
@@ -221,7 +224,7 @@ protected:
             String* bufferAsString;
         };
 
-        COMPILE_ASSERT(STRING_MAXIMUM_LENGTH < (std::numeric_limits<size_t>::max() >> 2), "");
+        COMPILE_ASSERT(STRING_MAXIMUM_LENGTH < (1 << 30), "");
 
         operator StringBufferAccessData() const
         {
@@ -410,33 +413,17 @@ public:
 
     String* substring(size_t from, size_t to);
 
-    template <typename T>
-    static inline size_t stringHash(T* src, size_t length)
-    {
-        size_t hash = static_cast<size_t>(0xc70f6907UL);
-        for (; length; --length)
-            hash = (hash * 131) + *src++;
-        return hash;
-    }
-
     size_t hashValue() const
     {
-        const auto& data = bufferAccessData();
-        size_t len = data.length;
-        size_t hash;
-        if (LIKELY(data.has8BitContent)) {
-            auto ptr = (const LChar*)data.buffer;
-            hash = stringHash(ptr, len);
-        } else {
-            auto ptr = (const char16_t*)data.buffer;
-            hash = stringHash(ptr, len);
-        }
-
-        if (UNLIKELY((hash % sizeof(size_t)) == 0)) {
-            hash++;
+#if defined(ESCARGOT_32)
+        return computeHashValue();
+#else
+        // strings are immutable. rope flattening or compression changes buffer only
+        if (UNLIKELY(!m_bufferData.hash)) {
+            const_cast<String*>(this)->m_bufferData.hash = computeHashValue();
         }
-
-        return hash;
+        return m_bufferData.hash;
+#endif
     }
 
     bool operator==(const String& src) const
@@ -518,6 +505,8 @@ protected:
     }
 
     static int stringCompare(size_t l1, size_t l2, const String* c1, const String* c2);
+    // 32-bit hash which is never zero
+    size_t computeHashValue() const;
 
     template <typename T>
     static ALWAYS_INLINE bool stringEqual(const T* s, const T* s1, const size_t len)
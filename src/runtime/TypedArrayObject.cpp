@@ -131,6 +131,186 @@ void TypedArrayObject::sort(ExecutionState& state, int64_t length, const std::fu
     }
 }
 
+// arrays shorter than this are sorted by comparison
+#define TYPEDARRAY_RADIX_SORT_MIN_LENGTH 64
+
+// elements are converted to unsigned keys whose order is the default sort order of the elements
+template <typename Type, typename KeyType>
+struct TypedArraySortKey {
+    static KeyType toKey(Type value)
+    {
+        KeyType key;
+        memcpy(&key, &value, sizeof(KeyType));
+        if (std::is_signed<Type>::value) {
+            key ^= (KeyType)1 << (sizeof(KeyType) * 8 - 1);
+        }
+        return key;
+    }
+
+    static Type fromKey(KeyType key)
+    {
+        if (std::is_signed<Type>::value) {
+            key ^= (KeyType)1 << (sizeof(KeyType) * 8 - 1);
+        }
+        Type value;
+        memcpy(&value, &key, sizeof(KeyType));
+        return value;
+    }
+};
+
+// negative numbers are flipped entirely and the sign bit is set for positive numbers
+// so -0 comes before +0. every NaN gets the largest key and becomes a positive NaN
+template <typename Type, typename KeyType>
+struct TypedArrayFloatSortKey {
+    static KeyType toKey(Type value)
+    {
+        const KeyType signBit = (KeyType)1 << (sizeof(KeyType) * 8 - 1);
+        if (UNLIKELY(std::isnan(value))) {
+            return ~(KeyType)0;
+        }
+        KeyType key;
+        memcpy(&key, &value, sizeof(KeyType));
+        return (key & signBit) ? ~key : (key | signBit);
+    }
+
+    static Type fromKey(KeyType key)
+    {
+        const KeyType signBit = (KeyType)1 << (sizeof(KeyType) * 8 - 1);
+        key = (key & signBit) ? (key ^ signBit) : ~key;
+        Type value;
+        memcpy(&value, &key, sizeof(KeyType));
+        return value;
+    }
+};
+
+// LSD radix sort of keys by bytes. passes where every key has the same byte are skipped
+template <typename KeyType>
+static void radixSortKeys(KeyType* keys, size_t length)
+{
+    const size_t passCount = sizeof(KeyType);
+    size_t counts[passCount][256];
+    memset(counts, 0, sizeof(counts));
+    for (size_t i = 0; i < length; i++) {
+        KeyType key = keys[i];
+        for (size_t pass = 0; pass < passCount; pass++) {
+            counts[pass][(key >> (pass * 8)) & 0xFF]++;
+        }
+    }
+
+    KeyType* temp = nullptr;
+    KeyType* from = keys;
+    for (size_t pass = 0; pass < passCount; pass++) {
+        size_t* count = counts[pass];
+        if (count[(from[0] >> (pass * 8)) & 0xFF] == length) {
+            continue;
+        }
+        if (!temp) {
+            temp = (KeyType*)GC_MALLOC_ATOMIC(sizeof(KeyType) * length);
+        }
+        KeyType* to = from == keys ? temp : keys;
+
+        size_t offset = 0;
+        for (size_t i = 0; i < 256; i++) {
+            size_t c = count[i];
+            count[i] = offset;
+            offset += c;
+        }
+        for (size_t i = 0; i < length; i++) {
+            KeyType key = from[i];
+            to[count[(key >> (pass * 8)) & 0xFF]++] = key;
+        }
+        from = to;
+    }
+
+    if (from != keys) {
+        memcpy(keys, from, sizeof(KeyType) * length);
+    }
+    if (temp) {
+        GC_FREE(temp);
+    }
+}
+
+template <typename Type, typename KeyType, typename SortKey>
+static void sortTypedArrayBuffer(uint8_t* buffer, size_t length)
+{
+    COMPILE_ASSERT(sizeof(Type) == sizeof(KeyType), "");
+    // the buffer is aligned to the element size
+    KeyType* keys = (KeyType*)buffer;
+    Type* values = (Type*)buffer;
+    for (size_t i = 0; i < length; i++) {
+        keys[i] = SortKey::toKey(values[i]);
+    }
+
+    if (sizeof(KeyType) == 1) {
+        // counting sort
+        size_t counts[256];
+        memset(counts, 0, sizeof(counts));
+        for (size_t i = 0; i < length; i++) {
+            counts[keys[i]]++;
+        }
+        size_t index = 0;
+        for (size_t i = 0; i < 256; i++) {
+            for (size_t j = 0; j < counts[i]; j++) {
+                keys[index++] = (KeyType)i;
+            }
+        }
+    } else if (length < TYPEDARRAY_RADIX_SORT_MIN_LENGTH) {
+        std::sort(keys, keys + length);
+    } else {
+        radixSortKeys(keys, length);
+    }
+
+    for (size_t i = 0; i < length; i++) {
+        values[i] = SortKey::fromKey(keys[i]);
+    }
+}
+
+void TypedArrayObject::sortInDefaultOrder()
+{
+    size_t length = arrayLength();
+    if (length < 2) {
+        return;
+    }
+
+    uint8_t* buffer = rawBuffer();
+    ASSERT(buffer);
+    switch (typedArrayType()) {
+    case TypedArrayType::Int8:
+        sortTypedArrayBuffer<int8_t, uint8_t, TypedArraySortKey<int8_t, uint8_t>>(buffer, length);
+        break;
+    case TypedArrayType::Uint8:
+    case TypedArrayType::Uint8Clamped:
+        sortTypedArrayBuffer<uint8_t, uint8_t, TypedArraySortKey<uint8_t, uint8_t>>(buffer, length);
+        break;
+    case TypedArrayType::Int16:
+        sortTypedArrayBuffer<int16_t, uint16_t, TypedArraySortKey<int16_t, uint16_t>>(buffer, length);
+        break;
+    case TypedArrayType::Uint16:
+        sortTypedArrayBuffer<uint16_t, uint16_t, TypedArraySortKey<uint16_t, uint16_t>>(buffer, length);
+        break;
+    case TypedArrayType::Int32:
+        sortTypedArrayBuffer<int32_t, uint32_t, TypedArraySortKey<int32_t, uint32_t>>(buffer, length);
+        break;
+    case TypedArrayType::Uint32:
+        sortTypedArrayBuffer<uint32_t, uint32_t, TypedArraySortKey<uint32_t, uint32_t>>(buffer, length);
+        break;
+    case TypedArrayType::Float32:
+        sortTypedArrayBuffer<float, uint32_t, TypedArrayFloatSortKey<float, uint32_t>>(buffer, length);
+        break;
+    case TypedArrayType::Float64:
+        sortTypedArrayBuffer<double, uint64_t, TypedArrayFloatSortKey<double, uint64_t>>(buffer, length);
+        break;
+    case TypedArrayType::BigInt64:
+        sortTypedArrayBuffer<int64_t, uint64_t, TypedArraySortKey<int64_t, uint64_t>>(buffer, length);
+        break;
+    case TypedArrayType::BigUint64:
+        sortTypedArrayBuffer<uint64_t, uint64_t, TypedArraySortKey<uint64_t, uint64_t>>(buffer, length);
+        break;
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+}
+
 // https://www.ecma-international.org/ecma-262/10.0/#sec-integerindexedelementget
 ObjectGetResult TypedArrayObject::integerIndexedElementGet(ExecutionState& state, double index)
 {
@@ -79,6 +79,8 @@ public:
     virtual bool set(ExecutionState& state, const ObjectPropertyName& P, const Value& v, const Value& receiver) override;
     virtual void enumeration(ExecutionState& state, bool (*callback)(ExecutionState& state, Object* self, const ObjectPropertyName&, const ObjectStructurePropertyDescriptor& desc, void* data), void* data, bool shouldSkipSymbolKey) override;
     virtual void sort(ExecutionState& state, int64_t length, const std::function<bool(const Value& a, const Value& b)>& comp) override;
+    // sorts the elements in the buffer in ascending numeric order (NaN last, -0 before +0) without boxing them
+    void sortInDefaultOrder();
 
 protected:
     explicit TypedArrayObject(ExecutionState& state, Object* proto)
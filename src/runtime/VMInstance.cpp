@@ -27,9 +27,11 @@
 #include "runtime/JobQueue.h"
 #include "runtime/CompressibleString.h"
 #include "runtime/ReloadableString.h"
+#include "runtime/WeakObjectTable.h"
 #include "runtime/Intl.h"
 #include "interpreter/ByteCode.h"
 #include "parser/ASTAllocator.h"
+#include "parser/Script.h"
 #if defined(ENABLE_CODE_CACHE)
 #include "codecache/CodeCache.h"
 #endif
@@ -148,13 +150,37 @@ void VMInstance::gcEventCallback(GC_EventType t, void* data)
     const bool debuggerEnabled = false;
 #endif /* ESCARGOT_DEBUGGER */
 
+#if defined(ENABLE_THREADING)
+    // any registered thread can start collection while the owner thread of this instance is stopped at arbitrary point.
+    // per-instance maintenance is done only in collections started by the owner thread
+    if (!self->isOwnerThread()) {
+        return;
+    }
+#endif
+
+    if (t == GC_EventType::GC_EVENT_MARK_START && self->m_getObjectMegamorphicCache) {
+        // entries hold unmarked structures. addresses can be reused after this collection
+        self->m_getObjectMegamorphicCache->clear();
+    }
+
     if (t == GC_EventType::GC_EVENT_MARK_START && LIKELY(!debuggerEnabled)) {
         if (self->m_regexpCache->size() > REGEXP_CACHE_SIZE_MAX || UNLIKELY(self->m_inEnterIdleMode)) {
             self->m_regexpCache->clear();
         }
 
         auto& currentCodeSizeTotal = self->compiledByteCodeSize();
-        if (currentCodeSizeTotal > SCRIPT_FUNCTION_OBJECT_BYTECODE_SIZE_MAX || UNLIKELY(self->m_inEnterIdleMode)) {
+#if defined(ENABLE_IC_STATISTICS)
+        // dropping bytecode loses inline cache counters
+        bool shouldDropByteCode = UNLIKELY(self->m_inEnterIdleMode);
+#else
+        bool shouldDropByteCode = currentCodeSizeTotal > SCRIPT_FUNCTION_OBJECT_BYTECODE_SIZE_MAX || UNLIKELY(self->m_inEnterIdleMode);
+#endif
+#if defined(ENABLE_THREADING)
+        // dropped bytecode is restored after invoking finalizers in GC_EVENT_RECLAIM_END
+        // but finalizers cannot be invoked while collecting thread holds the allocation lock
+        shouldDropByteCode = false;
+#endif
+        if (shouldDropByteCode) {
             currentCodeSizeTotal = std::numeric_limits<size_t>::max();
             auto& v = self->compiledByteCodeBlocks();
             for (size_t i = 0; i < v.size(); i++) {
@@ -165,13 +191,21 @@ void VMInstance::gcEventCallback(GC_EventType t, void* data)
             }
         }
     } else if (t == GC_EventType::GC_EVENT_RECLAIM_END) {
+        {
+            VMInstanceFinalizerLocker locker;
+            auto& weakTables = self->weakObjectTables();
+            for (size_t i = 0; i < weakTables.size(); i++) {
+                self->m_droppedWeakEntryCount += weakTables[i]->sweep();
+            }
+
 #if defined(ENABLE_COMPRESSIBLE_STRING)
-        auto currentTick = fastTickCount();
-        if (currentTick - self->m_lastCompressibleStringsTestTime > ESCARGOT_COMPRESSIBLE_COMPRESS_CHECK_INTERVAL) {
-            self->compressStringsIfNeeds(currentTick);
-            self->m_lastCompressibleStringsTestTime = currentTick;
-        }
+            auto currentTick = fastTickCount();
+            if (currentTick - self->m_lastCompressibleStringsTestTime > ESCARGOT_COMPRESSIBLE_COMPRESS_CHECK_INTERVAL) {
+                self->compressStringsIfNeeds(currentTick);
+                self->m_lastCompressibleStringsTestTime = currentTick;
+            }
 #endif
+        }
         auto& currentCodeSizeTotal = self->compiledByteCodeSize();
 
         if (currentCodeSizeTotal == std::numeric_limits<size_t>::max()) {
@@ -193,6 +227,7 @@ void VMInstance::gcEventCallback(GC_EventType t, void* data)
         printf("Done GC: HeapSize: [%f MB , %f MB]\n", GC_get_memory_use() / 1024.f / 1024.f, GC_get_heap_size() / 1024.f / 1024.f);
         printf("bytecode Size %f KiB codeblock count %zu\n", self->compiledByteCodeSize() / 1024.f, self->m_compiledByteCodeBlocks.size());
         printf("regexp cache size %zu\n", self->m_regexpCache->size());
+        printf("weak collection count %zu dropped entries %zu\n", self->m_weakObjectTables.size(), self->m_droppedWeakEntryCount);
     }
     */
 }
@@ -252,27 +287,37 @@ void* VMInstance::operator new(size_t size)
 VMInstance::~VMInstance()
 {
     {
-        auto& v = compiledByteCodeBlocks();
-        for (size_t i = 0; i < v.size(); i++) {
-            v[i]->m_isOwnerMayFreed = true;
+        // finalizers of objects in this instance can run concurrently on other threads
+        VMInstanceFinalizerLocker locker;
+        {
+            auto& v = compiledByteCodeBlocks();
+            for (size_t i = 0; i < v.size(); i++) {
+                v[i]->m_isOwnerMayFreed = true;
+            }
+        }
+        {
+            auto& v = weakObjectTables();
+            for (size_t i = 0; i < v.size(); i++) {
+                v[i]->isOwnerMayFreed() = true;
+            }
         }
-    }
 #if defined(ENABLE_COMPRESSIBLE_STRING)
-    {
-        auto& v = compressibleStrings();
-        for (size_t i = 0; i < v.size(); i++) {
-            v[i]->m_isOwnerMayFreed = true;
+        {
+            auto& v = compressibleStrings();
+            for (size_t i = 0; i < v.size(); i++) {
+                v[i]->m_isOwnerMayFreed = true;
+            }
         }
-    }
 #endif
 #if defined(ENABLE_RELOADABLE_STRING)
-    {
-        auto& v = reloadableStrings();
-        for (size_t i = 0; i < v.size(); i++) {
-            v[i]->m_isOwnerMayFreed = true;
+        {
+            auto& v = reloadableStrings();
+            for (size_t i = 0; i < v.size(); i++) {
+                v[i]->m_isOwnerMayFreed = true;
+            }
         }
-    }
 #endif
+    }
     m_isFinalized = true;
     GC_remove_event_callback(gcEventCallback, this);
     if (m_onVMInstanceDestroy) {
@@ -283,6 +328,14 @@ VMInstance::~VMInstance()
     vzone_close(m_timezone);
 #endif
     delete m_astAllocator;
+#if defined(ENABLE_THREADING)
+    if (m_getObjectMegamorphicCache) {
+        m_getObjectMegamorphicCache->~GetObjectMegamorphicCache();
+        GC_FREE(m_getObjectMegamorphicCache);
+    }
+#else
+    delete m_getObjectMegamorphicCache;
+#endif
 
 #if defined(ENABLE_CODE_CACHE)
     delete m_codeCache;
@@ -306,6 +359,8 @@ VMInstance::VMInstance(Platform* platform, const char* locale, const char* timez
     , m_debuggerEnabled(false)
 #endif /* ESCARGOT_DEBUGGER */
     , m_compiledByteCodeSize(0)
+    , m_droppedWeakEntryCount(0)
+    , m_getObjectMegamorphicCache(nullptr)
 #if defined(ENABLE_COMPRESSIBLE_STRING)
     , m_lastCompressibleStringsTestTime(0)
     , m_compressibleStringsUncomressedBufferSize(0)
@@ -379,10 +434,16 @@ VMInstance::VMInstance(Platform* platform, const char* locale, const char* timez
     },
                     nullptr);
 
+#if defined(ENABLE_THREADING)
+    RELEASE_ASSERT(GC_thread_is_registered());
+    m_ownerThreadId = std::this_thread::get_id();
+    m_canBlock = true;
+#endif
     GC_add_event_callback(gcEventCallback, this);
 
     // initialize tag values
     // object tags will have valid values after installation of builtins
+    PointerValue::g_plainObjectTag = 0;
     PointerValue::g_arrayObjectTag = 0;
     PointerValue::g_arrayPrototypeObjectTag = 0;
     PointerValue::g_objectRareDataTag = ObjectRareData(nullptr).getTag();
@@ -531,6 +592,7 @@ void VMInstance::enterIdleMode()
         GC_gcollect_and_unmap();
     }
 
+    VMInstanceFinalizerLocker locker;
 #if defined(ENABLE_COMPRESSIBLE_STRING)
     // ESCARGOT_LOG_INFO("compressibleStringsUncomressedBufferSize before %lfKB\n", m_compressibleStringsUncomressedBufferSize/1024.f);
     auto& currentAllocatedCompressibleStrings = compressibleStrings();
@@ -558,6 +620,143 @@ void VMInstance::enterIdleMode()
     m_inEnterIdleMode = false;
 }
 
+GetObjectMegamorphicCache* VMInstance::ensureGetObjectMegamorphicCache()
+{
+    ASSERT(!m_getObjectMegamorphicCache);
+#if defined(ENABLE_THREADING)
+    // collections started by other threads don't clear this cache (see gcEventCallback)
+    // so cache should mark its structures to prevent reuse of their addresses
+    m_getObjectMegamorphicCache = new (GC_MALLOC_UNCOLLECTABLE(sizeof(GetObjectMegamorphicCache))) GetObjectMegamorphicCache();
+#else
+    m_getObjectMegamorphicCache = new GetObjectMegamorphicCache();
+#endif
+    return m_getObjectMegamorphicCache;
+}
+
+#if defined(ENABLE_THREADING)
+std::mutex& VMInstance::finalizerLock()
+{
+    static std::mutex lock;
+    return lock;
+}
+#endif
+
+void VMInstance::clearGetObjectMegamorphicCache()
+{
+    if (m_getObjectMegamorphicCache) {
+        m_getObjectMegamorphicCache->clear();
+    }
+}
+
+#if defined(ENABLE_IC_STATISTICS)
+struct InlineCacheSiteRecord {
+    ByteCodeBlock* m_block;
+    size_t m_codePosition;
+    String* m_propertyName;
+    bool m_isSetObjectSite;
+    bool m_isMegamorphic;
+    InlineCacheSiteStatistics m_statistics;
+};
+
+void VMInstance::dumpInlineCacheStatistics(size_t topN)
+{
+    // sites are copied first because computing source location generates bytecode again and can trigger GC
+    // records are allocated in GC heap to keep their ByteCodeBlocks alive
+    std::vector<InlineCacheSiteRecord, GCUtil::gc_malloc_allocator<InlineCacheSiteRecord>> records;
+    // every site is a GetObjectPreComputedCase(0) or SetObjectPreComputedCase(1) site
+    uint64_t accessCount[2] = { 0, 0 };
+    uint64_t missCount[2] = { 0, 0 };
+    size_t siteCount[2] = { 0, 0 };
+    size_t megamorphicSiteCount[2] = { 0, 0 };
+
+    const int maxCacheMissCount = 16;
+    std::vector<size_t> getObjectSites;
+    std::vector<size_t> setObjectSites;
+    auto& blocks = compiledByteCodeBlocks();
+    for (size_t i = 0; i < blocks.size(); i++) {
+        ByteCodeBlock* block = blocks[i];
+        getObjectSites.clear();
+        setObjectSites.clear();
+        block->collectInlineCacheSites(getObjectSites, setObjectSites);
+
+        for (size_t j = 0; j < getObjectSites.size(); j++) {
+            GetObjectPreComputedCase* code = block->peekCode<GetObjectPreComputedCase>(getObjectSites[j]);
+            InlineCacheSiteRecord record = { block, getObjectSites[j], code->m_propertyName.plainString(), false, code->m_cacheMissCount > maxCacheMissCount, code->m_statistics };
+            records.push_back(record);
+        }
+        for (size_t j = 0; j < setObjectSites.size(); j++) {
+            SetObjectPreComputedCase* code = block->peekCode<SetObjectPreComputedCase>(setObjectSites[j]);
+            InlineCacheSiteRecord record = { block, setObjectSites[j], code->m_propertyName.plainString(), true, code->m_missCount > maxCacheMissCount, code->m_statistics };
+            records.push_back(record);
+        }
+    }
+
+    for (size_t i = 0; i < records.size(); i++) {
+        const InlineCacheSiteRecord& r = records[i];
+        accessCount[r.m_isSetObjectSite] += r.m_statistics.m_accessCount;
+        missCount[r.m_isSetObjectSite] += r.m_statistics.m_missCount;
+        siteCount[r.m_isSetObjectSite]++;
+        if (r.m_isMegamorphic) {
+            megamorphicSiteCount[r.m_isSetObjectSite]++;
+        }
+    }
+
+    ESCARGOT_LOG_INFO("inline cache statistics of %zu ByteCodeBlocks\n", blocks.size());
+    for (size_t i = 0; i < 2; i++) {
+        double hitRatio = accessCount[i] ? (accessCount[i] - missCount[i]) * 100.0 / accessCount[i] : 0;
+        ESCARGOT_LOG_INFO("  %s sites %zu, accesses %llu, misses %llu (hit ratio %.2f%%), megamorphic sites %zu\n",
+                          i ? "set" : "get", siteCount[i], (unsigned long long)accessCount[i], (unsigned long long)missCount[i], hitRatio, megamorphicSiteCount[i]);
+    }
+    ESCARGOT_LOG_INFO("  megamorphic cache hits %llu, misses %llu\n",
+                      (unsigned long long)m_inlineCacheStatistics.m_megamorphicCacheHitCount, (unsigned long long)m_inlineCacheStatistics.m_megamorphicCacheMissCount);
+    ESCARGOT_LOG_INFO("  structure conversions (process-wide) WithTransition->WithoutTransition %zu, WithTransition->WithMap %zu, WithoutTransition->WithMap %zu\n",
+                      ObjectStructureStatistics::s_withTransitionToWithoutTransitionCount, ObjectStructureStatistics::s_withTransitionToWithMapCount,
+                      ObjectStructureStatistics::s_withoutTransitionToWithMapCount);
+
+    std::sort(records.begin(), records.end(), [](const InlineCacheSiteRecord& a, const InlineCacheSiteRecord& b) -> bool {
+        if (a.m_statistics.m_missCount != b.m_statistics.m_missCount) {
+            return a.m_statistics.m_missCount > b.m_statistics.m_missCount;
+        }
+        return a.m_statistics.m_accessCount > b.m_statistics.m_accessCount;
+    });
+
+    size_t printCount = topN ? std::min(topN, records.size()) : records.size();
+    ESCARGOT_LOG_INFO("  sites sorted by miss count\n");
+
+    ByteCodeLOCDataMap locMap;
+    for (size_t i = 0; i < printCount; i++) {
+        const InlineCacheSiteRecord& r = records[i];
+        if (!r.m_statistics.m_accessCount) {
+            break;
+        }
+
+        ByteCodeLOCData* locData;
+        auto iterMap = locMap.find(r.m_block);
+        if (iterMap == locMap.end()) {
+            locData = new ByteCodeLOCData();
+            locMap.insert(std::make_pair(r.m_block, locData));
+        } else {
+            locData = iterMap->second;
+        }
+
+        InterpretedCodeBlock* cb = r.m_block->m_codeBlock;
+        ExtendedNodeLOC loc = r.m_block->computeNodeLOCFromByteCode(cb->context(), r.m_codePosition, cb, locData);
+        String* functionName = cb->functionName().string();
+        const char* functionKind = cb->isGlobalCodeBlock() ? "global code" : "anonymous";
+
+        ESCARGOT_LOG_INFO("  %s %s at %s:%zu:%zu (%s): accesses %llu, misses %llu%s\n",
+                          r.m_isSetObjectSite ? "set" : "get", r.m_propertyName->toNonGCUTF8StringData().data(),
+                          cb->script()->srcName()->toNonGCUTF8StringData().data(), loc.line, loc.column,
+                          functionName->length() ? functionName->toNonGCUTF8StringData().data() : functionKind,
+                          (unsigned long long)r.m_statistics.m_accessCount, (unsigned long long)r.m_statistics.m_missCount, r.m_isMegamorphic ? ", megamorphic" : "");
+    }
+
+    for (auto iter = locMap.begin(); iter != locMap.end(); iter++) {
+        delete iter->second;
+    }
+}
+#endif
+
 void VMInstance::somePrototypeObjectDefineIndexedProperty(ExecutionState& state)
 {
     m_didSomePrototypeObjectDefineIndexedProperty = true;
@@ -46,6 +46,8 @@ class CodeBlock;
 class JobQueue;
 class Job;
 class ASTAllocator;
+class WeakObjectTable;
+class GetObjectMegamorphicCache;
 #if defined(ENABLE_COMPRESSIBLE_STRING)
 class CompressibleString;
 #endif
@@ -192,6 +194,72 @@ public:
         return m_compiledByteCodeSize;
     }
 
+    std::vector<WeakObjectTable*>& weakObjectTables()
+    {
+        return m_weakObjectTables;
+    }
+
+#if defined(ENABLE_THREADING)
+    // VMInstance and its Contexts are used only on the thread which created the VMInstance
+    bool isOwnerThread() const
+    {
+        return m_ownerThreadId == std::this_thread::get_id();
+    }
+
+    // [[CanBlock]] of the agent. Atomics.wait throws TypeError when this is false
+    bool canBlock() const
+    {
+        return m_canBlock;
+    }
+
+    void setCanBlock(bool canBlock)
+    {
+        m_canBlock = canBlock;
+    }
+
+    // finalizers can run on any thread which invokes them.
+    // vectors above which are updated by finalizers are guarded by this lock
+    static std::mutex& finalizerLock();
+#endif
+
+    GetObjectMegamorphicCache* getObjectMegamorphicCache()
+    {
+        if (UNLIKELY(!m_getObjectMegamorphicCache)) {
+            return ensureGetObjectMegamorphicCache();
+        }
+        return m_getObjectMegamorphicCache;
+    }
+
+    void clearGetObjectMegamorphicCache();
+
+#if defined(ENABLE_IC_STATISTICS)
+    struct InlineCacheStatistics {
+        InlineCacheStatistics()
+            : m_megamorphicCacheHitCount(0)
+            , m_megamorphicCacheMissCount(0)
+        {
+        }
+
+        uint64_t m_megamorphicCacheHitCount;
+        uint64_t m_megamorphicCacheMissCount;
+    };
+
+    InlineCacheStatistics& inlineCacheStatistics()
+    {
+        return m_inlineCacheStatistics;
+    }
+
+    // prints counters of every GetObjectPreComputedCase and SetObjectPreComputedCase site in compiled ByteCodeBlocks.
+    // sites are sorted by miss count and only the first topN sites are printed (0 prints every site)
+    void dumpInlineCacheStatistics(size_t topN);
+#endif
+
+    // total number of WeakMap and WeakSet entries released by GC because their keys were collected
+    size_t droppedWeakEntryCount() const
+    {
+        return m_droppedWeakEntryCount;
+    }
+
 #if defined(ENABLE_COMPRESSIBLE_STRING)
     std::vector<CompressibleString*>& compressibleStrings()
     {
@@ -304,6 +372,16 @@ private:
     std::vector<ByteCodeBlock*> m_compiledByteCodeBlocks;
     size_t m_compiledByteCodeSize;
 
+    std::vector<WeakObjectTable*> m_weakObjectTables;
+    size_t m_droppedWeakEntryCount;
+
+    // allocated when some site first becomes megamorphic
+    GetObjectMegamorphicCache* m_getObjectMegamorphicCache;
+    NEVER_INLINE GetObjectMegamorphicCache* ensureGetObjectMegamorphicCache();
+#if defined(ENABLE_IC_STATISTICS)
+    InlineCacheStatistics m_inlineCacheStatistics;
+#endif
+
 #if defined(ENABLE_COMPRESSIBLE_STRING)
     uint64_t m_lastCompressibleStringsTestTime;
     size_t m_compressibleStringsUncomressedBufferSize;
@@ -322,6 +400,10 @@ private:
     ToStringRecursionPreventer m_toStringRecursionPreventer;
 
     void* m_stackStartAddress;
+#if defined(ENABLE_THREADING)
+    std::thread::id m_ownerThreadId;
+    bool m_canBlock;
+#endif
 
     // regexp object data
     WTF::BumpPointerAllocator* m_bumpPointerAllocator;
@@ -360,6 +442,24 @@ private:
 
     bf_context_t m_bfContext;
 };
+
+// guards vectors of VMInstance which are updated by finalizers
+class VMInstanceFinalizerLocker {
+public:
+#if defined(ENABLE_THREADING)
+    VMInstanceFinalizerLocker()
+        : m_locker(VMInstance::finalizerLock())
+    {
+    }
+
+private:
+    std::lock_guard<std::mutex> m_locker;
+#else
+    VMInstanceFinalizerLocker()
+    {
+    }
+#endif
+};
 } // namespace Escargot
 
 #endif
@@ -21,6 +21,7 @@
 #include "WeakMapObject.h"
 #include "ArrayObject.h"
 #include "Context.h"
+#include "VMInstance.h"
 
 namespace Escargot {
 
@@ -31,20 +32,13 @@ WeakMapObject::WeakMapObject(ExecutionState& state)
 
 WeakMapObject::WeakMapObject(ExecutionState& state, Object* proto)
     : Object(state, proto)
+    , m_storage(state.context()->vmInstance(), true)
 {
-}
-
-void* WeakMapObject::WeakMapObjectDataItem::operator new(size_t size)
-{
-    static bool typeInited = false;
-    static GC_descr descr;
-    if (!typeInited) {
-        GC_word obj_bitmap[GC_BITMAP_SIZE(WeakMapObject::WeakMapObjectDataItem)] = { 0 };
-        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(WeakMapObject::WeakMapObjectDataItem, data));
-        descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(WeakMapObject::WeakMapObjectDataItem));
-        typeInited = true;
-    }
-    return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+    GC_REGISTER_FINALIZER_NO_ORDER(this, [](void* obj, void*) {
+        WeakMapObject* self = (WeakMapObject*)obj;
+        self->m_storage.finalize();
+    },
+                                   nullptr, nullptr, nullptr);
 }
 
 void* WeakMapObject::operator new(size_t size)
@@ -56,7 +50,8 @@ void* WeakMapObject::operator new(size_t size)
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(WeakMapObject, m_structure));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(WeakMapObject, m_prototype));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(WeakMapObject, m_values));
-        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(WeakMapObject, m_storage));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(WeakMapObject, m_storage.m_keys));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(WeakMapObject, m_storage.m_values));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(WeakMapObject));
         typeInited = true;
     }
@@ -65,54 +60,25 @@ void* WeakMapObject::operator new(size_t size)
 
 bool WeakMapObject::deleteOperation(ExecutionState& state, Object* key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        auto existingKey = m_storage[i]->key;
-        if (existingKey == key) {
-            m_storage[i]->key = nullptr;
-            m_storage[i]->data = EncodedValue(nullptr);
-            return true;
-        }
-    }
-    return false;
+    return m_storage.remove(key);
 }
 
 Value WeakMapObject::get(ExecutionState& state, Object* key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        auto existingKey = m_storage[i]->key;
-        if (existingKey == key) {
-            return m_storage[i]->data;
-        }
+    EncodedValue* data = m_storage.findValue(key);
+    if (data) {
+        return *data;
     }
     return Value();
 }
 
 bool WeakMapObject::has(ExecutionState& state, Object* key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        auto existingKey = m_storage[i]->key;
-        if (existingKey == key) {
-            return true;
-        }
-    }
-    return false;
+    return m_storage.has(key);
 }
 
-
 void WeakMapObject::set(ExecutionState& state, Object* key, const Value& value)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        auto existingKey = m_storage[i]->key;
-        if (existingKey == key) {
-            m_storage[i]->data = value;
-            return;
-        }
-    }
-
-    auto newData = new WeakMapObjectDataItem();
-    newData->key = key;
-    newData->data = value;
-    GC_GENERAL_REGISTER_DISAPPEARING_LINK((void**)&(newData->key), newData->key);
-    m_storage.pushBack(newData);
+    m_storage.set(key, value);
 }
 } // namespace Escargot
@@ -21,20 +21,13 @@
 #define __EscargotWeakMapObject__
 
 #include "runtime/Object.h"
+#include "runtime/WeakObjectTable.h"
 
 namespace Escargot {
 
 class WeakMapObject : public Object {
 public:
-    struct WeakMapObjectDataItem : public gc {
-        Object* key;
-        EncodedValue data;
-
-        void* operator new(size_t size);
-        void* operator new[](size_t size) = delete;
-    };
-
-    typedef TightVector<WeakMapObjectDataItem*, GCUtil::gc_malloc_allocator<WeakMapObjectDataItem*>> WeakMapObjectData;
+    typedef WeakObjectTable WeakMapObjectData;
 
     explicit WeakMapObject(ExecutionState& state);
     explicit WeakMapObject(ExecutionState& state, Object* proto);
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2021-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "WeakObjectTable.h"
+#include "Value.h"
+#include "EncodedValue.h"
+#include "VMInstance.h"
+
+namespace Escargot {
+
+#define WEAK_OBJECT_TABLE_MIN_CAPACITY 8
+#define WEAK_OBJECT_TABLE_NOT_FOUND SIZE_MAX
+
+enum WeakObjectTableSlotState : uint8_t {
+    SlotEmpty = 0,
+    // key of used slot can be nullptr when GC cleared it
+    SlotUsed,
+    SlotDeleted,
+};
+
+static inline size_t hashObject(Object* key)
+{
+    // finalizer of MurmurHash3. objects are aligned so lower bits of address are always same
+    uint64_t h = (uint64_t)(size_t)key;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return (size_t)h;
+}
+
+WeakObjectTable::WeakObjectTable(VMInstance* instance, bool hasValues)
+    : m_keys(nullptr)
+    , m_values(nullptr)
+    , m_vmInstance(instance)
+    , m_capacity(0)
+    , m_liveCount(0)
+    , m_deletedCount(0)
+    , m_hasValues(hasValues)
+    , m_isRehashing(false)
+    , m_isOwnerMayFreed(false)
+{
+    VMInstanceFinalizerLocker locker;
+    instance->weakObjectTables().push_back(this);
+}
+
+void WeakObjectTable::finalize()
+{
+    VMInstanceFinalizerLocker locker;
+    if (!m_isOwnerMayFreed) {
+        auto& v = m_vmInstance->weakObjectTables();
+        v.erase(std::find(v.begin(), v.end(), this));
+    }
+}
+
+size_t WeakObjectTable::lookup(Object* key) const
+{
+    ASSERT(key);
+    if (UNLIKELY(!m_capacity)) {
+        return WEAK_OBJECT_TABLE_NOT_FOUND;
+    }
+
+    size_t mask = m_capacity - 1;
+    size_t idx = hashObject(key) & mask;
+    uint8_t* s = states();
+    while (s[idx] != SlotEmpty) {
+        if (s[idx] == SlotUsed && m_keys[idx] == key) {
+            return idx;
+        }
+        idx = (idx + 1) & mask;
+    }
+    return WEAK_OBJECT_TABLE_NOT_FOUND;
+}
+
+size_t WeakObjectTable::insertionIndex(Object* key)
+{
+    // keep load factor including deleted slots under 3/4 so probing always meets an empty slot
+    if (UNLIKELY((m_liveCount + m_deletedCount + 1) * 4 > m_capacity * 3)) {
+        size_t newCapacity = WEAK_OBJECT_TABLE_MIN_CAPACITY;
+        while (newCapacity < (m_liveCount + 1) * 2) {
+            newCapacity *= 2;
+        }
+        rehash(newCapacity);
+    }
+
+    size_t mask = m_capacity - 1;
+    size_t idx = hashObject(key) & mask;
+    uint8_t* s = states();
+    while (s[idx] == SlotUsed) {
+        idx = (idx + 1) & mask;
+    }
+    if (s[idx] == SlotDeleted) {
+        m_deletedCount--;
+    }
+    return idx;
+}
+
+void WeakObjectTable::rehash(size_t newCapacity)
+{
+    ASSERT((newCapacity & (newCapacity - 1)) == 0);
+    ASSERT(newCapacity <= std::numeric_limits<uint32_t>::max());
+
+    Object** oldKeys = m_keys;
+    EncodedValue* oldValues = m_values;
+    size_t oldCapacity = m_capacity;
+    uint8_t* oldStates = states();
+
+    Object** newKeys = (Object**)GC_MALLOC_ATOMIC((sizeof(Object*) + sizeof(uint8_t)) * newCapacity);
+    memset(newKeys, 0, (sizeof(Object*) + sizeof(uint8_t)) * newCapacity);
+    EncodedValue* newValues = nullptr;
+    if (m_hasValues) {
+        newValues = (EncodedValue*)GC_MALLOC(sizeof(EncodedValue) * newCapacity);
+        for (size_t i = 0; i < newCapacity; i++) {
+            new (&newValues[i]) EncodedValue(EncodedValue::EmptyValue);
+        }
+    }
+
+    // registering disappearing link can trigger GC. sweep should not see half-moved table
+    m_isRehashing = true;
+    m_keys = newKeys;
+    m_values = newValues;
+    m_capacity = newCapacity;
+    m_liveCount = 0;
+    m_deletedCount = 0;
+
+    size_t mask = newCapacity - 1;
+    uint8_t* s = states();
+    for (size_t i = 0; i < oldCapacity; i++) {
+        Object* key = oldKeys[i];
+        if (oldStates[i] != SlotUsed || !key) {
+            continue;
+        }
+        GC_unregister_disappearing_link((void**)&oldKeys[i]);
+
+        size_t idx = hashObject(key) & mask;
+        while (s[idx] != SlotEmpty) {
+            idx = (idx + 1) & mask;
+        }
+        s[idx] = SlotUsed;
+        m_keys[idx] = key;
+        if (m_hasValues) {
+            m_values[idx] = oldValues[i];
+        }
+        m_liveCount++;
+        GC_GENERAL_REGISTER_DISAPPEARING_LINK((void**)&m_keys[idx], key);
+    }
+    m_isRehashing = false;
+}
+
+bool WeakObjectTable::has(Object* key) const
+{
+    return lookup(key) != WEAK_OBJECT_TABLE_NOT_FOUND;
+}
+
+EncodedValue* WeakObjectTable::findValue(Object* key) const
+{
+    ASSERT(m_hasValues);
+    size_t idx = lookup(key);
+    if (idx == WEAK_OBJECT_TABLE_NOT_FOUND) {
+        return nullptr;
+    }
+    return &m_values[idx];
+}
+
+void WeakObjectTable::add(Object* key)
+{
+    ASSERT(!m_hasValues);
+    if (lookup(key) != WEAK_OBJECT_TABLE_NOT_FOUND) {
+        return;
+    }
+
+    size_t idx = insertionIndex(key);
+    states()[idx] = SlotUsed;
+    m_keys[idx] = key;
+    m_liveCount++;
+    GC_GENERAL_REGISTER_DISAPPEARING_LINK((void**)&m_keys[idx], key);
+}
+
+void WeakObjectTable::set(Object* key, const Value& value)
+{
+    ASSERT(m_hasValues);
+    size_t idx = lookup(key);
+    if (idx != WEAK_OBJECT_TABLE_NOT_FOUND) {
+        m_values[idx] = value;
+        return;
+    }
+
+    idx = insertionIndex(key);
+    states()[idx] = SlotUsed;
+    m_keys[idx] = key;
+    m_values[idx] = value;
+    m_liveCount++;
+    GC_GENERAL_REGISTER_DISAPPEARING_LINK((void**)&m_keys[idx], key);
+}
+
+bool WeakObjectTable::remove(Object* key)
+{
+    size_t idx = lookup(key);
+    if (idx == WEAK_OBJECT_TABLE_NOT_FOUND) {
+        return false;
+    }
+
+    GC_unregister_disappearing_link((void**)&m_keys[idx]);
+    states()[idx] = SlotDeleted;
+    m_keys[idx] = nullptr;
+    if (m_hasValues) {
+        m_values[idx] = EncodedValue(EncodedValue::EmptyValue);
+    }
+    m_liveCount--;
+    m_deletedCount++;
+    return true;
+}
+
+size_t WeakObjectTable::sweep()
+{
+    if (!m_liveCount || m_isRehashing) {
+        return 0;
+    }
+
+    size_t dropped = 0;
+    uint8_t* s = states();
+    for (size_t i = 0; i < m_capacity; i++) {
+        if (s[i] == SlotUsed && !m_keys[i]) {
+            // link is already unregistered by GC when it is cleared
+            s[i] = SlotDeleted;
+            if (m_hasValues) {
+                m_values[i] = EncodedValue(EncodedValue::EmptyValue);
+            }
+            dropped++;
+        }
+    }
+    m_liveCount -= dropped;
+    m_deletedCount += dropped;
+    return dropped;
+}
+} // namespace Escargot
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2021-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotWeakObjectTable__
+#define __EscargotWeakObjectTable__
+
+namespace Escargot {
+
+class Object;
+class Value;
+class EncodedValue;
+class VMInstance;
+
+// Open addressing hash table keyed by object identity for [[WeakMapData]] and [[WeakSetData]].
+// Keys live in a pointer-free block and every used key slot is registered as a disappearing link,
+// so GC clears the slot when its key dies. A cleared slot keeps its place in the probe sequence
+// until VMInstance calls sweep() at the end of the collection, which releases the value of the entry.
+class WeakObjectTable {
+    friend class WeakMapObject;
+    friend class WeakSetObject;
+
+public:
+    WeakObjectTable(VMInstance* instance, bool hasValues);
+
+    size_t size() const
+    {
+        return m_liveCount;
+    }
+
+    bool has(Object* key) const;
+    // WeakMap only. returns nullptr if there is no entry for the key
+    EncodedValue* findValue(Object* key) const;
+    // WeakSet only
+    void add(Object* key);
+    // WeakMap only
+    void set(Object* key, const Value& value);
+    bool remove(Object* key);
+
+    // removes entries whose key was collected and returns the number of them
+    size_t sweep();
+
+    // should be called from finalizer of owner object
+    void finalize();
+
+    bool& isOwnerMayFreed()
+    {
+        return m_isOwnerMayFreed;
+    }
+
+private:
+    size_t lookup(Object* key) const;
+    size_t insertionIndex(Object* key);
+    void rehash(size_t newCapacity);
+
+    uint8_t* states() const
+    {
+        return reinterpret_cast<uint8_t*>(m_keys + m_capacity);
+    }
+
+    // [Object* key x capacity][uint8_t state x capacity]. allocated as atomic to keep keys weak
+    Object** m_keys;
+    // nullptr for WeakSet
+    EncodedValue* m_values;
+    VMInstance* m_vmInstance;
+    uint32_t m_capacity;
+    uint32_t m_liveCount;
+    uint32_t m_deletedCount;
+    bool m_hasValues;
+    bool m_isRehashing;
+    bool m_isOwnerMayFreed;
+};
+} // namespace Escargot
+
+#endif
@@ -21,6 +21,7 @@
 #include "WeakSetObject.h"
 #include "ArrayObject.h"
 #include "Context.h"
+#include "VMInstance.h"
 
 namespace Escargot {
 
@@ -31,7 +32,13 @@ WeakSetObject::WeakSetObject(ExecutionState& state)
 
 WeakSetObject::WeakSetObject(ExecutionState& state, Object* proto)
     : Object(state, proto)
+    , m_storage(state.context()->vmInstance(), false)
 {
+    GC_REGISTER_FINALIZER_NO_ORDER(this, [](void* obj, void*) {
+        WeakSetObject* self = (WeakSetObject*)obj;
+        self->m_storage.finalize();
+    },
+                                   nullptr, nullptr, nullptr);
 }
 
 void* WeakSetObject::operator new(size_t size)
@@ -43,7 +50,7 @@ void* WeakSetObject::operator new(size_t size)
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(WeakSetObject, m_structure));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(WeakSetObject, m_prototype));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(WeakSetObject, m_values));
-        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(WeakSetObject, m_storage));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(WeakSetObject, m_storage.m_keys));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(WeakSetObject));
         typeInited = true;
     }
@@ -52,45 +59,16 @@ void* WeakSetObject::operator new(size_t size)
 
 bool WeakSetObject::deleteOperation(ExecutionState& state, Object* key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        if (m_storage[i]) {
-            Object* existingKey = m_storage[i]->key;
-            if (existingKey == key) {
-                m_storage[i] = nullptr;
-                return true;
-            }
-        }
-    }
-    return false;
+    return m_storage.remove(key);
 }
 
 void WeakSetObject::add(ExecutionState& state, Object* key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        if (m_storage[i]) {
-            Object* existingKey = m_storage[i]->key;
-            if (existingKey == key) {
-                return;
-            }
-        }
-    }
-
-    auto newData = new WeakSetObjectDataItem();
-    newData->key = key;
-    GC_GENERAL_REGISTER_DISAPPEARING_LINK((void**)&(newData->key), newData->key);
-    m_storage.pushBack(newData);
+    m_storage.add(key);
 }
 
 bool WeakSetObject::has(ExecutionState& state, Object* key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        if (m_storage[i]) {
-            Object* existingKey = m_storage[i]->key;
-            if (existingKey == key) {
-                return true;
-            }
-        }
-    }
-    return false;
+    return m_storage.has(key);
 }
 } // namespace Escargot
@@ -21,21 +21,13 @@
 #define __EscargotWeakSetObject__
 
 #include "runtime/Object.h"
+#include "runtime/WeakObjectTable.h"
 
 namespace Escargot {
 
 class WeakSetObject : public Object {
 public:
-    struct WeakSetObjectDataItem : public gc {
-        Object* key;
-        void* operator new(size_t size)
-        {
-            return GC_MALLOC_ATOMIC(size);
-        }
-        void* operator new[](size_t size) = delete;
-    };
-
-    typedef TightVector<WeakSetObjectDataItem*, GCUtil::gc_malloc_allocator<WeakSetObjectDataItem*>> WeakSetObjectData;
+    typedef WeakObjectTable WeakSetObjectData;
 
     explicit WeakSetObject(ExecutionState& state);
     explicit WeakSetObject(ExecutionState& state, Object* proto);
@@ -662,6 +662,8 @@ int main(int argc, char* argv[])
     instance->setOnVMInstanceDelete([](VMInstanceRef* instance) {
         delete instance->platform();
     });
+    // shell runs a single agent, so nothing could wake the main thread from Atomics.wait
+    instance->setCanBlock(false);
     PersistentRefHolder<ContextRef> context = createEscargotContext(instance.get());
 
     if (getenv("GC_FREE_SPACE_DIVISOR") && strlen(getenv("GC_FREE_SPACE_DIVISOR"))) {
@@ -672,6 +674,8 @@ int main(int argc, char* argv[])
     bool runShell = true;
     bool seenModule = false;
     std::string fileName;
+    // number of inline cache sites reported at exit. SIZE_MAX means no report
+    size_t inlineCacheStatisticsReportCount = SIZE_MAX;
 
     for (int i = 1; i < argc; i++) {
         if (strlen(argv[i]) >= 2 && argv[i][0] == '-') { // parse command line option
@@ -688,6 +692,11 @@ int main(int argc, char* argv[])
                     fileName = argv[i] + sizeof("--filename-as=") - 1;
                     continue;
                 }
+                if (strstr(argv[i], "--ic-stats") == argv[i]) {
+                    // `--ic-stats` prints every site, `--ic-stats=N` prints N sites with most misses
+                    inlineCacheStatisticsReportCount = argv[i][sizeof("--ic-stats") - 1] == '=' ? strtoul(argv[i] + sizeof("--ic-stats=") - 1, nullptr, 10) : 0;
+                    continue;
+                }
                 if (strcmp(argv[i], "--start-debug-server") == 0) {
                     context->initDebugger(nullptr);
                     continue;
@@ -761,6 +770,13 @@ int main(int argc, char* argv[])
         evalScript(context, str, StringRef::createFromASCII("from shell input"), true, false);
     }
 
+    if (inlineCacheStatisticsReportCount != SIZE_MAX && !instance->dumpInlineCacheStatistics(inlineCacheStatisticsReportCount)) {
+        fprintf(stderr, "--ic-stats needs Escargot built with ESCARGOT_IC_STATISTICS\n");
+    }
+
+    // code cache files are written in background, so wait for them before exit
+    instance->flushCodeCache();
+
     context.release();
     instance.release();
 
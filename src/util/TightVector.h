@@ -482,6 +482,12 @@ public:
         return m_buffer;
     }
 
+    // buffer given here is not owned by the vector. it should be replaced before any operation which reallocates
+    void setBufferWithoutOwnership(T* buffer)
+    {
+        m_buffer = buffer;
+    }
+
 protected:
     T* m_buffer;
 };
@@ -466,6 +466,17 @@ public:
     }
     void* operator new[](size_t size) = delete;
 
+    // used by JIT code which reads vectors directly
+    static constexpr size_t offsetOfBuffer()
+    {
+        return offsetof(Vector, m_buffer);
+    }
+
+    static constexpr size_t offsetOfSize()
+    {
+        return offsetof(Vector, m_size);
+    }
+
 protected:
     T* m_buffer;
     size_t m_size;
@@ -732,3 +732,683 @@ TEST(FunctionTemplate, Basic3) {
     }, ftchild);
 }
 
+
+static size_t allocatedBytesWhileEvaluating(const char* source)
+{
+    Memory::gc();
+    size_t before = Memory::totalSize();
+    evalScript(g_context.get(), StringRef::createFromASCII(source, strlen(source)), StringRef::createFromASCII("test.js"), false);
+    return Memory::totalSize() - before;
+}
+
+TEST(UnboxedDouble, ValueRef) {
+    ValueRef* v = ValueRef::create(0.5);
+    EXPECT_TRUE(v->isNumber());
+    EXPECT_EQ(v->asNumber(), 0.5);
+#if defined(ESCARGOT_64)
+    EXPECT_FALSE(v->isStoreInHeap());
+#endif
+}
+
+TEST(UnboxedDouble, AllocationCount) {
+    // storing fresh doubles into EncodedValue slots (Map entries here) should not allocate more than storing SMIs
+    size_t smiBytes = allocatedBytesWhileEvaluating("var m = new Map(); for (var i = 0; i < 100000; i++) { m.set(i, i); } m = undefined;");
+    size_t doubleBytes = allocatedBytesWhileEvaluating("var m = new Map(); for (var i = 0; i < 100000; i++) { m.set(i, i + 0.5); } m = undefined;");
+#if defined(ESCARGOT_64)
+    EXPECT_LT(doubleBytes, smiBytes + 100000 * sizeof(double));
+#endif
+
+    // object properties and array elements use unboxed doubles only when they are stored as EncodedValue
+    smiBytes = allocatedBytesWhileEvaluating("var a = []; for (var i = 0; i < 100000; i++) { a.push({ x: i, y: i }); } a = undefined;");
+    doubleBytes = allocatedBytesWhileEvaluating("var a = []; for (var i = 0; i < 100000; i++) { a.push({ x: i + 0.5, y: i + 0.25 }); } a = undefined;");
+#if defined(ESCARGOT_64) && !defined(ESCARGOT_USE_32BIT_IN_64BIT)
+    EXPECT_LT(doubleBytes, smiBytes + 100000 * sizeof(double));
+#endif
+}
+
+#if defined(ENABLE_THREADING)
+#include <thread>
+
+TEST(SharedArrayBuffer, WaitResult) {
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var ia = new Int32Array(new SharedArrayBuffer(8)); Atomics.store(ia, 0, 1); Atomics.wait(ia, 0, 0) + ',' + Atomics.wait(ia, 0, 1, 10)"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "not-equal,timed-out");
+}
+
+static SharedDataBlockInfoRef* createSharedBufferForAtomicsTest()
+{
+    SharedDataBlockInfoRef* blockInfo = nullptr;
+    Evaluator::execute(g_context.get(), [](ExecutionStateRef* state, SharedDataBlockInfoRef** blockInfo) -> ValueRef* {
+        SharedArrayBufferObjectRef* sab = SharedArrayBufferObjectRef::create(state, 16);
+        *blockInfo = sab->acquireSharedDataBlockInfo();
+        state->context()->globalObject()->set(state, StringRef::createFromASCII("sharedBuffer"), sab);
+        return ValueRef::createUndefined();
+    },
+                       &blockInfo);
+    return blockInfo;
+}
+
+// runs source on its own VMInstance with the shared buffer as `sharedBuffer`
+static std::thread startAtomicsConsumer(SharedDataBlockInfoRef* blockInfo, const char* source, std::string* result)
+{
+    return std::thread([](SharedDataBlockInfoRef* blockInfo, const char* source, std::string* result) {
+        Globals::initializeThread();
+        EXPECT_TRUE(Globals::isInitializedThread());
+        {
+            PersistentRefHolder<VMInstanceRef> instance = VMInstanceRef::create(new ShellPlatform());
+            instance->setOnVMInstanceDelete([](VMInstanceRef* instance) {
+                delete instance->platform();
+            });
+            PersistentRefHolder<ContextRef> context = ContextRef::create(instance.get());
+
+            Evaluator::execute(context.get(), [](ExecutionStateRef* state, SharedDataBlockInfoRef* blockInfo) -> ValueRef* {
+                state->context()->globalObject()->set(state, StringRef::createFromASCII("sharedBuffer"), SharedArrayBufferObjectRef::create(state, blockInfo));
+                return ValueRef::createUndefined();
+            },
+                               blockInfo);
+            blockInfo->release();
+
+            *result = evalScript(context.get(), StringRef::createFromUTF8(source, strlen(source)), StringRef::createFromASCII("consumer.js"), false);
+        }
+        Globals::finalizeThread();
+    },
+                       blockInfo, source, result);
+}
+
+TEST(SharedArrayBuffer, ProducerConsumer) {
+    SharedDataBlockInfoRef* blockInfo = createSharedBufferForAtomicsTest();
+    ASSERT_TRUE(blockInfo);
+    EXPECT_EQ(blockInfo->byteLength(), 16u);
+
+    // consumer runs on its own VMInstance and sleeps in Atomics.wait until producer notifies it
+    std::string consumerResult;
+    std::thread consumer = startAtomicsConsumer(blockInfo, "var ia = new Int32Array(sharedBuffer); Atomics.wait(ia, 0, 0) + ':' + Atomics.load(ia, 1)", &consumerResult);
+
+    // retry notify until the consumer is woken. value at index 0 is never changed so wait can't return not-equal
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var ia = new Int32Array(sharedBuffer); Atomics.store(ia, 1, 42); while (Atomics.notify(ia, 0, 1) === 0) {} Atomics.load(ia, 1)"), StringRef::createFromASCII("producer.js"), false);
+    consumer.join();
+
+    EXPECT_EQ(s, "42");
+    EXPECT_EQ(consumerResult, "ok:42");
+}
+
+TEST(SharedArrayBuffer, WaitLargeTimeout) {
+    SharedDataBlockInfoRef* blockInfo = createSharedBufferForAtomicsTest();
+    ASSERT_TRUE(blockInfo);
+
+    // deadline of these timeouts can not be represented by the clock, so they should not time out at once.
+    // consumer sets index 2 after each wait so that producer stops notifying even if a wait returns early
+    std::string consumerResult;
+    std::thread consumer = startAtomicsConsumer(blockInfo, "var ia = new Int32Array(sharedBuffer); var r = []; [Number.MAX_SAFE_INTEGER, 1e300].forEach(function (t) { r.push(Atomics.wait(ia, 0, 0, t)); Atomics.add(ia, 2, 1); }); r.join()", &consumerResult);
+
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var ia = new Int32Array(sharedBuffer); var n = 0; while (Atomics.load(ia, 2) < 2) { if (Atomics.load(ia, 2) === n && Atomics.notify(ia, 0, 1) === 1) { n++; } } n"), StringRef::createFromASCII("producer.js"), false);
+    consumer.join();
+
+    EXPECT_EQ(consumerResult, "ok,ok");
+    EXPECT_EQ(s, "2");
+}
+
+TEST(SharedArrayBuffer, WaitCanNotBlock) {
+    g_context->vmInstance()->setCanBlock(false);
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var ia = new Int32Array(new SharedArrayBuffer(8)); var r; try { Atomics.wait(ia, 0, 1, 0); } catch (e) { r = e instanceof TypeError; } [r, Atomics.notify(ia, 0)].join()"), StringRef::createFromASCII("test.js"), false);
+    g_context->vmInstance()->setCanBlock(true);
+    EXPECT_EQ(s, "true,0");
+    EXPECT_TRUE(g_context->vmInstance()->canBlock());
+}
+#endif
+
+TEST(EvalScript, HotLoop) {
+    // long enough to be compiled when JIT is enabled. covers int32 overflow, property loads and exceptions in compiled loops
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("function f(o) { var s = 2147483000; for (var i = 0; i < 5000; i++) { s = s + o.x; } return s; } f({ x: 1 }) + ',' + f({ y: 0, x: 0.5 })"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "2147488000,2147485500");
+
+    s = evalScript(g_context.get(), StringRef::createFromASCII("function g(o) { var c = 0; for (var i = 0; i < 5000; i++) { try { if (i % 1000 == 999) o.x.y; c++; } catch (e) { c += 100; } } return c; } g({ x: null })"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "5495");
+}
+
+TEST(EvalScript, RegExp) {
+    // runs on native code when JIT is enabled. covers backtracking, captures, lookahead and 16-bit input
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("'2021-03-17 12:40:07 [WARN] id=42'.replace(/^(\\d{4})-(\\d\\d)-(\\d\\d) .*?\\[(\\w+)\\](?: id=(\\d+))?$/, '$4:$5:$3.$2.$1')"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "WARN:42:17.03.2021");
+
+    s = evalScript(g_context.get(), StringRef::createFromASCII("'aaa ab a1b 12ms \\u3042b'.match(/a+b|\\d+(?=ms)|(?!a)\\W?b/g).join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "ab,b,12,\xE3\x81\x82" "b");
+
+    s = evalScript(g_context.get(), StringRef::createFromASCII("var r = /(a)|b/y; r.lastIndex = 1; String(r.exec('xab')) + ',' + r.exec('xab') + ',' + r.lastIndex"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "a,a,b,,3");
+}
+
+TEST(EvalScript, ByteCodeOptimizer) {
+    // fused compares, threaded && chains and literals hoisted out of the loop
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("(function (a) { var r = ''; for (var i = 0; i < a.length; i++) { if (a[i] > 1 && a[i] !== 3 || a[i] == null) r += 'x'; else r += a[i] >= 2 ? 'y' : 'z'; } return r; })([0, 2, 3, null, 5, NaN])"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "zxyxxz");
+
+    // location of an error thrown after removed bytecodes
+    s = evalScript(g_context.get(), StringRef::createFromASCII("(function () { var o = null, n = 0;\nwhile (n < 3) n = n + 1;\ntry { (function () { var t = n + 1; return o.p + t; })(); } catch (e) { return e.stack.split('\\n')[1]; } })()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "at test.js:3:43");
+}
+
+TEST(EvalScript, ByteCodeOptimizerControlFlow) {
+    // labeled break and continue through finally blocks
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("(function(){ var log=[]; outer: for (var i=0;i<3;i++){ inner: for (var j=0;j<3;j++){ try { if (j==1) continue outer; if (i==2) break outer; log.push(i+''+j); } finally { log.push('f'); } } } return log.join(); })()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "00,f,f,10,f,f,f");
+    s = evalScript(g_context.get(), StringRef::createFromASCII("(function(){ var log=[], n=0; a: while (true) { n++; try { try { if (n < 3) continue a; break a; } finally { log.push('i' + n); } } finally { log.push('o' + n); } } return log.join() + ':' + n; })()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "i1,o1,i2,o2,i3,o3:3");
+    // switch fallthrough into default and the case after it
+    s = evalScript(g_context.get(), StringRef::createFromASCII("(function(){ var r=[]; for (var i=0;i<5;i++){ switch(i){ case 0: r.push('a'); case 1: r.push('b'); break; case 3: r.push('c'); default: r.push('d'); case 4: r.push('e'); } } return r.join(''); })()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "abbdecdee");
+    // variables inside with can resolve to object properties
+    s = evalScript(g_context.get(), StringRef::createFromASCII("(function(){ var o={x:1}, x=10, r=[]; with(o){ for (var k=0;k<3;k++){ x = x + k; r.push(x); } } var y = x; return r.join()+','+o.x+','+y; })()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "1,2,4,4,10");
+}
+
+TEST(EvalScript, ByteCodeOptimizerRegisters) {
+    // registers live across yield
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("(function(){ function* g(a){ var t = a; var u = t; for (var i=0;i<3;i++){ var v = u + i; u = (yield v) || u; } return u; } var it=g(5), r=[]; r.push(it.next().value); r.push(it.next(10).value); r.push(it.next().value); r.push(it.next(1).value); return r.join(); })()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "5,11,12,1");
+    // copies of captured variables and per iteration bindings
+    s = evalScript(g_context.get(), StringRef::createFromASCII("(function(){ var a = 1; var b = a; var f = function(){ return a; }; a = 2; var c = b; b = 3; var fs = []; for (let i = 0; i < 3; i++) { let j = i; fs.push(() => j); } return [a,b,c,f(),fs.map(g => g()).join('')].join(); })()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "2,3,1,2,012");
+    // parameters aliased by mapped arguments
+    s = evalScript(g_context.get(), StringRef::createFromASCII("(function(a,b){ var c = a; arguments[0] = 5; var d = a; b = 7; var e = arguments[1]; a = 9; return [c,d,e,arguments[0],arguments.length].join(); })(1,2)"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "1,5,7,9,2");
+
+    // registers live across await
+    s = evalScript(g_context.get(), StringRef::createFromASCII("var asyncResult; (async function(){ var a = 1, b = a; for (var i=0;i<3;i++){ var c = b; b = c + await i; a = b; } asyncResult = [a,b,c].join(); })(); 0"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "0");
+    s = evalScript(g_context.get(), StringRef::createFromASCII("asyncResult"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "4,4,2");
+}
+
+TEST(EvalScript, StringSearch) {
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var s = 'x'.repeat(300) + 'needle in a long haystack' + 'y'.repeat(300); [s.indexOf('needle in a long haystack'), s.indexOf('needle in a long haystacks'), s.indexOf('x', 299), s.indexOf('xn'), s.includes('yy', 600)].join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "300,-1,299,299,true");
+
+    s = evalScript(g_context.get(), StringRef::createFromASCII("['a\\u0101b\\u0101'.indexOf('\\u0101b'), 'ab'.indexOf('\\u0101'), 'a\\u0101b'.indexOf('b'), 'a,b,,c'.split(',').length, 'a\\r\\nb\\r\\n'.split('\\r\\n').join('|'), 'abcabc'.split('bc', 1).join()].join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "1,-1,2,4,a|b|,a");
+}
+
+TEST(EvalScript, TypedArraySort) {
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var a = new Float64Array(100); for (var i = 0; i < 100; i++) a[i] = (i * 37 % 100) - 50; a[3] = NaN; a[5] = -0; a[7] = 0; a[9] = -Infinity; a.sort(); var z = a.indexOf(0); [a[0], a[1], 1 / a[z], 1 / a[z + 1], a[98], a[99]].join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "-Infinity,-50,-Infinity,Infinity,49,NaN");
+
+    s = evalScript(g_context.get(), StringRef::createFromASCII("var u = new Uint32Array(200); var v = new Int16Array(200); for (var i = 0; i < 200; i++) { u[i] = i * 2654435761; v[i] = i * 40503; } u.sort(); v.sort(); var ok = true; for (var i = 1; i < 200; i++) ok = ok && u[i - 1] <= u[i] && v[i - 1] <= v[i]; [ok, new Int8Array([3, -1, 2]).sort().join(' '), new BigInt64Array([5n, -3n, 0n]).sort().join(' ')].join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "true,-1 2 3,-3 0 5");
+}
+
+TEST(EvalScript, TypedArrayBuiltins) {
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var a = new Float32Array([1, 2.5, NaN, -0, 2.5]); var i = new Int8Array([1, -1, 127, 0]); [a.indexOf(2.5), a.lastIndexOf(2.5), a.indexOf(NaN), a.includes(NaN), a.indexOf(0), i.indexOf(255), i.indexOf(-1), i.includes(127, 3), i.indexOf('1')].join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "1,4,-1,true,3,-1,1,false,-1");
+
+    s = evalScript(g_context.get(), StringRef::createFromASCII("var b = new Uint16Array([1, 2, 3, 4, 5, 6]); b.fill(9, 5); b.reverse(); b.copyWithin(2, 0, 3); b.set(b.subarray(1, 3), 4); var c = new Uint8ClampedArray(3); c.set(new Float64Array([-1, 254.5, 300])); var d = new Int16Array(3); d.set(new Uint32Array([70000, 1, 4294967295])); [b.join(' '), c.join(' '), d.join(' ')].join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "9 5 9 5 5 9,0 254 255,4464 1 -1");
+}
+
+TEST(EvalScript, MegamorphicInlineCache) {
+    // property get sites in run() see 40 structures and use the megamorphic cache. it should observe prototype and property changes
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var base = { p: 'base' }; var mid = Object.create(base); var objs = []; for (var i = 0; i < 40; i++) { var o = Object.create(mid); o['k' + i] = i; objs.push(o); } function get(o) { return o.p; } function getQ(o) { return o.q; } function run(f) { var r; for (var n = 0; n < 5; n++) { for (var i = 0; i < objs.length; i++) { r = f(objs[i]); } } return r; } var r = [run(get), run(getQ)]; base.p = 'changed'; r.push(run(get)); mid.p = 'mid'; r.push(run(get)); delete mid.p; r.push(run(get)); objs[39].p = 'own'; r.push(run(get)); delete objs[39].p; r.push(run(get)); Object.setPrototypeOf(mid, { p: 'proto' }); r.push(run(get)); base.q = 'q'; Object.setPrototypeOf(mid, base); r.push(run(getQ)); var tail = Object.create(null); Object.setPrototypeOf(base, tail); delete base.q; r.push(run(getQ)); Object.setPrototypeOf(tail, { q: 'late' }); r.push(run(getQ)); r.join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "base,,changed,mid,changed,own,changed,proto,q,,late");
+}
+
+TEST(EvalScript, ArraySearchUnboxedElements) {
+    // search values which are not int32 should not match int32 elements
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var a = [1, 2, 0, -1]; [a.indexOf(NaN), a.includes(NaN), a.indexOf(Infinity), a.includes(-Infinity), a.indexOf(4294967297), a.includes(2147483649), a.indexOf(-4294967295), a.indexOf(1.5), a.indexOf(-0), a.includes(-0), a.indexOf(2)].join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "-1,false,-1,false,-1,false,-1,-1,2,true,1");
+
+    s = evalScript(g_context.get(), StringRef::createFromASCII("var d = [1.5, NaN, Infinity, 2]; var h = [1, , 3]; Array.prototype[1] = 2; var r = [d.indexOf(NaN), d.includes(NaN), d.indexOf(Infinity), d.indexOf(2), h.indexOf(2), h.includes(2), h.indexOf(NaN)]; delete Array.prototype[1]; r.join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "-1,true,2,3,1,true,-1");
+}
+
+TEST(EvalScript, RopeStringAppend) {
+    // appending to a flattened rope writes in the spare capacity of its buffer. the previous strings should not change
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var s = ''; var saved = []; for (var i = 0; i < 300; i++) { s += 'item' + i + ';'; if (i % 50 == 0) { s.charCodeAt(0); saved.push(s); } } var t = saved[1] + 'x'; var u = saved[1] + 'y'; [s.length, saved[1].length, saved[1].slice(-8), t.slice(-9), u.slice(-9), (saved[2] + '\\u3042').slice(-3)].join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "2290,347,;item50;,;item50;x,;item50;y,0;\xE3\x81\x82");
+}
+
+TEST(EvalScript, RopeStringAppendAfterRead) {
+    // strings made from a prefix which was read get an exact buffer. appending to one of them again reserves capacity
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var p = 'prefix-' + 'p'.repeat(40); p.charCodeAt(0); var k = []; for (var i = 0; i < 4; i++) { k.push(p + i); k[i].charCodeAt(0); } var g = k[1]; for (var j = 0; j < 5; j++) { g += '<' + j + '>'; g.charCodeAt(0); k.push(g); } var h = k[5] + '!'; [p.length, k[0].slice(-2), k[3].slice(-2), k[4].slice(-4), k[5].slice(-4), k[8].slice(-7), h.slice(-4), g.length].join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "47,p0,p3,1<0>,><1>,><3><4>,<1>!,63");
+}
+
+TEST(EvalScript, StringHashAcrossRepresentations) {
+    // equal strings should hash the same whether they are 8-bit, 16-bit or rope, so computed keys find the property
+    Evaluator::execute(g_context.get(), [](ExecutionStateRef* state) -> ValueRef* {
+        state->context()->globalObject()->set(state, StringRef::createFromASCII("hashKeyAcrossRepresentations0"), ValueRef::create(1));
+        return ValueRef::createUndefined();
+    });
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var o = {}; var m = new Map(); var keys = []; var base = 'hashKeyAcrossRepresentations'; for (var i = 1; i <= base.length; i++) { var k = base.substring(0, i); o[k] = i; m.set(k, i); keys.push(k); } var r = keys.every(function (k, i) { var wide = ('\\u3042' + k).substring(1); var rope = k.substring(0, i >> 1) + k.substring(i >> 1); var parts = k.split(''); var built = ''; for (var j = 0; j < parts.length; j++) { built += parts[j]; } return [wide, rope, built, String.fromCharCode.apply(null, parts.map(function (c) { return c.charCodeAt(0); }))].every(function (v) { return v === k && o[v] === i + 1 && m.get(v) === i + 1 && v in o && o.hasOwnProperty(v); }); }); var wideKey = '\\u3042\\u3044' + base; o[wideKey] = 'wide'; var wideRope = '\\u3042' + ('\\u3044' + base); [r, o[wideRope], o[wideRope.substring(0)], globalThis[base + '' + 0]].join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "true,wide,wide,1");
+
+    Evaluator::execute(g_context.get(), [](ExecutionStateRef* state) -> ValueRef* {
+        const char* ascii = "hashKeyAcrossRepresentations0";
+        size_t length = strlen(ascii);
+        std::u16string wide(ascii, ascii + length);
+        auto global = state->context()->globalObject();
+        EXPECT_TRUE(global->get(state, StringRef::createFromUTF16(wide.data(), length))->equalsTo(state, ValueRef::create(1)));
+        EXPECT_TRUE(global->get(state, StringRef::createFromLatin1(reinterpret_cast<const unsigned char*>(ascii), length))->equalsTo(state, ValueRef::create(1)));
+        return ValueRef::createUndefined();
+    });
+}
+
+TEST(JSON, StringifyFastPathBailout) {
+    // each value is made twice and serialized without and with a replacer. a replacer always takes the spec path
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("function stringifyBothPaths(make, gap) { var a = JSON.stringify(make(), undefined, gap), b = JSON.stringify(make(), function (k, x) { return x; }, gap); return a === b ? a : 'MISMATCH ' + a + ' / ' + b; } 0"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "0");
+
+    // toJSON on a prototype
+    s = evalScript(g_context.get(), StringRef::createFromASCII("(function(){ function P() { this.own = 1; } P.prototype.toJSON = function (k) { return 'P' + k; }; return stringifyBothPaths(function () { return { a: new P(), b: [new P()] }; }); })()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "{\"a\":\"Pa\",\"b\":[\"P0\"]}");
+
+    // toJSON added to Object.prototype
+    s = evalScript(g_context.get(), StringRef::createFromASCII("(function(){ Object.prototype.toJSON = function () { return 'O'; }; try { return stringifyBothPaths(function () { return { a: 1 }; }) + ',' + stringifyBothPaths(function () { return [{}]; }); } finally { delete Object.prototype.toJSON; } })()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "\"O\",\"O\"");
+
+    // enumerable getters. keys are collected before the getter adds a property
+    s = evalScript(g_context.get(), StringRef::createFromASCII("stringifyBothPaths(function () { var o = { x: 1 }; Object.defineProperty(o, 'g', { enumerable: true, get: function () { o.late = 3; return 2; } }); return { o: o, h: { get v() { return [1]; } } }; })"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "{\"o\":{\"x\":1,\"g\":2},\"h\":{\"v\":[1]}}");
+
+    // array holes read through Array.prototype
+    s = evalScript(g_context.get(), StringRef::createFromASCII("(function(){ Array.prototype[1] = 'proto'; try { return stringifyBothPaths(function () { return [0, , 2]; }) + ',' + stringifyBothPaths(function () { return { a: [, 'x'] }; }); } finally { delete Array.prototype[1]; } })()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "[0,\"proto\",2],{\"a\":[null,\"x\"]}");
+
+    // proxies
+    s = evalScript(g_context.get(), StringRef::createFromASCII("stringifyBothPaths(function () { return { p: new Proxy({ a: 1, b: 2 }, { get: function (t, k) { return k === 'a' ? 'trap' : t[k]; } }), q: new Proxy([1, 2], {}) }; })"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "{\"p\":{\"a\":\"trap\",\"b\":2},\"q\":[1,2]}");
+
+    // boxed primitives are converted with their own valueOf and toString
+    s = evalScript(g_context.get(), StringRef::createFromASCII("stringifyBothPaths(function () { var n = new Number(1); n.valueOf = function () { return 42; }; var s = new String('s'); s.toString = function () { return 'str'; }; return [n, s, new Boolean(false), new Number(2), new String('t')]; })"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "[42,\"str\",false,2,\"t\"]");
+
+    // objects with non-default prototypes
+    s = evalScript(g_context.get(), StringRef::createFromASCII("stringifyBothPaths(function () { class C { constructor() { this.own = 1; } get g() { return 2; } } return [Object.create({ inherited: 1 }, { own: { value: 2, enumerable: true } }), new C(), Object.create(null)]; }, 1)"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "[\n {\n  \"own\": 2\n },\n {\n  \"own\": 1\n },\n {}\n]");
+
+    // cycles throw TypeError on both paths
+    s = evalScript(g_context.get(), StringRef::createFromASCII("(function(){ var a = { k: 1 }; a.self = a; var arr = [1]; arr.push([arr]); var r = []; [a, arr, { x: { y: a } }].forEach(function (v) { try { JSON.stringify(v); r.push('none'); } catch (e) { r.push(e instanceof TypeError); } try { JSON.stringify(v, function (k, x) { return x; }); r.push('none'); } catch (e) { r.push(e instanceof TypeError); } }); return r.join(); })()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "true,true,true,true,true,true");
+}
+
+TEST(JSON, ParseGrammar) {
+    // number grammar, escapes, control characters and whitespace rules of https://tc39.es/ecma262/#sec-json.parse
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var inputs = ['01', '1.', '.5', '1e', '1e+', '-', '-01', '+1', '0x10', '1.5e3', '-0', '1E-2', '\"\\\\x\"', '\"\\\\u12\"', '\"\\\\ud800\"', '\"\\\\udc00\\\\ud800\"', '\"\\\\u0041\\\\/\\\\b\"', '\"a' + String.fromCharCode(9) + 'b\"', '\"' + String.fromCharCode(31) + '\"', '\"' + String.fromCharCode(127) + '\"', ' 1 ', '1 2', '[1]x', '\\u00a01', '\\u000b1', '\\r\\n\\t 1', '', 'tru', '[1,]', '{\"a\":1,}', \"{'a':1}\", '\"abc']; inputs.map(function (s) { try { var v = JSON.parse(s); return typeof v === 'string' ? v.split('').map(function (c) { return c.charCodeAt(0); }).join(' ') : 1 / v === -Infinity ? '-0' : String(v); } catch (e) { return e.name; } }).join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "SyntaxError,SyntaxError,SyntaxError,SyntaxError,SyntaxError,SyntaxError,SyntaxError,SyntaxError,SyntaxError,1500,-0,0.01,SyntaxError,SyntaxError,55296,56320 55296,65 47 8,SyntaxError,SyntaxError,127,1,SyntaxError,SyntaxError,SyntaxError,SyntaxError,1,SyntaxError,SyntaxError,SyntaxError,SyntaxError,SyntaxError,SyntaxError");
+}
+
+TEST(JSON, ParseDuplicateAndProtoKeys) {
+    // later duplicate key wins and keeps first position. __proto__ is defined as own property
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var d = JSON.parse('{\"a\":1,\"b\":2,\"a\":3}'); var p = JSON.parse('{\"__proto__\":{\"x\":1},\"y\":2}'); var r = JSON.parse('[{\"a\":1,\"b\":2},{\"a\":1,\"a\":2,\"b\":3},{\"b\":4,\"a\":5,\"b\":6}]'); [Object.keys(d), d.a, Object.keys(p), Object.getPrototypeOf(p) === Object.prototype, p.x, p.__proto__.x, r.map(function (o) { return Object.keys(o) + ':' + o.a + ':' + o.b; }).join(' ')].join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "a,b,3,__proto__,y,true,,1,a,b:1:2 a,b:2:3 b,a:5:6");
+}
+
+TEST(JSON, ParseIndexKeyOrder) {
+    // integer index keys come first in ascending order, also for records reusing cached structure
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var o = JSON.parse('{\"b\":1,\"2\":2,\"a\":3,\"1\":4,\"01\":5,\"4294967295\":6,\"4294967294\":7,\"-1\":8}'); var rows = JSON.parse('[{\"1\":1,\"a\":2,\"0\":3},{\"1\":4,\"a\":5,\"0\":6}]'); [Object.keys(o).join(' '), rows.map(function (r) { return Object.keys(r).join(' ') + '=' + r[0] + r[1] + r.a; }).join(' ')].join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "1 2 4294967294 b a 01 4294967295 -1,0 1 a=312 0 1 a=645");
+}
+
+TEST(JSON, ParseReviver) {
+    // reviver walks depth first and sees changes made to holder while walking
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var log = []; var v = JSON.parse('{\"a\":[1,{\"b\":2}],\"c\":3}', function (k, v) { log.push(k === '' ? '(root)' : k); return v; }); var log2 = []; var w = JSON.parse('{\"a\":1,\"b\":2,\"c\":3}', function (k, v) { log2.push(k + '=' + v); if (k === 'a') { delete this.b; this.d = 4; this.c = 30; } return k === 'c' ? undefined : v; }); var u = JSON.parse('[1,2,3]', function (k, v) { return k === '1' ? undefined : v; }); [log.join(' '), log2.join(' '), Object.keys(w).join(' '), w.d, u.length, 1 in u].join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "0 b 1 a c (root),a=1 b=undefined c=30 =[object Object],a d,4,3,false");
+}
+
+TEST(JSON, ParseDeepNesting) {
+    // deep nesting throws RangeError instead of overflowing native stack
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("function depthError(s) { try { JSON.parse(s); return 'parsed'; } catch (e) { return e.name; } } [depthError('['.repeat(1000000)), depthError('{\"a\":'.repeat(1000000)), depthError('['.repeat(1000) + ']'.repeat(1000))].join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "RangeError,RangeError,parsed");
+}
+
+TEST(JSON, ParseStructureCache) {
+    // records sharing a cached structure should stay independent. also covers key order variance, superset and subset records
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("function shape(rows) { return rows.map(function (o) { return Object.keys(o).map(function (k) { return k + o[k]; }).join(''); }).join(' '); } var text = '[{\"x\":1,\"y\":2},{\"x\":3,\"y\":4},{\"x\":5,\"y\":6},{\"x\":7,\"y\":8}]'; var rows = JSON.parse(text); rows[0].z = 9; delete rows[1].x; rows[2].y = 0; Object.defineProperty(rows[3], 'x', { value: 'c', enumerable: false }); var again = JSON.parse(text); again[0].w = 1; [shape(rows), rows[3].x, shape(again), shape(JSON.parse('[{\"x\":1,\"y\":2},{\"y\":3,\"x\":4},{\"x\":5,\"y\":6}]')), shape(JSON.parse('[{\"x\":1,\"y\":2},{\"x\":3,\"y\":4,\"z\":5},{\"x\":6,\"y\":7},{\"x\":8},{}]')), shape(JSON.parse('[{\"a\":{\"x\":1}},{\"a\":{\"x\":2,\"y\":3}},{\"a\":{\"x\":4}}]').map(function (o) { return o.a; }))].join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "x1y2z9 y4 x5y0 y8,c,x1y2w1 x3y4 x5y6 x7y8,x1y2 y3x4 x5y6,x1y2 x3y4z5 x6y7 x8 ,x1 x2y3 x4");
+}
+
+TEST(EvalScript, CodeCacheBackgroundWrite) {
+    // source should be longer than CODE_CACHE_MIN_SOURCE_LENGTH to be cached
+    std::string src = "var total = 0;";
+    for (int i = 0; i < 200; i++) {
+        src += "function cached" + std::to_string(i) + "(a) { return a + " + std::to_string(i) + "; }";
+    }
+    src += "total = cached10(1) + cached199(1); total";
+
+    // second evaluation may find the cache entry which is still being written in background
+    auto s = evalScript(g_context.get(), StringRef::createFromUTF8(src.data(), src.length()), StringRef::createFromASCII("codecache.js"), false);
+    EXPECT_EQ(s, "211");
+    s = evalScript(g_context.get(), StringRef::createFromUTF8(src.data(), src.length()), StringRef::createFromASCII("codecache.js"), false);
+    EXPECT_EQ(s, "211");
+
+    g_context->vmInstance()->flushCodeCache();
+}
+
+TEST(EvalScript, CodeCacheNestedArrowFunctions) {
+    // nested arrow functions end at the same source position
+    std::string src = "var add3 = a => b => c => a * 100 + b * 10 + c; var pair = x => y => [x, y].join(':');";
+    for (int i = 0; i < 200; i++) {
+        src += "function padding" + std::to_string(i) + "(a) { return a + " + std::to_string(i) + "; }";
+    }
+    src += "[add3(1)(2)(3), add3(4)(5)(6), pair('p')('q'), padding7(1)].join()";
+
+    auto s = evalScript(g_context.get(), StringRef::createFromUTF8(src.data(), src.length()), StringRef::createFromASCII("codecache-arrow.js"), false);
+    EXPECT_EQ(s, "123,456,p:q,8");
+    g_context->vmInstance()->flushCodeCache();
+
+    // following evaluations load every CodeBlock and function ByteCode from the cache
+    for (int i = 0; i < 2; i++) {
+        s = evalScript(g_context.get(), StringRef::createFromUTF8(src.data(), src.length()), StringRef::createFromASCII("codecache-arrow.js"), false);
+        EXPECT_EQ(s, "123,456,p:q,8");
+    }
+}
+
+#include <algorithm>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// temporary directory for code cache tests
+// each evaluation runs on a new VMInstance whose HOME is a new directory holding a copy of the cache files of the previous run,
+// so that every run after the first one loads the cache files from disk like another process does
+class CodeCacheTestHome {
+public:
+    CodeCacheTestHome()
+        : m_runCount(0)
+    {
+        char path[] = "/tmp/escargot-cctest-XXXXXX";
+        m_path = mkdtemp(path) ? path : "";
+    }
+
+    ~CodeCacheTestHome()
+    {
+        for (size_t i = 1; i <= m_runCount; i++) {
+            std::string home = homeOf(i);
+            removeFilesIn(home + "/Escargot-cache");
+            rmdir((home + "/Escargot-cache").data());
+            rmdir(home.data());
+        }
+        // files written by tests
+        removeFilesIn(m_path);
+        rmdir(m_path.data());
+    }
+
+    const std::string& path() const { return m_path; }
+
+    // resultSource is evaluated as a script after source, and its result is returned instead (e.g. to read what a module did)
+    std::string eval(const std::string& source, const std::string& fileName, bool isModule = false, const char* resultSource = nullptr)
+    {
+        m_runCount++;
+        std::string home = homeOf(m_runCount);
+        mkdir(home.data(), 0755);
+        if (m_runCount > 1) {
+            std::string cacheDir = home + "/Escargot-cache";
+            mkdir(cacheDir.data(), 0755);
+            std::string prevCacheDir = homeOf(m_runCount - 1) + "/Escargot-cache";
+            for (const auto& file : filesIn(prevCacheDir)) {
+                writeFile(cacheDir + "/" + file, readFile(prevCacheDir + "/" + file));
+            }
+        }
+
+        std::string oldHome = getenv("HOME") ? getenv("HOME") : "";
+        setenv("HOME", home.data(), 1);
+        PersistentRefHolder<VMInstanceRef> instance = VMInstanceRef::create(new ShellPlatform());
+        setenv("HOME", oldHome.data(), 1);
+        instance->setOnVMInstanceDelete([](VMInstanceRef* instance) {
+            delete instance->platform();
+        });
+
+        std::string result;
+        {
+            PersistentRefHolder<ContextRef> context = ContextRef::create(instance.get());
+            result = evalScript(context.get(), StringRef::createFromUTF8(source.data(), source.length()), StringRef::createFromUTF8(fileName.data(), fileName.length()), isModule);
+            if (resultSource) {
+                result = evalScript(context.get(), StringRef::createFromUTF8(resultSource, strlen(resultSource)), StringRef::createFromASCII("result.js"), false);
+            }
+        }
+        instance->flushCodeCache();
+        return result;
+    }
+
+    // paths of cache data files written by the last run in the order of their names
+    std::vector<std::string> cacheDataFiles()
+    {
+        std::vector<std::string> result;
+        std::string dir = homeOf(m_runCount) + "/Escargot-cache";
+        for (const auto& file : filesIn(dir)) {
+            if (file != "cache_list") {
+                result.push_back(dir + "/" + file);
+            }
+        }
+        return result;
+    }
+
+    static std::vector<char> readFile(const std::string& path)
+    {
+        std::vector<char> data;
+        if (FILE* file = fopen(path.data(), "rb")) {
+            char buffer[4096];
+            size_t n;
+            while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+                data.insert(data.end(), buffer, buffer + n);
+            }
+            fclose(file);
+        }
+        return data;
+    }
+
+    static void writeFile(const std::string& path, const std::vector<char>& data)
+    {
+        if (FILE* file = fopen(path.data(), "wb")) {
+            fwrite(data.data(), 1, data.size(), file);
+            fclose(file);
+        }
+    }
+
+private:
+    std::string m_path;
+    size_t m_runCount;
+
+    std::string homeOf(size_t run) const
+    {
+        return m_path + "/run" + std::to_string(run);
+    }
+
+    static std::vector<std::string> filesIn(const std::string& dir)
+    {
+        std::vector<std::string> result;
+        if (DIR* d = opendir(dir.data())) {
+            while (struct dirent* entry = readdir(d)) {
+                std::string name = entry->d_name;
+                if (name != "." && name != "..") {
+                    result.push_back(name);
+                }
+            }
+            closedir(d);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    static void removeFilesIn(const std::string& dir)
+    {
+        for (const auto& file : filesIn(dir)) {
+            unlink((dir + "/" + file).data());
+        }
+    }
+};
+
+static std::string codeCacheTestSource(const char* result, const char* prefix = "var add = a => b => a + b;")
+{
+    // source should be longer than CODE_CACHE_MIN_SOURCE_LENGTH to be cached
+    std::string src = prefix;
+    for (int i = 0; i < 200; i++) {
+        src += "function padding" + std::to_string(i) + "(a) { return a + " + std::to_string(i) + "; }";
+    }
+    return src + result;
+}
+
+TEST(EvalScript, CodeCacheStaleSource) {
+    if (!g_context->vmInstance()->flushCodeCache()) {
+        GTEST_SKIP() << "code cache is not enabled";
+    }
+
+    CodeCacheTestHome home;
+    ASSERT_FALSE(home.path().empty());
+    std::string srcA = codeCacheTestSource("[add(1)(2), padding3(1)].join()");
+    std::string srcB = codeCacheTestSource("[add('x')('y'), padding5(1), 'b'].join()");
+
+    EXPECT_EQ(home.eval(srcA, "a.js"), "3,4");
+    std::vector<std::string> files = home.cacheDataFiles();
+    ASSERT_EQ(files.size(), 1u);
+    std::string nameA = files[0].substr(files[0].rfind('/'));
+    EXPECT_EQ(home.eval(srcB, "b.js"), "xy,6,b");
+    files = home.cacheDataFiles();
+    ASSERT_EQ(files.size(), 2u);
+    std::string fileA = files[0].substr(files[0].rfind('/')) == nameA ? files[0] : files[1];
+    std::string fileB = files[0] == fileA ? files[1] : files[0];
+
+    // cache data file of B now holds the data generated from A
+    CodeCacheTestHome::writeFile(fileB, CodeCacheTestHome::readFile(fileA));
+    EXPECT_EQ(home.eval(srcB, "b.js"), "xy,6,b");
+    EXPECT_EQ(home.eval(srcB, "b.js"), "xy,6,b");
+}
+
+TEST(EvalScript, CodeCacheCorruptedData) {
+    if (!g_context->vmInstance()->flushCodeCache()) {
+        GTEST_SKIP() << "code cache is not enabled";
+    }
+
+    CodeCacheTestHome home;
+    ASSERT_FALSE(home.path().empty());
+    std::string src = codeCacheTestSource("[add(1)(2), padding3(1)].join()");
+
+    EXPECT_EQ(home.eval(src, "a.js"), "3,4");
+    std::vector<std::string> files = home.cacheDataFiles();
+    ASSERT_EQ(files.size(), 1u);
+    std::vector<char> data = CodeCacheTestHome::readFile(files[0]);
+    ASSERT_GT(data.size(), 264u);
+
+    // overwrite some bytes of the payload while the header is kept
+    std::vector<char> corrupted = data;
+    memset(corrupted.data() + 200, 0xff, 64);
+    CodeCacheTestHome::writeFile(files[0], corrupted);
+    EXPECT_EQ(home.eval(src, "a.js"), "3,4");
+
+    // cache is written again after the failed loading
+    EXPECT_EQ(home.eval(src, "a.js"), "3,4");
+    files = home.cacheDataFiles();
+    ASSERT_EQ(files.size(), 1u);
+
+    std::vector<char> truncated(data.begin(), data.begin() + data.size() / 2);
+    CodeCacheTestHome::writeFile(files[0], truncated);
+    EXPECT_EQ(home.eval(src, "a.js"), "3,4");
+    EXPECT_EQ(home.eval(src, "a.js"), "3,4");
+}
+
+TEST(EvalScript, CodeCacheModule) {
+    if (!g_context->vmInstance()->flushCodeCache()) {
+        GTEST_SKIP() << "code cache is not enabled";
+    }
+
+    CodeCacheTestHome home;
+    ASSERT_FALSE(home.path().empty());
+    auto writeModule = [&home](const char* name, const char* source) {
+        std::string src = codeCacheTestSource(source, "");
+        CodeCacheTestHome::writeFile(home.path() + "/" + name, std::vector<char>(src.begin(), src.end()));
+    };
+    writeModule("lib.mjs", "export var x = 1; export function f() { return 'f'; } var y = 2; export { y as renamed }; export default class D { v() { return 'd'; } }");
+    writeModule("re.mjs", "export { x as reX, renamed } from './lib.mjs'; export * from './other.mjs';");
+    writeModule("other.mjs", "export const other = 'o'; export default 'not re-exported';");
+    std::string main = codeCacheTestSource("globalThis.moduleResult = [x, f(), r, new D().v(), ns.reX, ns.renamed, ns.other, Object.keys(ns).join('|'), ns.default, padding1(1)].join();",
+                                           "import D, { x, f, renamed as r } from './lib.mjs'; import * as ns from './re.mjs';");
+    // module loader of ShellPlatform resolves the path of the main module too
+    CodeCacheTestHome::writeFile(home.path() + "/main.mjs", std::vector<char>(main.begin(), main.end()));
+
+    // every module is cached by the first run and loaded from the cache by the following runs
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(home.eval(main, home.path() + "/main.mjs", true, "moduleResult"), "1,f,2,d,1,2,o,other|reX|renamed,,2");
+    }
+    EXPECT_EQ(home.cacheDataFiles().size(), 4u);
+
+    // the same source is cached separately as a script and as a module
+    std::string both = codeCacheTestSource("globalThis.kind = [typeof this, (function () { return this === undefined; })()].join();", "");
+    std::string bothPath = home.path() + "/both.js";
+    CodeCacheTestHome::writeFile(bothPath, std::vector<char>(both.begin(), both.end()));
+    for (int i = 0; i < 2; i++) {
+        EXPECT_EQ(home.eval(both, bothPath, false, "kind"), "object,false");
+        EXPECT_EQ(home.eval(both, bothPath, true, "kind"), "undefined,true");
+    }
+    EXPECT_EQ(home.cacheDataFiles().size(), 6u);
+}
+
+TEST(Context, LazyBuiltins) {
+    auto context = ContextRef::create(g_context->vmInstance());
+    auto s = evalScript(context.get(), StringRef::createFromASCII("var d = Object.getOwnPropertyDescriptor(this, 'Map'); Reflect = 1; delete this.WeakSet; Object.defineProperty(this, 'JSON', { enumerable: true }); [d.value === Map, d.writable, d.enumerable, d.configurable, Reflect, typeof WeakSet, typeof JSON.parse, Object.keys(this).join(), /a/.constructor === RegExp, Uint8Array.__proto__ === Int8Array.__proto__].join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "true,true,false,true,1,undefined,function,JSON,d,true,true");
+
+    // installing every builtin ahead should not change the global object
+    auto lazyContext = ContextRef::create(g_context->vmInstance());
+    auto warmContext = ContextRef::create(g_context->vmInstance());
+    warmContext->installLazyBuiltins();
+    StringRef* src = StringRef::createFromASCII("Object.getOwnPropertyNames(this).map(function (n) { var d = Object.getOwnPropertyDescriptor(this, n); return n + (d.writable ? 'w' : '') + (d.enumerable ? 'e' : '') + (d.configurable ? 'c' : ''); }, this).join()");
+    EXPECT_EQ(evalScript(lazyContext.get(), src, StringRef::createFromASCII("test.js"), false), evalScript(warmContext.get(), src, StringRef::createFromASCII("test.js"), false));
+}
+
+TEST(MapSet, MutationDuringIteration) {
+    // entries deleted and added again during forEach are visited at their new position
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("(function(){ var m = new Map([[1,'a'],[2,'b'],[3,'c']]), r=[], once = true; m.forEach(function(v,k){ r.push(k + v); if (once) { once = false; m.delete(1); m.set(1, 'z'); m.delete(2); } }); return r.join() + ':' + Array.from(m.keys()).join(); })()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "1a,3c,1z:3,1");
+    s = evalScript(g_context.get(), StringRef::createFromASCII("(function(){ var s = new Set([1,2,3]), r=[]; s.forEach(function(v){ r.push(v); if (v === 2) { s.delete(1); s.add(1); s.add(4); } }); return r.join(); })()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "1,2,3,1,4");
+    // live iterator sees entries added after it was created
+    s = evalScript(g_context.get(), StringRef::createFromASCII("(function(){ var m = new Map([['a',1],['b',2]]), it = m.entries(), r=[]; r.push(it.next().value.join('=')); m.delete('b'); m.set('c', 3); m.set('b', 4); for (var e of it) r.push(e.join('=')); return r.join(); })()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "a=1,c=3,b=4");
+    s = evalScript(g_context.get(), StringRef::createFromASCII("(function(){ var s = new Set(['a','b','c']), it = s.values(), r=[]; r.push(it.next().value); s.delete('a'); s.delete('b'); r.push(it.next().value); r.push(String(it.next().done)); s.add('d'); r.push(String(it.next().done)); return r.join(); })()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "a,c,true,true");
+}
+
+TEST(MapSet, IteratorAfterClearAndRehash) {
+    // iterator opened before clear continues with entries added after clear
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("(function(){ var m = new Map([[1,1],[2,2],[3,3]]), it = m.keys(), r=[]; r.push(it.next().value); m.clear(); m.set(9, 9); var n = it.next(); r.push(n.value, n.done); r.push(it.next().done); return r.join(); })()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "1,9,false,true");
+    // finished iterator stays finished
+    s = evalScript(g_context.get(), StringRef::createFromASCII("(function(){ var s = new Set([1,2,3]), it = s.values(); it.next(); s.clear(); var d = it.next().done; s.add(5); return [d, it.next().done, s.size].join(); })()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "true,true,1");
+    // iterator crosses rehash after mass deletion
+    s = evalScript(g_context.get(), StringRef::createFromASCII("(function(){ var m = new Map(); for (var i = 0; i < 1000; i++) m.set(i, i); var it = m.keys(), r = []; r.push(it.next().value); for (var i = 0; i < 995; i++) m.delete(i); for (var i = 0; i < 300; i++) m.set('k' + i, i); var count = 0, first, last; for (var k of it) { if (count === 0) first = k; last = k; count++; } return [r[0], first, last, count, m.size].join(); })()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "0,995,k299,305,305");
+    s = evalScript(g_context.get(), StringRef::createFromASCII("(function(){ var s = new Set(), r=[]; for (var i = 0; i < 64; i++) s.add(i); var it = s.values(); for (var i = 0; i < 60; i++) s.delete(i); s.add('x'); for (var v of it) r.push(v); return r.join(); })()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "60,61,62,63,x");
+}
+
+TEST(MapSet, KeyNormalization) {
+    // -0 is stored as +0, every NaN is the same key and BigInts are compared by value
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("(function(){ var m = new Map(); m.set(-0, 'zero'); m.set(NaN, 'nan'); m.set(0/0, 'nan2'); m.set(1n, 'big'); m.set(2n ** 70n, 'huge'); var k = Array.from(m.keys()); return [Object.is(k[0], 0), m.get(0), m.get(-0), m.get(NaN), m.size, m.get(1n), m.has(1), m.get(2n ** 70n), m.has(BigInt(1)), m.get(BigInt('1180591620717411303424'))].join(); })()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "true,zero,zero,nan2,4,big,false,huge,true,huge");
+    s = evalScript(g_context.get(), StringRef::createFromASCII("(function(){ var s = new Set([-0, 0, NaN, NaN, 1n, 1n, BigInt(1), 1]); var v = Array.from(s); return [s.size, Object.is(v[0], 0), s.has(-0), s.has(NaN), s.has(1n), s.has(1)].join(); })()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "4,true,true,true,true,true");
+}
+
+static size_t g_reclaimCountForWeakMapTest;
+
+TEST(WeakMap, DropCollectedEntries) {
+    size_t droppedBefore = g_context->vmInstance()->droppedWeakEntryCount();
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var weakMapForGC = new WeakMap(); var weakSetForGC = new WeakSet(); var keptKeys = []; (function () { for (var i = 0; i < 1000; i++) { var k = {}; weakMapForGC.set(k, i); weakSetForGC.add({}); if (i % 100 == 0) keptKeys.push(k); } })(); keptKeys.length"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "10");
+
+    g_reclaimCountForWeakMapTest = 0;
+    Memory::setGCEventListener([]() {
+        g_reclaimCountForWeakMapTest++;
+    });
+    for (int i = 0; i < 3; i++) {
+        Memory::gc();
+    }
+    Memory::setGCEventListener(nullptr);
+
+    s = evalScript(g_context.get(), StringRef::createFromASCII("keptKeys.every(function (k) { return weakMapForGC.get(k) % 100 === 0 && !weakSetForGC.has(k); })"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "true");
+
+    if (!g_reclaimCountForWeakMapTest) {
+        GTEST_SKIP() << "gc did not reclaim any memory";
+    }
+    // conservative GC may keep a few keys alive through stale stack slots
+    EXPECT_GE(g_context->vmInstance()->droppedWeakEntryCount() - droppedBefore, 1500u);
+}
@@ -26,6 +26,7 @@
 #pragma once
 
 #include "YarrPattern.h"
+#include "YarrJIT.h"
 
 namespace WTF {
 class BumpPointerAllocator;
@@ -384,6 +385,9 @@ public:
 
     void clear()
     {
+#if defined(ENABLE_JIT)
+        m_jitCode.clear();
+#endif
         deleteAllValues(m_allParenthesesInfo);
         deleteAllValues(m_userCharacterClasses);
         m_body.reset();
@@ -404,6 +408,11 @@ public:
     CharacterClass* newlineCharacterClass;
     CharacterClass* wordcharCharacterClass;
 
+#if defined(ENABLE_JIT)
+    // native code of the pattern. it is compiled on first match
+    YarrCodeBlock m_jitCode;
+#endif
+
 private:
     Vector<std::unique_ptr<ByteDisjunction>> m_allParenthesesInfo;
     Vector<std::unique_ptr<CharacterClass>> m_userCharacterClasses;
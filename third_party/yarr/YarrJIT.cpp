@@ -0,0 +1,936 @@
+/*
+ * Copyright (C) 2021-present Samsung Electronics Co., Ltd
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "WTFBridge.h"
+#include "YarrJIT.h"
+
+#if defined(ENABLE_JIT)
+
+#include "YarrPattern.h"
+#include "jit/X86_64Assembler.h"
+#include "jit/JITCode.h"
+
+#include <map>
+
+namespace JSC {
+namespace Yarr {
+
+using Escargot::X86_64Assembler;
+
+// The generated code is called as
+//   unsigned code(const CharType* input, unsigned start, unsigned length, unsigned* output)
+// and keeps its state in these registers. Backtracking information of terms
+// is stored in fixed slots of the stack frame, so no construct which needs
+// an unbounded amount of backtracking state is compiled.
+static const X86_64Assembler::Register inputRegister = X86_64Assembler::RDI;
+static const X86_64Assembler::Register indexRegister = X86_64Assembler::RSI;
+static const X86_64Assembler::Register lengthRegister = X86_64Assembler::RDX;
+static const X86_64Assembler::Register outputRegister = X86_64Assembler::RCX;
+static const X86_64Assembler::Register matchStartRegister = X86_64Assembler::R8;
+static const X86_64Assembler::Register characterRegister = X86_64Assembler::RAX;
+static const X86_64Assembler::Register temp1Register = X86_64Assembler::R9;
+static const X86_64Assembler::Register temp2Register = X86_64Assembler::R10;
+// used by character class tests only
+static const X86_64Assembler::Register classRegister = X86_64Assembler::R11;
+
+static const unsigned maximumFrameSlots = 2048;
+// characters above 0xff of a class are tested by a compare for each match or range
+static const unsigned maximumWideClassEntries = 64;
+// quantities larger than this can never be reached since strings are shorter
+static const unsigned maximumBoundedQuantity = 0x7fffffff;
+static const size_t characterTableSize = 256;
+
+static bool characterClassContains(CharacterClass* characterClass, UChar32 ch)
+{
+    if (characterClass->m_anyCharacter) {
+        return true;
+    }
+
+    const Vector<UChar32>& matches = isASCII(ch) ? characterClass->m_matches : characterClass->m_matchesUnicode;
+    const Vector<CharacterRange>& ranges = isASCII(ch) ? characterClass->m_ranges : characterClass->m_rangesUnicode;
+    for (unsigned i = 0; i < matches.size(); ++i) {
+        if (matches[i] == ch) {
+            return true;
+        }
+    }
+    for (unsigned i = 0; i < ranges.size(); ++i) {
+        if (ranges[i].begin <= ch && ch <= ranges[i].end) {
+            return true;
+        }
+    }
+    return false;
+}
+
+class YarrGenerator {
+public:
+    YarrGenerator(YarrPattern& pattern, YarrCharSize charSize)
+        : m_pattern(pattern)
+        , m_charSize(charSize)
+        , m_frameSlots(0)
+        , m_newlineCharacterClass(newlineCreate())
+        , m_wordCharacterClass(wordcharCreate())
+    {
+    }
+
+    // returns false when the pattern has constructs which are not supported
+    bool generate();
+
+    const X86_64Assembler& assembler() const
+    {
+        return m_assembler;
+    }
+
+private:
+    typedef std::vector<size_t> JumpList;
+
+    struct TermState {
+        explicit TermState(PatternTerm* term)
+            : m_term(term)
+            , m_frameSlot(0)
+            , m_forwardEnd(0)
+            , m_bodyEntry(0)
+        {
+        }
+
+        PatternTerm* m_term;
+        unsigned m_frameSlot;
+        // where matching continues after the term
+        size_t m_forwardEnd;
+        // jumps from the term which should backtrack into the previous terms
+        JumpList m_failures;
+        // parentheses only: where backtracking into each alternative starts
+        std::vector<size_t> m_alternativeBacktracks;
+        // non-greedy parentheses only: where matching of the body starts after skipping it failed
+        size_t m_bodyEntry;
+    };
+    typedef std::vector<TermState> SequenceState;
+
+    size_t label() const
+    {
+        return m_assembler.size();
+    }
+
+    void linkJumps(JumpList& jumps, size_t target)
+    {
+        for (size_t jump : jumps) {
+            m_assembler.link(jump, target);
+        }
+        jumps.clear();
+    }
+
+    void linkJumps(JumpList& jumps)
+    {
+        linkJumps(jumps, label());
+    }
+
+    unsigned allocateFrameSlots(unsigned count)
+    {
+        unsigned slot = m_frameSlots;
+        m_frameSlots += count;
+        return slot;
+    }
+
+    static int32_t frameOffset(unsigned slot)
+    {
+        return (int32_t)(slot * sizeof(uintptr_t));
+    }
+
+    bool isSupported(CharacterClass* characterClass);
+    bool isSupported(PatternDisjunction* disjunction);
+
+    size_t characterTable(CharacterClass* characterClass, bool invert);
+
+    void loadCharacter(X86_64Assembler::Register index, int32_t offset);
+    void generateCharacterClassTest(CharacterClass* characterClass, bool invert, JumpList& mismatch);
+    void generateCharacterTest(PatternTerm& term, JumpList& mismatch);
+
+    void generateBodyAlternative(PatternAlternative* alternative, JumpList& matched, JumpList& failed);
+    void generateFirstCharacterScan(PatternAlternative* alternative, JumpList& notMatched);
+    void generateSequence(PatternAlternative* alternative, SequenceState& state);
+    size_t generateSequenceBacktrack(SequenceState& state, JumpList& exhausted);
+
+    void generateTerm(TermState& state);
+    void generateTermBacktrack(TermState& state, JumpList& exhausted);
+
+    void generateAssertionBOL(TermState& state);
+    void generateAssertionEOL(TermState& state);
+    void generateAssertionWordBoundary(TermState& state);
+    void generateCharacterTerm(TermState& state);
+    void generateCharacterTermBacktrack(TermState& state, JumpList& exhausted);
+    void generateParenthesesOnce(TermState& state);
+    void generateParenthesesOnceBacktrack(TermState& state, JumpList& exhausted);
+    void generateParenthesesTerminal(TermState& state);
+    void generateParentheticalAssertion(TermState& state);
+
+    void clearCapture(unsigned subpatternId);
+
+    YarrPattern& m_pattern;
+    YarrCharSize m_charSize;
+    X86_64Assembler m_assembler;
+    unsigned m_frameSlots;
+    std::unique_ptr<CharacterClass> m_newlineCharacterClass;
+    std::unique_ptr<CharacterClass> m_wordCharacterClass;
+
+    // 256 entry tables of character classes which are placed after the code
+    std::vector<std::vector<uint8_t>> m_characterTables;
+    std::map<std::pair<CharacterClass*, bool>, size_t> m_characterTableIndex;
+    // (end of lea instruction, table index)
+    std::vector<std::pair<size_t, size_t>> m_characterTableReferences;
+};
+
+bool YarrGenerator::isSupported(CharacterClass* characterClass)
+{
+    unsigned wideEntries = 0;
+    for (UChar32 ch : characterClass->m_matchesUnicode) {
+        wideEntries += ch > 0xff;
+    }
+    for (const CharacterRange& range : characterClass->m_rangesUnicode) {
+        wideEntries += range.end > 0xff;
+    }
+    return wideEntries <= maximumWideClassEntries;
+}
+
+bool YarrGenerator::isSupported(PatternDisjunction* disjunction)
+{
+    for (auto& alternative : disjunction->m_alternatives) {
+        for (PatternTerm& term : alternative->m_terms) {
+            switch (term.type) {
+            case PatternTerm::TypeAssertionBOL:
+            case PatternTerm::TypeAssertionEOL:
+            case PatternTerm::TypeAssertionWordBoundary:
+            case PatternTerm::TypeForwardReference:
+                break;
+            case PatternTerm::TypePatternCharacter:
+                // case folding of non-ASCII characters is left to the interpreter
+                if (m_pattern.ignoreCase() && !isASCII(term.patternCharacter)) {
+                    return false;
+                }
+                break;
+            case PatternTerm::TypeCharacterClass:
+                if (!isSupported(term.characterClass)) {
+                    return false;
+                }
+                break;
+            case PatternTerm::TypeParenthesesSubpattern:
+                if (!(term.quantityMaxCount == 1 && !term.parentheses.isCopy) && !term.parentheses.isTerminal) {
+                    return false;
+                }
+                if (!isSupported(term.parentheses.disjunction)) {
+                    return false;
+                }
+                break;
+            case PatternTerm::TypeParentheticalAssertion:
+                if (term.quantityType != QuantifierFixedCount || term.quantityMaxCount != 1) {
+                    return false;
+                }
+                if (!isSupported(term.parentheses.disjunction)) {
+                    return false;
+                }
+                break;
+            case PatternTerm::TypeBackReference:
+            case PatternTerm::TypeDotStarEnclosure:
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+size_t YarrGenerator::characterTable(CharacterClass* characterClass, bool invert)
+{
+    auto key = std::make_pair(characterClass, invert);
+    auto iter = m_characterTableIndex.find(key);
+    if (iter != m_characterTableIndex.end()) {
+        return iter->second;
+    }
+
+    std::vector<uint8_t> table(characterTableSize);
+    for (size_t ch = 0; ch < characterTableSize; ch++) {
+        table[ch] = characterClassContains(characterClass, ch) != invert;
+    }
+
+    size_t index = m_characterTables.size();
+    m_characterTables.push_back(std::move(table));
+    m_characterTableIndex.insert(std::make_pair(key, index));
+    return index;
+}
+
+void YarrGenerator::loadCharacter(X86_64Assembler::Register index, int32_t offset)
+{
+    if (m_charSize == Char8) {
+        m_assembler.load8(characterRegister, inputRegister, index, offset);
+    } else {
+        m_assembler.load16(characterRegister, inputRegister, index, offset * (int32_t)sizeof(UChar));
+    }
+}
+
+void YarrGenerator::generateCharacterClassTest(CharacterClass* characterClass, bool invert, JumpList& mismatch)
+{
+    if (characterClass->m_anyCharacter) {
+        if (invert) {
+            mismatch.push_back(m_assembler.jump());
+        }
+        return;
+    }
+
+    size_t wideCharacter = 0;
+    if (m_charSize == Char16) {
+        m_assembler.arithmeticImmediate32(X86_64Assembler::Cmp, characterRegister, 0xff);
+        wideCharacter = m_assembler.jump(X86_64Assembler::Above);
+    }
+
+    m_characterTableReferences.push_back(std::make_pair(m_assembler.loadEffectiveAddressRelative(classRegister), characterTable(characterClass, invert)));
+    m_assembler.compareByteImmediate(classRegister, characterRegister, 0);
+    mismatch.push_back(m_assembler.jump(X86_64Assembler::Equal));
+
+    if (m_charSize == Char16) {
+        JumpList done;
+        done.push_back(m_assembler.jump());
+        m_assembler.link(wideCharacter);
+
+        JumpList inClass;
+        for (UChar32 ch : characterClass->m_matchesUnicode) {
+            if (ch > 0xff) {
+                m_assembler.arithmeticImmediate32(X86_64Assembler::Cmp, characterRegister, ch);
+                inClass.push_back(m_assembler.jump(X86_64Assembler::Equal));
+            }
+        }
+        for (const CharacterRange& range : characterClass->m_rangesUnicode) {
+            if (range.end > 0xff) {
+                UChar32 begin = std::max(range.begin, (UChar32)0x100);
+                m_assembler.move32(classRegister, characterRegister);
+                m_assembler.arithmeticImmediate32(X86_64Assembler::Sub, classRegister, begin);
+                m_assembler.arithmeticImmediate32(X86_64Assembler::Cmp, classRegister, range.end - begin);
+                inClass.push_back(m_assembler.jump(X86_64Assembler::BelowOrEqual));
+            }
+        }
+
+        if (invert) {
+            done.push_back(m_assembler.jump());
+            linkJumps(inClass);
+            mismatch.push_back(m_assembler.jump());
+        } else {
+            mismatch.push_back(m_assembler.jump());
+            linkJumps(inClass);
+        }
+        linkJumps(done);
+    }
+}
+
+void YarrGenerator::generateCharacterTest(PatternTerm& term, JumpList& mismatch)
+{
+    if (term.type == PatternTerm::TypeCharacterClass) {
+        generateCharacterClassTest(term.characterClass, term.invert(), mismatch);
+        return;
+    }
+
+    ASSERT(term.type == PatternTerm::TypePatternCharacter);
+    UChar32 ch = term.patternCharacter;
+    if (m_pattern.ignoreCase() && isASCIIAlpha(ch)) {
+        // only 'X' and 'x' become 'x' by setting 0x20
+        m_assembler.arithmeticImmediate32(X86_64Assembler::Or, characterRegister, 0x20);
+        m_assembler.arithmeticImmediate32(X86_64Assembler::Cmp, characterRegister, toASCIILower(ch));
+    } else {
+        m_assembler.arithmeticImmediate32(X86_64Assembler::Cmp, characterRegister, ch);
+    }
+    mismatch.push_back(m_assembler.jump(X86_64Assembler::NotEqual));
+}
+
+void YarrGenerator::generateAssertionBOL(TermState& state)
+{
+    m_assembler.test(indexRegister, indexRegister);
+    size_t atStart = m_assembler.jump(X86_64Assembler::Equal);
+    if (m_pattern.multiline()) {
+        loadCharacter(indexRegister, -1);
+        generateCharacterClassTest(m_newlineCharacterClass.get(), false, state.m_failures);
+    } else {
+        state.m_failures.push_back(m_assembler.jump());
+    }
+    m_assembler.link(atStart);
+}
+
+void YarrGenerator::generateAssertionEOL(TermState& state)
+{
+    m_assembler.compare(indexRegister, lengthRegister);
+    size_t atEnd = m_assembler.jump(X86_64Assembler::Equal);
+    if (m_pattern.multiline()) {
+        loadCharacter(indexRegister, 0);
+        generateCharacterClassTest(m_newlineCharacterClass.get(), false, state.m_failures);
+    } else {
+        state.m_failures.push_back(m_assembler.jump());
+    }
+    m_assembler.link(atEnd);
+}
+
+void YarrGenerator::generateAssertionWordBoundary(TermState& state)
+{
+    // temp1 = whether the previous character is a word character, temp2 = the next one
+    JumpList done;
+    m_assembler.arithmetic32(X86_64Assembler::Xor, temp1Register, temp1Register);
+    m_assembler.test(indexRegister, indexRegister);
+    done.push_back(m_assembler.jump(X86_64Assembler::Equal));
+    loadCharacter(indexRegister, -1);
+    generateCharacterClassTest(m_wordCharacterClass.get(), false, done);
+    m_assembler.moveImmediate(temp1Register, 1);
+    linkJumps(done);
+
+    m_assembler.arithmetic32(X86_64Assembler::Xor, temp2Register, temp2Register);
+    m_assembler.compare(indexRegister, lengthRegister);
+    done.push_back(m_assembler.jump(X86_64Assembler::AboveOrEqual));
+    loadCharacter(indexRegister, 0);
+    generateCharacterClassTest(m_wordCharacterClass.get(), false, done);
+    m_assembler.moveImmediate(temp2Register, 1);
+    linkJumps(done);
+
+    m_assembler.compare32(temp1Register, temp2Register);
+    state.m_failures.push_back(m_assembler.jump(state.m_term->invert() ? X86_64Assembler::NotEqual : X86_64Assembler::Equal));
+}
+
+void YarrGenerator::generateCharacterTerm(TermState& state)
+{
+    PatternTerm& term = *state.m_term;
+    unsigned maxCount = term.quantityMaxCount.unsafeGet();
+
+    switch (term.quantityType) {
+    case QuantifierFixedCount: {
+        if (!maxCount) {
+            break;
+        }
+        if (maxCount > maximumBoundedQuantity) {
+            state.m_failures.push_back(m_assembler.jump());
+            break;
+        }
+
+        // check all characters are available at once
+        if (maxCount == 1) {
+            m_assembler.compare(indexRegister, lengthRegister);
+            state.m_failures.push_back(m_assembler.jump(X86_64Assembler::AboveOrEqual));
+        } else {
+            m_assembler.move(temp1Register, indexRegister);
+            m_assembler.arithmeticImmediate(X86_64Assembler::Add, temp1Register, maxCount);
+            m_assembler.compare(temp1Register, lengthRegister);
+            state.m_failures.push_back(m_assembler.jump(X86_64Assembler::Above));
+        }
+
+        const unsigned maximumUnrolledCount = 8;
+        if (maxCount <= maximumUnrolledCount) {
+            for (unsigned i = 0; i < maxCount; i++) {
+                loadCharacter(indexRegister, i);
+                generateCharacterTest(term, state.m_failures);
+            }
+            m_assembler.arithmeticImmediate(X86_64Assembler::Add, indexRegister, maxCount);
+        } else {
+            m_assembler.moveImmediate(temp2Register, maxCount);
+            size_t loop = label();
+            loadCharacter(indexRegister, 0);
+            generateCharacterTest(term, state.m_failures);
+            m_assembler.arithmeticImmediate(X86_64Assembler::Add, indexRegister, 1);
+            m_assembler.arithmeticImmediate(X86_64Assembler::Sub, temp2Register, 1);
+            m_assembler.link(m_assembler.jump(X86_64Assembler::NotEqual), loop);
+        }
+        break;
+    }
+    case QuantifierGreedy: {
+        // frame: begin index, end index of the current match
+        state.m_frameSlot = allocateFrameSlots(2);
+        m_assembler.store(X86_64Assembler::RSP, frameOffset(state.m_frameSlot), indexRegister);
+
+        X86_64Assembler::Register limit = lengthRegister;
+        if (maxCount <= maximumBoundedQuantity) {
+            m_assembler.move(temp2Register, indexRegister);
+            m_assembler.arithmeticImmediate(X86_64Assembler::Add, temp2Register, maxCount);
+            m_assembler.compare(temp2Register, lengthRegister);
+            m_assembler.conditionalMove(X86_64Assembler::Above, temp2Register, lengthRegister);
+            limit = temp2Register;
+        }
+
+        JumpList done;
+        size_t loop = label();
+        m_assembler.compare(indexRegister, limit);
+        done.push_back(m_assembler.jump(X86_64Assembler::AboveOrEqual));
+        loadCharacter(indexRegister, 0);
+        generateCharacterTest(term, done);
+        m_assembler.arithmeticImmediate(X86_64Assembler::Add, indexRegister, 1);
+        m_assembler.link(m_assembler.jump(), loop);
+        linkJumps(done);
+        m_assembler.store(X86_64Assembler::RSP, frameOffset(state.m_frameSlot + 1), indexRegister);
+        break;
+    }
+    case QuantifierNonGreedy:
+        // frame: begin index, end index of the current match
+        state.m_frameSlot = allocateFrameSlots(2);
+        m_assembler.store(X86_64Assembler::RSP, frameOffset(state.m_frameSlot), indexRegister);
+        m_assembler.store(X86_64Assembler::RSP, frameOffset(state.m_frameSlot + 1), indexRegister);
+        break;
+    }
+}
+
+void YarrGenerator::generateCharacterTermBacktrack(TermState& state, JumpList& exhausted)
+{
+    PatternTerm& term = *state.m_term;
+    unsigned maxCount = term.quantityMaxCount.unsafeGet();
+
+    switch (term.quantityType) {
+    case QuantifierFixedCount:
+        break;
+    case QuantifierGreedy:
+        // give back one character
+        m_assembler.load(indexRegister, X86_64Assembler::RSP, frameOffset(state.m_frameSlot + 1));
+        m_assembler.compare(indexRegister, X86_64Assembler::RSP, frameOffset(state.m_frameSlot));
+        exhausted.push_back(m_assembler.jump(X86_64Assembler::Equal));
+        m_assembler.arithmeticImmediate(X86_64Assembler::Sub, indexRegister, 1);
+        m_assembler.store(X86_64Assembler::RSP, frameOffset(state.m_frameSlot + 1), indexRegister);
+        m_assembler.link(m_assembler.jump(), state.m_forwardEnd);
+        break;
+    case QuantifierNonGreedy:
+        // take one more character
+        m_assembler.load(indexRegister, X86_64Assembler::RSP, frameOffset(state.m_frameSlot + 1));
+        if (maxCount <= maximumBoundedQuantity) {
+            m_assembler.move(temp1Register, indexRegister);
+            m_assembler.load(temp2Register, X86_64Assembler::RSP, frameOffset(state.m_frameSlot));
+            m_assembler.arithmetic(X86_64Assembler::Sub, temp1Register, temp2Register);
+            m_assembler.arithmeticImmediate(X86_64Assembler::Cmp, temp1Register, maxCount);
+            exhausted.push_back(m_assembler.jump(X86_64Assembler::AboveOrEqual));
+        }
+        m_assembler.compare(indexRegister, lengthRegister);
+        exhausted.push_back(m_assembler.jump(X86_64Assembler::AboveOrEqual));
+        loadCharacter(indexRegister, 0);
+        generateCharacterTest(term, exhausted);
+        m_assembler.arithmeticImmediate(X86_64Assembler::Add, indexRegister, 1);
+        m_assembler.store(X86_64Assembler::RSP, frameOffset(state.m_frameSlot + 1), indexRegister);
+        m_assembler.link(m_assembler.jump(), state.m_forwardEnd);
+        break;
+    }
+}
+
+void YarrGenerator::clearCapture(unsigned subpatternId)
+{
+    m_assembler.moveImmediate(temp1Register, offsetNoMatch);
+    m_assembler.store32(outputRegister, (subpatternId << 1) * sizeof(unsigned), temp1Register);
+    m_assembler.store32(outputRegister, ((subpatternId << 1) + 1) * sizeof(unsigned), temp1Register);
+}
+
+void YarrGenerator::generateParenthesesOnce(TermState& state)
+{
+    // same behavior as ParenthesesSubpatternOnceBegin/End of the interpreter
+    PatternTerm& term = *state.m_term;
+    auto& alternatives = term.parentheses.disjunction->m_alternatives;
+    unsigned subpatternId = term.parentheses.subpatternId;
+
+    // frame: begin index, alternative which matched (alternatives.size() when the parentheses are skipped)
+    state.m_frameSlot = allocateFrameSlots(2);
+    int32_t beginOffset = frameOffset(state.m_frameSlot);
+    int32_t alternativeOffset = frameOffset(state.m_frameSlot + 1);
+
+    JumpList skipped;
+    m_assembler.store(X86_64Assembler::RSP, beginOffset, indexRegister);
+    if (term.quantityType == QuantifierNonGreedy) {
+        // try to skip first
+        m_assembler.storeImmediate(X86_64Assembler::RSP, alternativeOffset, alternatives.size());
+        skipped.push_back(m_assembler.jump());
+        state.m_bodyEntry = label();
+        m_assembler.load(indexRegister, X86_64Assembler::RSP, beginOffset);
+    }
+    if (term.capture()) {
+        m_assembler.store32(outputRegister, (subpatternId << 1) * sizeof(unsigned), indexRegister);
+    }
+
+    JumpList matched;
+    JumpList exhausted;
+    for (size_t i = 0; i < alternatives.size(); i++) {
+        linkJumps(exhausted);
+        if (i) {
+            m_assembler.load(indexRegister, X86_64Assembler::RSP, beginOffset);
+        }
+
+        SequenceState sequence;
+        generateSequence(alternatives[i].get(), sequence);
+        JumpList empty;
+        if (term.quantityType != QuantifierFixedCount) {
+            // an empty match of optional parentheses is a failure
+            m_assembler.compare(indexRegister, X86_64Assembler::RSP, beginOffset);
+            empty.push_back(m_assembler.jump(X86_64Assembler::Equal));
+        }
+        m_assembler.storeImmediate(X86_64Assembler::RSP, alternativeOffset, i);
+        matched.push_back(m_assembler.jump());
+
+        size_t backtrack = generateSequenceBacktrack(sequence, exhausted);
+        linkJumps(empty, backtrack);
+        state.m_alternativeBacktracks.push_back(backtrack);
+    }
+
+    // no alternative matched
+    linkJumps(exhausted);
+    if (term.capture()) {
+        clearCapture(subpatternId);
+    }
+    if (term.quantityType == QuantifierGreedy) {
+        m_assembler.load(indexRegister, X86_64Assembler::RSP, beginOffset);
+        m_assembler.storeImmediate(X86_64Assembler::RSP, alternativeOffset, alternatives.size());
+        skipped.push_back(m_assembler.jump());
+    } else {
+        state.m_failures.push_back(m_assembler.jump());
+    }
+
+    linkJumps(matched);
+    if (term.capture()) {
+        m_assembler.store32(outputRegister, ((subpatternId << 1) + 1) * sizeof(unsigned), indexRegister);
+    }
+    linkJumps(skipped);
+}
+
+void YarrGenerator::generateParenthesesOnceBacktrack(TermState& state, JumpList& exhausted)
+{
+    PatternTerm& term = *state.m_term;
+    int32_t alternativeOffset = frameOffset(state.m_frameSlot + 1);
+    size_t alternativeCount = state.m_alternativeBacktracks.size();
+
+    if (term.quantityType != QuantifierFixedCount) {
+        m_assembler.compareImmediate(X86_64Assembler::RSP, alternativeOffset, alternativeCount);
+        if (term.quantityType == QuantifierGreedy) {
+            // matching nothing was the last chance
+            exhausted.push_back(m_assembler.jump(X86_64Assembler::Equal));
+        } else {
+            // try the body after skipping it
+            m_assembler.link(m_assembler.jump(X86_64Assembler::Equal), state.m_bodyEntry);
+        }
+    }
+
+    for (size_t i = 0; i + 1 < alternativeCount; i++) {
+        m_assembler.compareImmediate(X86_64Assembler::RSP, alternativeOffset, i);
+        m_assembler.link(m_assembler.jump(X86_64Assembler::Equal), state.m_alternativeBacktracks[i]);
+    }
+    m_assembler.link(m_assembler.jump(), state.m_alternativeBacktracks[alternativeCount - 1]);
+}
+
+void YarrGenerator::generateParenthesesTerminal(TermState& state)
+{
+    // greedy non-capturing (...)* at the end of the pattern. it is never backtracked into,
+    // so only the current iteration can backtrack
+    auto& alternatives = state.m_term->parentheses.disjunction->m_alternatives;
+    state.m_frameSlot = allocateFrameSlots(1);
+    int32_t beginOffset = frameOffset(state.m_frameSlot);
+
+    size_t loop = label();
+    m_assembler.store(X86_64Assembler::RSP, beginOffset, indexRegister);
+
+    JumpList exhausted;
+    for (size_t i = 0; i < alternatives.size(); i++) {
+        linkJumps(exhausted);
+        if (i) {
+            m_assembler.load(indexRegister, X86_64Assembler::RSP, beginOffset);
+        }
+
+        SequenceState sequence;
+        generateSequence(alternatives[i].get(), sequence);
+        // an empty iteration is a failure
+        JumpList empty;
+        m_assembler.compare(indexRegister, X86_64Assembler::RSP, beginOffset);
+        empty.push_back(m_assembler.jump(X86_64Assembler::Equal));
+        m_assembler.link(m_assembler.jump(), loop);
+
+        size_t backtrack = generateSequenceBacktrack(sequence, exhausted);
+        linkJumps(empty, backtrack);
+    }
+
+    // the iteration failed, which finishes the parentheses
+    linkJumps(exhausted);
+    m_assembler.load(indexRegister, X86_64Assembler::RSP, beginOffset);
+}
+
+void YarrGenerator::generateParentheticalAssertion(TermState& state)
+{
+    // lookahead is atomic: it is never backtracked into
+    PatternTerm& term = *state.m_term;
+    auto& alternatives = term.parentheses.disjunction->m_alternatives;
+    state.m_frameSlot = allocateFrameSlots(1);
+    int32_t beginOffset = frameOffset(state.m_frameSlot);
+    m_assembler.store(X86_64Assembler::RSP, beginOffset, indexRegister);
+
+    JumpList matched;
+    JumpList exhausted;
+    for (size_t i = 0; i < alternatives.size(); i++) {
+        linkJumps(exhausted);
+        if (i) {
+            m_assembler.load(indexRegister, X86_64Assembler::RSP, beginOffset);
+        }
+
+        SequenceState sequence;
+        generateSequence(alternatives[i].get(), sequence);
+        matched.push_back(m_assembler.jump());
+        generateSequenceBacktrack(sequence, exhausted);
+    }
+
+    JumpList done;
+    linkJumps(exhausted);
+    if (term.invert()) {
+        m_assembler.load(indexRegister, X86_64Assembler::RSP, beginOffset);
+        done.push_back(m_assembler.jump());
+    } else {
+        state.m_failures.push_back(m_assembler.jump());
+    }
+
+    linkJumps(matched);
+    if (term.invert()) {
+        state.m_failures.push_back(m_assembler.jump());
+    } else {
+        m_assembler.load(indexRegister, X86_64Assembler::RSP, beginOffset);
+    }
+    linkJumps(done);
+}
+
+void YarrGenerator::generateTerm(TermState& state)
+{
+    PatternTerm& term = *state.m_term;
+    switch (term.type) {
+    case PatternTerm::TypeAssertionBOL:
+        generateAssertionBOL(state);
+        break;
+    case PatternTerm::TypeAssertionEOL:
+        generateAssertionEOL(state);
+        break;
+    case PatternTerm::TypeAssertionWordBoundary:
+        generateAssertionWordBoundary(state);
+        break;
+    case PatternTerm::TypePatternCharacter:
+    case PatternTerm::TypeCharacterClass:
+        generateCharacterTerm(state);
+        break;
+    case PatternTerm::TypeForwardReference:
+        // always matches the empty string
+        break;
+    case PatternTerm::TypeParenthesesSubpattern:
+        if (term.quantityMaxCount == 1 && !term.parentheses.isCopy) {
+            generateParenthesesOnce(state);
+        } else {
+            ASSERT(term.parentheses.isTerminal);
+            generateParenthesesTerminal(state);
+        }
+        break;
+    case PatternTerm::TypeParentheticalAssertion:
+        generateParentheticalAssertion(state);
+        break;
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+}
+
+void YarrGenerator::generateTermBacktrack(TermState& state, JumpList& exhausted)
+{
+    PatternTerm& term = *state.m_term;
+    switch (term.type) {
+    case PatternTerm::TypePatternCharacter:
+    case PatternTerm::TypeCharacterClass:
+        generateCharacterTermBacktrack(state, exhausted);
+        break;
+    case PatternTerm::TypeParenthesesSubpattern:
+        if (term.quantityMaxCount == 1 && !term.parentheses.isCopy) {
+            generateParenthesesOnceBacktrack(state, exhausted);
+        }
+        break;
+    default:
+        // nothing to retry. continue backtracking into the previous term
+        break;
+    }
+}
+
+void YarrGenerator::generateSequence(PatternAlternative* alternative, SequenceState& state)
+{
+    state.reserve(alternative->m_terms.size());
+    for (PatternTerm& term : alternative->m_terms) {
+        state.emplace_back(&term);
+        generateTerm(state.back());
+        state.back().m_forwardEnd = label();
+    }
+}
+
+size_t YarrGenerator::generateSequenceBacktrack(SequenceState& state, JumpList& exhausted)
+{
+    // backtracking visits terms in reverse order. a term which finds another way
+    // to match jumps back to the forward code of the next term
+    size_t entry = label();
+    JumpList pending;
+    for (size_t i = state.size(); i--;) {
+        linkJumps(pending);
+        if (i + 1 < state.size()) {
+            linkJumps(state[i + 1].m_failures);
+        }
+        generateTermBacktrack(state[i], pending);
+    }
+    linkJumps(pending);
+    if (state.size()) {
+        linkJumps(state[0].m_failures);
+    }
+    exhausted.push_back(m_assembler.jump());
+    return entry;
+}
+
+void YarrGenerator::generateBodyAlternative(PatternAlternative* alternative, JumpList& matched, JumpList& failed)
+{
+    m_assembler.move(indexRegister, matchStartRegister);
+    SequenceState sequence;
+    generateSequence(alternative, sequence);
+    matched.push_back(m_assembler.jump());
+    generateSequenceBacktrack(sequence, failed);
+}
+
+void YarrGenerator::generateFirstCharacterScan(PatternAlternative* alternative, JumpList& notMatched)
+{
+    // skip start positions where the first character of the only alternative does not match
+    if (alternative->m_terms.isEmpty()) {
+        return;
+    }
+    PatternTerm& first = alternative->m_terms[0];
+    if ((first.type != PatternTerm::TypePatternCharacter && first.type != PatternTerm::TypeCharacterClass)
+        || first.quantityType != QuantifierFixedCount || !first.quantityMaxCount) {
+        return;
+    }
+
+    size_t scan = label();
+    m_assembler.compare(matchStartRegister, lengthRegister);
+    notMatched.push_back(m_assembler.jump(X86_64Assembler::AboveOrEqual));
+    loadCharacter(matchStartRegister, 0);
+    JumpList mismatch;
+    generateCharacterTest(first, mismatch);
+    size_t found = m_assembler.jump();
+    linkJumps(mismatch);
+    m_assembler.arithmeticImmediate(X86_64Assembler::Add, matchStartRegister, 1);
+    m_assembler.link(m_assembler.jump(), scan);
+    m_assembler.link(found);
+}
+
+bool YarrGenerator::generate()
+{
+    // surrogate pairs are not handled
+    if (m_pattern.unicode() || !isSupported(m_pattern.m_body)) {
+        return false;
+    }
+
+    // upper halves of 32-bit arguments are undefined
+    m_assembler.move32(indexRegister, indexRegister);
+    m_assembler.move32(lengthRegister, lengthRegister);
+    m_assembler.arithmeticImmediate(X86_64Assembler::Sub, X86_64Assembler::RSP, 0);
+    size_t frameSizePosition = label();
+    m_assembler.move(matchStartRegister, indexRegister);
+
+    JumpList matched;
+    JumpList notMatched;
+    JumpList nextAlternative;
+    auto& alternatives = m_pattern.m_body->m_alternatives;
+
+    // alternatives which start with ^ are tried at the start position only (see optimizeBOL)
+    size_t firstLoopAlternative = 0;
+    while (firstLoopAlternative < alternatives.size() && alternatives[firstLoopAlternative]->onceThrough()) {
+        linkJumps(nextAlternative);
+        generateBodyAlternative(alternatives[firstLoopAlternative].get(), matched, nextAlternative);
+        firstLoopAlternative++;
+    }
+    linkJumps(nextAlternative);
+
+    if (firstLoopAlternative == alternatives.size()) {
+        notMatched.push_back(m_assembler.jump());
+    } else {
+        size_t loop = label();
+        if (!m_pattern.sticky() && firstLoopAlternative + 1 == alternatives.size()) {
+            generateFirstCharacterScan(alternatives[firstLoopAlternative].get(), notMatched);
+        }
+        for (size_t i = firstLoopAlternative; i < alternatives.size(); i++) {
+            linkJumps(nextAlternative);
+            generateBodyAlternative(alternatives[i].get(), matched, nextAlternative);
+        }
+
+        // no alternative matched. try from the next position
+        linkJumps(nextAlternative);
+        if (m_pattern.sticky()) {
+            notMatched.push_back(m_assembler.jump());
+        } else {
+            m_assembler.compare(matchStartRegister, lengthRegister);
+            notMatched.push_back(m_assembler.jump(X86_64Assembler::AboveOrEqual));
+            m_assembler.arithmeticImmediate(X86_64Assembler::Add, matchStartRegister, 1);
+            m_assembler.link(m_assembler.jump(), loop);
+        }
+    }
+
+    JumpList done;
+    linkJumps(matched);
+    m_assembler.store32(outputRegister, 0, matchStartRegister);
+    m_assembler.store32(outputRegister, sizeof(unsigned), indexRegister);
+    m_assembler.move32(X86_64Assembler::RAX, matchStartRegister);
+    done.push_back(m_assembler.jump());
+
+    linkJumps(notMatched);
+    m_assembler.moveImmediate(X86_64Assembler::RAX, offsetNoMatch);
+
+    linkJumps(done);
+    if (m_frameSlots > maximumFrameSlots) {
+        return false;
+    }
+    int32_t frameSize = (int32_t)((frameOffset(m_frameSlots) + 15) & ~15);
+    m_assembler.patch32(frameSizePosition, frameSize);
+    m_assembler.arithmeticImmediate(X86_64Assembler::Add, X86_64Assembler::RSP, frameSize);
+    m_assembler.ret();
+
+    // character tables follow the code and are addressed relative to rip
+    std::vector<size_t> tablePositions;
+    m_assembler.align(16);
+    for (auto& table : m_characterTables) {
+        tablePositions.push_back(label());
+        m_assembler.emitBytes(table.data(), table.size());
+    }
+    for (auto& reference : m_characterTableReferences) {
+        m_assembler.patch32(reference.first, (int32_t)(tablePositions[reference.second] - reference.first));
+    }
+
+    return true;
+}
+
+bool YarrCodeBlock::compile(YarrPattern& pattern, YarrCharSize charSize)
+{
+    YarrGenerator generator(pattern, charSize);
+    if (generator.generate()) {
+        const X86_64Assembler& assembler = generator.assembler();
+        m_code[charSize] = Escargot::JITCode::allocateExecutableMemory(assembler.data(), assembler.size(), m_memorySize[charSize]);
+    }
+
+    if (!m_code[charSize]) {
+        m_compileFailed[charSize] = true;
+        return false;
+    }
+    return true;
+}
+
+void YarrCodeBlock::clear()
+{
+    for (size_t i = 0; i < 2; i++) {
+        if (m_code[i]) {
+            Escargot::JITCode::freeExecutableMemory(m_code[i], m_memorySize[i]);
+            m_code[i] = nullptr;
+        }
+    }
+}
+}
+} // namespace JSC::Yarr
+
+#endif // ENABLE_JIT
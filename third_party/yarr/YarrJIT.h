@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2021-present Samsung Electronics Co., Ltd
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#if defined(ENABLE_JIT)
+
+#include "Yarr.h"
+
+namespace JSC {
+namespace Yarr {
+
+struct YarrPattern;
+
+// Native code of a pattern, compiled separately for 8-bit and 16-bit input.
+// Patterns with constructs the JIT does not handle (back references, quantified
+// parentheses, unicode mode...) are left to the interpreter.
+class YarrCodeBlock {
+public:
+    typedef unsigned (*YarrJITCode8)(const LChar* input, unsigned start, unsigned length, unsigned* output);
+    typedef unsigned (*YarrJITCode16)(const UChar* input, unsigned start, unsigned length, unsigned* output);
+
+    YarrCodeBlock()
+        : m_compileFailed{ false, false }
+        , m_code{ nullptr, nullptr }
+        , m_memorySize{ 0, 0 }
+    {
+    }
+
+    ~YarrCodeBlock()
+    {
+        clear();
+    }
+
+    // compiles the pattern for `charSize` on first use.
+    // returns false when the pattern should run on the interpreter
+    bool ensureCompiled(YarrPattern& pattern, YarrCharSize charSize)
+    {
+        if (LIKELY(m_code[charSize] != nullptr)) {
+            return true;
+        }
+        if (m_compileFailed[charSize]) {
+            return false;
+        }
+        return compile(pattern, charSize);
+    }
+
+    // same as interpret(): returns the match start or offsetNoMatch and fills `output`
+    unsigned execute(const LChar* input, unsigned start, unsigned length, unsigned* output, unsigned numSubpatterns)
+    {
+        if (start > length) {
+            return offsetNoMatch;
+        }
+        resetOutput(output, numSubpatterns);
+        return reinterpret_cast<YarrJITCode8>(m_code[Char8])(input, start, length, output);
+    }
+
+    unsigned execute(const UChar* input, unsigned start, unsigned length, unsigned* output, unsigned numSubpatterns)
+    {
+        if (start > length) {
+            return offsetNoMatch;
+        }
+        resetOutput(output, numSubpatterns);
+        return reinterpret_cast<YarrJITCode16>(m_code[Char16])(input, start, length, output);
+    }
+
+    void clear();
+
+private:
+    bool compile(YarrPattern& pattern, YarrCharSize charSize);
+
+    static void resetOutput(unsigned* output, unsigned numSubpatterns)
+    {
+        for (unsigned i = 0; i < numSubpatterns + 1; ++i) {
+            output[i << 1] = offsetNoMatch;
+        }
+    }
+
+    bool m_compileFailed[2];
+    void* m_code[2];
+    size_t m_memorySize[2];
+};
+}
+} // namespace JSC::Yarr
+
+#endif // ENABLE_JIT
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2021-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// Regular expression microbenchmarks.
+// usage: escargot tools/benchmark/regexp.js
+
+var logLines = [];
+for (var i = 0; i < 200; i++) {
+    logLines.push("2021-03-" + (10 + i % 20) + " 12:" + (10 + i % 50) + ":07.123 [" + (i % 3 ? "INFO" : "WARN") +
+        "] worker-" + (i % 7) + " request id=" + (100000 + i) + " path=/api/v1/items/" + i + " took " + (i * 7 % 300) + "ms");
+}
+var logText = logLines.join("\n");
+
+var template = "";
+for (var i = 0; i < 100; i++) {
+    template += "<li class=\"{{cls}}\">{{name}} - {{ price }} ({{count}})</li>\n";
+}
+var templateValues = { cls: "item", name: "Escargot", price: "12.50", count: "3" };
+
+var mailText = "";
+for (var i = 0; i < 100; i++) {
+    mailText += "contact user" + i + ".name@example" + (i % 5) + ".com or visit http://www.example.org/page" + i + ", ";
+}
+
+var wideText = logText.replace(/INFO/g, "안녕");
+
+var benchmarks = {
+    "log-parse": function () {
+        var re = /^(\d{4})-(\d\d)-(\d\d) (\d\d):(\d\d):(\d\d)\.\d+ \[(\w+)\] ([\w-]+) .*?id=(\d+) path=(\S+) took (\d+)ms$/;
+        var count = 0;
+        for (var i = 0; i < logLines.length; i++) {
+            var m = re.exec(logLines[i]);
+            if (m && m[7] === "WARN") {
+                count++;
+            }
+        }
+        return count;
+    },
+    "log-scan-multiline": function () {
+        return logText.match(/^.*WARN.*$/gm).length;
+    },
+    "template-replace": function () {
+        return template.replace(/\{\{\s*(\w+)\s*\}\}/g, function (all, key) {
+            return templateValues[key];
+        }).length;
+    },
+    "email-extract": function () {
+        return mailText.match(/[a-z0-9._%+-]+@[a-z0-9.-]+\.[a-z]{2,}/gi).length;
+    },
+    "url-extract": function () {
+        return mailText.match(/https?:\/\/[\w.]+(?:\/[\w-]*)*/g).length;
+    },
+    "split-whitespace": function () {
+        return logText.split(/\s+/).length;
+    },
+    "test-keyword": function () {
+        var re = /worker-[3-5]\b/;
+        var count = 0;
+        for (var i = 0; i < logLines.length; i++) {
+            if (re.test(logLines[i])) {
+                count++;
+            }
+        }
+        return count;
+    },
+    "class-scan": function () {
+        return logText.replace(/[^a-zA-Z0-9]+/g, " ").length;
+    },
+    "lookahead": function () {
+        return logText.match(/\d+(?=ms)/g).length;
+    },
+    "wide-log-scan": function () {
+        return wideText.match(/\[(\S+)\] worker-(\d)/g).length;
+    }
+};
+
+var iterations = 200;
+var total = 0;
+for (var name in benchmarks) {
+    var fn = benchmarks[name];
+    fn(); // warm up
+    var start = Date.now();
+    for (var i = 0; i < iterations; i++) {
+        fn();
+    }
+    var elapsed = Date.now() - start;
+    total += elapsed;
+    print(name + ": " + elapsed + "ms");
+}
+print("total: " + total + "ms");
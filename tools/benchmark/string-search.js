@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2021-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// String search microbenchmarks (indexOf, includes, split and replace with string patterns).
+// usage: escargot tools/benchmark/string-search.js
+
+var logLines = [];
+for (var i = 0; i < 200; i++) {
+    logLines.push("2021-03-" + (10 + i % 20) + " 12:" + (10 + i % 50) + ":07.123 [" + (i % 3 ? "INFO" : "WARN") +
+        "] worker-" + (i % 7) + " request id=" + (100000 + i) + " path=/api/v1/items/" + i + " took " + (i * 7 % 300) + "ms");
+}
+var logText = logLines.join("\n");
+
+var csvRows = [];
+for (var i = 0; i < 500; i++) {
+    csvRows.push(i + ",item" + i + "," + (i * 13 % 1000) / 10 + ",\"" + (i % 2 ? "red" : "blue") + "\"," + (i % 4 === 0));
+}
+var csvText = csvRows.join("\r\n");
+
+var wideText = logText.replace(/INFO/g, "안녕");
+
+var benchmarks = {
+    "log-indexOf-char": function () {
+        var count = 0;
+        var pos = logText.indexOf("[");
+        while (pos >= 0) {
+            count++;
+            pos = logText.indexOf("[", pos + 1);
+        }
+        return count;
+    },
+    "log-indexOf-word": function () {
+        var count = 0;
+        var pos = logText.indexOf("WARN");
+        while (pos >= 0) {
+            count++;
+            pos = logText.indexOf("WARN", pos + 1);
+        }
+        return count;
+    },
+    "log-includes-line": function () {
+        var count = 0;
+        for (var i = 0; i < logLines.length; i++) {
+            if (logLines[i].includes("path=/api/v1/items/1")) {
+                count++;
+            }
+        }
+        return count;
+    },
+    "log-indexOf-long-miss": function () {
+        return logText.indexOf("request id=100199 path=/api/v1/items/200");
+    },
+    "log-split-lines": function () {
+        return logText.split("\n").length;
+    },
+    "csv-split": function () {
+        var rows = csvText.split("\r\n");
+        var cells = 0;
+        for (var i = 0; i < rows.length; i++) {
+            cells += rows[i].split(",").length;
+        }
+        return cells;
+    },
+    "log-replace-string": function () {
+        var count = 0;
+        for (var i = 0; i < logLines.length; i++) {
+            count += logLines[i].replace(" took ", "=").length;
+        }
+        return count;
+    },
+    "wide-indexOf": function () {
+        var count = 0;
+        var pos = wideText.indexOf("worker-3");
+        while (pos >= 0) {
+            count++;
+            pos = wideText.indexOf("worker-3", pos + 1);
+        }
+        return count;
+    },
+    "wide-split-lines": function () {
+        return wideText.split("\n").length;
+    }
+};
+
+var iterations = 200;
+var total = 0;
+for (var name in benchmarks) {
+    var fn = benchmarks[name];
+    fn(); // warm up
+    var start = Date.now();
+    for (var i = 0; i < iterations; i++) {
+        fn();
+    }
+    var elapsed = Date.now() - start;
+    total += elapsed;
+    print(name + ": " + elapsed + "ms");
+}
+print("total: " + total + "ms");